@@ -0,0 +1,273 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+// Measures the throughput of the encrypted backup archive.
+//
+// Usage: benchmark-opentxs-backup <scratch directory> [objects...]
+//
+// For each object count (default 100000 and 1000000) a fresh archive is
+// filled with synthetic objects, then 1% of the objects are replaced and the
+// tree is backed up again the way StorageMultiplex synchronizes a backup:
+// every key is offered, keys the archive already holds are skipped. The
+// archive is then reopened to time manifest loading and random restores.
+//
+// legacy_encrypt extrapolates the previous one-AEAD-per-object cost from a
+// sample of per-object encryptions with the same key.
+
+#include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/api/crypto/Symmetric.hpp"
+#include "opentxs/api/storage/Storage.hpp"
+#include "opentxs/api/Native.hpp"
+#include "opentxs/core/crypto/OTPassword.hpp"
+#include "opentxs/core/crypto/OTPasswordData.hpp"
+#include "opentxs/core/crypto/SymmetricKey.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Flag.hpp"
+#include "opentxs/storage/drivers/StorageFSArchive.hpp"
+#include "opentxs/storage/StorageConfig.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Proto.hpp"
+#include "opentxs/Types.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define OBJECT_SIZE 256
+#define LEGACY_SAMPLE 10000
+#define RESTORE_SAMPLE 1000
+
+using namespace opentxs;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(const Clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start)
+        .count();
+}
+
+// Stands in for the base58 content hash which keys real objects
+std::string make_key(const std::uint64_t generation, const std::uint64_t index)
+{
+    std::ostringstream key{};
+    key << "ot" << std::hex << std::setw(16) << std::setfill('0')
+        << generation << std::setw(16) << index;
+
+    return key.str();
+}
+
+// Serialized protobufs are partly structured and partly random
+std::string make_value(std::mt19937_64& rng, const std::uint64_t index)
+{
+    std::string output(OBJECT_SIZE, '\0');
+
+    for (std::size_t i = 0; i < output.size(); i += 8) {
+        const auto word = (0 == (i % 32)) ? index : rng();
+
+        for (std::size_t j = 0; (j < 8) && ((i + j) < output.size()); ++j) {
+            output[i + j] = static_cast<char>(word >> (8 * j));
+        }
+    }
+
+    return output;
+}
+
+void report(
+    const std::string& label,
+    const std::uint64_t objects,
+    const std::uint64_t written,
+    const double total)
+{
+    std::cout << label << " objects=" << objects << " written=" << written
+              << " total_ms=" << total
+              << " per_second=" << (1000.0 * objects / total) << std::endl;
+}
+
+std::unique_ptr<StorageFSArchive> open_archive(
+    const StorageConfig& config,
+    const Flag& bucket,
+    const std::string& folder,
+    const OTPassword& seed)
+{
+    const auto& crypto = OT::App().Crypto();
+    auto key = crypto.Symmetric().Key(seed);
+    const Digest digest = [](const std::uint32_t,
+                             const std::string&,
+                             std::string&) -> bool { return false; };
+    const Random random = []() -> std::string { return {}; };
+
+    return std::unique_ptr<StorageFSArchive>(StorageFSArchive::Factory(
+        OT::App().DB(), config, digest, random, bucket, folder, key));
+}
+
+void run(const std::string& directory, const std::uint64_t objects)
+{
+    const std::string folder = directory + "/backup-" + std::to_string(objects);
+    boost::system::error_code ec{};
+    boost::filesystem::remove_all(folder, ec);
+    StorageConfig config{};
+    auto bucket = Flag::Factory(false);
+    OTPassword seed{};
+    seed.randomizeMemory(32);
+    std::mt19937_64 rng(objects);
+    std::vector<std::uint64_t> generation(objects, 0);
+
+    {
+        auto archive = open_archive(config, bucket, folder, seed);
+        const auto start = Clock::now();
+
+        for (std::uint64_t i = 0; i < objects; ++i) {
+            archive->Store(false, make_key(0, i), make_value(rng, i), false);
+        }
+
+        archive->StoreRoot(false, make_key(0, objects));
+        report("full", objects, objects, elapsed_ms(start));
+    }
+
+    {
+        auto archive = open_archive(config, bucket, folder, seed);
+        const auto changed = std::max<std::uint64_t>(1, objects / 100);
+
+        for (std::uint64_t i = 0; i < changed; ++i) {
+            generation[rng() % objects] = 1;
+        }
+
+        std::uint64_t written{0};
+        const auto start = Clock::now();
+
+        for (std::uint64_t i = 0; i < objects; ++i) {
+            const auto key = make_key(generation[i], i);
+
+            if (archive->Archived(key)) {
+                continue;
+            }
+
+            archive->Store(false, key, make_value(rng, i), false);
+            ++written;
+        }
+
+        archive->StoreRoot(false, make_key(1, objects));
+        report("incremental", objects, written, elapsed_ms(start));
+    }
+
+    {
+        const auto start = Clock::now();
+        auto archive = open_archive(config, bucket, folder, seed);
+        report("reopen", objects, 0, elapsed_ms(start));
+        std::uint64_t failed{0};
+        const auto restore = Clock::now();
+
+        for (std::uint64_t i = 0; i < RESTORE_SAMPLE; ++i) {
+            const auto index = rng() % objects;
+            std::string value{};
+
+            const auto key = make_key(generation[index], index);
+
+            if (false == archive->Load(key, false, value)) {
+                ++failed;
+            }
+        }
+
+        std::cout << "restore objects=" << RESTORE_SAMPLE
+                  << " failed=" << failed
+                  << " total_ms=" << elapsed_ms(restore) << std::endl;
+    }
+
+    {
+        const auto& crypto = OT::App().Crypto();
+        auto key = crypto.Symmetric().Key(seed);
+        const auto sample = std::min<std::uint64_t>(objects, LEGACY_SAMPLE);
+        OTPasswordData reason("");
+        const auto start = Clock::now();
+
+        for (std::uint64_t i = 0; i < sample; ++i) {
+            proto::Ciphertext ciphertext{};
+            auto iv = Data::Factory();
+            key->Encrypt(make_value(rng, i), iv, reason, ciphertext, false);
+        }
+
+        const auto total = elapsed_ms(start) * objects / sample;
+        report("legacy_encrypt", objects, objects, total);
+    }
+
+    boost::filesystem::remove_all(folder, ec);
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    if (2 > argc) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <scratch directory> [objects...]" << std::endl;
+
+        return 1;
+    }
+
+    std::vector<std::uint64_t> sizes{};
+
+    for (int i = 2; i < argc; ++i) {
+        sizes.push_back(std::stoull(argv[i]));
+    }
+
+    if (sizes.empty()) {
+        sizes = {100000, 1000000};
+    }
+
+    ArgList args{};
+    OT::ClientFactory(args);
+
+    for (const auto& objects : sizes) {
+        run(argv[1], objects);
+    }
+
+    OT::Cleanup();
+
+    return 0;
+}
@@ -0,0 +1,209 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+// Measures request latency and throughput of a single notary connection.
+// Requests are first sent one at a time, which is what the old REQ socket
+// allowed, and then with up to <window> requests outstanding at once.
+//
+// Usage: benchmark-opentxs-connection <server contract file> [requests]
+//        [window]
+//
+// The contract file contains the armored contract of a notary which is
+// already running, for example a local opentxs-notary instance. Requests are
+// empty keepalive messages so the figures reflect the transport and the
+// notary message loop rather than command processing.
+
+#include "opentxs/api/network/ZMQ.hpp"
+#include "opentxs/api/Api.hpp"
+#include "opentxs/api/Native.hpp"
+#include "opentxs/client/OTAPI_Exec.hpp"
+#include "opentxs/network/ServerConnection.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Types.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace opentxs;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(const Clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start)
+        .count();
+}
+
+double percentile(std::vector<double>& samples, const double fraction)
+{
+    if (samples.empty()) {
+
+        return 0;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const auto index =
+        static_cast<std::size_t>(fraction * (samples.size() - 1));
+
+    return samples.at(index);
+}
+
+std::string read_file(const std::string& path)
+{
+    std::ifstream file(path);
+    std::stringstream output{};
+    output << file.rdbuf();
+
+    return output.str();
+}
+
+void report(
+    const std::string& label,
+    std::vector<double>& latency,
+    const std::size_t failed,
+    const double total)
+{
+    std::cout << label << " requests=" << latency.size()
+              << " failed=" << failed << " total_ms=" << total
+              << " per_second=" << (1000.0 * latency.size() / total)
+              << " p50_ms=" << percentile(latency, 0.5)
+              << " p99_ms=" << percentile(latency, 0.99) << std::endl;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    if (2 > argc) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <server contract file> [requests] [window]"
+                  << std::endl;
+
+        return 1;
+    }
+
+    const std::size_t requests = (2 < argc) ? std::stoul(argv[2]) : 1000;
+    const std::size_t window = (3 < argc) ? std::stoul(argv[3]) : 32;
+    ArgList args{};
+    OT::ClientFactory(args);
+
+    {
+        const auto& api = OT::App().API();
+        const auto serverID = api.Exec().AddServerContract(read_file(argv[1]));
+
+        if (serverID.empty()) {
+            std::cerr << "Failed to import " << argv[1] << std::endl;
+
+            return 1;
+        }
+
+        auto& connection = OT::App().ZMQ().Server(serverID);
+        std::vector<double> latency{};
+        std::size_t failed{0};
+
+        // Establish the connection before timing anything
+        connection.Send(std::string(""));
+
+        auto start = Clock::now();
+
+        for (std::size_t i = 0; i < requests; ++i) {
+            const auto sent = Clock::now();
+            const auto reply = connection.Send(std::string(""));
+
+            if (SendResult::VALID_REPLY == reply.first) {
+                latency.push_back(elapsed_ms(sent));
+            } else {
+                ++failed;
+            }
+        }
+
+        report("serial", latency, failed, elapsed_ms(start));
+        latency.clear();
+        failed = 0;
+        std::deque<std::pair<Clock::time_point, std::future<NetworkReplyRaw>>>
+            pending{};
+        start = Clock::now();
+
+        for (std::size_t i = 0; i < requests; ++i) {
+            if (pending.size() >= window) {
+                auto& [sent, future] = pending.front();
+
+                if (SendResult::VALID_REPLY == future.get().first) {
+                    latency.push_back(elapsed_ms(sent));
+                } else {
+                    ++failed;
+                }
+
+                pending.pop_front();
+            }
+
+            pending.emplace_back(
+                Clock::now(), connection.SendAsync(std::string("")));
+        }
+
+        while (false == pending.empty()) {
+            auto& [sent, future] = pending.front();
+
+            if (SendResult::VALID_REPLY == future.get().first) {
+                latency.push_back(elapsed_ms(sent));
+            } else {
+                ++failed;
+            }
+
+            pending.pop_front();
+        }
+
+        report(
+            "pipelined window=" + std::to_string(window),
+            latency,
+            failed,
+            elapsed_ms(start));
+    }
+
+    OT::Cleanup();
+
+    return 0;
+}
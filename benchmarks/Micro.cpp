@@ -0,0 +1,379 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+// Times the operations which dominate notary and wallet request processing
+// and prints the results as JSON, so runs from different releases can be
+// compared by a script.
+//
+// Usage: benchmark-opentxs-micro [filter] [min_time_ms]
+//
+// Only benchmarks whose name contains filter are run. Each benchmark is
+// repeated until it has run for at least min_time_ms (default 250).
+//
+// Output:
+//
+// {"benchmarks":[{"name":"armor_encode_4096","iterations":1024,
+//   "ns_per_op":1234.5,"ok":true},...]}
+
+#include "opentxs/api/client/Wallet.hpp"
+#include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/api/storage/Storage.hpp"
+#include "opentxs/api/Native.hpp"
+#include "opentxs/core/crypto/CryptoAsymmetric.hpp"
+#include "opentxs/core/crypto/NymParameters.hpp"
+#include "opentxs/core/crypto/OTASCIIArmor.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Item.hpp"
+#include "opentxs/core/Ledger.hpp"
+#include "opentxs/core/Message.hpp"
+#include "opentxs/core/Nym.hpp"
+#include "opentxs/core/OTTransaction.hpp"
+#include "opentxs/core/OTTransactionType.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Proto.hpp"
+#include "opentxs/Types.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace opentxs;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    std::string name_{};
+    std::size_t iterations_{0};
+    double ns_per_op_{0};
+    bool ok_{true};
+};
+
+std::string filter_{};
+std::chrono::milliseconds min_time_{250};
+std::vector<Result> results_{};
+
+// Runs function in doubling batches until a batch takes at least min_time_
+void measure(const std::string& name, const std::function<bool()>& function)
+{
+    if (std::string::npos == name.find(filter_)) {
+
+        return;
+    }
+
+    Result result{};
+    result.name_ = name;
+    result.ok_ = function();
+    std::size_t batch{1};
+
+    while (result.ok_) {
+        const auto start = Clock::now();
+
+        for (std::size_t i = 0; i < batch; ++i) {
+            result.ok_ &= function();
+        }
+
+        const auto elapsed = Clock::now() - start;
+
+        if ((elapsed >= min_time_) || (false == result.ok_)) {
+            result.iterations_ = batch;
+            result.ns_per_op_ =
+                std::chrono::duration<double, std::nano>(elapsed).count() /
+                batch;
+
+            break;
+        }
+
+        batch *= 2;
+    }
+
+    std::cerr << name << ": " << result.ns_per_op_ << " ns/op" << std::endl;
+    results_.push_back(result);
+}
+
+void print()
+{
+    std::cout << "{\"benchmarks\":[";
+    bool first{true};
+
+    for (const auto& result : results_) {
+        if (false == first) {
+            std::cout << ",";
+        }
+
+        first = false;
+        std::cout << "{\"name\":\"" << result.name_ << "\",\"iterations\":"
+                  << result.iterations_
+                  << ",\"ns_per_op\":" << result.ns_per_op_
+                  << ",\"ok\":" << (result.ok_ ? "true" : "false") << "}";
+    }
+
+    std::cout << "]}" << std::endl;
+}
+
+std::string payload(const std::size_t size)
+{
+    std::string output{};
+    output.reserve(size);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        output.push_back(static_cast<char>('a' + (i % 26)));
+    }
+
+    return output;
+}
+
+void armor()
+{
+    for (const std::size_t size : {256, 4096, 65536}) {
+        const String plain(payload(size));
+        const OTASCIIArmor armored(plain);
+        const auto suffix = std::to_string(size);
+        measure("armor_encode_" + suffix, [&]() -> bool {
+            OTASCIIArmor output(plain);
+
+            return output.Exists();
+        });
+        measure("armor_decode_" + suffix, [&]() -> bool {
+            String output{};
+
+            return armored.GetString(output);
+        });
+    }
+}
+
+void digest()
+{
+    for (const std::size_t size : {32, 1024, 65536}) {
+        const auto text = payload(size);
+        const auto input = Data::Factory(
+            std::vector<unsigned char>(text.begin(), text.end()));
+        measure(
+            "identifier_calculate_digest_" + std::to_string(size),
+            [&]() -> bool {
+                Identifier id{};
+
+                return id.CalculateDigest(input);
+            });
+    }
+}
+
+void contracts(const Nym& nym)
+{
+    const auto& nymID = nym.ID();
+    const auto notaryID = Identifier::Random();
+    const auto accountID = Identifier::Random();
+
+    Message message{};
+    message.m_strCommand = "getRequestNumber";
+    message.m_strNymID = String(nymID);
+    message.m_strNotaryID = String(notaryID.get());
+    message.m_strRequestNum = "1";
+    message.SignContract(nym);
+    message.SaveContract();
+    const String serializedMessage(message);
+    measure("message_load_from_string", [&]() -> bool {
+        Message output{};
+
+        return output.LoadContractFromString(serializedMessage);
+    });
+
+    std::unique_ptr<Ledger> ledger(
+        Ledger::GenerateLedger(nymID, accountID, notaryID, Ledger::inbox));
+
+    if (false == bool(ledger)) {
+
+        return;
+    }
+
+    String serializedTransaction{};
+
+    for (std::int64_t i = 1; i <= 100; ++i) {
+        auto transaction = OTTransaction::GenerateTransaction(
+            *ledger, OTTransaction::pending, originType::not_applicable, i);
+
+        if (nullptr == transaction) {
+
+            return;
+        }
+
+        auto item =
+            Item::CreateItemFromTransaction(*transaction, Item::transfer);
+
+        if (nullptr == item) {
+
+            return;
+        }
+
+        item->SetAmount(i);
+        item->SignContract(nym);
+        item->SaveContract();
+        transaction->AddItem(*item);
+        transaction->SignContract(nym);
+        transaction->SaveContract();
+        ledger->AddTransaction(*transaction);
+
+        if (1 == i) {
+            serializedTransaction = String(*transaction);
+        }
+    }
+
+    ledger->SignContract(nym);
+    ledger->SaveContract();
+    const String serializedLedger(*ledger);
+    measure("transaction_load_from_string", [&]() -> bool {
+        std::unique_ptr<OTTransactionType> output(
+            OTTransactionType::TransactionFactory(serializedTransaction));
+
+        return bool(output);
+    });
+    measure("ledger_100_load_from_string", [&]() -> bool {
+        Ledger output(nymID, accountID, notaryID);
+
+        return output.LoadContractFromString(serializedLedger);
+    });
+}
+
+void signatures(
+    const std::string& name,
+    const NymParameterType type,
+    const CryptoAsymmetric& engine)
+{
+    NymParameters parameters(proto::CREDTYPE_LEGACY);
+    parameters.setNymParameterType(type);
+    const auto nym = OT::App().Wallet().Nym(
+        parameters, proto::CITEMTYPE_INDIVIDUAL, name);
+
+    if (false == bool(nym)) {
+        std::cerr << "Failed to create " << name << " nym" << std::endl;
+
+        return;
+    }
+
+    const auto& privateKey = nym->GetPrivateSignKey();
+    const auto& publicKey = nym->GetPublicSignKey();
+    const auto text = payload(256);
+    const auto plaintext =
+        Data::Factory(std::vector<unsigned char>(text.begin(), text.end()));
+    auto signature = Data::Factory();
+    engine.Sign(
+        plaintext, privateKey, proto::HASHTYPE_BLAKE2B256, signature.get());
+    measure(name + "_sign", [&]() -> bool {
+        auto output = Data::Factory();
+
+        return engine.Sign(
+            plaintext, privateKey, proto::HASHTYPE_BLAKE2B256, output.get());
+    });
+    measure(name + "_verify", [&]() -> bool {
+        return engine.Verify(
+            plaintext, publicKey, signature, proto::HASHTYPE_BLAKE2B256);
+    });
+}
+
+void storage(const Nym& nym)
+{
+    const auto& db = OT::App().DB();
+    const auto serialized = nym.asPublicNym();
+    const auto id = nym.ID().str();
+    measure("storage_store_credential_index", [&]() -> bool {
+        return db.Store(serialized);
+    });
+    measure("storage_load_credential_index", [&]() -> bool {
+        std::shared_ptr<proto::CredentialIndex> output{};
+
+        return db.Load(id, output);
+    });
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    if (1 < argc) {
+        filter_ = argv[1];
+    }
+
+    if (2 < argc) {
+        min_time_ = std::chrono::milliseconds(std::stoul(argv[2]));
+    }
+
+    ArgList args{};
+    OT::ClientFactory(args);
+
+    {
+        NymParameters parameters(proto::CREDTYPE_LEGACY);
+        parameters.setNymParameterType(NymParameterType::ED25519);
+        const auto nym = OT::App().Wallet().Nym(
+            parameters, proto::CITEMTYPE_INDIVIDUAL, "benchmark");
+
+        if (false == bool(nym)) {
+            std::cerr << "Failed to create nym" << std::endl;
+
+            return 1;
+        }
+
+        armor();
+        digest();
+        contracts(*nym);
+        measure("nym_verify_pseudonym", [&]() -> bool {
+            return nym->VerifyPseudonym();
+        });
+        signatures(
+            "ed25519",
+            NymParameterType::ED25519,
+            OT::App().Crypto().ED25519());
+#if OT_CRYPTO_SUPPORTED_KEY_SECP256K1
+        signatures(
+            "secp256k1",
+            NymParameterType::SECP256K1,
+            OT::App().Crypto().SECP256K1());
+#endif  // OT_CRYPTO_SUPPORTED_KEY_SECP256K1
+        storage(*nym);
+    }
+
+    OT::Cleanup();
+    print();
+
+    return 0;
+}
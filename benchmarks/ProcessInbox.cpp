@@ -0,0 +1,225 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+// Measures the per receipt work a notary does for a processInbox request:
+// loading and hashing the box receipts of the inbox, and verifying the
+// signature of each accept item. Each figure is measured one receipt at a
+// time, which is how the notary used to do it, and then through
+// Ledger::LoadBoxReceipts and OTTransaction::VerifyItems, which split large
+// boxes across several threads.
+//
+// Usage: benchmark-opentxs-process-inbox [receipts]...
+//
+// Defaults to inboxes of 10, 1000 and 10000 receipts. Receipts are written to
+// the client data folder and are not removed afterwards.
+
+#include "opentxs/api/client/Wallet.hpp"
+#include "opentxs/api/Native.hpp"
+#include "opentxs/core/crypto/NymParameters.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Item.hpp"
+#include "opentxs/core/Ledger.hpp"
+#include "opentxs/core/Nym.hpp"
+#include "opentxs/core/OTTransaction.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Types.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace opentxs;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(const Clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start)
+        .count();
+}
+
+bool run(const Nym& nym, const std::size_t count)
+{
+    const auto& nymID = nym.ID();
+    const auto notaryID = Identifier::Random();
+    const auto accountID = Identifier::Random();
+    std::unique_ptr<Ledger> inbox(Ledger::GenerateLedger(
+        nymID, accountID, notaryID, Ledger::inbox, true));
+    std::unique_ptr<OTTransaction> processInbox(
+        OTTransaction::GenerateTransaction(
+            nymID,
+            accountID,
+            notaryID,
+            OTTransaction::processInbox,
+            originType::not_applicable,
+            1));
+
+    if ((false == bool(inbox)) || (false == bool(processInbox))) {
+        std::cerr << "Failed to create inbox" << std::endl;
+
+        return false;
+    }
+
+    std::vector<std::int64_t> numbers{};
+    std::vector<const Item*> items{};
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto number = static_cast<std::int64_t>(i + 2);
+        auto receipt = OTTransaction::GenerateTransaction(
+            *inbox, OTTransaction::pending, originType::not_applicable, number);
+
+        if (nullptr == receipt) {
+            std::cerr << "Failed to create receipt" << std::endl;
+
+            return false;
+        }
+
+        receipt->SetReferenceToNum(number);
+        receipt->SignContract(nym);
+        receipt->SaveContract();
+        inbox->AddTransaction(*receipt);
+        receipt->SaveBoxReceipt(*inbox);
+        auto item = Item::CreateItemFromTransaction(
+            *processInbox, Item::acceptPending);
+
+        if (nullptr == item) {
+            std::cerr << "Failed to create item" << std::endl;
+
+            return false;
+        }
+
+        item->SetReferenceToNum(number);
+        item->SignContract(nym);
+        item->SaveContract();
+        processInbox->AddItem(*item);
+        numbers.push_back(number);
+        items.push_back(item);
+    }
+
+    inbox->ReleaseSignatures();
+    inbox->SignContract(nym);
+    inbox->SaveContract();
+
+    if (false == inbox->SaveInbox()) {
+        std::cerr << "Failed to save inbox" << std::endl;
+
+        return false;
+    }
+
+    Ledger serial(nymID, accountID, notaryID);
+    Ledger parallel(nymID, accountID, notaryID);
+
+    if ((false == serial.LoadInbox()) || (false == parallel.LoadInbox())) {
+        std::cerr << "Failed to load inbox" << std::endl;
+
+        return false;
+    }
+
+    auto start = Clock::now();
+    bool loaded{true};
+
+    for (const auto& number : numbers) {
+        loaded &= serial.LoadBoxReceipt(number);
+    }
+
+    const auto serialLoad = elapsed_ms(start);
+    start = Clock::now();
+    loaded &= parallel.LoadBoxReceipts();
+    const auto parallelLoad = elapsed_ms(start);
+    start = Clock::now();
+    bool verified{true};
+
+    for (const auto& item : items) {
+        verified &= item->VerifySignature(nym);
+    }
+
+    const auto serialVerify = elapsed_ms(start);
+    start = Clock::now();
+    verified &= processInbox->VerifyItems(nym);
+    const auto parallelVerify = elapsed_ms(start);
+
+    std::cout << "receipts=" << count << " loaded=" << loaded
+              << " verified=" << verified << " load_serial_ms=" << serialLoad
+              << " load_parallel_ms=" << parallelLoad
+              << " verify_serial_ms=" << serialVerify
+              << " verify_parallel_ms=" << parallelVerify << std::endl;
+
+    return loaded && verified;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<std::size_t> sizes{};
+
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(std::stoul(argv[i]));
+    }
+
+    if (sizes.empty()) { sizes = {10, 1000, 10000}; }
+
+    ArgList args{};
+    OT::ClientFactory(args);
+    bool success{true};
+
+    {
+        const auto nym = OT::App().Wallet().Nym(
+            NymParameters(proto::CREDTYPE_LEGACY),
+            proto::CITEMTYPE_INDIVIDUAL,
+            "benchmark");
+
+        if (false == bool(nym)) {
+            std::cerr << "Failed to create nym" << std::endl;
+
+            return 1;
+        }
+
+        for (const auto& size : sizes) {
+            success &= run(*nym, size);
+        }
+    }
+
+    OT::Cleanup();
+
+    return success ? 0 : 1;
+}
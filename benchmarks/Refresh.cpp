@@ -0,0 +1,193 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+// Measures how long it takes to download the nymbox from several notaries,
+// first one notary at a time and then all at once. Server round trips only
+// hold the per context lock, so the second figure should approach the time of
+// the slowest single notary rather than the sum of all of them.
+//
+// Usage: benchmark-opentxs-refresh <server contract file>...
+//
+// Each file contains the armored contract of a notary which is already
+// running, for example several local opentxs-notary instances listening on
+// different ports.
+
+#include "opentxs/api/client/Sync.hpp"
+#include "opentxs/api/client/Wallet.hpp"
+#include "opentxs/api/Api.hpp"
+#include "opentxs/api/Native.hpp"
+#include "opentxs/client/OTAPI_Exec.hpp"
+#include "opentxs/core/crypto/NymParameters.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Nym.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Types.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace opentxs;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(const Clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start)
+        .count();
+}
+
+bool wait(const api::client::Sync& sync, const Identifier& taskID)
+{
+    while (true) {
+        switch (sync.Status(taskID)) {
+            case ThreadStatus::RUNNING: {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            } break;
+            case ThreadStatus::FINISHED_SUCCESS: {
+
+                return true;
+            }
+            default: {
+
+                return false;
+            }
+        }
+    }
+}
+
+std::string read_file(const std::string& path)
+{
+    std::ifstream file(path);
+    std::stringstream output{};
+    output << file.rdbuf();
+
+    return output.str();
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    if (2 > argc) {
+        std::cerr << "Usage: " << argv[0] << " <server contract file>..."
+                  << std::endl;
+
+        return 1;
+    }
+
+    ArgList args{};
+    OT::ClientFactory(args);
+
+    {
+        const auto& api = OT::App().API();
+        const auto& sync = api.Sync();
+        const auto nym = OT::App().Wallet().Nym(
+            NymParameters(proto::CREDTYPE_LEGACY),
+            proto::CITEMTYPE_INDIVIDUAL,
+            "benchmark");
+
+        if (false == bool(nym)) {
+            std::cerr << "Failed to create nym" << std::endl;
+
+            return 1;
+        }
+
+        const auto& nymID = nym->ID();
+        std::vector<Identifier> servers{};
+
+        for (int i = 1; i < argc; ++i) {
+            const auto id = api.Exec().AddServerContract(read_file(argv[i]));
+
+            if (id.empty()) {
+                std::cerr << "Failed to import " << argv[i] << std::endl;
+
+                return 1;
+            }
+
+            servers.emplace_back(id);
+        }
+
+        std::vector<Identifier> tasks{};
+
+        for (const auto& serverID : servers) {
+            tasks.push_back(sync.ScheduleRegisterNym(nymID, serverID));
+        }
+
+        for (const auto& taskID : tasks) {
+            if (false == wait(sync, taskID)) {
+                std::cerr << "Failed to register nym" << std::endl;
+
+                return 1;
+            }
+        }
+
+        auto start = Clock::now();
+
+        for (const auto& serverID : servers) {
+            wait(sync, sync.ScheduleDownloadNymbox(nymID, serverID));
+        }
+
+        const auto serial = elapsed_ms(start);
+        tasks.clear();
+        start = Clock::now();
+
+        for (const auto& serverID : servers) {
+            tasks.push_back(sync.ScheduleDownloadNymbox(nymID, serverID));
+        }
+
+        for (const auto& taskID : tasks) {
+            wait(sync, taskID);
+        }
+
+        const auto parallel = elapsed_ms(start);
+
+        std::cout << "refresh notaries=" << servers.size()
+                  << " serial_ms=" << serial << " parallel_ms=" << parallel
+                  << " speedup=" << (serial / parallel) << std::endl;
+    }
+
+    OT::Cleanup();
+
+    return 0;
+}
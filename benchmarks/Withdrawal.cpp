@@ -0,0 +1,187 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+// Measures the cost of signing the tokens of a cash withdrawal, one token at a
+// time with Mint::SignToken and as a batch with Mint::SignTokens.
+//
+// Usage: benchmark-opentxs-withdrawal [token count]...
+//
+// Without arguments, withdrawals of 1, 100 and 1000 tokens are measured.
+
+#include "opentxs/api/client/Wallet.hpp"
+#include "opentxs/api/Native.hpp"
+#include "opentxs/cash/Mint.hpp"
+#include "opentxs/cash/Purse.hpp"
+#include "opentxs/cash/Token.hpp"
+#include "opentxs/core/crypto/NymParameters.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Nym.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Types.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#define DENOMINATION 10
+
+using namespace opentxs;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(const Clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start)
+        .count();
+}
+
+void run(const Nym& nym, Mint& mint, const Purse& purse, const int count)
+{
+    std::vector<std::unique_ptr<Token>> requests{};
+    std::vector<Token*> tokens{};
+
+    for (int i = 0; i < count; ++i) {
+        requests.emplace_back(Token::InstantiateAndGenerateTokenRequest(
+            purse, nym, mint, DENOMINATION));
+
+        if (false == bool(requests.back())) {
+            std::cerr << "Failed to generate token request" << std::endl;
+
+            std::exit(1);
+        }
+
+        tokens.push_back(requests.back().get());
+    }
+
+    auto start = Clock::now();
+    int serialOK{0};
+
+    for (auto* token : tokens) {
+        String signature{};
+
+        if (mint.SignToken(nym, *token, signature, 0)) {
+            ++serialOK;
+        }
+    }
+
+    const auto serial = elapsed_ms(start);
+    start = Clock::now();
+    std::vector<String> signatures{};
+    const auto results = mint.SignTokens(nym, tokens, signatures, 0);
+    const auto batch = elapsed_ms(start);
+    int batchOK{0};
+
+    for (const auto result : results) {
+        if (result) {
+            ++batchOK;
+        }
+    }
+
+    std::cout << "withdrawal tokens=" << count << " serial_ms=" << serial
+              << " serial_ok=" << serialOK << " batch_ms=" << batch
+              << " batch_ok=" << batchOK << " speedup=" << (serial / batch)
+              << std::endl;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<int> counts{};
+
+    for (int i = 1; i < argc; ++i) {
+        counts.push_back(std::atoi(argv[i]));
+    }
+
+    if (counts.empty()) {
+        counts = {1, 100, 1000};
+    }
+
+    ArgList args{};
+    OT::ClientFactory(args);
+
+    {
+        const auto nym = OT::App().Wallet().Nym(
+            NymParameters(proto::CREDTYPE_LEGACY),
+            proto::CITEMTYPE_INDIVIDUAL,
+            "benchmark");
+
+        if (false == bool(nym)) {
+            std::cerr << "Failed to create nym" << std::endl;
+
+            return 1;
+        }
+
+        const auto notaryID = Identifier::Random();
+        const auto unitID = Identifier::Random();
+        const String notary(notaryID), unit(unitID), nymID(nym->ID());
+        std::unique_ptr<Mint> mint(Mint::MintFactory(notary, nymID, unit));
+
+        if (false == bool(mint)) {
+            std::cerr << "Failed to instantiate mint" << std::endl;
+
+            return 1;
+        }
+
+        const std::time_t now = std::time(nullptr);
+        mint->GenerateNewMint(
+            0,
+            now,
+            now + 86400,
+            now + 43200,
+            unitID,
+            notaryID,
+            *nym,
+            DENOMINATION);
+        const Purse purse(notaryID, unitID, nym->ID());
+
+        for (const auto count : counts) {
+            run(*nym, *mint, purse, count);
+        }
+    }
+
+    OT::Cleanup();
+
+    return 0;
+}
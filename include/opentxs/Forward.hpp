@@ -99,6 +99,7 @@ namespace network
 namespace zeromq
 {
 class Context;
+class DealerSocket;
 class ListenCallback;
 class Message;
 class PairEventCallback;
@@ -110,6 +111,7 @@ class PushSocket;
 class ReplyCallback;
 class ReplySocket;
 class RequestSocket;
+class RouterSocket;
 class Socket;
 class SubscribeSocket;
 }  // namespace opentxs::network::zeromq
@@ -123,6 +125,8 @@ class ZMQ;
 namespace OTDB
 {
 class OfferListNym;
+class Storable;
+class StringMap;
 class TradeListMarket;
 }  // namespace opentxs::OTDB
 
@@ -170,8 +174,10 @@ class CryptoSymmetric;
 class CryptoSymmetricNew;
 class Data;
 class Ecdsa;
+class FixedIdentifier;
 class Flag;
 class Identifier;
+class IntervalSet;
 class Item;
 class Ledger;
 class Letter;
@@ -254,6 +260,7 @@ using OTUIContactList = Pimpl<ui::ContactList>;
 using OTUIContactListItem = Pimpl<ui::ContactListItem>;
 using OTUIMessagableList = Pimpl<ui::MessagableList>;
 using OTZMQContext = Pimpl<network::zeromq::Context>;
+using OTZMQDealerSocket = Pimpl<network::zeromq::DealerSocket>;
 using OTZMQListenCallback = Pimpl<network::zeromq::ListenCallback>;
 using OTZMQMessage = Pimpl<network::zeromq::Message>;
 using OTZMQPairEventCallback = Pimpl<network::zeromq::PairEventCallback>;
@@ -265,6 +272,7 @@ using OTZMQPushSocket = Pimpl<network::zeromq::PushSocket>;
 using OTZMQReplyCallback = Pimpl<network::zeromq::ReplyCallback>;
 using OTZMQReplySocket = Pimpl<network::zeromq::ReplySocket>;
 using OTZMQRequestSocket = Pimpl<network::zeromq::RequestSocket>;
+using OTZMQRouterSocket = Pimpl<network::zeromq::RouterSocket>;
 using OTZMQSubscribeSocket = Pimpl<network::zeromq::SubscribeSocket>;
 }  // namespace opentxs
 #endif  // OPENTXS_FORWARD_HPP
@@ -421,6 +421,9 @@ enum class MessageType : std::uint8_t {
 
     addClaim = 59,
     addClaimR = 60,
+
+    getMarketData = 61,
+    getMarketDataR = 62,
 };
 
 enum class ThreadStatus : std::uint8_t {
@@ -467,6 +470,8 @@ enum class SocketType : std::uint8_t {
     Push = 5,
     Pull = 6,
     Pair = 7,
+    Dealer = 8,
+    Router = 9,
 };
 
 enum class RemoteBoxType : std::int8_t {
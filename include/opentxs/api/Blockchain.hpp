@@ -41,14 +41,19 @@
 
 #include "opentxs/Forward.hpp"
 
+#include "opentxs/core/Flag.hpp"
+#include "opentxs/core/Identifier.hpp"
 #include "opentxs/Proto.hpp"
 #include "opentxs/Types.hpp"
 
 #include <cstdint>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <thread>
+#include <utility>
 
 namespace opentxs
 {
@@ -102,20 +107,51 @@ public:
     std::shared_ptr<proto::BlockchainTransaction> Transaction(
         const Identifier& id) const;
 
-    ~Blockchain() = default;
+    ~Blockchain();
 
 private:
     typedef std::map<Identifier, std::mutex> IDLock;
+    /** nym id, account */
+    typedef std::pair<std::string, std::shared_ptr<proto::Bip44Account>>
+        CachedAccount;
+    typedef std::pair<Identifier, BIP44Chain> PoolKey;
+    /** index, address */
+    typedef std::deque<std::pair<std::uint32_t, std::string>> AddressQueue;
+
+    /** Addresses derived ahead of allocation for one chain of an account */
+    struct AddressPool {
+        /** Holds only the type and path of the account */
+        proto::Bip44Account account_{};
+        /** Lowest index which has not been allocated */
+        std::uint32_t allocated_{0};
+        /** Next index to be derived */
+        std::uint32_t next_{0};
+        AddressQueue addresses_{};
+    };
 
     friend class implementation::Native;
 
     const Activity& activity_;
     const Crypto& crypto_;
+    const Settings& config_;
     const storage::Storage& storage_;
     const client::Wallet& wallet_;
+    const std::uint32_t gap_{0};
     mutable std::mutex lock_;
     mutable IDLock nym_lock_;
     mutable IDLock account_lock_;
+    /** The map is guarded by lock_, each account by its account mutex */
+    mutable std::map<Identifier, CachedAccount> accounts_;
+    /** Accounts with address allocations which have not been saved */
+    mutable std::set<Identifier> dirty_;
+    /** First index of each chain which may not be allocated until a higher
+     *  mark has been saved. Guarded by lock_. */
+    mutable std::map<PoolKey, std::uint32_t> reserved_;
+    mutable std::mutex pool_lock_;
+    mutable std::map<PoolKey, AddressPool> pools_;
+    OTFlag running_;
+    std::unique_ptr<std::thread> pool_thread_;
+
     proto::Bip44Address& add_address(
         const std::uint32_t index,
         proto::Bip44Account& account,
@@ -137,6 +173,7 @@ private:
         const std::uint32_t account,
         const BlockchainAccountType standard,
         proto::HDPath& path) const;
+    void flush() const;
     std::shared_ptr<proto::Bip44Account> load_account(
         const Lock& lock,
         const std::string& nymID,
@@ -146,12 +183,42 @@ private:
         const proto::Bip44Address& address,
         const std::string& fromContact,
         const std::string& toContact) const;
+    std::string pooled_address(
+        const Identifier& accountID,
+        const proto::Bip44Account& account,
+        const BIP44Chain chain,
+        const std::uint32_t index) const;
+    void refill_pools() const;
+    void register_pool(
+        const Identifier& accountID,
+        const proto::Bip44Account& account,
+        const BIP44Chain chain) const;
+    bool reserve(
+        const Lock& lock,
+        const Identifier& accountID,
+        const BIP44Chain chain,
+        const std::uint32_t index) const;
+    static std::string reserved_key(
+        const Identifier& accountID,
+        const BIP44Chain chain);
+    void resume(
+        const Lock& lock,
+        const Identifier& accountID,
+        const BIP44Chain chain,
+        proto::Bip44Account& account) const;
+    void save_reserved(const std::map<PoolKey, std::uint32_t>& marks) const;
+    bool save_account(
+        const Lock& lock,
+        const std::string& nymID,
+        const proto::Bip44Account& account) const;
 
     Blockchain(
         const Activity& activity,
         const Crypto& crypto,
+        const Settings& config,
         const storage::Storage& storage,
-        const client::Wallet& wallet);
+        const client::Wallet& wallet,
+        const std::uint32_t gap);
     Blockchain() = delete;
     Blockchain(const Blockchain&) = delete;
     Blockchain(Blockchain&&) = delete;
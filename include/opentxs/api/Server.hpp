@@ -44,6 +44,7 @@
 #include "opentxs/OT.hpp"
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 
 namespace opentxs
@@ -53,6 +54,20 @@ namespace api
 class Server
 {
 public:
+    /** Returns true if the calling thread is applying a request whose box
+     *  signatures are deferred until the request is complete */
+    virtual bool BatchingBoxes() const = 0;
+    /** Register the function which signs a box that was stored unsigned
+     *  while BatchingBoxes() was true
+     *
+     *  It runs once, when the request is complete, and replaces any function
+     *  registered earlier in the same request for the same box.
+     */
+    virtual void DeferBoxSignature(
+        const std::string& folder,
+        const std::string& one,
+        const std::string& two,
+        const std::function<bool()>& sign) const = 0;
     virtual const std::string GetCommandPort() const = 0;
     virtual const std::string GetDefaultBindIP() const = 0;
     virtual const std::string GetEEP() const = 0;
@@ -66,15 +81,60 @@ public:
         std::uint32_t series) const = 0;
     virtual std::shared_ptr<const Mint> GetPublicMint(
         const Identifier& unitID) const = 0;
+    virtual std::shared_ptr<const OTASCIIArmor> GetPublicMintPayload(
+        const Identifier& unitID) const = 0;
 #endif  // OT_CASH
     virtual const std::string GetUserName() const = 0;
     virtual const std::string GetUserTerms() const = 0;
     virtual const Identifier& ID() const = 0;
     virtual const Identifier& NymID() const = 0;
+    /** Announce a changed nymbox, inbox or outbox to subscribed clients
+     *
+     *  The notice is published on the notification port as a single frame
+     *  "<topic> <box> <hash>", where the topic is
+     *  server::Server::NotificationTopic for the nym. Account IDs are not
+     *  published.
+     */
+    virtual void PublishBoxChange(
+        const Identifier& nymID,
+        const std::string& box,
+        const Identifier& hash) const = 0;
+    /** Read an account, box or box receipt file through the notary
+     *  write-back cache */
+    virtual std::string QueryFile(
+        const std::string& folder,
+        const std::string& one,
+        const std::string& two,
+        const std::string& three = "") const = 0;
 #if OT_CASH
     virtual void ScanMints() const = 0;
     virtual void UpdateMint(const Identifier& unitID) const = 0;
 #endif  // OT_CASH
+    /** Record that the current contents of an account or box file carry a
+     *  valid notary signature */
+    virtual void SetVerifiedFile(
+        const std::string& folder,
+        const std::string& one,
+        const std::string& two) const = 0;
+    /** Write an account, box or box receipt file through the notary
+     *  write-back cache
+     *
+     *  The file reaches storage before the reply to the current request is
+     *  sent.
+     */
+    virtual bool StoreFile(
+        const std::string& contents,
+        const std::string& folder,
+        const std::string& one,
+        const std::string& two,
+        const std::string& three = "") const = 0;
+
+    /** Returns true if the current contents of an account or box file have
+     *  already had their notary signature verified */
+    virtual bool VerifiedFile(
+        const std::string& folder,
+        const std::string& one,
+        const std::string& two) const = 0;
 
     virtual ~Server() = default;
 
@@ -150,6 +150,13 @@ public:
         const Identifier& localNymID,
         const Identifier& serverID,
         const Identifier& contractID) const = 0;
+    EXPORT virtual Action DownloadMarketData(
+        const Identifier& localNymID,
+        const Identifier& serverID,
+        const Identifier& marketID,
+        const std::chrono::seconds interval,
+        const std::chrono::system_clock::time_point from,
+        const std::chrono::system_clock::time_point to) const = 0;
     EXPORT virtual Action DownloadMarketList(
         const Identifier& localNymID,
         const Identifier& serverID) const = 0;
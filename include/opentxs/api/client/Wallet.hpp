@@ -78,6 +78,23 @@ namespace client
 class Wallet
 {
 public:
+    struct CacheStatistics {
+        std::size_t nyms_{0};
+        std::size_t servers_{0};
+        std::size_t units_{0};
+        std::size_t contexts_{0};
+        std::size_t issuers_{0};
+        std::size_t locks_{0};
+        /** Sum of the serialized sizes of the cached nyms, contracts and
+         *  contexts */
+        std::size_t bytes_{0};
+        std::uint64_t evictions_{0};
+    };
+
+    /**   Report the number and estimated size of the objects held in memory
+     */
+    virtual CacheStatistics CacheStats() const = 0;
+
     /**   Load a read-only copy of a Context object
      *
      *    This method should only be called if the specific client or server
@@ -564,6 +581,17 @@ public:
         const Identifier& id,
         const std::string& alias) const = 0;
 
+    /**   Drop unreferenced objects, least recently used first, until the
+     *    estimated size of the cache is within budget
+     *
+     *    Contexts are evicted first, then contracts, then nyms, since the
+     *    earlier caches hold pointers into the later ones. Unused per-ID
+     *    mutexes are always dropped.
+     *
+     *    \param[in] budget the estimated size to keep, in bytes
+     */
+    virtual void Trim(const std::size_t budget) const = 0;
+
     /**   Obtain a list of all available unit definition contracts and their
      *    aliases
      */
@@ -55,6 +55,9 @@ namespace storage
 class Driver
 {
 public:
+    // True if the key and every object it references are already durably
+    // present, so a migration into this driver can skip the whole subtree
+    virtual bool Archived(const std::string& key) const = 0;
     virtual bool EmptyBucket(const bool bucket) const = 0;
 
     virtual bool Load(
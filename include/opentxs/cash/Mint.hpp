@@ -47,6 +47,7 @@
 #include <cstdint>
 #include <ctime>
 #include <map>
+#include <vector>
 
 namespace opentxs
 {
@@ -241,6 +242,17 @@ public:
         String& theOutput,
         int32_t nTokenIndex) = 0;
 
+    // Lucre step 3, for every token in a purse.
+    //
+    // theOutput receives one signature per token, and the return value one
+    // result per token, in the same order as theTokens. Tokens which could not
+    // be signed have a false result and an empty signature.
+    EXPORT virtual std::vector<bool> SignTokens(
+        const Nym& theNotary,
+        const std::vector<Token*>& theTokens,
+        std::vector<String>& theOutput,
+        int32_t nTokenIndex);
+
     // step 4: (unblind coin is in Token)
 
     // Lucre step 5: mint verifies token when it is redeemed by merchant.
@@ -248,6 +260,15 @@ public:
         const Nym& theNotary,
         String& theCleartextToken,
         int64_t lDenomination) = 0;
+
+    // Lucre step 5, for every token in a purse.
+    //
+    // theCleartextTokens and theDenominations must be the same length. The
+    // return value contains one result per token, in the same order.
+    EXPORT virtual std::vector<bool> VerifyTokens(
+        const Nym& theNotary,
+        std::vector<String>& theCleartextTokens,
+        const std::vector<int64_t>& theDenominations);
 };
 }  // namespace opentxs
 #endif  // OT_CASH
@@ -47,6 +47,7 @@
 #include "opentxs/core/String.hpp"
 
 #include <stdint.h>
+#include <vector>
 
 namespace opentxs
 {
@@ -82,12 +83,41 @@ public:
         Token& theToken,
         String& theOutput,
         int32_t nTokenIndex) override;
+    EXPORT std::vector<bool> SignTokens(
+        const Nym& theNotary,
+        const std::vector<Token*>& theTokens,
+        std::vector<String>& theOutput,
+        int32_t nTokenIndex) override;
     EXPORT bool VerifyToken(
         const Nym& theNotary,
         String& theCleartextToken,
         int64_t lDenomination) override;
+    EXPORT std::vector<bool> VerifyTokens(
+        const Nym& theNotary,
+        std::vector<String>& theCleartextTokens,
+        const std::vector<int64_t>& theDenominations) override;
 
     EXPORT virtual ~MintLucre();
+
+private:
+    // Decrypts the private bank information for one denomination. This is the
+    // expensive part of signing or verifying, so the batch methods do it once
+    // per denomination instead of once per token.
+    bool open_private_bank(
+        const Nym& theNotary,
+        int64_t lDenomination,
+        String& theOutput);
+    // Signing and verification with already-decrypted bank information. These
+    // do not touch any state of the mint, so the batch methods call them from
+    // several threads at once.
+    bool sign_token(
+        const String& thePrivateBank,
+        Token& theToken,
+        String& theOutput,
+        int32_t nTokenIndex) const;
+    bool verify_token(
+        const String& thePrivateBank,
+        const String& theCleartextToken) const;
 };
 }  // namespace opentxs
 #endif  // OT_CASH_USING_LUCRE
@@ -271,10 +271,6 @@ public:
     /** Lucre step 5: token verifies when it is redeemed by merchant. Now
      * including spent token database! */
     EXPORT bool VerifyToken(Nym& theNotary, Mint& theMint);
-    /** Spent Token Database */
-    EXPORT bool IsTokenAlreadySpent(String& theCleartextToken);
-    /** Spent Token Database */
-    EXPORT bool RecordTokenAsSpent(String& theCleartextToken);
     EXPORT void SetSignature(
         const OTASCIIArmor& theSignature,
         int32_t nTokenIndex);
@@ -2179,6 +2179,11 @@ contract
     EXPORT std::string LoadServerContract(const std::string& NOTARY_ID)
         const;  // returns nullptr, or a server contract.
 
+    EXPORT std::string LoadMarketData(
+        const std::string& NOTARY_ID,
+        const std::string& MARKET_ID,
+        const std::int64_t& INTERVAL) const;  // returns "", or market data
+
 #if OT_CASH
     //! Returns OT_TRUE if the mint is still usable.
     //! Returns OT_FALSE if expired or other error.
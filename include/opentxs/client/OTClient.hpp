@@ -178,6 +178,7 @@ private:
 #if OT_CASH
     bool processServerReplyGetMint(const Message& theReply);
 #endif  // OT_CASH
+    bool processServerReplyGetMarketData(const Message& theReply);
     bool processServerReplyGetMarketList(const Message& theReply);
     bool processServerReplyGetMarketOffers(const Message& theReply);
     bool processServerReplyGetMarketRecentTrades(const Message& theReply);
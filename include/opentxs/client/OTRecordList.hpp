@@ -189,9 +189,27 @@ private:
     list_of_strings m_accounts;
     list_of_strings m_nyms;
     vec_OTRecordList m_contents;
+    // Records built from each box on previous calls to Populate, together
+    // with the digest of the box contents they were built from, keyed by box
+    // location. Boxes whose digest has not changed are not parsed again.
+    std::map<std::string, std::pair<std::string, vec_OTRecordList>> m_index;
     static const std::string s_blank;
     static const std::string s_message_type;
 
+    struct PreparedBox;
+    typedef std::map<std::string, std::unique_ptr<PreparedBox>> PreparedBoxes;
+
+    void index_box(
+        PreparedBoxes& boxes,
+        const std::string& key,
+        const std::size_t first);
+    void prepare_box(PreparedBox& box) const;
+    void prepare_boxes(OTWallet& wallet, PreparedBoxes& boxes) const;
+    Ledger* take_box(
+        PreparedBoxes& boxes,
+        const std::string& key,
+        bool& unchanged);
+
 public:  // ADDRESS BOOK CALLBACK
     static bool setAddrBookCaller(OTLookupCaller& theCaller);
     static OTLookupCaller* getAddrBookCaller();
@@ -285,7 +303,11 @@ public:
     EXPORT static void setTextTo(std::string text) { s_strTextTo = text; }
     EXPORT static void setTextFrom(std::string text) { s_strTextFrom = text; }
 
-    EXPORT void SetFastMode() { m_bRunFast = true; }
+    EXPORT void SetFastMode()
+    {
+        ResetIndex();
+        m_bRunFast = true;
+    }
     EXPORT void IgnoreMail(bool bIgnore = true) { m_bIgnoreMail = bIgnore; }
     // SETUP:
     /** Set the default server here. */
@@ -330,6 +352,10 @@ public:
     /** Clears m_contents (NOT nyms, accounts, servers, or instrument
      * definitions.) */
     EXPORT void ClearContents();
+    /** Forgets the records kept from previous calls to Populate, so every box
+     * is parsed again. Records keep the names which were looked up when their
+     * box was parsed, so call this after the address book changes. */
+    EXPORT void ResetIndex();
     /** Populate already sorts. But if you have to add some external records
      * after Populate, then you can sort again. P.S. sorting is performed based
      * on the "from" date. */
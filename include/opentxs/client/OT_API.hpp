@@ -52,6 +52,7 @@
 #include "opentxs/Types.hpp"
 
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -78,6 +79,15 @@ public:
     typedef std::pair<std::unique_ptr<Ledger>, std::unique_ptr<Ledger>>
         ProcessInbox;
 
+    /** Serializes operations on a single local nym / server context
+     *
+     *  Server round trips hold only this lock, so operations against
+     *  different servers or different nyms run concurrently. When both are
+     *  needed, acquire the context lock before the API lock.
+     */
+    EXPORT std::recursive_mutex& ContextLock(
+        const Identifier& nymID,
+        const Identifier& serverID) const;
     EXPORT bool GetWalletFilename(String& strPath) const;
     EXPORT bool SetWalletFilename(const String& strPath) const;
     EXPORT OTWallet* GetWallet(const char* szFuncName = nullptr) const;
@@ -513,6 +523,11 @@ public:
         const Identifier& NOTARY_ID,
         const Identifier& INSTRUMENT_DEFINITION_ID) const;
 #endif  // OT_CASH
+    /** Returns the stored reply to getMarketData, or an empty string */
+    EXPORT std::string LoadMarketData(
+        const Identifier& NOTARY_ID,
+        const Identifier& MARKET_ID,
+        const std::int64_t interval) const;
     EXPORT bool IsBasketCurrency(
         const Identifier& BASKET_INSTRUMENT_DEFINITION_ID) const;
 
@@ -1195,6 +1210,12 @@ public:
         char STOP_SIGN = 0,  // For stop orders, set to '<' or '>'
         const Amount ACTIVATION_PRICE = 0) const;  // For stop orders, set the
                                                    // threshold price here.
+    EXPORT CommandResult getMarketData(
+        ServerContext& context,
+        const Identifier& MARKET_ID,
+        const std::int64_t interval,
+        const time64_t from,
+        const time64_t to) const;
     EXPORT CommandResult getMarketList(ServerContext& context) const;
     EXPORT CommandResult getMarketOffers(
         ServerContext& context,
@@ -1280,6 +1301,11 @@ private:
     std::unique_ptr<OTClient> m_pClient;
 
     std::recursive_mutex& lock_;
+    mutable std::mutex context_lock_map_lock_;
+    mutable std::map<
+        std::pair<Identifier, Identifier>,
+        std::unique_ptr<std::recursive_mutex>>
+        context_locks_;
 
     bool add_accept_item(
         const Item::itemType type,
@@ -1289,6 +1315,7 @@ private:
         const Nym& nym,
         const Amount amount,
         OTTransaction& processInbox) const;
+    std::recursive_mutex& context_lock(const ServerContext& context) const;
     bool find_cron(
         const ServerContext& context,
         const Item& item,
@@ -2003,6 +2003,11 @@ public:
         const std::string& NOTARY_ID);  // returns nullptr, or a server
                                         // contract.
 
+    EXPORT static std::string LoadMarketData(
+        const std::string& NOTARY_ID,
+        const std::string& MARKET_ID,
+        const std::int64_t& INTERVAL);  // returns "", or market data
+
 #if OT_CASH
     //! Returns OT_TRUE if the mint is still usable.
     //! Returns OT_FALSE if expired or other error.
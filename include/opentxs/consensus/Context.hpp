@@ -43,6 +43,7 @@
 
 #include "opentxs/api/Editor.hpp"
 #include "opentxs/core/contract/Signable.hpp"
+#include "opentxs/core/IntervalSet.hpp"
 #include "opentxs/Proto.hpp"
 #include "opentxs/Types.hpp"
 
@@ -108,10 +109,10 @@ protected:
     std::mutex& nymfile_lock_;
     const OTIdentifier server_id_;
     std::shared_ptr<const class Nym> remote_nym_{};
-    std::set<TransactionNumber> available_transaction_numbers_{};
-    std::set<TransactionNumber> issued_transaction_numbers_{};
+    IntervalSet available_transaction_numbers_{};
+    IntervalSet issued_transaction_numbers_{};
     std::atomic<RequestNumber> request_number_{0};
-    std::set<RequestNumber> acknowledged_request_numbers_{};
+    IntervalSet acknowledged_request_numbers_{};
     OTIdentifier local_nymbox_hash_;
     OTIdentifier remote_nymbox_hash_;
 
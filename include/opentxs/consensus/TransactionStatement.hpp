@@ -41,10 +41,10 @@
 
 #include "opentxs/Forward.hpp"
 
+#include "opentxs/core/IntervalSet.hpp"
 #include "opentxs/core/String.hpp"
 #include "opentxs/Types.hpp"
 
-#include <set>
 #include <string>
 
 namespace opentxs
@@ -56,8 +56,8 @@ private:
     std::string version_;
     std::string nym_id_;
     std::string notary_;
-    std::set<TransactionNumber> available_;
-    std::set<TransactionNumber> issued_;
+    IntervalSet available_;
+    IntervalSet issued_;
 
     TransactionStatement() = delete;
     TransactionStatement(const TransactionStatement& rhs) = delete;
@@ -67,14 +67,14 @@ private:
 public:
     TransactionStatement(
         const std::string& notary,
-        const std::set<TransactionNumber>& issued,
-        const std::set<TransactionNumber>& available);
+        const IntervalSet& issued,
+        const IntervalSet& available);
     TransactionStatement(const String& serialized);
     TransactionStatement(TransactionStatement&& rhs) = default;
 
     explicit operator String() const;
 
-    const std::set<TransactionNumber>& Issued() const;
+    const IntervalSet& Issued() const;
     const std::string& Notary() const;
 
     void Remove(const TransactionNumber& number);
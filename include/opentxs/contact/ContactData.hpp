@@ -75,8 +75,8 @@ public:
         const std::string& nym,
         const std::uint32_t targetVersion,
         const proto::ContactData& serialized);
-    ContactData(const ContactData&) = default;
-    ContactData(ContactData&&) = default;
+    ContactData(const ContactData&);
+    ContactData(ContactData&&);
 
     ContactData operator+(const ContactData& rhs) const;
 
@@ -130,9 +130,15 @@ private:
         pair<proto::ContactItemType, std::shared_ptr<const ContactGroup>>
             Scope;
 
+    struct Index;
+
     const std::uint32_t version_{0};
     const std::string nym_{};
     const SectionMap sections_{};
+    // Built by the first lookup which needs it. Since ContactData is
+    // immutable the index never has to be updated, and updates which are
+    // never queried never pay for one.
+    mutable std::shared_ptr<const Index> index_{nullptr};
 
     static std::uint32_t check_version(
         const std::uint32_t in,
@@ -142,6 +148,7 @@ private:
         const std::uint32_t targetVersion,
         const proto::ContactData& serialized);
 
+    std::shared_ptr<const Index> index() const;
     Scope scope() const;
 
     ContactData() = delete;
@@ -0,0 +1,142 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_CACHEINDEX_HPP
+#define OPENTXS_CORE_CACHEINDEX_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+namespace opentxs
+{
+/** Recency and estimated size of the entries of one cache map
+ *
+ *  Guarded by the lock of the map it describes. The size of an entry is the
+ *  serialized size of its object, recorded when the entry is first touched.
+ */
+template <typename Key>
+class CacheIndex
+{
+public:
+    std::size_t Bytes() const { return bytes_; }
+    void Erase(const Key& key)
+    {
+        const auto it = entries_.find(key);
+
+        if (entries_.end() == it) {
+
+            return;
+        }
+
+        const auto& [tick, bytes] = it->second;
+        order_.erase(tick);
+        bytes_ -= bytes;
+        entries_.erase(it);
+    }
+    /** Visits entries in least recently used order and drops every entry for
+     *  which erase returns true, until at least the requested number of
+     *  bytes has been released. Returns the number of entries dropped. */
+    std::size_t Evict(
+        const std::size_t bytes,
+        const std::function<bool(const Key&)>& erase)
+    {
+        std::size_t output{0};
+        std::size_t released{0};
+        auto it = order_.begin();
+
+        while ((order_.end() != it) && (released < bytes)) {
+            const auto entry = entries_.find(it->second);
+
+            if (erase(it->second)) {
+                released += entry->second.second;
+                bytes_ -= entry->second.second;
+                entries_.erase(entry);
+                it = order_.erase(it);
+                ++output;
+            } else {
+                ++it;
+            }
+        }
+
+        return output;
+    }
+    std::size_t Size() const { return entries_.size(); }
+    /** Marks the entry as most recently used. The estimate is only evaluated
+     *  for entries which are not yet indexed. */
+    void Touch(const Key& key, const std::function<std::size_t()>& estimate)
+    {
+        const auto tick = ++clock_;
+        auto it = entries_.find(key);
+
+        if (entries_.end() == it) {
+            const auto bytes = estimate();
+            entries_.emplace(key, std::make_pair(tick, bytes));
+            bytes_ += bytes;
+        } else {
+            order_.erase(it->second.first);
+            it->second.first = tick;
+        }
+
+        order_.emplace(tick, key);
+    }
+
+    CacheIndex()
+        : clock_(0)
+        , bytes_(0)
+        , order_()
+        , entries_()
+    {
+    }
+
+    ~CacheIndex() = default;
+
+private:
+    std::uint64_t clock_{0};
+    std::size_t bytes_{0};
+    std::map<std::uint64_t, Key> order_{};
+    /** tick, bytes */
+    std::unordered_map<Key, std::pair<std::uint64_t, std::size_t>> entries_{};
+};
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_CACHEINDEX_HPP
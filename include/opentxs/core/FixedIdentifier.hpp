@@ -0,0 +1,129 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_FIXEDIDENTIFIER_HPP
+#define OPENTXS_CORE_FIXEDIDENTIFIER_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include "opentxs/Types.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <utility>
+
+namespace opentxs
+{
+/** Inline, fixed size copy of an Identifier for use as a container key
+ *
+ *  Holds the binary form of an ID without allocating and computes its hash
+ *  once on construction, so lookups in unordered containers never touch the
+ *  heap or the base58 encoder. Convert with str() or Get() only where a
+ *  string or Identifier leaves the container. */
+class FixedIdentifier
+{
+public:
+    static const std::size_t MaxSize{32};
+
+    EXPORT OTIdentifier Get() const;
+    std::size_t Hash() const { return hash_; }
+    bool empty() const { return 0 == size_; }
+    std::size_t size() const { return size_; }
+    EXPORT std::string str() const;
+    ID Type() const { return type_; }
+
+    bool operator==(const FixedIdentifier& rhs) const
+    {
+        return (hash_ == rhs.hash_) && (type_ == rhs.type_) &&
+               (size_ == rhs.size_) &&
+               (0 == std::memcmp(bytes_.data(), rhs.bytes_.data(), size_));
+    }
+    bool operator!=(const FixedIdentifier& rhs) const
+    {
+        return false == (*this == rhs);
+    }
+    /** Binary order; not the same as the order of the base58 strings */
+    EXPORT bool operator<(const FixedIdentifier& rhs) const;
+
+    EXPORT FixedIdentifier();
+    /** Identifiers longer than MaxSize produce an empty key */
+    EXPORT explicit FixedIdentifier(const Identifier& id);
+    EXPORT explicit FixedIdentifier(const std::string& id);
+    FixedIdentifier(const FixedIdentifier&) = default;
+    FixedIdentifier& operator=(const FixedIdentifier&) = default;
+
+    ~FixedIdentifier() = default;
+
+private:
+    std::array<std::uint8_t, MaxSize> bytes_;
+    std::uint8_t size_{0};
+    ID type_{ID::ERROR};
+    std::size_t hash_{0};
+
+    static std::size_t calculate_hash(
+        const std::uint8_t* data,
+        const std::size_t size,
+        const ID type);
+};
+}  // namespace opentxs
+
+namespace std
+{
+template <>
+struct hash<opentxs::FixedIdentifier> {
+    std::size_t operator()(const opentxs::FixedIdentifier& id) const
+    {
+        return id.Hash();
+    }
+};
+
+template <>
+struct hash<std::pair<opentxs::FixedIdentifier, opentxs::FixedIdentifier>> {
+    std::size_t operator()(
+        const std::pair<opentxs::FixedIdentifier, opentxs::FixedIdentifier>&
+            id) const
+    {
+        return id.first.Hash() ^ (id.second.Hash() * 31);
+    }
+};
+}  // namespace std
+#endif  // OPENTXS_CORE_FIXEDIDENTIFIER_HPP
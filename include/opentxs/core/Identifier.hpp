@@ -120,6 +120,7 @@ public:
 
 private:
     friend OTIdentifier;
+    friend class FixedIdentifier;
 
     static const ID DefaultType{ID::BLAKE2B};
     static const size_t MinimumSize{10};
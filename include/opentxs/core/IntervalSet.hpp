@@ -0,0 +1,156 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_INTERVALSET_HPP
+#define OPENTXS_CORE_INTERVALSET_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace opentxs
+{
+/** Ordered set of integers stored as maximal runs of consecutive values
+ *
+ *  Transaction and request numbers are issued sequentially, so the sets held
+ *  by a Context collapse to a handful of ranges. The interface mirrors the
+ *  parts of std::set used for those sets, plus range-aware comparisons and a
+ *  compact "1-100,105" serialization. */
+class IntervalSet
+{
+public:
+    using value_type = std::int64_t;
+    using Ranges = std::map<value_type, value_type>;
+
+    /** Visits every member in ascending order */
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = IntervalSet::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        reference operator*() const { return value_; }
+        pointer operator->() const { return &value_; }
+        const_iterator& operator++();
+        const_iterator operator++(int);
+        bool operator==(const const_iterator& rhs) const;
+        bool operator!=(const const_iterator& rhs) const;
+
+        const_iterator() = default;
+
+    private:
+        friend class IntervalSet;
+
+        Ranges::const_iterator range_{};
+        Ranges::const_iterator end_{};
+        value_type value_{0};
+
+        const_iterator(
+            const Ranges::const_iterator range,
+            const Ranges::const_iterator end,
+            const value_type value);
+    };
+
+    using iterator = const_iterator;
+
+    /** Parses a comma or whitespace separated list in which every entry is
+     *  either a single number or, if ranges is true, an inclusive
+     *  "first-last" range. Plain NumList strings are accepted unchanged.
+     *
+     *  Strings received from peers must be parsed with ranges set to false:
+     *  a single range may name more numbers than callers can expand. */
+    static bool Parse(
+        const std::string& input,
+        IntervalSet& output,
+        const bool ranges = true);
+
+    const_iterator begin() const;
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    /** True if every member of rhs is also a member of *this */
+    bool Contains(const IntervalSet& rhs) const;
+    std::size_t count(const value_type number) const;
+    bool empty() const { return ranges_.empty(); }
+    const_iterator end() const;
+    const_iterator find(const value_type number) const;
+    /** True if *this and rhs share at least one member */
+    bool Intersects(const IntervalSet& rhs) const;
+    const Ranges& Intervals() const { return ranges_; }
+    /** Writes "1-100,105", or "1,2,...,100,105" if ranges is false */
+    std::string Serialize(const bool ranges = true) const;
+    std::set<value_type> Set() const;
+    std::size_t size() const { return size_; }
+
+    bool operator==(const IntervalSet& rhs) const;
+    bool operator!=(const IntervalSet& rhs) const;
+
+    void clear();
+    std::size_t erase(const value_type number);
+    std::pair<const_iterator, bool> insert(const value_type number);
+    /** Returns the number of values which were not already present */
+    std::size_t Insert(const IntervalSet& rhs);
+    /** Returns the number of values which were not already present */
+    std::size_t InsertRange(const value_type first, const value_type last);
+
+    explicit IntervalSet(const std::set<value_type>& numbers);
+    explicit IntervalSet(std::set<value_type>&& numbers);
+    IntervalSet() = default;
+    IntervalSet(const IntervalSet&) = default;
+    IntervalSet(IntervalSet&&) = default;
+    IntervalSet& operator=(const IntervalSet&) = default;
+    IntervalSet& operator=(IntervalSet&&) = default;
+
+    ~IntervalSet() = default;
+
+private:
+    Ranges ranges_{};
+    std::size_t size_{0};
+
+    Ranges::const_iterator find_range(const value_type number) const;
+};
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_INTERVALSET_HPP
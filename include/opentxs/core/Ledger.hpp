@@ -47,7 +47,10 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <set>
+#include <string>
+#include <vector>
 
 namespace opentxs
 {
@@ -84,6 +87,21 @@ private:
     mapOfTransactions m_mapTransactions;  // a ledger contains a map of
                                           // transactions.
 
+    // Loads and verifies the full box receipt for each abbreviated
+    // transaction. Large boxes are split across several threads. The
+    // ledger is not modified.
+    std::vector<std::unique_ptr<OTTransaction>> load_box_receipts(
+        const std::vector<OTTransaction*>& abbreviated) const;
+    // When running as a notary, tell subscribed clients this box changed.
+    void publish_change(const Identifier* pHash);
+
+    // The nym whose signature on this box was deferred by the notary until
+    // the current request is complete
+    const Nym* deferred_signer_{nullptr};
+    // Set while signing contents which were serialized earlier, so that
+    // UpdateContents() leaves them as they are
+    bool sign_as_is_{false};
+
 protected:
     // return -1 if error, 0 if nothing, and 1 if the node was processed.
     int32_t ProcessXMLNode(irr::io::IrrXMLReader*& xml) override;
@@ -121,11 +139,27 @@ public:
                  // legacy box or a hashed box. (Legacy boxes
                  // stored ALL of the receipts IN the box. No
                  // more.)
+    // True if this box was read through the notary cache, rather than from
+    // a string supplied by the caller
+    bool loaded_from_cache_{false};
 
 protected:
+    // True if the notary reads and writes this box through its cache
+    static bool cached_box(const ledgerType type);
+
     bool LoadGeneric(ledgerType theType, const String* pString = nullptr);
     bool SaveGeneric(ledgerType theType);
 
+private:
+    // Signs and stores a box which was stored unsigned during a notary batch
+    static bool sign_deferred(
+        const ledgerType type,
+        const Nym& signer,
+        const String& contents,
+        const std::string& folder,
+        const std::string& notaryID,
+        const std::string& boxID);
+
 public:
     inline ledgerType GetType() const { return m_Type; }
 
@@ -192,6 +226,19 @@ public:
     // it.
     //
     EXPORT bool VerifyAccount(const Nym& theNym) override;
+    using ot_super::SignContract;
+    /** While the notary is batching a request, nymboxes, inboxes and outboxes
+     *  are stored unsigned and signed once, when the request is complete. */
+    EXPORT bool SignContract(
+        const Nym& theNym,
+        const OTPasswordData* pPWData = nullptr) override;
+    using ot_super::VerifySignature;
+    /** A box read through the notary cache whose contents were already
+     *  verified, or were stored by the notary itself, is not checked again.
+     */
+    EXPORT bool VerifySignature(
+        const Nym& theNym,
+        const OTPasswordData* pPWData = nullptr) const override;
     // For ALL abbreviated transactions, load the actual box receipt for each.
     EXPORT bool LoadBoxReceipts(
         std::set<int64_t>* psetUnloaded = nullptr);  // if psetUnloaded passed
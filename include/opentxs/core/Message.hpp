@@ -213,6 +213,8 @@ public:
     int64_t m_lTransactionNum{
         0};  // For Market-related messages... Also used by
              // getBoxReceipt
+    int64_t m_lRangeStart{0};  // For getMarketData: start of the time range
+    int64_t m_lRangeEnd{0};    // For getMarketData: end of the time range
 
     int32_t keytypeAuthent_ = 0;
     int32_t keytypeEncrypt_ = 0;
@@ -225,6 +227,9 @@ public:
     bool m_bBool{
         false};  // Some commands need to send a bool. This variable is for
                  // those.
+    bool m_bStarting{false};  // Server reply: the notary refused the request
+                              // because it is still starting up. The request
+                              // may be retried.
     int64_t m_lTime{0};  // Timestamp when the message was signed.
 
     static OTMessageStrategyManager messageStrategyManager;
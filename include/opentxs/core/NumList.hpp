@@ -41,6 +41,8 @@
 
 #include "opentxs/Forward.hpp"
 
+#include "opentxs/core/IntervalSet.hpp"
+
 #include <cstdint>
 #include <set>
 #include <string>
@@ -56,10 +58,11 @@ class String;
  * string, And easily being able to add/remove/verify the individual transaction
  * numbers that are there. (Used by OTTransaction::blank and
  * OTTransaction::successNotice.) Also used in OTMessage, for storing lists of
- * acknowledged request numbers. */
+ * acknowledged request numbers. The numbers are held as an IntervalSet, but
+ * strings are always plain comma-separated lists. */
 class NumList
 {
-    std::set<int64_t> m_setData;
+    IntervalSet m_setData;
 
     /** private for security reasons, used internally only by a function that
      * knows the string length already. if false, means the numbers were already
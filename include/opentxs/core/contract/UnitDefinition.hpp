@@ -48,6 +48,8 @@
 #include "opentxs/Proto.hpp"
 
 #include <cstdint>
+#include <map>
+#include <set>
 #include <string>
 
 namespace opentxs
@@ -60,8 +62,17 @@ private:
     std::string primary_unit_name_;
     std::string short_name_;
 
+    std::map<std::string, std::string> account_records(
+        const Lock& lock,
+        const std::size_t shard) const;
+    std::string account_records_folder(const Lock& lock) const;
     proto::UnitDefinition contract(const Lock& lock) const;
     Identifier GetID(const Lock& lock) const override;
+    bool migrate_account_records(const Lock& lock) const;
+    bool save_account_records(
+        const Lock& lock,
+        const std::size_t shard,
+        const std::map<std::string, std::string>& records) const;
     bool verify_signature(const Lock& lock, const proto::Signature& signature)
         const override;
 
@@ -85,6 +96,11 @@ protected:
         const std::string& terms);
 
 public:
+    /** The account records for each unit are split across this many files,
+     *  so that adding or removing an account only rewrites one of them. */
+    static constexpr std::size_t AccountRecordShards{256};
+
+    EXPORT static std::size_t AccountRecordShard(const std::string& accountID);
     EXPORT static UnitDefinition* Create(
         const ConstNym& nym,
         const std::string& shortname,
@@ -126,6 +142,10 @@ public:
     // removes the account from the list. (When account is deleted.)
     EXPORT bool EraseAccountRecord(const Identifier& theAcctID) const;
 
+    /** Returns the IDs of the accounts stored in one shard of the records
+     *  list */
+    EXPORT std::set<std::string> AccountRecords(const std::size_t shard) const;
+
     EXPORT bool VisitAccountRecords(AccountVisitor& visitor) const;
 
     EXPORT static std::string formatLongAmount(
@@ -45,6 +45,14 @@
 #include "opentxs/core/util/StringUtils.hpp"
 #include "opentxs/core/util/Timer.hpp"
 #include "opentxs/core/Contract.hpp"
+#include "opentxs/core/String.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace opentxs
 {
@@ -54,6 +62,10 @@ typedef std::map<int64_t, OTCronItem*> mapOfCronItems;
 typedef std::multimap<time64_t, OTCronItem*> multimapOfCronItems;
 /** Mapped (uniquely) to market ID. */
 typedef std::map<std::string, OTMarket*> mapOfMarkets;
+/** Markets named in the cron file whose own file has not been loaded yet.
+ * Mapped to market ID: instrument definition ID, currency ID, scale. */
+typedef std::map<std::string, std::tuple<std::string, std::string, int64_t>>
+    mapOfUnloadedMarkets;
 /** Cron stores a bunch of these on this list, which the server refreshes from
  * time to time. */
 typedef std::list<int64_t> listOfLongNumbers;
@@ -68,6 +80,12 @@ private:
 private:
     // A list of all valid markets.
     mapOfMarkets m_mapMarkets;
+    // Markets are loaded from the market folder the first time they are
+    // needed, rather than all at once when the cron file is loaded.
+    mapOfUnloadedMarkets m_mapUnloadedMarkets;
+    // Cron items read from the cron file, instantiated by LoadCron once the
+    // signature on the file has been verified.
+    std::vector<std::pair<time64_t, String>> m_vecPendingItems;
     // Cron Items are found on both lists.
     mapOfCronItems m_mapCronItems;
     multimapOfCronItems m_multimapCronItems;
@@ -91,6 +109,10 @@ private:
 
     static Timer tCron;
 
+    bool load_items();
+    OTMarket* load_market(const std::string& id);
+    void load_markets();
+
 public:
     static int32_t GetCronMsBetweenProcess()
     {
@@ -137,7 +159,12 @@ public:
     bool RemoveMarket(const Identifier& MARKET_ID);  // if returns false,
                                                      // market wasn't found.
 
+    /** Loads the market from its file if this is the first access. */
     EXPORT OTMarket* GetMarket(const Identifier& MARKET_ID);
+    inline std::size_t GetUnloadedMarketCount() const
+    {
+        return m_mapUnloadedMarkets.size();
+    }
     OTMarket* GetOrCreateMarket(
         const Identifier& INSTRUMENT_DEFINITION_ID,
         const Identifier& CURRENCY_ID,
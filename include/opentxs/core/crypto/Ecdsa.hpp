@@ -135,6 +135,13 @@ public:
         const OTPassword& seed,
         OTPassword& privateKey,
         Data& publicKey) const;
+    /** Computes the shared secret which DecryptSessionKeyECDH uses to unlock
+     *  a session key, so that it can be reused for several candidates */
+    virtual bool SessionKeySecretECDH(
+        const AsymmetricKeyEC& privateKey,
+        const AsymmetricKeyEC& publicKey,
+        const OTPasswordData& password,
+        OTPassword& secret) const;
 
     virtual ~Ecdsa() = default;
 };
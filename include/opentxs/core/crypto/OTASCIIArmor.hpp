@@ -177,12 +177,13 @@ public:
     EXPORT bool GetString(String& theData, bool bLineBreaks = true) const;
     EXPORT bool SetString(const String& theData, bool bLineBreaks = true);
 
-private:
-    std::string compress_string(
+    /** zlib compression, throws std::runtime_error on failure */
+    EXPORT static std::string compress_string(
         const std::string& str,
-        int32_t compressionlevel) const;
-    std::string decompress_string(const std::string& str) const;
+        int32_t compressionlevel);
+    EXPORT static std::string decompress_string(const std::string& str);
 
+private:
     static std::unique_ptr<OTDB::OTPacker> s_pPacker;
 };
 
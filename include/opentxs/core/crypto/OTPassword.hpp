@@ -180,15 +180,18 @@ public:
 
 private:
     std::size_t size_{0};
-    std::uint8_t data_[OT_DEFAULT_MEMSIZE]{};
+    /** OT_DEFAULT_MEMSIZE bytes from the secure arena */
+    std::uint8_t* data_{nullptr};
+    /** Number of leading bytes of data_ which may hold secret data */
+    std::size_t dirty_{0};
     bool isText_{false};
     bool isBinary_{false};
-    bool isPageLocked_{false};
     const std::size_t blockSize_{OT_DEFAULT_BLOCKSIZE};
     std::uint32_t position_{};
 
-    bool ot_lockPage(void* addr, size_t len);
-    bool ot_unlockPage(void* addr, size_t len);
+    static std::uint8_t* allocate();
+
+    void mark_dirty(const std::size_t size);
 };
 
 }  // namespace opentxs
@@ -45,6 +45,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
 
@@ -60,6 +61,12 @@ class String;
 
 class SymmetricKey
 {
+public:
+    /** Secondary keys derived from a single password, indexed by salt and
+     *  size. Reusing one of these across several Unlock() calls runs the KDF
+     *  once per distinct salt instead of once per key. */
+    using DerivedKeys = std::map<std::string, std::unique_ptr<SymmetricKey>>;
+
 private:
     /// The library providing the underlying crypto algorithms
     const CryptoSymmetricNew& engine_;
@@ -104,6 +111,8 @@ private:
         const OTPasswordData& keyPassword,
         const proto::SymmetricKeyType type = proto::SKEYTYPE_ARGON2);
     bool GetPassword(const OTPasswordData& keyPassword, OTPassword& password);
+    bool prepare_unlock();
+    bool unlock(const SymmetricKey& secondaryKey);
 
     SymmetricKey(const CryptoSymmetricNew& engine);
     SymmetricKey(
@@ -234,6 +243,7 @@ public:
     bool Serialize(proto::SymmetricKey& output) const;
 
     bool Unlock(const OTPasswordData& keyPassword);
+    bool Unlock(const OTPasswordData& keyPassword, DerivedKeys& derived);
 
     ~SymmetricKey() = default;
 };
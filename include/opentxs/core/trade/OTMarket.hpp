@@ -48,12 +48,14 @@
 
 #include "opentxs/core/cron/OTCron.hpp"
 #include "opentxs/core/trade/OTOffer.hpp"
+#include "opentxs/core/trade/TradeLog.hpp"
 #include "opentxs/core/util/Common.hpp"
 #include "opentxs/core/Contract.hpp"
 #include "opentxs/core/OTStorage.hpp"
 
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
 
 namespace opentxs
@@ -79,6 +81,9 @@ private:
     OTCron* m_pCron{nullptr};  // The Cron object that owns this Market.
 
     OTDB::TradeListMarket* m_pTradeList{nullptr};
+    // Every trade on this market, partitioned by time. Opened on first use
+    // since the market ID is not known until the market has been loaded.
+    std::unique_ptr<TradeLog> trade_log_{nullptr};
 
     mapOfOffers m_mapBids;  // The buyers, ordered by price limit
     mapOfOffers m_mapAsks;  // The sellers, ordered by price limit
@@ -127,6 +132,7 @@ private:
     // two are technically
     // interchangeable.
 
+    TradeLog& trade_log();
     void cleanup_four_accounts(
         Account* p1,
         Account* p2,
@@ -164,6 +170,15 @@ public:
     EXPORT bool GetRecentTradeList(
         OTASCIIArmor& ascOutput,
         int32_t& nTradeCount);
+    // Returns the trades (interval 0) or the bars at the given interval
+    // within [from, to), one per line after an "interval" header line. Only
+    // the most recent rows are returned if the range holds too many.
+    EXPORT bool GetMarketData(
+        const int64_t interval,
+        const time64_t from,
+        const time64_t to,
+        String& output,
+        int32_t& count);
 
     // Returns more detailed information about offers for a specific Nym.
     bool GetNym_OfferList(
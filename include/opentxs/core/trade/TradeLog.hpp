@@ -0,0 +1,167 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_TRADE_TRADELOG_HPP
+#define OPENTXS_CORE_TRADE_TRADELOG_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include "opentxs/core/util/Common.hpp"
+#include "opentxs/Types.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace opentxs
+{
+/** Time-partitioned columnar log of the trades on one market
+ *
+ *  Trades are appended to hourly partitions, each stored as one column per
+ *  field under markets/trades/<market id>/<partition start>. Partitions are
+ *  only ever appended to, so once an hour has passed its file never changes.
+ *
+ *  The market's index holds one OHLCV bar per partition. It is split into
+ *  one file per day, named index_<day start>, and a days file lists the
+ *  days which have one, so a save only rewrites the days which changed.
+ *  Bars at the longer intervals are kept in memory from the index, and
+ *  bars at the intervals shorter than a partition are computed when a
+ *  partition is loaded and updated as trades are added. A query only loads the
+ *  partitions that overlap its range, and bar queries at an hour or longer
+ *  do not load any.
+ */
+class TradeLog
+{
+public:
+    struct Trade {
+        time64_t time_{0};
+        /** Priced per scale */
+        std::int64_t price_{0};
+        std::int64_t amount_{0};
+        std::int64_t offer_{0};
+        std::int64_t other_offer_{0};
+    };
+
+    struct Bar {
+        time64_t start_{0};
+        std::int64_t open_{0};
+        std::int64_t high_{0};
+        std::int64_t low_{0};
+        std::int64_t close_{0};
+        std::int64_t volume_{0};
+        std::int64_t trades_{0};
+    };
+
+    /** The bar intervals which may be queried, in seconds */
+    static const std::set<std::int64_t>& Intervals();
+
+    void Add(const Trade& trade);
+    /** Returns the newest limit bars at the given interval which start within
+     *  [from, to), oldest first
+     *
+     *  Returns an empty list if the interval is not supported.
+     */
+    std::vector<Bar> Bars(
+        const std::int64_t interval,
+        const time64_t from,
+        const time64_t to,
+        const std::size_t limit) const;
+    /** Writes every partition which has changed since the last save, and the
+     *  days of the index which have changed */
+    bool Save();
+    /** Returns the newest limit trades within [from, to), oldest first */
+    std::vector<Trade> Trades(
+        const time64_t from,
+        const time64_t to,
+        const std::size_t limit) const;
+
+    explicit TradeLog(const std::string& marketID);
+
+    ~TradeLog() = default;
+
+private:
+    struct Partition {
+        std::vector<time64_t> time_{};
+        std::vector<std::int64_t> price_{};
+        std::vector<std::int64_t> amount_{};
+        std::vector<std::int64_t> offer_{};
+        std::vector<std::int64_t> other_offer_{};
+        /** interval, (start, bar). Intervals shorter than a partition */
+        std::map<std::int64_t, std::map<time64_t, Bar>> bars_{};
+        bool dirty_{false};
+    };
+
+    const std::string market_id_{};
+    mutable std::mutex lock_;
+    /** interval, (start, bar). Intervals of a partition or longer. The
+     *  partition interval is the contents of the index files, which is
+     *  corrected when a partition is loaded. */
+    mutable std::map<std::int64_t, std::map<time64_t, Bar>> bars_;
+    mutable std::map<time64_t, std::shared_ptr<Partition>> partitions_;
+    /** Start of each day with an index file */
+    mutable std::set<time64_t> days_;
+    /** Days whose index file has changed since the last save */
+    mutable std::set<time64_t> dirty_days_;
+    mutable bool days_dirty_{false};
+
+    static void add(Bar& bar, const time64_t start, const Trade& trade);
+    static time64_t floor(const time64_t time, const std::int64_t interval);
+    static std::string index_name(const time64_t day);
+    static std::string serialize(const Partition& partition);
+    static std::string serialize(const std::map<time64_t, Bar>& bars);
+
+    std::shared_ptr<Partition> load(const Lock& lock, const time64_t start)
+        const;
+    void load_index(const Lock& lock);
+    void mark_dirty(const Lock& lock, const time64_t start) const;
+    void read_index(const Lock& lock, const std::string& name);
+    void roll_up(const Lock& lock) const;
+    void trim(const Lock& lock) const;
+
+    TradeLog() = delete;
+    TradeLog(const TradeLog&) = delete;
+    TradeLog(TradeLog&&) = delete;
+    TradeLog& operator=(const TradeLog&) = delete;
+    TradeLog& operator=(TradeLog&&) = delete;
+};
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_TRADE_TRADELOG_HPP
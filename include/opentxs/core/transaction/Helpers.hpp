@@ -84,6 +84,10 @@ EXPORT bool VerifyBoxReceiptExists(
     int32_t nBoxType,  // 0/nymbox, 1/inbox, 2/outbox
     const int64_t& lTransactionNum);
 
+// True if the notary reads and writes the box receipts for this box type
+// through its cache.
+bool CachedBoxReceipt(int64_t lLedgerType);
+
 OTTransaction* LoadBoxReceipt(OTTransaction& theAbbrev, Ledger& theLedger);
 
 EXPORT OTTransaction* LoadBoxReceipt(
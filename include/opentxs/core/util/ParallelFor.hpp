@@ -0,0 +1,66 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_PARALLELFOR_HPP
+#define OPENTXS_CORE_PARALLELFOR_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include <cstddef>
+#include <functional>
+
+// Default upper bound on the number of workers ParallelFor starts
+#define OT_PARALLEL_MAX_THREADS 8
+
+namespace opentxs
+{
+/** Calls function once for every index in [0, count)
+ *
+ *  If count is below threshold every call is made on the calling thread.
+ *  Otherwise the indices are divided between up to maxThreads workers, but
+ *  no more than the hardware supports, each taking every n-th index.
+ *  Returns once all calls have completed. Calls for different indices may
+ *  run concurrently, so function must only write state owned by its index.
+ */
+EXPORT void ParallelFor(
+    const std::size_t count,
+    const std::size_t threshold,
+    const std::size_t maxThreads,
+    const std::function<void(const std::size_t)>& function);
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_PARALLELFOR_HPP
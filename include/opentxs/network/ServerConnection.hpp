@@ -44,6 +44,7 @@
 #include "opentxs/Proto.hpp"
 #include "opentxs/Types.hpp"
 
+#include <future>
 #include <string>
 
 namespace opentxs::network
@@ -61,6 +62,16 @@ public:
     EXPORT virtual NetworkReplyRaw Send(const std::string& message) = 0;
     EXPORT virtual NetworkReplyString Send(const String& message) = 0;
     EXPORT virtual NetworkReplyMessage Send(const Message& message) = 0;
+    /** Send a request without waiting for the reply
+     *
+     *  Any number of requests may be outstanding on the same connection. The
+     *  reply is matched to its request by the notary and delivered through
+     *  the returned future.
+     */
+    EXPORT virtual std::future<NetworkReplyRaw> SendAsync(
+        const std::string& message) = 0;
+    EXPORT virtual std::future<NetworkReplyMessage> SendAsync(
+        const Message& message) = 0;
     EXPORT virtual bool Status() const = 0;
 
     virtual ~ServerConnection() = default;
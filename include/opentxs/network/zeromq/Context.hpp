@@ -72,6 +72,8 @@ public:
 
     EXPORT virtual operator void*() const = 0;
 
+    EXPORT virtual Pimpl<network::zeromq::DealerSocket> DealerSocket()
+        const = 0;
     EXPORT virtual Pimpl<network::zeromq::SubscribeSocket> PairEventListener(
         const PairEventCallback& callback) const = 0;
     EXPORT virtual Pimpl<network::zeromq::PairSocket> PairSocket(
@@ -98,6 +100,8 @@ public:
         const ReplyCallback& callback) const = 0;
     EXPORT virtual Pimpl<network::zeromq::RequestSocket> RequestSocket()
         const = 0;
+    EXPORT virtual Pimpl<network::zeromq::RouterSocket> RouterSocket(
+        const ReplyCallback& callback) const = 0;
     EXPORT virtual Pimpl<network::zeromq::SubscribeSocket> SubscribeSocket(
         const ListenCallback& callback) const = 0;
 
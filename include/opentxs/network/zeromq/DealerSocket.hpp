@@ -0,0 +1,111 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_NETWORK_ZEROMQ_DEALERSOCKET_HPP
+#define OPENTXS_NETWORK_ZEROMQ_DEALERSOCKET_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include "opentxs/network/zeromq/Socket.hpp"
+
+#include <future>
+
+#ifdef SWIG
+// clang-format off
+%ignore opentxs::Pimpl<opentxs::network::zeromq::DealerSocket>::operator+=;
+%ignore opentxs::Pimpl<opentxs::network::zeromq::DealerSocket>::operator==;
+%ignore opentxs::Pimpl<opentxs::network::zeromq::DealerSocket>::operator!=;
+%ignore opentxs::Pimpl<opentxs::network::zeromq::DealerSocket>::operator<;
+%ignore opentxs::Pimpl<opentxs::network::zeromq::DealerSocket>::operator<=;
+%ignore opentxs::Pimpl<opentxs::network::zeromq::DealerSocket>::operator>;
+%ignore opentxs::Pimpl<opentxs::network::zeromq::DealerSocket>::operator>=;
+%template(OTZMQDealerSocket) opentxs::Pimpl<opentxs::network::zeromq::DealerSocket>;
+%rename($ignore, regextarget=1, fullname=1) "opentxs::network::zeromq::DealerSocket::Factory.*";
+%rename($ignore, regextarget=1, fullname=1) "opentxs::network::zeromq::DealerSocket::SendRequest.*";
+%rename($ignore, regextarget=1, fullname=1) "opentxs::network::zeromq::DealerSocket::SetCurve.*";
+%rename(ZMQDealerSocket) opentxs::network::zeromq::DealerSocket;
+// clang-format on
+#endif  // SWIG
+
+namespace opentxs
+{
+namespace network
+{
+namespace zeromq
+{
+/** Asynchronous request socket
+ *
+ *  Unlike RequestSocket, any number of requests may be outstanding at once.
+ *  Each request is tagged with a correlation ID which the remote RouterSocket
+ *  echoes back, and the reply is delivered through the returned future. A
+ *  request which receives no reply within the receive timeout resolves with
+ *  SendResult::TIMEOUT.
+ */
+class DealerSocket : virtual public Socket
+{
+public:
+    EXPORT static OTZMQDealerSocket Factory(const class Context& context);
+
+#ifndef SWIG
+    EXPORT virtual std::future<MessageSendResult> SendRequest(
+        const std::string& message) const = 0;
+    EXPORT virtual std::future<MessageSendResult> SendRequest(
+        opentxs::network::zeromq::Message& message) const = 0;
+#endif
+    EXPORT virtual bool SetCurve(const ServerContract& contract) const = 0;
+    EXPORT virtual bool SetSocksProxy(const std::string& proxy) const = 0;
+
+    EXPORT virtual ~DealerSocket() = default;
+
+protected:
+    DealerSocket() = default;
+
+private:
+    friend OTZMQDealerSocket;
+
+    virtual DealerSocket* clone() const = 0;
+
+    DealerSocket(const DealerSocket&) = delete;
+    DealerSocket(DealerSocket&&) = default;
+    DealerSocket& operator=(const DealerSocket&) = delete;
+    DealerSocket& operator=(DealerSocket&&) = default;
+};
+}  // namespace zeromq
+}  // namespace network
+}  // namespace opentxs
+#endif  // OPENTXS_NETWORK_ZEROMQ_DEALERSOCKET_HPP
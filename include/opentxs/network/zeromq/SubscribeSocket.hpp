@@ -74,6 +74,9 @@ public:
 
     EXPORT virtual bool SetCurve(const ServerContract& contract) const = 0;
     EXPORT virtual bool SetSocksProxy(const std::string& proxy) const = 0;
+    /** Only deliver messages which begin with topic. The first call replaces
+     *  the default subscription to every message. */
+    EXPORT virtual bool Subscribe(const std::string& topic) const = 0;
 
     EXPORT virtual ~SubscribeSocket() = default;
 
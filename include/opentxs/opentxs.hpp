@@ -97,7 +97,9 @@
 #include <opentxs/core/Account.hpp>
 #include <opentxs/core/Cheque.hpp>
 #include <opentxs/core/Data.hpp>
+#include <opentxs/core/FixedIdentifier.hpp>
 #include <opentxs/core/Identifier.hpp>
+#include <opentxs/core/IntervalSet.hpp>
 #include <opentxs/core/Ledger.hpp>
 #include <opentxs/core/Log.hpp>
 #include <opentxs/core/Message.hpp>
@@ -0,0 +1,234 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_SERVER_BOXCACHE_HPP
+#define OPENTXS_SERVER_BOXCACHE_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/Types.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+namespace opentxs
+{
+namespace server
+{
+/** Write-back cache of account and box files
+ *
+ *  Holds the serialized form of accounts, nymboxes, inboxes, outboxes and
+ *  their box receipts so that hot files are not re-read on every request,
+ *  and coalesces repeated writes to the same file. Dirty entries are
+ *  written to storage by Flush(), which the message processor calls before
+ *  each reply is sent and after each cron run, so nothing acknowledged to a
+ *  client is held only in memory.
+ *
+ *  The cache also remembers the hash of the last contents whose signature
+ *  was verified for each file, so an unchanged file is not verified twice.
+ *  Contents stored by the notary itself were signed by the notary nym
+ *  immediately beforehand and are treated as verified.
+ *
+ *  A file is only held dirty if it already exists in storage, so existence
+ *  checks made directly against storage remain correct.
+ */
+class BoxCache
+{
+public:
+    /** Defers the notary signature on boxes stored by the calling thread
+     *
+     *  While a Batch is open, boxes which are saved on the thread which
+     *  opened it are stored unsigned, and each one is signed once, with its
+     *  final contents, when the Batch is destroyed. Flush() never writes a
+     *  box whose signature is still pending.
+     */
+    class Batch
+    {
+    public:
+        explicit Batch(const BoxCache& cache);
+        Batch() = delete;
+        Batch(const Batch&) = delete;
+        Batch(Batch&&) = delete;
+        Batch& operator=(const Batch&) = delete;
+        Batch& operator=(Batch&&) = delete;
+
+        ~Batch();
+
+    private:
+        const BoxCache& cache_;
+    };
+
+    struct Statistics {
+        std::uint64_t hits_{0};
+        std::uint64_t misses_{0};
+        std::uint64_t writes_{0};
+        std::uint64_t coalesced_writes_{0};
+        std::uint64_t verifications_skipped_{0};
+        std::uint64_t flushes_{0};
+        std::uint64_t flush_errors_{0};
+        std::chrono::microseconds last_flush_{0};
+        std::chrono::microseconds max_flush_{0};
+        std::chrono::microseconds total_flush_{0};
+    };
+
+    /** Writes every dirty entry to storage as a single unit
+     *
+     *  The entries are written to a journal by Prepare() before any of them
+     *  are written to their files. If the process stops part way through,
+     *  Recover() finishes the writes when the server next starts, so either
+     *  every change made since the previous flush survives or none does.
+     */
+    /** Returns true if the calling thread has an open Batch */
+    bool Batching() const;
+    bool Commit() const;
+    /** Registers the function which signs a box stored during the open
+     *  Batch, replacing any function registered earlier for the same box */
+    void Defer(
+        const std::string& folder,
+        const std::string& one,
+        const std::string& two,
+        const std::function<bool()>& sign) const;
+    /** Writes every dirty entry to storage
+     *
+     *  Entries which fail to write remain dirty and are retried on the next
+     *  flush.
+     */
+    bool Flush() const;
+    /** Writes every dirty entry to the journal without writing their files.
+     *  The journal is removed once a later flush has written them all. */
+    bool Prepare() const;
+    std::string Query(
+        const std::string& folder,
+        const std::string& one,
+        const std::string& two = "",
+        const std::string& three = "") const;
+    /** Applies the journal left by an interrupted Commit(), if any. Must be
+     *  called before the cache is used. */
+    bool Recover() const;
+    /** Marks the current contents of the file as having a valid signature */
+    void SetVerified(
+        const std::string& folder,
+        const std::string& one,
+        const std::string& two = "") const;
+    Statistics Stats() const;
+    /** Box receipts are stored with a non-empty three. No verification state
+     *  is kept for them, since they are checked against the hash in their
+     *  box rather than by signature. */
+    bool Store(
+        const std::string& contents,
+        const std::string& folder,
+        const std::string& one,
+        const std::string& two = "",
+        const std::string& three = "") const;
+    /** Returns true if the current contents of the file have already been
+     *  verified */
+    bool Verified(
+        const std::string& folder,
+        const std::string& one,
+        const std::string& two = "") const;
+
+    explicit BoxCache(const std::size_t capacity = 4096);
+
+    ~BoxCache();
+
+private:
+    struct Entry {
+        std::string folder_{};
+        std::string one_{};
+        std::string two_{};
+        std::string three_{};
+        std::string contents_{};
+        OTIdentifier hash_{Identifier::Factory()};
+        bool dirty_{false};
+        std::list<std::string>::iterator position_{};
+    };
+
+    const std::size_t capacity_{0};
+    mutable std::mutex lock_;
+    mutable std::map<std::string, Entry> entries_;
+    // Keys of the entries which must be written by the next flush
+    mutable std::set<std::string> dirty_;
+    // Least recently used first
+    mutable std::list<std::string> lru_;
+    // Only holds keys which are present in entries_
+    mutable std::map<std::string, OTIdentifier> verified_;
+    mutable Statistics stats_;
+    // True while the journal holds entries which may not have been written
+    mutable bool journal_{false};
+    // The thread which opened the current Batch, if any
+    mutable std::thread::id batch_{};
+    // Signatures to apply when the current Batch closes. Entries with a
+    // pending signature are not written to storage.
+    mutable std::map<std::string, std::function<bool()>> deferred_;
+
+    static OTIdentifier hash(const std::string& contents);
+    static std::string key(
+        const std::string& folder,
+        const std::string& one,
+        const std::string& two,
+        const std::string& three = "");
+
+    void begin_batch() const;
+    void end_batch() const;
+    void evict(const Lock& lock) const;
+    bool flush(const Lock& lock) const;
+    bool prepare(const Lock& lock) const;
+    Entry* load(
+        const Lock& lock,
+        const std::string& folder,
+        const std::string& one,
+        const std::string& two,
+        const std::string& three = "") const;
+    void touch(const Lock& lock, Entry& entry) const;
+
+    BoxCache(const BoxCache&) = delete;
+    BoxCache(BoxCache&&) = delete;
+    BoxCache& operator=(const BoxCache&) = delete;
+    BoxCache& operator=(BoxCache&&) = delete;
+};
+}  // namespace server
+}  // namespace opentxs
+#endif  // OPENTXS_SERVER_BOXCACHE_HPP
@@ -44,6 +44,7 @@
 #include "opentxs/core/Lockable.hpp"
 #include "opentxs/core/Flag.hpp"
 #include "opentxs/network/zeromq/Socket.hpp"
+#include "opentxs/server/Metrics.hpp"
 
 #include <atomic>
 #include <memory>
@@ -73,10 +74,22 @@ private:
     const Flag& running_;
     [[maybe_unused]] const network::zeromq::Context& context_;
     OTZMQReplyCallback reply_socket_callback_;
-    OTZMQReplySocket reply_socket_;
+    OTZMQRouterSocket router_socket_;
+    Metrics metrics_;
+    OTZMQReplyCallback metrics_callback_;
+    OTZMQReplySocket metrics_socket_;
+    /** Only set when the metrics endpoint is not reachable from other hosts,
+     *  since the metrics socket is not authenticated */
+    bool metrics_reset_{false};
     std::unique_ptr<std::thread> thread_{nullptr};
 
-    bool processMessage(const std::string& messageString, std::string& reply);
+    static bool is_local(const std::string& endpoint);
+
+    bool processMessage(
+        const std::string& messageString,
+        std::string& reply,
+        Metrics::Request& metrics);
+    OTZMQMessage processMetrics(const network::zeromq::Message& incoming);
     OTZMQMessage processSocket(const network::zeromq::Message& incoming);
     void run();
 };
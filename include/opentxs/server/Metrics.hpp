@@ -0,0 +1,182 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_SERVER_METRICS_HPP
+#define OPENTXS_SERVER_METRICS_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include "opentxs/Types.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace opentxs
+{
+namespace server
+{
+/** Latency histograms for the phases of each notary request
+ *
+ *  The message processor wraps each request in a Request. Code running on
+ *  the same thread marks the phases it performs with a Timer, which does
+ *  nothing if no Request is active (for example during cron). When the
+ *  Request ends, the time spent in each phase is added to the histograms for
+ *  the request's MessageType.
+ *
+ *  Phases may nest (box I/O happens inside the handler), so they do not sum
+ *  to the total.
+ *
+ *  Histograms use fixed log-linear buckets, eight per power of two
+ *  microseconds, so recorded values are within 12.5% of the true value.
+ *  They are updated with relaxed atomic operations, so recording never
+ *  blocks. A report taken while requests are running is approximate.
+ */
+class Metrics
+{
+public:
+    enum class Phase : std::uint8_t {
+        Decode = 0,
+        Parse = 1,
+        CheckNym = 2,
+        LoadContext = 3,
+        Handler = 4,
+        BoxIO = 5,
+        Sign = 6,
+        Encode = 7,
+        Total = 8,
+    };
+
+    static constexpr std::size_t PhaseCount{9};
+
+    class Timer;
+
+    /** Collects the phase timings of the request processed by this thread */
+    class Request
+    {
+    public:
+        void SetType(const MessageType type);
+
+        explicit Request(Metrics& metrics);
+
+        ~Request();
+
+    private:
+        friend class Metrics;
+        friend class Timer;
+
+        Metrics& metrics_;
+        Request* const parent_{nullptr};
+        const std::chrono::steady_clock::time_point start_{};
+        MessageType type_{MessageType::badID};
+        std::array<std::chrono::nanoseconds, PhaseCount> phases_{};
+
+        Request() = delete;
+        Request(const Request&) = delete;
+        Request(Request&&) = delete;
+        Request& operator=(const Request&) = delete;
+        Request& operator=(Request&&) = delete;
+    };
+
+    /** Adds the lifetime of this object to a phase of the current request */
+    class Timer
+    {
+    public:
+        explicit Timer(const Phase phase);
+
+        ~Timer();
+
+    private:
+        Request* const request_{nullptr};
+        const Phase phase_{Phase::Total};
+        const std::chrono::steady_clock::time_point start_{};
+
+        Timer() = delete;
+        Timer(const Timer&) = delete;
+        Timer(Timer&&) = delete;
+        Timer& operator=(const Timer&) = delete;
+        Timer& operator=(Timer&&) = delete;
+    };
+
+    /** One line per message type and phase with count, mean, p50, p90, p99
+     *  and max in microseconds */
+    std::string Report() const;
+    void Reset();
+
+    Metrics();
+
+    ~Metrics();
+
+private:
+    static constexpr std::size_t Buckets{304};
+    static constexpr std::size_t Types{256};
+
+    struct Histogram {
+        std::array<std::atomic<std::uint64_t>, Buckets> buckets_{};
+        std::atomic<std::uint64_t> count_{0};
+        std::atomic<std::uint64_t> total_{0};
+        std::atomic<std::uint64_t> max_{0};
+
+        std::uint64_t Percentile(
+            const std::uint64_t count,
+            const double fraction) const;
+        void Record(const std::uint64_t microseconds);
+        void Reset();
+    };
+
+    using Histograms = std::array<Histogram, PhaseCount>;
+
+    mutable std::array<std::atomic<Histograms*>, Types> histograms_;
+
+    static std::size_t bucket(const std::uint64_t microseconds);
+    static std::uint64_t bucket_limit(const std::size_t bucket);
+    static std::string phase_name(const Phase phase);
+
+    Histograms& get(const MessageType type) const;
+    void record(const Request& request);
+
+    Metrics(const Metrics&) = delete;
+    Metrics(Metrics&&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+    Metrics& operator=(Metrics&&) = delete;
+};
+}  // namespace server
+}  // namespace opentxs
+#endif  // OPENTXS_SERVER_METRICS_HPP
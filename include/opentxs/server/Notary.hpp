@@ -41,10 +41,21 @@
 
 #include "opentxs/Forward.hpp"
 
+#if OT_CASH
+#include "opentxs/server/SpentTokens.hpp"
+#endif  // OT_CASH
+
+#include <cstdint>
+#include <map>
+#include <memory>
+
 namespace opentxs
 {
 class Account;
+class Cheque;
 class ClientContext;
+class Item;
+class Ledger;
 class Nym;
 class OTTransaction;
 
@@ -89,9 +100,21 @@ public:
 private:
     friend class Server;
 
+    // The item an inbox receipt was issued for, and the cheque attached to
+    // that item if it is a cheque deposit
+    struct OriginalItem {
+        std::unique_ptr<Item> item_{};
+        std::unique_ptr<Cheque> cheque_{};
+    };
+    // Keyed by the transaction number of the inbox receipt
+    using OriginalItems = std::map<std::int64_t, OriginalItem>;
+
     Server& server_;
     const opentxs::api::Server& mint_;
     const opentxs::api::client::Wallet& wallet_;
+#if OT_CASH
+    SpentTokens spent_tokens_;
+#endif  // OT_CASH
 
     void NotarizeCancelCronItem(
         Nym& nym,
@@ -156,6 +179,10 @@ private:
         OTTransaction& tranIn,
         OTTransaction& tranOut,
         bool& outSuccess);
+    OriginalItems parse_original_items(
+        Ledger& inbox,
+        OTTransaction& processInbox) const;
+    bool verify_account_signature(const Account& account) const;
 
     explicit Notary(
         Server& server,
@@ -110,6 +110,9 @@ public:
     int64_t GetAmountPaidOut() { return m_lAmountPaidOut; }
     int64_t GetAmountReturned() { return m_lAmountReturned; }
 
+    // Sends a voucher for funds which were not paid to any shareholder back
+    // to the nym who initiated the payout.
+    bool Refund(const int64_t lAmount);
     bool Trigger(Account& theAccount) override;
 };
 
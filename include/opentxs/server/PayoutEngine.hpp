@@ -0,0 +1,128 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_SERVER_PAYOUTENGINE_HPP
+#define OPENTXS_SERVER_PAYOUTENGINE_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include "opentxs/core/AccountVisitor.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace opentxs
+{
+namespace server
+{
+class Server;
+
+/** Pays a dividend to every holder of a share unit
+ *
+ *  Holders are read from the unit's account records one shard at a time, so
+ *  memory use does not depend on the number of shareholders. Each batch of
+ *  accounts is loaded on a pool of worker threads and then paid in order on
+ *  the calling thread, since every voucher draws on the same reserve account
+ *  and the same source of transaction numbers.
+ *
+ *  The checkpoint is stored through the box cache. After each shard the
+ *  vouchers and the checkpoint which moves past that shard are committed as
+ *  one unit, so if the server stops part way through a payout it is resumed
+ *  from the first shard whose vouchers were not committed, and no voucher is
+ *  sent twice.
+ */
+class PayoutEngine
+{
+public:
+    struct Payout {
+        // Transaction number of the payDividend request
+        std::string id_{};
+        std::string nym_{};
+        std::string shares_{};
+        std::string payout_unit_{};
+        std::string voucher_account_{};
+        std::string memo_{};
+        std::int64_t per_share_{0};
+        std::int64_t total_{0};
+        std::size_t next_shard_{0};
+        std::int64_t paid_{0};
+        std::int64_t returned_{0};
+    };
+
+    /** Pays every shareholder and returns any leftover funds to the payer
+     *
+     *  The funds must already have been moved to the voucher reserve account.
+     *  Accounts in loaded are used instead of being loaded from storage.
+     */
+    bool Pay(Payout& payout, mapOfAccounts* loaded);
+    /** Finishes any payouts which were interrupted */
+    void Resume();
+
+    ~PayoutEngine() = default;
+
+private:
+    friend class Server;
+
+    Server& server_;
+    const std::size_t batch_size_{0};
+
+    static Payout deserialize(const std::string& id, const std::string& input);
+    static std::string serialize(const Payout& payout);
+
+    bool erase_checkpoint(const std::string& id) const;
+    std::vector<std::unique_ptr<Account>> load(
+        const Identifier& notaryID,
+        const std::vector<std::string>& ids,
+        const mapOfAccounts* loaded) const;
+    std::unique_ptr<OTDB::Storable> load_checkpoints() const;
+    bool pay(Payout& payout, mapOfAccounts* loaded) const;
+    bool save_checkpoint(const Payout& payout) const;
+    bool store_checkpoints(OTDB::StringMap& checkpoints) const;
+
+    explicit PayoutEngine(Server& server);
+    PayoutEngine() = delete;
+    PayoutEngine(const PayoutEngine&) = delete;
+    PayoutEngine(PayoutEngine&&) = delete;
+    PayoutEngine& operator=(const PayoutEngine&) = delete;
+    PayoutEngine& operator=(PayoutEngine&&) = delete;
+};
+}  // namespace server
+}  // namespace opentxs
+#endif  // OPENTXS_SERVER_PAYOUTENGINE_HPP
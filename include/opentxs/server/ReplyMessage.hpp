@@ -107,6 +107,7 @@ public:
     bool SetPayload2(const String& payload);
     bool SetPayload3(const String& payload);
     void SetRequestNumber(const RequestNumber number);
+    void SetStarting();
     void SetSuccess(const bool success);
     void SetTargetNym(const String& nymID);
     void SetTransactionNumber(const TransactionNumber& number);
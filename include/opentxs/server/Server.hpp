@@ -45,16 +45,24 @@
 #include "opentxs/core/util/Common.hpp"
 #include "opentxs/core/Nym.hpp"
 #include "opentxs/core/OTTransaction.hpp"
+#include "opentxs/server/BoxCache.hpp"
 #include "opentxs/server/Transactor.hpp"
 #include "opentxs/server/Notary.hpp"
 #include "opentxs/server/MainFile.hpp"
+#include "opentxs/server/PayoutEngine.hpp"
 #include "opentxs/server/UserCommandProcessor.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 namespace opentxs
 {
@@ -76,18 +84,29 @@ class Server
     friend class MainFile;
     friend class opentxs::PayDividendVisitor;
     friend class Notary;
+    friend class PayoutEngine;
 
 public:
     EXPORT bool GetConnectInfo(std::string& hostname, std::uint32_t& port)
         const;
+    EXPORT bool GetNotifyInfo(std::uint32_t& port) const;
+    /** The topic under which box change notices for a nym are published.
+     *  It is keyed with a secret held by the notary, so it can not be
+     *  computed from the nym ID. */
+    EXPORT std::string NotificationTopic(const Identifier& nymID) const;
     EXPORT const Identifier& GetServerID() const;
     EXPORT const Nym& GetServerNym() const;
     EXPORT std::unique_ptr<OTPassword> TransportKey(Data& pubkey) const;
     EXPORT bool IsFlaggedForShutdown() const;
 
+    /** Loads the cron file on a background thread and activates cron once it
+     *  is loaded. Until then CronReady() is false. */
     EXPORT void ActivateCron();
+    EXPORT bool CronReady() const { return cron_ready_.load(); }
     EXPORT void Init(bool readOnly = false);
     EXPORT void ProcessCron();
+    /** Time spent in each phase of startup, for the metrics endpoint. */
+    EXPORT std::string StartupReport() const;
     EXPORT std::int64_t computeTimeout() { return m_Cron.computeTimeout(); }
 
     EXPORT ~Server();
@@ -106,10 +125,12 @@ private:
     const opentxs::api::Server& mint_;
     const opentxs::api::storage::Storage& storage_;
     const opentxs::api::client::Wallet& wallet_;
+    BoxCache cache_;
     MainFile mainFile_;
     Notary notary_;
     Transactor transactor_;
     UserCommandProcessor userCommandProcessor_;
+    PayoutEngine payout_;
     String m_strWalletFilename;
     // Used at least for whether or not to write to the PID.
     bool m_bReadOnly{false};
@@ -124,6 +145,14 @@ private:
     // connect info.
     Nym m_nymServer;
     OTCron m_Cron;  // This is where re-occurring and expiring tasks go.
+    std::atomic<bool> cron_ready_{false};
+    bool have_notify_port_{false};
+    std::uint32_t notify_port_{0};
+    std::string notify_key_{};
+    std::unique_ptr<std::thread> cron_thread_{nullptr};
+    mutable std::mutex startup_lock_;
+    std::chrono::steady_clock::time_point startup_{};
+    std::vector<std::pair<std::string, std::chrono::microseconds>> phases_{};
 
     Server(
         const opentxs::api::Crypto& crypto,
@@ -133,6 +162,11 @@ private:
         const opentxs::api::client::Wallet& wallet);
 
     void CreateMainFile(bool& mainFileExists);
+    void load_cron();
+    void load_notify_info();
+    void startup_phase(
+        const std::string& name,
+        const std::chrono::steady_clock::time_point& start);
     // Note: SendInstrumentToNym and SendMessageToNym CALL THIS.
     // They are higher-level, this is lower-level.
     bool DropMessageToNymbox(
@@ -74,6 +74,23 @@ struct ServerSettings {
         __heartbeat_ms_between_beats = value;
     }
 
+    static const std::string& GetMetricsEndpoint()
+    {
+        return __metrics_endpoint;
+    }
+
+    static void SetMetricsEndpoint(const std::string& endpoint)
+    {
+        __metrics_endpoint = endpoint;
+    }
+
+    static bool GetMetricsAllowRemote() { return __metrics_allow_remote; }
+
+    static void SetMetricsAllowRemote(bool value)
+    {
+        __metrics_allow_remote = value;
+    }
+
     static const std::string& GetOverrideNymID() { return __override_nym_id; }
 
     static void SetOverrideNymID(const std::string& id)
@@ -86,6 +103,11 @@ struct ServerSettings {
     static std::int32_t __heartbeat_no_requests;
     static std::int32_t __heartbeat_ms_between_beats;
 
+    // Where request latency reports are served. Empty means disabled.
+    static std::string __metrics_endpoint;
+    // Whether the metrics endpoint may be reachable from other hosts
+    static bool __metrics_allow_remote;
+
     // The Nym who's allowed to do certain commands even if they are turned off.
     static std::string __override_nym_id;
     // Are usage credits REQUIRED in order to use this server?
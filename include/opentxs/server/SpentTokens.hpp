@@ -0,0 +1,129 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_SERVER_SPENTTOKENS_HPP
+#define OPENTXS_SERVER_SPENTTOKENS_HPP
+
+#include "opentxs/Forward.hpp"
+
+#if OT_CASH
+#include "opentxs/Types.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace opentxs
+{
+class Identifier;
+
+namespace server
+{
+/** Spent token database
+ *
+ *  One store exists per instrument definition and mint series. Each store
+ *  consists of:
+ *
+ *    <unit>.<series>.log  append-only list of fixed size token hashes
+ *    <unit>.<series>.idx  open addressing hash table over the log
+ *
+ *  A Bloom filter is held in memory in front of the index so that the common
+ *  case (a token which has never been seen) is answered without disk access.
+ *  The index is disposable and is rebuilt from the log whenever it is missing,
+ *  truncated, or does not cover every logged record.
+ *
+ *  Tokens recorded by older versions as individual files under
+ *  OTFolders::Spent() are still honored.
+ */
+class SpentTokens
+{
+public:
+    /** Token hashes to be spent, grouped by mint series */
+    using Batch = std::map<std::uint32_t, std::vector<OTIdentifier>>;
+
+    /** Calculates the identifier under which a token is recorded */
+    static OTIdentifier TokenID(const String& spendableToken);
+
+    /** Returns true if the token was spent, or if its status can not be
+     *  determined.
+     *
+     *  Any value other than false must be treated as "do not accept".
+     */
+    bool IsSpent(
+        const Identifier& unitID,
+        const std::uint32_t series,
+        const Identifier& tokenID) const;
+    /** Atomically checks and records every token in the batch
+     *
+     *  Returns false without recording anything if any token in the batch is
+     *  already spent, appears more than once, or if the records can not be
+     *  durably written.
+     */
+    bool Spend(const Identifier& unitID, const Batch& tokens) const;
+
+    SpentTokens();
+
+    ~SpentTokens();
+
+private:
+    class Store;
+
+    mutable std::mutex lock_;
+    mutable std::map<std::string, std::unique_ptr<Store>> stores_;
+
+    static std::string store_name(
+        const Identifier& unitID,
+        const std::uint32_t series);
+
+    Store& get_store(
+        const Lock& lock,
+        const Identifier& unitID,
+        const std::uint32_t series) const;
+
+    SpentTokens(const SpentTokens&) = delete;
+    SpentTokens(SpentTokens&&) = delete;
+    SpentTokens& operator=(const SpentTokens&) = delete;
+    SpentTokens& operator=(SpentTokens&&) = delete;
+};
+}  // namespace server
+}  // namespace opentxs
+#endif  // OT_CASH
+#endif  // OPENTXS_SERVER_SPENTTOKENS_HPP
@@ -129,6 +129,9 @@ private:
     const opentxs::api::Server& mint_;
     const opentxs::api::client::Wallet& wallet_;
 
+    static std::string box_folder(const Ledger& box);
+    static bool uses_cron(const Ledger& input);
+
     bool add_numbers_to_nymbox(
         const TransactionNumber transactionNumber,
         const NumList& newNumbers,
@@ -136,6 +139,7 @@ private:
         Ledger& nymbox,
         Identifier& nymboxHash) const;
     void check_acknowledgements(ReplyMessage& reply) const;
+    bool check_cron_ready(ReplyMessage& reply) const;
     bool check_client_nym(ReplyMessage& reply) const;
     bool check_ping_notary(const Message& msgIn) const;
     bool check_request_number(
@@ -150,6 +154,8 @@ private:
     bool cmd_get_box_receipt(ReplyMessage& reply) const;
     // Get the publicly-available list of offers on a specific market.
     bool cmd_get_instrument_definition(ReplyMessage& reply) const;
+    // Get trades or OHLCV bars for a time range on a specific market.
+    bool cmd_get_market_data(ReplyMessage& reply) const;
     // Get the list of markets on this server.
     bool cmd_get_market_list(ReplyMessage& reply) const;
     bool cmd_get_market_offers(ReplyMessage& reply) const;
@@ -65,6 +65,7 @@ class Storage;
 class Plugin : virtual public opentxs::api::storage::Plugin
 {
 public:
+    bool Archived(const std::string& key) const override;
     bool EmptyBucket(const bool bucket) const override = 0;
 
     bool Load(const std::string& key, const bool checking, std::string& value)
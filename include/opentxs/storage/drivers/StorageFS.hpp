@@ -74,11 +74,26 @@ public:
     ~StorageFS();
 
 protected:
+    typedef boost::iostreams::stream<boost::iostreams::file_descriptor_sink>
+        File;
+
     const std::string folder_;
     const std::string path_seperator_{};
     OTFlag ready_;
 
+    std::string read_file(const std::string& filename) const;
+    void store(
+        const bool isTransaction,
+        const std::string& key,
+        const std::string& value,
+        const bool bucket,
+        std::promise<bool>* promise) const override;
     bool sync(const std::string& path) const;
+    bool sync(File& file) const;
+    bool write_file(
+        const std::string& directory,
+        const std::string& filename,
+        const std::string& contents) const;
 
     StorageFS(
         const api::storage::Storage& storage,
@@ -89,29 +104,14 @@ protected:
         const Flag& bucket);
 
 private:
-    typedef boost::iostreams::stream<boost::iostreams::file_descriptor_sink>
-        File;
-
     virtual std::string calculate_path(
         const std::string& key,
         const bool bucket,
         std::string& directory) const = 0;
     virtual std::string prepare_read(const std::string& input) const;
     virtual std::string prepare_write(const std::string& input) const;
-    std::string read_file(const std::string& filename) const;
     virtual std::string root_filename() const = 0;
-    void store(
-        const bool isTransaction,
-        const std::string& key,
-        const std::string& value,
-        const bool bucket,
-        std::promise<bool>* promise) const override;
-    bool sync(File& file) const;
     bool sync(int fd) const;
-    bool write_file(
-        const std::string& directory,
-        const std::string& filename,
-        const std::string& contents) const;
 
     void Cleanup_StorageFS();
     void Init_StorageFS();
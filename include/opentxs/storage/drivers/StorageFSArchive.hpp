@@ -45,7 +45,12 @@
 
 #include "opentxs/storage/drivers/StorageFS.hpp"
 
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
 
 namespace opentxs
 {
@@ -61,7 +66,24 @@ private:
     typedef StorageFS ot_super;
 
 public:
+    // Opens an archive outside of the storage api, for tools which read or
+    // write backups directly
+    static StorageFSArchive* Factory(
+        const api::storage::Storage& storage,
+        const StorageConfig& config,
+        const Digest& hash,
+        const Random& random,
+        const Flag& bucket,
+        const std::string& folder,
+        std::unique_ptr<SymmetricKey>& key);
+
+    bool Archived(const std::string& key) const override;
     bool EmptyBucket(const bool bucket) const override;
+    bool LoadFromBucket(
+        const std::string& key,
+        std::string& value,
+        const bool bucket) const override;
+    bool StoreRoot(const bool commit, const std::string& hash) const override;
 
     void Cleanup() override;
 
@@ -70,16 +92,41 @@ public:
 private:
     friend class StorageMultiplex;
 
+    // segment, offset, size
+    typedef std::tuple<std::uint64_t, std::uint64_t, std::uint64_t> Location;
+
     const std::unique_ptr<SymmetricKey> encryption_key_;
     const bool encrypted_{false};
+    // Encrypted archives pack objects into compressed segments which are
+    // encrypted as a whole, instead of encrypting every object separately
+    const bool segmented_{false};
+    mutable std::mutex segment_lock_;
+    mutable std::map<std::string, Location> manifest_;
+    mutable std::map<std::string, std::string> pending_;
+    mutable std::uint64_t pending_bytes_{0};
+    mutable std::uint64_t next_segment_{0};
+    mutable std::uint64_t cached_segment_id_{0};
+    mutable std::string cached_segment_;
 
     std::string calculate_path(
         const std::string& key,
         const bool bucket,
         std::string& directory) const override;
+    bool flush_segment(const Lock& lock) const;
+    bool load_segment(const Lock& lock, const std::uint64_t segment) const;
+    std::string manifest_filename() const;
     std::string prepare_read(const std::string& ciphertext) const override;
     std::string prepare_write(const std::string& plaintext) const override;
+    void read_manifest();
     std::string root_filename() const override;
+    std::string segment_directory() const;
+    std::string segment_filename(const std::uint64_t segment) const;
+    void store(
+        const bool isTransaction,
+        const std::string& key,
+        const std::string& value,
+        const bool bucket,
+        std::promise<bool>* promise) const override;
 
     void Init_StorageFSArchive();
     void Cleanup_StorageFSArchive();
@@ -76,6 +76,7 @@ class Tree;
 class StorageMultiplex : virtual public opentxs::api::storage::Driver
 {
 public:
+    bool Archived(const std::string& key) const override;
     bool EmptyBucket(const bool bucket) const override;
     bool LoadFromBucket(
         const std::string& key,
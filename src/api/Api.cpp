@@ -136,11 +136,11 @@ void Api::Init()
     OT_ASSERT(otapi_exec_);
 
     server_action_.reset(new api::client::implementation::ServerAction(
-        lock_, *ot_api_, *otapi_exec_, wallet_));
+        *ot_api_, *otapi_exec_, wallet_));
 
     OT_ASSERT(server_action_)
 
-    cash_.reset(new api::client::implementation::Cash(lock_));
+    cash_.reset(new api::client::implementation::Cash());
 
     OT_ASSERT(cash_);
 
@@ -160,7 +160,6 @@ void Api::Init()
 
     pair_.reset(new api::client::implementation::Pair(
         running_,
-        lock_,
         *sync_,
         *server_action_,
         wallet_,
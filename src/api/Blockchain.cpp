@@ -46,6 +46,7 @@
 #include "opentxs/api/crypto/Encode.hpp"
 #include "opentxs/api/crypto/Hash.hpp"
 #include "opentxs/api/Activity.hpp"
+#include "opentxs/api/Settings.hpp"
 #include "opentxs/core/crypto/AsymmetricKeySecp256k1.hpp"
 #include "opentxs/core/crypto/Bip32.hpp"
 #include "opentxs/core/crypto/OTAsymmetricKey.hpp"
@@ -54,6 +55,11 @@
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/String.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <tuple>
+#include <vector>
+
 #define LOCK_ACCOUNT()                                                         \
     Lock mapLock(lock_);                                                       \
     auto& accountMutex = account_lock_[accountID];                             \
@@ -76,6 +82,10 @@
 #define LITECOIN_PUBKEY_HASH 0x30
 #define DOGECOIN_PUBKEY_HASH 0x1e
 #define DASH_PUBKEY_HASH 0x4c
+#define BLOCKCHAIN_FLUSH_MILLISECONDS 1000
+#define BLOCKCHAIN_POOL_SLEEP_MILLISECONDS 50
+#define BLOCKCHAIN_RESERVED_ADDRESSES 100
+#define BLOCKCHAIN_RESERVED_SECTION "blockchain_reserved"
 
 #define OT_METHOD "opentxs::Blockchain::"
 
@@ -84,16 +94,28 @@ namespace opentxs::api
 Blockchain::Blockchain(
     const Activity& activity,
     const Crypto& crypto,
+    const Settings& config,
     const storage::Storage& storage,
-    const client::Wallet& wallet)
+    const client::Wallet& wallet,
+    const std::uint32_t gap)
     : activity_(activity)
     , crypto_(crypto)
+    , config_(config)
     , storage_(storage)
     , wallet_(wallet)
+    , gap_(gap)
     , lock_()
     , nym_lock_()
     , account_lock_()
+    , accounts_()
+    , dirty_()
+    , reserved_()
+    , pool_lock_()
+    , pools_()
+    , running_(Flag::Factory(true))
+    , pool_thread_(nullptr)
 {
+    pool_thread_.reset(new std::thread(&Blockchain::refill_pools, this));
 }
 
 std::shared_ptr<proto::Bip44Account> Blockchain::Account(
@@ -109,9 +131,11 @@ std::shared_ptr<proto::Bip44Account> Blockchain::Account(
     if (false == bool(account)) {
         otErr << OT_METHOD << __FUNCTION__ << ": Account does not exist."
               << std::endl;
+
+        return account;
     }
 
-    return account;
+    return std::make_shared<proto::Bip44Account>(*account);
 }
 
 std::set<Identifier> Blockchain::AccountList(
@@ -208,7 +232,6 @@ std::unique_ptr<proto::Bip44Address> Blockchain::AllocateAddress(
         return output;
     }
 
-    const auto& type = account->type();
     const auto index =
         chain ? account->internalindex() : account->externalindex();
 
@@ -218,25 +241,30 @@ std::unique_ptr<proto::Bip44Address> Blockchain::AllocateAddress(
         return output;
     }
 
+    if (false == reserve(accountLock, accountID, chain, index)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to reserve index "
+              << index << "." << std::endl;
+
+        return output;
+    }
+
     auto& newAddress = add_address(index, *account, chain);
     newAddress.set_version(BLOCKCHAIN_VERSION);
     newAddress.set_index(index);
-    newAddress.set_address(calculate_address(*account, chain, index));
+    newAddress.set_address(pooled_address(accountID, *account, chain, index));
 
     OT_ASSERT(false == newAddress.address().empty());
 
     otErr << OT_METHOD << __FUNCTION__ << ": Address " << newAddress.address()
           << " allocated." << std::endl;
     newAddress.set_label(label);
-    const auto saved = storage_.Store(sNymID, type, *account);
-
-    if (false == saved) {
-        otErr << OT_METHOD << __FUNCTION__ << ": Failed to save account."
-              << std::endl;
-
-        return output;
-    }
-
+    // The cached account now holds the allocation. The pool thread saves it
+    // along with any other allocations made before the next flush. The
+    // index is already below the saved reservation mark, so a crash before
+    // then can not cause it to be allocated again.
+    mapLock.lock();
+    dirty_.emplace(accountID);
+    mapLock.unlock();
     output.reset(new proto::Bip44Address(newAddress));
 
     return output;
@@ -263,7 +291,6 @@ bool Blockchain::AssignAddress(
         return false;
     }
 
-    const auto& type = account->type();
     const auto allocatedIndex =
         chain ? account->internalindex() : account->externalindex();
 
@@ -284,7 +311,7 @@ bool Blockchain::AssignAddress(
     address.set_contact(sContactID);
     account->set_revision(account->revision() + 1);
 
-    return storage_.Store(sNymID, type, *account);
+    return save_account(accountLock, sNymID, *account);
 }
 
 Bip44Type Blockchain::bip44_type(const proto::ContactItemType type) const
@@ -445,6 +472,35 @@ proto::Bip44Address& Blockchain::find_address(
     OT_FAIL;
 }
 
+void Blockchain::flush() const
+{
+    Lock mapLock(lock_);
+    const auto dirty = dirty_;
+    dirty_.clear();
+    mapLock.unlock();
+
+    for (const auto& accountID : dirty) {
+        mapLock.lock();
+        auto& accountMutex = account_lock_[accountID];
+        mapLock.unlock();
+        Lock accountLock(accountMutex);
+        mapLock.lock();
+        const auto cached = accounts_.at(accountID);
+        mapLock.unlock();
+        const auto& [nymID, account] = cached;
+
+        OT_ASSERT(account);
+
+        if (false == storage_.Store(nymID, account->type(), *account)) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to save account "
+                  << accountID.str() << "." << std::endl;
+            mapLock.lock();
+            dirty_.emplace(accountID);
+            mapLock.unlock();
+        }
+    }
+}
+
 void Blockchain::init_path(
     const std::string& root,
     const proto::ContactItemType chain,
@@ -476,13 +532,52 @@ void Blockchain::init_path(
 }
 
 std::shared_ptr<proto::Bip44Account> Blockchain::load_account(
-    const Lock&,
+    const Lock& lock,
     const std::string& nymID,
     const std::string& accountID) const
 {
+    const Identifier id(accountID);
+    Lock mapLock(lock_);
+    const auto it = accounts_.find(id);
+
+    if (accounts_.end() != it) {
+        const auto& [owner, cached] = it->second;
+
+        if (owner != nymID) {
+
+            return {};
+        }
+
+        return cached;
+    }
+
+    mapLock.unlock();
     std::shared_ptr<proto::Bip44Account> account{nullptr};
     storage_.Load(nymID, accountID, account);
 
+    if (false == bool(account)) {
+
+        return account;
+    }
+
+    const auto revision = account->revision();
+    resume(lock, id, INTERNAL_CHAIN, *account);
+    resume(lock, id, EXTERNAL_CHAIN, *account);
+
+    if ((revision != account->revision()) &&
+        (false == storage_.Store(nymID, account->type(), *account))) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to save account "
+              << accountID << "." << std::endl;
+        mapLock.lock();
+        dirty_.emplace(id);
+        mapLock.unlock();
+    }
+
+    register_pool(id, *account, INTERNAL_CHAIN);
+    register_pool(id, *account, EXTERNAL_CHAIN);
+    mapLock.lock();
+    accounts_.emplace(id, CachedAccount{nymID, account});
+
     return account;
 }
 
@@ -612,6 +707,266 @@ Identifier Blockchain::NewAccount(
     return {};
 }
 
+std::string Blockchain::pooled_address(
+    const Identifier& accountID,
+    const proto::Bip44Account& account,
+    const BIP44Chain chain,
+    const std::uint32_t index) const
+{
+    std::string output{};
+    Lock poolLock(pool_lock_);
+    auto it = pools_.find(PoolKey{accountID, chain});
+
+    if (pools_.end() != it) {
+        auto& pool = it->second;
+        auto& addresses = pool.addresses_;
+
+        while ((false == addresses.empty()) &&
+               (addresses.front().first < index)) {
+            addresses.pop_front();
+        }
+
+        if ((false == addresses.empty()) &&
+            (addresses.front().first == index)) {
+            output = addresses.front().second;
+            addresses.pop_front();
+        }
+
+        pool.allocated_ = std::max(pool.allocated_, index + 1);
+        pool.next_ = std::max(pool.next_, pool.allocated_);
+    }
+
+    poolLock.unlock();
+
+    if (output.empty()) {
+        otWarn << OT_METHOD << __FUNCTION__ << ": Address pool is empty."
+               << std::endl;
+
+        return calculate_address(account, chain, index);
+    }
+
+    return output;
+}
+
+void Blockchain::refill_pools() const
+{
+    typedef std::tuple<PoolKey, proto::Bip44Account, std::uint32_t> Job;
+
+    auto lastFlush = std::chrono::steady_clock::now();
+
+    while (running_.get()) {
+        const auto now = std::chrono::steady_clock::now();
+        const auto interval =
+            std::chrono::milliseconds(BLOCKCHAIN_FLUSH_MILLISECONDS);
+
+        if ((now - lastFlush) > interval) {
+            flush();
+            lastFlush = now;
+        }
+
+        // Reserve one index per chain which is short of the gap, then derive
+        // the keys without holding the pool lock so that allocations are
+        // never blocked by key derivation.
+        std::vector<Job> jobs{};
+        Lock poolLock(pool_lock_);
+
+        for (auto& [key, pool] : pools_) {
+            const bool full = (gap_ <= pool.addresses_.size());
+
+            if ((false == full) && (MAX_INDEX > pool.next_)) {
+                jobs.emplace_back(key, pool.account_, pool.next_++);
+            }
+        }
+
+        poolLock.unlock();
+        bool idle{jobs.empty()};
+
+        for (const auto& [key, account, index] : jobs) {
+            if (false == running_.get()) {
+
+                break;
+            }
+
+            const auto address = calculate_address(account, key.second, index);
+            poolLock.lock();
+            auto& pool = pools_.at(key);
+
+            if (address.empty()) {
+                // Retry on the next pass instead of leaving a hole
+                if (pool.next_ == (index + 1)) {
+                    pool.next_ = index;
+                }
+
+                idle = true;
+            } else if (index >= pool.allocated_) {
+                pool.addresses_.emplace_back(index, address);
+            }
+
+            poolLock.unlock();
+        }
+
+        if (idle) {
+            Log::Sleep(
+                std::chrono::milliseconds(BLOCKCHAIN_POOL_SLEEP_MILLISECONDS));
+        }
+    }
+}
+
+void Blockchain::register_pool(
+    const Identifier& accountID,
+    const proto::Bip44Account& account,
+    const BIP44Chain chain) const
+{
+    if (0 == gap_) {
+
+        return;
+    }
+
+    const PoolKey key{accountID, chain};
+    Lock poolLock(pool_lock_);
+
+    if (0 < pools_.count(key)) {
+
+        return;
+    }
+
+    auto& pool = pools_[key];
+    pool.account_.set_type(account.type());
+    *pool.account_.mutable_path() = account.path();
+    pool.allocated_ =
+        chain ? account.internalindex() : account.externalindex();
+    pool.next_ = pool.allocated_;
+}
+
+bool Blockchain::reserve(
+    const Lock& lock,
+    const Identifier& accountID,
+    const BIP44Chain chain,
+    const std::uint32_t index) const
+{
+    OT_ASSERT(lock.owns_lock())
+
+    const PoolKey key{accountID, chain};
+    Lock mapLock(lock_);
+    const auto reserved = reserved_[key];
+    mapLock.unlock();
+
+    if (index < reserved) {
+
+        return true;
+    }
+
+    // Saving a mark ahead of the allocated index lets allocations be saved
+    // in batches. After a crash, resume() skips everything below the mark.
+    const auto mark = static_cast<std::uint32_t>(std::min<std::uint64_t>(
+        std::uint64_t(index) + BLOCKCHAIN_RESERVED_ADDRESSES, MAX_INDEX));
+    bool notUsed{false};
+    const bool saved = config_.Set_long(
+                           BLOCKCHAIN_RESERVED_SECTION,
+                           String(reserved_key(accountID, chain)),
+                           mark,
+                           notUsed) &&
+                       config_.Save();
+
+    if (false == saved) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to save reservation mark." << std::endl;
+
+        return false;
+    }
+
+    mapLock.lock();
+    reserved_[key] = mark;
+
+    return true;
+}
+
+std::string Blockchain::reserved_key(
+    const Identifier& accountID,
+    const BIP44Chain chain)
+{
+    return accountID.str() + (chain ? "_internal" : "_external");
+}
+
+void Blockchain::resume(
+    const Lock& lock,
+    const Identifier& accountID,
+    const BIP44Chain chain,
+    proto::Bip44Account& account) const
+{
+    OT_ASSERT(lock.owns_lock())
+
+    std::int64_t mark{0};
+    bool exists{false};
+    config_.Check_long(
+        BLOCKCHAIN_RESERVED_SECTION,
+        String(reserved_key(accountID, chain)),
+        mark,
+        exists);
+    const std::int64_t index =
+        chain ? account.internalindex() : account.externalindex();
+
+    if ((false == exists) || (mark <= index) || (MAX_INDEX < mark)) {
+
+        return;
+    }
+
+    // The previous session did not shut down cleanly, so every index below
+    // the mark may have been handed out without being saved. Record them as
+    // allocated so they are never handed out again.
+    otErr << OT_METHOD << __FUNCTION__ << ": Skipping indices " << index
+          << " to " << (mark - 1) << " of account " << accountID.str()
+          << std::endl;
+
+    for (auto i = index; i < mark; ++i) {
+        const auto position = static_cast<std::uint32_t>(i);
+        auto& address = add_address(position, account, chain);
+        address.set_version(BLOCKCHAIN_VERSION);
+        address.set_index(position);
+        address.set_address(calculate_address(account, chain, position));
+    }
+}
+
+bool Blockchain::save_account(
+    const Lock&,
+    const std::string& nymID,
+    const proto::Bip44Account& account) const
+{
+    const bool saved = storage_.Store(nymID, account.type(), account);
+
+    if (saved) {
+        Lock mapLock(lock_);
+        dirty_.erase(Identifier(account.id()));
+    }
+
+    return saved;
+}
+
+void Blockchain::save_reserved(
+    const std::map<PoolKey, std::uint32_t>& marks) const
+{
+    if (marks.empty()) {
+
+        return;
+    }
+
+    bool notUsed{false};
+
+    for (const auto& [key, mark] : marks) {
+        const auto& [accountID, chain] = key;
+        config_.Set_long(
+            BLOCKCHAIN_RESERVED_SECTION,
+            String(reserved_key(accountID, chain)),
+            mark,
+            notUsed);
+    }
+
+    if (false == config_.Save()) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to save reservation marks." << std::endl;
+    }
+}
+
 bool Blockchain::StoreIncoming(
     const Identifier& nymID,
     const Identifier& accountID,
@@ -656,7 +1011,7 @@ bool Blockchain::StoreIncoming(
         address.add_incoming(transaction.txid());
     }
 
-    auto saved = storage_.Store(sNymID, account->type(), *account);
+    auto saved = save_account(accountLock, sNymID, *account);
 
     if (false == saved) {
         otErr << OT_METHOD << __FUNCTION__ << ": Failed to save account."
@@ -706,7 +1061,7 @@ bool Blockchain::StoreOutgoing(
 
     const auto& txid = transaction.txid();
     account->add_outgoing(txid);
-    auto saved = storage_.Store(sNymID, account->type(), *account);
+    auto saved = save_account(accountLock, sNymID, *account);
 
     if (false == saved) {
         otErr << OT_METHOD << __FUNCTION__ << ": Failed to save account."
@@ -748,4 +1103,41 @@ std::shared_ptr<proto::BlockchainTransaction> Blockchain::Transaction(
 
     return output;
 }
+
+Blockchain::~Blockchain()
+{
+    running_->Off();
+
+    if (pool_thread_) {
+        pool_thread_->join();
+        pool_thread_.reset();
+    }
+
+    flush();
+
+    // Every allocation of a saved account is now in storage, so its marks
+    // can be lowered to the allocated index and the next session does not
+    // skip anything
+    Lock mapLock(lock_);
+    std::map<PoolKey, std::uint32_t> marks{};
+
+    for (const auto& [key, mark] : reserved_) {
+        const auto& [accountID, chain] = key;
+
+        if ((0 < dirty_.count(accountID)) || (0 == mark)) {
+
+            continue;
+        }
+
+        const auto& account = accounts_.at(accountID).second;
+
+        OT_ASSERT(account);
+
+        marks[key] =
+            chain ? account->internalindex() : account->externalindex();
+    }
+
+    mapLock.unlock();
+    save_reserved(marks);
+}
 }  // namespace opentxs::api
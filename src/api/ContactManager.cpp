@@ -82,10 +82,10 @@ ContactManager::ContactMap::iterator ContactManager::add_contact(
     }
 
     const auto& id = contact->ID();
-    auto& it = contact_map_[id];
+    auto& it = contact_map_[FixedIdentifier(id)];
     it.second.reset(contact);
 
-    return contact_map_.find(id);
+    return contact_map_.find(FixedIdentifier(id));
 }
 
 Identifier ContactManager::address_to_contact(
@@ -117,7 +117,7 @@ ContactManager::ContactNameMap ContactManager::build_name_map(
     ContactNameMap output{};
 
     for (const auto & [ id, alias ] : storage.ContactList()) {
-        output.emplace(id, alias);
+        output.emplace(FixedIdentifier(id), alias);
     }
 
     return output;
@@ -180,7 +180,7 @@ std::shared_ptr<const class Contact> ContactManager::contact(
 
     const auto& contactID = contact->ID();
 
-    OT_ASSERT(0 == contact_map_.count(contactID));
+    OT_ASSERT(0 == contact_map_.count(FixedIdentifier(contactID)));
 
     auto it = add_contact(lock, contact.release());
     auto& output = it->second.second;
@@ -217,7 +217,7 @@ ObjectList ContactManager::ContactList() const
 std::string ContactManager::ContactName(const Identifier& contactID) const
 {
     rLock lock(lock_);
-    auto it = contact_name_map_.find(contactID);
+    auto it = contact_name_map_.find(FixedIdentifier(contactID));
 
     if (contact_name_map_.end() == it) {
 
@@ -393,7 +393,7 @@ std::shared_ptr<const class Contact> ContactManager::Merge(
         OT_FAIL;
     }
 
-    contact_map_.erase(child);
+    contact_map_.erase(FixedIdentifier(child));
 
     return parentContact;
 }
@@ -408,7 +408,7 @@ std::unique_ptr<Editor<class Contact>> ContactManager::mutable_contact(
 
     std::unique_ptr<Editor<class Contact>> output{nullptr};
 
-    auto it = contact_map_.find(id);
+    auto it = contact_map_.find(FixedIdentifier(id));
 
     if (contact_map_.end() == it) {
         it = load_contact(lock, id);
@@ -537,7 +537,7 @@ std::shared_ptr<const class Contact> ContactManager::NewContactFromAddress(
     OT_ASSERT(newContact);
 
     const auto newContactID = newContact->ID();
-    auto& it = contact_map_.at(newContactID);
+    auto& it = contact_map_.at(FixedIdentifier(newContactID));
     auto& contact = *it.second;
 
     if (false == contact.AddBlockchainAddress(address, currency)) {
@@ -565,7 +565,7 @@ ContactManager::ContactMap::iterator ContactManager::obtain_contact(
         throw std::runtime_error("lock error");
     }
 
-    auto it = contact_map_.find(id);
+    auto it = contact_map_.find(FixedIdentifier(id));
 
     if (contact_map_.end() != it) {
 
@@ -589,7 +589,7 @@ void ContactManager::refresh_indices(const rLock& lock, class Contact& contact)
     }
 
     const auto& id = contact.ID();
-    contact_name_map_[id] = contact.Label();
+    contact_name_map_[FixedIdentifier(id)] = contact.Label();
     const std::string rawID{id.str()};
     publisher_->Publish(rawID);
 }
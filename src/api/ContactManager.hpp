@@ -42,10 +42,12 @@
 #include "opentxs/Internal.hpp"
 
 #include "opentxs/api/ContactManager.hpp"
+#include "opentxs/core/FixedIdentifier.hpp"
 
 #include <map>
 #include <mutex>
 #include <tuple>
+#include <unordered_map>
 
 namespace opentxs::api::implementation
 {
@@ -87,8 +89,8 @@ private:
 
     using ContactLock = std::pair<std::mutex, std::shared_ptr<class Contact>>;
     using Address = std::pair<proto::ContactItemType, std::string>;
-    using ContactMap = std::map<Identifier, ContactLock>;
-    using ContactNameMap = std::map<Identifier, std::string>;
+    using ContactMap = std::unordered_map<FixedIdentifier, ContactLock>;
+    using ContactNameMap = std::unordered_map<FixedIdentifier, std::string>;
 
     const api::storage::Storage& storage_;
     const api::client::Wallet& wallet_;
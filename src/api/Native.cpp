@@ -86,16 +86,24 @@
 #include "network/DhtConfig.hpp"
 #include "network/OpenDHT.hpp"
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <ctime>
+#include <future>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
+#define BLOCKCHAIN_ADDRESS_GAP 20
 #define CLIENT_CONFIG_KEY "client"
 #define SERVER_CONFIG_KEY "server"
 #define STORAGE_CONFIG_KEY "storage"
+#define WALLET_CACHE_MEGABYTES 256
+#define WALLET_CACHE_TRIM_SECONDS 30
 
 #define OT_METHOD "opentxs::api::implementation::Native::"
 
@@ -298,26 +306,45 @@ const api::Identity& Native::Identity() const
 
 void Native::Init()
 {
-    Init_Config();
-    Init_Log();  // requires Init_Config()
-    Init_Crypto();
-    Init_Storage();  // requires Init_Config(), Init_Crypto()
-    Init_ZMQ();      // requires Init_Config()
-    Init_Contracts();
-    Init_Dht();         // requires Init_Config()
-    Init_Identity();    // requires Init_Contracts()
-    Init_Contacts();    // requires Init_Contracts(), Init_Storage(), Init_ZMQ()
-    Init_Activity();    // requires Init_Storage(), Init_Contacts(),
-                        // Init_Contracts()
-    Init_Blockchain();  // requires Init_Storage(), Init_Crypto(),
-                        // Init_Contracts(), Init_Activity()
-    Init_Api();  // requires Init_Config(), Init_Crypto(), Init_Contracts(),
-                 // Init_Identity(), Init_Storage(), Init_ZMQ(), Init_Contacts()
-                 // Init_Activity()
+    // Each stage starts as soon as the stages it names have finished. Every
+    // stage waits for the log so nothing is written before it is configured.
+    std::vector<InitStage> stages{
+        {"config", {}, [this]() { Init_Config(); }},
+        {"log", {"config"}, [this]() { Init_Log(); }},
+        {"crypto", {"log"}, [this]() { Init_Crypto(); }},
+        {"storage", {"config", "crypto"}, [this]() { Init_Storage(); }},
+        {"zmq", {"log"}, [this]() { Init_ZMQ(); }},
+        {"contracts", {"log"}, [this]() { Init_Contracts(); }},
+        {"dht", {"config", "contracts"}, [this]() { Init_Dht(); }},
+        {"identity", {"contracts"}, [this]() { Init_Identity(); }},
+        {"contacts",
+         {"contracts", "storage", "zmq"},
+         [this]() { Init_Contacts(); }},
+        {"activity",
+         {"storage", "contacts", "contracts"},
+         [this]() { Init_Activity(); }},
+        {"blockchain",
+         {"config", "storage", "crypto", "contracts", "activity"},
+         [this]() { Init_Blockchain(); }},
+        {"api",
+         {"config",
+          "crypto",
+          "contracts",
+          "identity",
+          "storage",
+          "zmq",
+          "contacts",
+          "activity"},
+         [this]() { Init_Api(); }},
+    };
+
     if (!server_mode_) {
-        Init_UI();  // requires Init_Activity(), Init_Contacts(), Init_Api()
+        stages.push_back(
+            {"ui", {"activity", "contacts", "api"}, [this]() { Init_UI(); }});
     }
 
+    run_stages("init", stages);
+
     if (recover_) {
         recover();
     }
@@ -375,8 +402,27 @@ void Native::Init_Blockchain()
     OT_ASSERT(storage_);
     OT_ASSERT(wallet_)
 
-    blockchain_.reset(
-        new api::Blockchain(*activity_, *crypto_, *storage_, *wallet_));
+    std::int64_t gap{0};
+    bool notUsed{false};
+    Config().CheckSet_long(
+        "blockchain",
+        "address_gap",
+        BLOCKCHAIN_ADDRESS_GAP,
+        gap,
+        notUsed,
+        "Number of unallocated addresses to derive ahead of each chain");
+
+    if (0 > gap) {
+        gap = 0;
+    }
+
+    blockchain_.reset(new api::Blockchain(
+        *activity_,
+        *crypto_,
+        Config(),
+        *storage_,
+        *wallet_,
+        static_cast<std::uint32_t>(gap)));
 }
 
 void Native::Init_Config()
@@ -496,6 +542,25 @@ void Native::Init_Identity()
     identity_.reset(new api::Identity(*wallet_));
 }
 
+void Native::Init_LegacyWallet()
+{
+    OT_ASSERT(api_);
+
+    const bool loaded = api_->OTAPI().LoadWallet();
+
+    OT_ASSERT(loaded);
+
+    auto wallet = api_->OTAPI().GetWallet(nullptr);
+
+    OT_ASSERT(nullptr != wallet);
+
+    if (false == encrypted_directory_.empty()) {
+        set_storage_encryption();
+    }
+
+    wallet->SaveWallet();
+}
+
 void Native::Init_Log()
 {
     std::string type{};
@@ -584,6 +649,34 @@ void Native::Init_Periodic()
         },
         (now - std::chrono::seconds(unit_refresh_interval_) / 2));
 
+    auto wallet =
+        dynamic_cast<api::client::implementation::Wallet*>(wallet_.get());
+
+    OT_ASSERT(nullptr != wallet);
+
+    std::int64_t megabytes{0};
+    std::int64_t interval{0};
+    bool notUsed{false};
+    Config().CheckSet_long(
+        "wallet",
+        "cache_megabytes",
+        WALLET_CACHE_MEGABYTES,
+        megabytes,
+        notUsed,
+        "Estimated size of unused nyms, contracts and contexts kept in memory");
+    Config().CheckSet_long(
+        "wallet",
+        "cache_trim_interval",
+        WALLET_CACHE_TRIM_SECONDS,
+        interval,
+        notUsed);
+    const std::size_t budget = std::max<std::int64_t>(megabytes, 0) << 20;
+
+    Schedule(
+        std::chrono::seconds(std::max<std::int64_t>(interval, 1)),
+        [wallet, budget]() -> void { wallet->Trim(budget); },
+        now);
+
     periodic_.reset(new std::thread(&Native::Periodic, this));
 }
 
@@ -780,16 +873,6 @@ void Native::Init_Storage()
         config.gc_interval_ = configGcInterval;
     }
 
-    if (dht_) {
-        config.dht_callback_ = std::bind(
-            static_cast<void (api::network::Dht::*)(
-                const std::string&, const std::string&) const>(
-                &api::network::Dht::Insert),
-            dht_.get(),
-            std::placeholders::_1,
-            std::placeholders::_2);
-    }
-
     OT_ASSERT(crypto_);
 
     storage_.reset(new api::storage::implementation::Storage(
@@ -894,6 +977,61 @@ void Native::recover()
     }
 }
 
+void Native::run_stages(
+    const std::string& phase,
+    const std::vector<InitStage>& stages)
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::map<std::string, std::shared_future<void>> running{};
+    // Written by each stage's own task, read after all of them finish
+    std::vector<std::chrono::microseconds> elapsed(stages.size());
+
+    for (std::size_t i = 0; i < stages.size(); ++i) {
+        const auto& [name, after, task] = stages.at(i);
+        std::vector<std::shared_future<void>> dependencies{};
+
+        for (const auto& dependency : after) {
+            auto it = running.find(dependency);
+
+            // Stages must be listed after the stages they depend on
+            OT_ASSERT(running.end() != it);
+
+            dependencies.emplace_back(it->second);
+        }
+
+        auto& time = elapsed.at(i);
+        const auto& run = task;
+        running.emplace(
+            name,
+            std::async(std::launch::async, [dependencies, &time, &run]() {
+                for (const auto& dependency : dependencies) {
+                    dependency.get();
+                }
+
+                const auto begin = std::chrono::steady_clock::now();
+                run();
+                time = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - begin);
+            }).share());
+    }
+
+    for (auto& it : running) {
+        it.second.get();
+    }
+
+    for (std::size_t i = 0; i < stages.size(); ++i) {
+        otWarn << OT_METHOD << __FUNCTION__ << ": " << phase << " stage "
+               << std::get<0>(stages.at(i)) << " took "
+               << elapsed.at(i).count() / 1000 << " ms" << std::endl;
+    }
+
+    otWarn << OT_METHOD << __FUNCTION__ << ": " << phase << " finished in "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - start)
+                  .count()
+           << " ms" << std::endl;
+}
+
 void Native::Schedule(
     const std::chrono::seconds& interval,
     const PeriodicTask& task,
@@ -991,32 +1129,32 @@ void Native::start()
     auto& activity = dynamic_cast<api::implementation::Activity&>(*activity_);
 
     OT_ASSERT(contacts_);
+    OT_ASSERT(storage_);
 
-    if (false == server_mode_) {
-        OT_ASSERT(api_);
-
-        const bool loaded = api_->OTAPI().LoadWallet();
-
-        OT_ASSERT(loaded);
-
-        auto wallet = api_->OTAPI().GetWallet(nullptr);
-
-        OT_ASSERT(nullptr != wallet);
-
-        if (false == encrypted_directory_.empty()) {
-            set_storage_encryption();
-        }
+    // Stages which write to storage must wait until the backup plugins have
+    // been added, since adding them is not synchronized with concurrent
+    // writes. Beyond that the nym upgrade is independent of the contact
+    // import, so it runs alongside the import and the thread migration.
+    // The thread migration needs the imported contacts.
+    std::vector<InitStage> stages{};
 
-        wallet->SaveWallet();
+    if (false == server_mode_) {
+        stages.push_back({"wallet", {}, [this]() { Init_LegacyWallet(); }});
+        stages.push_back(
+            {"backup", {"wallet"}, [this]() { Init_StorageBackup(); }});
+    } else {
+        stages.push_back({"backup", {}, [this]() { Init_StorageBackup(); }});
     }
 
-    Init_StorageBackup();
-
-    OT_ASSERT(storage_);
-
-    storage_->UpgradeNyms();
-    dynamic_cast<ContactManager&>(*contacts_).start();
-    activity.MigrateLegacyThreads();
+    stages.push_back(
+        {"upgrade", {"backup"}, [this]() { storage_->UpgradeNyms(); }});
+    stages.push_back({"contacts", {"backup"}, [this]() {
+                          dynamic_cast<ContactManager&>(*contacts_).start();
+                      }});
+    stages.push_back({"threads", {"contacts"}, [&activity]() {
+                          activity.MigrateLegacyThreads();
+                      }});
+    run_stages("start", stages);
     Init_Periodic();
 
     if (server_mode_) {
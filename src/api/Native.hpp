@@ -49,6 +49,7 @@
 
 #include <atomic>
 #include <cstdint>
+#include <functional>
 #include <limits>
 #include <list>
 #include <map>
@@ -57,6 +58,7 @@
 #include <string>
 #include <thread>
 #include <tuple>
+#include <vector>
 
 namespace opentxs::api::implementation
 {
@@ -97,6 +99,10 @@ private:
     typedef std::tuple<time64_t, time64_t, PeriodicTask> TaskItem;
     typedef std::list<TaskItem> TaskList;
     typedef std::map<std::string, std::unique_ptr<api::Settings>> ConfigMap;
+    /** Name, names of the stages which must finish first, Task */
+    typedef std::
+        tuple<std::string, std::vector<std::string>, std::function<void()>>
+            InitStage;
 
     Flag& running_;
     const bool recover_{false};
@@ -162,6 +168,7 @@ private:
     void Init_Crypto();
     void Init_Dht();
     void Init_Identity();
+    void Init_LegacyWallet();
     void Init_Log();
     void Init_Periodic();
     void Init_Server();
@@ -172,6 +179,9 @@ private:
     void Init();
     void Periodic();
     void recover();
+    static void run_stages(
+        const std::string& phase,
+        const std::vector<InitStage>& stages);
     void set_storage_encryption();
     void shutdown();
     void start();
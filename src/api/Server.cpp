@@ -45,10 +45,13 @@
 #include <opentxs/core/util/OTDataFolder.hpp>
 #include <opentxs/core/util/OTFolders.hpp>
 #include <opentxs/core/util/OTPaths.hpp>
+#include "opentxs/core/crypto/OTASCIIArmor.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Log.hpp"
 #include <opentxs/core/OTStorage.hpp>
 #include "opentxs/core/String.hpp"
+#include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/PublishSocket.hpp"
 #include "opentxs/server/MessageProcessor.hpp"
 #include "opentxs/server/Server.hpp"
 #include "opentxs/server/ServerSettings.hpp"
@@ -65,6 +68,7 @@
 #define MINT_EXPIRE_MONTHS 6
 #define MINT_VALID_MONTHS 12
 #define MINT_GENERATE_DAYS 7
+#define MINT_SCAN_HOURS 1
 #endif  // OT_CASH
 
 #define OT_METHOD "opentxs::api::implementation::Server::"
@@ -91,12 +95,14 @@ Server::Server(
     , message_processor_p_(
           new server::MessageProcessor(server_, context, running_))
     , message_processor_(*message_processor_p_)
+    , box_publisher_(context.PublishSocket())
 #if OT_CASH
     , mint_thread_(nullptr)
     , mint_lock_()
     , mint_update_lock_()
     , mint_scan_lock_()
     , mints_()
+    , public_mint_payloads_()
     , mints_to_check_()
 #endif  // OT_CASH
 {
@@ -108,6 +114,8 @@ Server::Server(
 #endif  // OT_CASH
 }
 
+bool Server::BatchingBoxes() const { return server_.cache_.Batching(); }
+
 void Server::Cleanup()
 {
     otErr << OT_METHOD << __FUNCTION__ << ": Shutting down and cleaning up."
@@ -116,6 +124,15 @@ void Server::Cleanup()
     message_processor_.cleanup();
 }
 
+void Server::DeferBoxSignature(
+    const std::string& folder,
+    const std::string& one,
+    const std::string& two,
+    const std::function<bool()>& sign) const
+{
+    server_.cache_.Defer(folder, one, two, sign);
+}
+
 #if OT_CASH
 void Server::generate_mint(
     const std::string& serverID,
@@ -174,12 +191,9 @@ void Server::generate_mint(
         10000,
         100000);
 
+    // Key generation above runs without the mint lock. Only the save and the
+    // swap of the cached public mint block requests for this unit.
     Lock mintLock(mint_lock_);
-
-    if (mints_.end() != mints_.find(unitID)) {
-        mints_.at(unitID).erase(PUBLIC_SERIES);
-    }
-
     mint->SetSavePrivateKeys();
     mint->SignContract(nym);
     mint->SaveContract();
@@ -189,6 +203,16 @@ void Server::generate_mint(
     mint->SignContract(nym);
     mint->SaveContract();
     mint->SaveMint(PUBLIC_SERIES);
+    auto& seriesMap = mints_[unitID];
+    seriesMap[seriesID] = mint;
+    seriesMap.erase(PUBLIC_SERIES);
+    public_mint_payloads_.erase(unitID);
+
+    if (false == bool(load_public_mint(mintLock, unitID, PUBLIC_SERIES))) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to load new public mint for " << unitID
+              << std::endl;
+    }
 }
 
 const std::string Server::get_arg(const std::string& argName) const
@@ -235,6 +259,33 @@ const std::string Server::GetOnion() const
     return get_arg(OPENTXS_ARG_ONION);
 }
 
+#if OT_CASH
+std::shared_ptr<const Mint> Server::get_public_mint(
+    const Lock& lock,
+    const std::string& unitID) const
+{
+    OT_ASSERT(verify_lock(lock, mint_lock_));
+
+    const std::string seriesID{PUBLIC_SERIES};
+    auto currency = mints_.find(unitID);
+
+    if (mints_.end() == currency) {
+
+        return load_public_mint(lock, unitID, seriesID);
+    }
+
+    auto& seriesMap = currency->second;
+    auto series = seriesMap.find(seriesID);
+
+    if (seriesMap.end() == series) {
+
+        return load_public_mint(lock, unitID, seriesID);
+    }
+
+    return series->second;
+}
+#endif  // OT_CASH
+
 std::shared_ptr<Mint> Server::GetPrivateMint(
     const Identifier& unitID,
     std::uint32_t index) const
@@ -251,8 +302,6 @@ std::shared_ptr<Mint> Server::GetPrivateMint(
     }
 
     auto& seriesMap = currency->second;
-    // Modifying the private version may invalid the public version
-    seriesMap.erase(PUBLIC_SERIES);
     auto series = seriesMap.find(seriesID);
 
     if (seriesMap.end() == series) {
@@ -267,24 +316,35 @@ std::shared_ptr<const Mint> Server::GetPublicMint(
     const Identifier& unitID) const
 {
     Lock lock(mint_lock_);
+
+    return get_public_mint(lock, unitID.str());
+}
+
+std::shared_ptr<const OTASCIIArmor> Server::GetPublicMintPayload(
+    const Identifier& unitID) const
+{
+    Lock lock(mint_lock_);
     const std::string id{unitID.str()};
-    const std::string seriesID{PUBLIC_SERIES};
-    auto currency = mints_.find(id);
+    auto it = public_mint_payloads_.find(id);
 
-    if (mints_.end() == currency) {
+    if (public_mint_payloads_.end() != it) {
 
-        return load_public_mint(lock, id, seriesID);
+        return it->second;
     }
 
-    auto& seriesMap = currency->second;
-    auto series = seriesMap.find(seriesID);
+    if (false == bool(get_public_mint(lock, id))) {
 
-    if (seriesMap.end() == series) {
+        return {};
+    }
 
-        return load_public_mint(lock, id, seriesID);
+    it = public_mint_payloads_.find(id);
+
+    if (public_mint_payloads_.end() == it) {
+
+        return {};
     }
 
-    return series->second;
+    return it->second;
 }
 #endif  // OT_CASH
 
@@ -356,6 +416,7 @@ std::shared_ptr<Mint> Server::load_public_mint(
 void Server::mint() const
 {
     Lock updateLock(mint_update_lock_, std::defer_lock);
+    auto lastScan = std::chrono::steady_clock::now();
 
     while (server_.GetServerID().empty()) {
         Log::Sleep(std::chrono::milliseconds(50));
@@ -373,6 +434,16 @@ void Server::mint() const
             continue;
         }
 
+        // Rescan periodically so that the next series of every unit is
+        // generated before the current one expires, even if no request for
+        // that unit arrives in the meantime.
+        const auto scanNow = std::chrono::steady_clock::now();
+
+        if ((scanNow - lastScan) > std::chrono::hours(MINT_SCAN_HOURS)) {
+            lastScan = scanNow;
+            ScanMints();
+        }
+
         std::string unitID{""};
         updateLock.lock();
 
@@ -424,6 +495,35 @@ void Server::mint() const
 
 const Identifier& Server::NymID() const { return server_.GetServerNym().ID(); }
 
+void Server::PublishBoxChange(
+    const Identifier& nymID,
+    const std::string& box,
+    const Identifier& hash) const
+{
+    const auto topic = server_.NotificationTopic(nymID);
+
+    if (topic.empty()) {
+
+        return;
+    }
+
+    const std::string notice = topic + " " + box + " " + hash.str();
+
+    if (false == box_publisher_->Publish(notice)) {
+        otInfo << OT_METHOD << __FUNCTION__
+               << ": Failed to publish box change notice." << std::endl;
+    }
+}
+
+std::string Server::QueryFile(
+    const std::string& folder,
+    const std::string& one,
+    const std::string& two,
+    const std::string& three) const
+{
+    return server_.cache_.Query(folder, one, two, three);
+}
+
 #if OT_CASH
 void Server::ScanMints() const
 {
@@ -440,10 +540,17 @@ void Server::ScanMints() const
 }
 #endif  // OT_CASH
 
+void Server::SetVerifiedFile(
+    const std::string& folder,
+    const std::string& one,
+    const std::string& two) const
+{
+    server_.cache_.SetVerified(folder, one, two);
+}
+
 void Server::Start()
 {
     server_.Init();
-    server_.ActivateCron();
     std::string hostname{};
     std::uint32_t port{0};
     const auto connectInfo = server_.GetConnectInfo(hostname, port);
@@ -455,13 +562,39 @@ void Server::Start()
 
     OT_ASSERT(privateKey);
 
+    const auto bindStart = std::chrono::steady_clock::now();
     message_processor_.init(port, *privateKey);
     message_processor_.Start();
+    server_.startup_phase("bind", bindStart);
+    // Requests which need cron get a retryable reply until it has loaded
+    server_.ActivateCron();
+    std::uint32_t notifyPort{0};
+    server_.GetNotifyInfo(notifyPort);
+    const auto endpoint = std::string("tcp://*:") + std::to_string(notifyPort);
+    box_publisher_->SetCurve(*privateKey);
+    const auto bound = box_publisher_->Start(endpoint);
+
+    if (false == bound) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to bind box notification socket to " << endpoint
+              << std::endl;
+    }
+
 #if OT_CASH
     ScanMints();
 #endif  // OT_CASH
 }
 
+bool Server::StoreFile(
+    const std::string& contents,
+    const std::string& folder,
+    const std::string& one,
+    const std::string& two,
+    const std::string& three) const
+{
+    return server_.cache_.Store(contents, folder, one, two, three);
+}
+
 #if OT_CASH
 void Server::UpdateMint(const Identifier& unitID) const
 {
@@ -517,6 +650,11 @@ std::shared_ptr<Mint> Server::verify_mint(
 
     OT_ASSERT(true == bool(output));
 
+    if (PUBLIC_SERIES == seriesID) {
+        public_mint_payloads_[unitID] =
+            std::make_shared<const OTASCIIArmor>(String(*mint));
+    }
+
     return output;
 }
 
@@ -537,6 +675,14 @@ bool Server::verify_mint_directory(const std::string& serverID) const
 }
 #endif  // OT_CASH
 
+bool Server::VerifiedFile(
+    const std::string& folder,
+    const std::string& one,
+    const std::string& two) const
+{
+    return server_.cache_.Verified(folder, one, two);
+}
+
 Server::~Server()
 {
 #if OT_CASH
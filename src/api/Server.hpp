@@ -57,6 +57,12 @@ namespace opentxs::api::implementation
 class Server : virtual public opentxs::api::Server
 {
 public:
+    bool BatchingBoxes() const override;
+    void DeferBoxSignature(
+        const std::string& folder,
+        const std::string& one,
+        const std::string& two,
+        const std::function<bool()>& sign) const override;
     const std::string GetCommandPort() const override;
     const std::string GetDefaultBindIP() const override;
     const std::string GetEEP() const override;
@@ -70,15 +76,40 @@ public:
         std::uint32_t series) const override;
     std::shared_ptr<const Mint> GetPublicMint(
         const Identifier& unitID) const override;
+    std::shared_ptr<const OTASCIIArmor> GetPublicMintPayload(
+        const Identifier& unitID) const override;
 #endif  // OT_CASH
     const std::string GetUserName() const override;
     const std::string GetUserTerms() const override;
     const Identifier& ID() const override;
     const Identifier& NymID() const override;
+    void PublishBoxChange(
+        const Identifier& nymID,
+        const std::string& box,
+        const Identifier& hash) const override;
+    std::string QueryFile(
+        const std::string& folder,
+        const std::string& one,
+        const std::string& two,
+        const std::string& three = "") const override;
 #if OT_CASH
     void ScanMints() const override;
     void UpdateMint(const Identifier& unitID) const override;
 #endif  // OT_CASH
+    void SetVerifiedFile(
+        const std::string& folder,
+        const std::string& one,
+        const std::string& two) const override;
+    bool StoreFile(
+        const std::string& contents,
+        const std::string& folder,
+        const std::string& one,
+        const std::string& two,
+        const std::string& three = "") const override;
+    bool VerifiedFile(
+        const std::string& folder,
+        const std::string& one,
+        const std::string& two) const override;
 
     ~Server();
 
@@ -100,12 +131,15 @@ private:
     server::Server& server_;
     std::unique_ptr<server::MessageProcessor> message_processor_p_;
     server::MessageProcessor& message_processor_;
+    OTZMQPublishSocket box_publisher_;
 #if OT_CASH
     std::unique_ptr<std::thread> mint_thread_;
     mutable std::mutex mint_lock_;
     mutable std::mutex mint_update_lock_;
     mutable std::mutex mint_scan_lock_;
     mutable std::map<std::string, MintSeries> mints_;
+    mutable std::map<std::string, std::shared_ptr<const OTASCIIArmor>>
+        public_mint_payloads_;
     mutable std::deque<std::string> mints_to_check_;
 #endif  // OT_CASH
 
@@ -117,6 +151,9 @@ private:
 #endif  // OT_CASH
     const std::string get_arg(const std::string& argName) const;
 #if OT_CASH
+    std::shared_ptr<const Mint> get_public_mint(
+        const Lock& lock,
+        const std::string& unitID) const;
     std::int32_t last_generated_series(
         const std::string& serverID,
         const std::string& unitID) const;
@@ -52,8 +52,8 @@
 
 namespace opentxs::api::client::implementation
 {
-Cash::Cash(std::recursive_mutex& apilock)
-    : api_lock_(apilock)
+Cash::Cash()
+    : cash_lock_()
 {
 }
 
@@ -64,7 +64,7 @@ bool Cash::deposit_cash(
     const std::string& ACCT_ID,
     const std::string& STR_PURSE) const
 {
-    rLock lock(api_lock_);
+    rLock lock(cash_lock_);
     return 1 == deposit_purse(notaryID, ACCT_ID, nymID, STR_PURSE, "");
 }
 
@@ -74,14 +74,14 @@ bool Cash::deposit_local_purse(
     const std::string& ACCT_ID,
     const std::string& STR_INDICES) const
 {
-    rLock lock(api_lock_);
+    rLock lock(cash_lock_);
     return 1 == deposit_purse(notaryID, ACCT_ID, nymID, "", STR_INDICES);
 }
 
 bool Cash::easy_withdraw_cash(const std::string& ACCT_ID, std::int64_t AMOUNT)
     const
 {
-    rLock lock(api_lock_);
+    rLock lock(cash_lock_);
     // There are other high-level functions that call this low-level version.
     // (Not just the function we're currently in.)
     return 1 == easy_withdraw_cash_low_level(ACCT_ID, AMOUNT);
@@ -96,7 +96,7 @@ std::string Cash::export_cash(
     bool bPasswordProtected,
     std::string& retainedCopy) const
 {
-    rLock lock(api_lock_);
+    rLock lock(cash_lock_);
 
     std::string strContract = SwigWrap::GetAssetType_Contract(unitTypeID);
 
@@ -148,7 +148,7 @@ bool Cash::withdraw_and_export_cash(
     std::shared_ptr<const Purse>& senderCopy,
     bool bPasswordProtected /*=false*/) const
 {
-    rLock lock(api_lock_);
+    rLock lock(cash_lock_);
 
     const std::string server = SwigWrap::GetAccountWallet_NotaryID(ACCT_ID);
     const std::string mynym = SwigWrap::GetAccountWallet_NymID(ACCT_ID);
@@ -175,7 +175,7 @@ bool Cash::withdraw_and_send_cash(
     const std::string& recipientNymID,
     std::int64_t AMOUNT) const
 {
-    rLock lock(api_lock_);
+    rLock lock(cash_lock_);
 
     std::string response, indices;
     std::string hisnym = recipientNymID;
@@ -316,7 +316,7 @@ std::int32_t Cash::send_cash(
     std::string& indices,
     bool hasPassword) const
 {
-    rLock lock(api_lock_);
+    rLock lock(cash_lock_);
 
     std::int64_t startAmount = (amount.empty() ? 0 : stoll(amount));
 
@@ -511,7 +511,7 @@ std::int32_t Cash::deposit_purse(
     const std::string& indices,
     std::string* pOptionalOutput /*=nullptr*/) const  // contains server reply
 {
-    rLock lock(api_lock_);
+    rLock lock(cash_lock_);
 
     std::string assetType =
         SwigWrap::GetAccountWallet_InstrumentDefinitionID(myacct);
@@ -184,12 +184,11 @@ protected:
 private:
     friend api::implementation::Api;
 
-    std::recursive_mutex& api_lock_;
-
-    Cash(std::recursive_mutex& apilock);
-
-    Cash() = delete;
+    // Serializes cash operations. Server round trips inside take the per
+    // context lock, so this is deliberately not the API lock.
+    mutable std::recursive_mutex cash_lock_;
 
+    Cash();
     Cash(const Cash&) = delete;
     Cash(Cash&&) = delete;
     Cash& operator=(const Cash&) = delete;
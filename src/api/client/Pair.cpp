@@ -86,7 +86,6 @@ Pair::Cleanup::~Cleanup() { run_.Off(); }
 
 Pair::Pair(
     const Flag& running,
-    std::recursive_mutex& apiLock,
     const api::client::Sync& sync,
     const client::ServerAction& action,
     const client::Wallet& wallet,
@@ -100,7 +99,6 @@ Pair::Pair(
     , ot_api_(otapi)
     , exec_(exec)
     , zmq_(context)
-    , api_lock_(apiLock)
     , status_lock_()
     , pairing_(Flag::Factory(false))
     , last_refresh_(0)
@@ -213,7 +211,7 @@ std::pair<bool, Identifier> Pair::get_connection(
 {
     std::pair<bool, Identifier> output{false, {}};
     auto & [ success, requestID ] = output;
-    rLock lock(api_lock_);
+    rLock lock(ot_api_.ContextLock(localNymID, serverID));
     auto action = action_.InitiateRequestConnection(
         localNymID, serverID, issuerNymID, type);
     action->Run();
@@ -251,7 +249,7 @@ std::pair<bool, Identifier> Pair::initiate_bailment(
         return output;
     }
 
-    rLock lock(api_lock_);
+    rLock lock(ot_api_.ContextLock(nymID, serverID));
     auto action = action_.InitiateBailment(nymID, serverID, issuerID, unitID);
     action->Run();
     lock.unlock();
@@ -475,7 +473,7 @@ void Pair::process_pending_bailment(
                   << ": Failed to set request as used on issuer." << std::endl;
         }
 
-        rLock lock(api_lock_);
+        rLock lock(ot_api_.ContextLock(nymID, serverID));
         auto action = action_.AcknowledgeNotice(
             nymID, serverID, issuerNymID, requestID, true);
         action->Run();
@@ -641,7 +639,7 @@ std::pair<bool, Identifier> Pair::register_account(
         return output;
     }
 
-    rLock lock(api_lock_);
+    rLock lock(ot_api_.ContextLock(nymID, serverID));
     auto action = action_.RegisterAccount(nymID, serverID, unitID);
     action->Run();
     lock.unlock();
@@ -761,6 +759,7 @@ void Pair::state_machine(
             if (trusted) {
                 needStoreSecret = (false == issuer.StoreSecretComplete()) &&
                                   (false == issuer.StoreSecretInitiated());
+                rLock contextLock(ot_api_.ContextLock(localNymID, serverID));
                 auto editor =
                     wallet_.mutable_ServerContext(localNymID, serverID);
                 auto& context = editor.It();
@@ -905,7 +904,7 @@ std::pair<bool, Identifier> Pair::store_secret(
 {
     std::pair<bool, Identifier> output{false, {}};
     auto & [ success, requestID ] = output;
-    rLock lock(api_lock_);
+    rLock lock(ot_api_.ContextLock(localNymID, serverID));
     auto action = action_.InitiateStoreSecret(
         localNymID,
         serverID,
@@ -147,6 +147,13 @@ public:
         const Identifier& localNymID,
         const Identifier& serverID,
         const Identifier& contractID) const override;
+    Action DownloadMarketData(
+        const Identifier& localNymID,
+        const Identifier& serverID,
+        const Identifier& marketID,
+        const std::chrono::seconds interval,
+        const std::chrono::system_clock::time_point from,
+        const std::chrono::system_clock::time_point to) const override;
     Action DownloadMarketList(
         const Identifier& localNymID,
         const Identifier& serverID) const override;
@@ -335,13 +342,11 @@ public:
 private:
     friend api::implementation::Api;
 
-    std::recursive_mutex& api_lock_;
     const OT_API& otapi_;
     const OTAPI_Exec& exec_;
     const api::client::Wallet& wallet_;
 
     ServerAction(
-        std::recursive_mutex& apiLock,
         const OT_API& otapi,
         const OTAPI_Exec& exec,
         const api::client::Wallet& wallet);
@@ -55,7 +55,9 @@
 #include "opentxs/contact/ContactData.hpp"
 #include "opentxs/contact/ContactGroup.hpp"
 #include "opentxs/contact/ContactItem.hpp"
+#include "opentxs/core/contract/ServerContract.hpp"
 #include "opentxs/core/crypto/OTPassword.hpp"
+#include "opentxs/core/Account.hpp"
 #include "opentxs/core/Cheque.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Ledger.hpp"
@@ -64,12 +66,20 @@
 #include "opentxs/core/String.hpp"
 #include "opentxs/ext/OTPayment.hpp"
 #include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/ListenCallback.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
 #include "opentxs/network/zeromq/PublishSocket.hpp"
+#include "opentxs/network/zeromq/SubscribeSocket.hpp"
 
 #include <chrono>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <vector>
 
 #include "Sync.hpp"
 
+#define BOX_SWEEP_REFRESHES 10
 #define CONTACT_REFRESH_DAYS 1
 #define CONTRACT_DOWNLOAD_SECONDS 10
 #define MAIN_LOOP_SECONDS 5
@@ -202,6 +212,7 @@ Sync::Sync(
     , introduction_server_lock_()
     , nym_fetch_lock_()
     , task_status_lock_()
+    , box_notice_lock_()
     , refresh_counter_(0)
     , operations_()
     , server_nym_fetch_()
@@ -211,6 +222,10 @@ Sync::Sync(
     , introduction_server_id_()
     , task_status_()
     , nym_publisher_(zmq.PublishSocket())
+    , box_notice_callbacks_()
+    , box_notice_subscribers_()
+    , box_notice_topics_()
+    , box_notice_nyms_()
 {
     nym_publisher_->Start(
         opentxs::network::zeromq::Socket::NymDownloadEndpoint);
@@ -311,14 +326,14 @@ bool Sync::AcceptIncoming(
     const Identifier& serverID,
     const std::size_t max) const
 {
-    rLock apiLock(api_lock_);
+    rLock contextLock(ot_api_.ContextLock(nymID, serverID));
     auto context = wallet_.mutable_ServerContext(nymID, serverID);
     std::size_t remaining{1};
     std::size_t retries{PROCESS_INBOX_RETRIES};
 
     while (0 < remaining) {
         const auto attempt =
-            accept_incoming(apiLock, max, accountID, context.It());
+            accept_incoming(contextLock, max, accountID, context.It());
         const auto & [ success, unprocessed ] = attempt;
         remaining = unprocessed;
 
@@ -687,7 +702,7 @@ bool Sync::deposit_cheque(
         return finish_task(taskID, false);
     }
 
-    rLock lock(api_lock_);
+    rLock lock(ot_api_.ContextLock(nymID, serverID));
     auto action =
         server_action_.DepositCheque(nymID, serverID, accountID, cheque);
     action->Run();
@@ -790,7 +805,7 @@ bool Sync::download_contract(
     OT_ASSERT(false == serverID.empty())
     OT_ASSERT(false == contractID.empty())
 
-    rLock lock(api_lock_);
+    rLock lock(ot_api_.ContextLock(nymID, serverID));
     auto action = server_action_.DownloadContract(nymID, serverID, contractID);
     action->Run();
     lock.unlock();
@@ -827,7 +842,7 @@ bool Sync::download_nym(
     OT_ASSERT(false == serverID.empty())
     OT_ASSERT(false == targetNymID.empty())
 
-    rLock lock(api_lock_);
+    rLock lock(ot_api_.ContextLock(nymID, serverID));
     auto action = server_action_.DownloadNym(nymID, serverID, targetNymID);
     action->Run();
     lock.unlock();
@@ -1007,7 +1022,7 @@ bool Sync::get_admin(
 
     {
         const std::string serverPassword(password.getPassword());
-        rLock lock(api_lock_);
+        rLock lock(ot_api_.ContextLock(nymID, serverID));
         auto action =
             server_action_.RequestAdmin(nymID, serverID, serverPassword);
         action->Run();
@@ -1022,6 +1037,7 @@ bool Sync::get_admin(
         }
     }
 
+    rLock contextLock(ot_api_.ContextLock(nymID, serverID));
     auto mContext = wallet_.mutable_ServerContext(nymID, serverID);
     auto& context = mContext.It();
     context.SetAdminAttempted();
@@ -1119,7 +1135,7 @@ bool Sync::message_nym(
     OT_ASSERT(false == serverID.empty())
     OT_ASSERT(false == targetNymID.empty())
 
-    rLock lock(api_lock_);
+    rLock lock(ot_api_.ContextLock(nymID, serverID));
     auto action =
         server_action_.SendMessage(nymID, serverID, targetNymID, text);
     action->Run();
@@ -1164,7 +1180,7 @@ bool Sync::pay_nym(
     OT_ASSERT(false == serverID.empty())
     OT_ASSERT(false == targetNymID.empty())
 
-    rLock lock(api_lock_);
+    rLock lock(ot_api_.ContextLock(nymID, serverID));
     auto action =
         server_action_.SendPayment(nymID, serverID, targetNymID, payment);
     action->Run();
@@ -1212,7 +1228,7 @@ bool Sync::pay_nym_cash(
     OT_ASSERT(false == serverID.empty())
     OT_ASSERT(false == targetNymID.empty())
 
-    rLock lock(api_lock_);
+    rLock lock(ot_api_.ContextLock(nymID, serverID));
     auto action = server_action_.SendCash(
         nymID, serverID, targetNymID, recipientCopy, senderCopy);
     action->Run();
@@ -1361,6 +1377,93 @@ Identifier Sync::PayContactCash(
 }
 #endif  // OT_CASH
 
+void Sync::process_box_notice(
+    const Identifier& serverID,
+    const opentxs::network::zeromq::Message& message) const
+{
+    std::istringstream notice{std::string(message)};
+    std::string topic{};
+    std::string box{};
+    std::string hash{};
+    notice >> topic >> box >> hash;
+
+    if (hash.empty()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Invalid notice from server "
+              << String(serverID) << std::endl;
+
+        return;
+    }
+
+    Identifier nymID{};
+
+    {
+        Lock lock(box_notice_lock_);
+        const auto it = box_notice_nyms_.find(topic);
+
+        if (box_notice_nyms_.end() == it) {
+
+            return;
+        }
+
+        nymID = it->second;
+    }
+
+    const Identifier boxHash(hash);
+    auto& queue = get_operations({nymID, serverID});
+
+    if ("nymbox" == box) {
+        const auto context = wallet_.ServerContext(nymID, serverID);
+
+        if (context && (context->LocalNymboxHash() == boxHash)) {
+
+            return;
+        }
+
+        queue.download_nymbox_.Push(Identifier::Random(), true);
+
+        return;
+    }
+
+    if (("inbox" != box) && ("outbox" != box)) {
+
+        return;
+    }
+
+    // Notices do not name the account, so every account the nym holds on
+    // the server is downloaded unless one of them is already current
+    std::vector<Identifier> accounts{};
+
+    for (const auto & [ accountID, ownerID, notaryID, unitID ] :
+         ot_api_.Accounts()) {
+        const auto& notUsed[[maybe_unused]] = unitID;
+
+        if ((ownerID != nymID) || (notaryID != serverID)) {
+            continue;
+        }
+
+        const auto pAccount =
+            ot_api_.LoadAssetAccount(serverID, nymID, accountID);
+
+        if (pAccount) {
+            Identifier localHash{};
+            const bool haveHash = ("inbox" == box)
+                                      ? pAccount->GetInboxHash(localHash)
+                                      : pAccount->GetOutboxHash(localHash);
+
+            if (haveHash && (localHash == boxHash)) {
+
+                return;
+            }
+        }
+
+        accounts.push_back(accountID);
+    }
+
+    for (const auto& accountID : accounts) {
+        queue.download_account_.Push(Identifier::Random(), accountID);
+    }
+}
+
 bool Sync::publish_server_registration(
     const Identifier& nymID,
     const Identifier& serverID,
@@ -1392,6 +1495,9 @@ void Sync::refresh_accounts() const
     otInfo << OT_METHOD << __FUNCTION__ << ": Begin" << std::endl;
     const auto serverList = wallet_.ServerList();
     const auto accounts = ot_api_.Accounts();
+    // Contexts which receive box change notices only need an occasional
+    // sweep in case a notice was dropped
+    const bool sweep = (0 == (refresh_counter_.load() % BOX_SWEEP_REFRESHES));
 
     for (const auto server : serverList) {
         SHUTDOWN()
@@ -1409,9 +1515,15 @@ void Sync::refresh_accounts() const
 
             if (registered) {
                 otWarn << "is ";
-                auto& queue = get_operations({nymID, serverID});
-                const auto taskID(Identifier::Random());
-                queue.download_nymbox_.Push(taskID, true);
+                // Retry subscriptions which failed when the context started
+                subscribe_box_notices({nymID, serverID});
+
+                if (sweep || (false == subscribed_box_notices(
+                                           {nymID, serverID}))) {
+                    auto& queue = get_operations({nymID, serverID});
+                    const auto taskID(Identifier::Random());
+                    queue.download_nymbox_.Push(taskID, true);
+                }
             } else {
                 otWarn << "is not ";
             }
@@ -1430,6 +1542,12 @@ void Sync::refresh_accounts() const
                << ":\n"
                << "  * Owned by nym: " << String(nymID) << "\n"
                << "  * On server: " << String(serverID) << std::endl;
+
+        if ((false == sweep) && subscribed_box_notices({nymID, serverID})) {
+
+            continue;
+        }
+
         auto& queue = get_operations({nymID, serverID});
         const auto taskID(Identifier::Random());
         queue.download_account_.Push(taskID, accountID);
@@ -1541,7 +1659,7 @@ bool Sync::register_account(
     OT_ASSERT(false == serverID.empty())
     OT_ASSERT(false == unitID.empty())
 
-    rLock lock(api_lock_);
+    rLock lock(ot_api_.ContextLock(nymID, serverID));
     auto action = server_action_.RegisterAccount(nymID, serverID, unitID);
     action->Run();
     lock.unlock();
@@ -1576,7 +1694,7 @@ bool Sync::register_nym(
     OT_ASSERT(false == serverID.empty())
 
     set_contact(nymID, serverID);
-    rLock lock(api_lock_);
+    rLock lock(ot_api_.ContextLock(nymID, serverID));
     auto action = server_action_.RegisterNym(nymID, serverID);
     action->Run();
     lock.unlock();
@@ -1827,6 +1945,7 @@ void Sync::state_machine(const ContextID id, OperationQueue& queue) const
     SHUTDOWN()
     OT_ASSERT(context)
 
+    subscribe_box_notices(id);
     bool queueValue{false};
     bool needAdmin{false};
     bool registerNym{false};
@@ -2173,6 +2292,111 @@ ThreadStatus Sync::status(const Lock& lock, const Identifier& taskID) const
     return output;
 }
 
+bool Sync::subscribed_box_notices(const ContextID& id) const
+{
+    Lock lock(box_notice_lock_);
+
+    return (0 < box_notice_topics_.count(id));
+}
+
+void Sync::subscribe_box_notices(const ContextID& id) const
+{
+    const auto & [ nymID, serverID ] = id;
+
+    if (subscribed_box_notices(id)) {
+
+        return;
+    }
+
+    const auto contract = wallet_.Server(serverID);
+
+    OT_ASSERT(contract)
+
+    std::string hostname{};
+    std::uint32_t port{0};
+
+    if (false == contract->ConnectInfo(hostname, port)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": No endpoint for server "
+              << String(serverID) << std::endl;
+
+        return;
+    }
+
+    // The notary reports its notification port, and the topic it publishes
+    // this nym's notices under, in the ping reply. The ping is a network
+    // round trip, so box_notice_lock_ is not held while it is made.
+    port = 0;
+    std::string topic{};
+
+    {
+        rLock contextLock(ot_api_.ContextLock(nymID, serverID));
+        auto context = wallet_.mutable_ServerContext(nymID, serverID);
+        const auto[result, reply] = context.It().PingNotary();
+
+        if ((SendResult::VALID_REPLY == result) && reply &&
+            reply->m_bSuccess && (0 < reply->m_lDepth) &&
+            (std::numeric_limits<std::uint16_t>::max() >= reply->m_lDepth)) {
+            port = static_cast<std::uint32_t>(reply->m_lDepth);
+            String payload{};
+
+            if (reply->m_ascPayload.GetString(payload)) {
+                topic = payload.Get();
+            }
+        }
+    }
+
+    if ((0 == port) || topic.empty()) {
+        otWarn << OT_METHOD << __FUNCTION__ << ": Server " << String(serverID)
+               << " does not publish box change notices for nym "
+               << String(nymID) << std::endl;
+
+        return;
+    }
+
+    Lock lock(box_notice_lock_);
+
+    if (0 < box_notice_topics_.count(id)) {
+
+        return;
+    }
+
+    auto it = box_notice_subscribers_.find(serverID);
+
+    if (box_notice_subscribers_.end() == it) {
+        const auto& callback =
+            box_notice_callbacks_
+                .emplace(
+                    serverID,
+                    opentxs::network::zeromq::ListenCallback::Factory(
+                        [this, serverID](
+                            const opentxs::network::zeromq::Message& message)
+                            -> void {
+                            this->process_box_notice(serverID, message);
+                        }))
+                .first->second;
+        auto subscriber = zmq_.SubscribeSocket(callback.get());
+        subscriber->SetCurve(*contract);
+        subscriber->Subscribe(topic);
+        const auto endpoint =
+            std::string("tcp://") + hostname + ":" + std::to_string(port);
+
+        if (false == subscriber->Start(endpoint)) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to connect to "
+                  << endpoint << std::endl;
+
+            return;
+        }
+
+        box_notice_subscribers_.emplace(serverID, std::move(subscriber));
+    } else if (false == it->second->Subscribe(topic)) {
+
+        return;
+    }
+
+    box_notice_nyms_.emplace(topic, nymID);
+    box_notice_topics_.insert(id);
+}
+
 ThreadStatus Sync::Status(const Identifier& taskID) const
 {
     Lock lock(task_status_lock_);
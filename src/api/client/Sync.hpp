@@ -49,6 +49,7 @@
 #include <atomic>
 #include <memory>
 #include <map>
+#include <set>
 #include <thread>
 #include <tuple>
 
@@ -181,6 +182,7 @@ private:
     mutable std::mutex introduction_server_lock_{};
     mutable std::mutex nym_fetch_lock_{};
     mutable std::mutex task_status_lock_{};
+    mutable std::mutex box_notice_lock_{};
     mutable std::atomic<std::uint64_t> refresh_counter_{0};
     mutable std::map<ContextID, OperationQueue> operations_;
     mutable std::map<Identifier, UniqueQueue<Identifier>> server_nym_fetch_;
@@ -190,6 +192,11 @@ private:
     mutable std::unique_ptr<Identifier> introduction_server_id_;
     mutable std::map<Identifier, ThreadStatus> task_status_;
     OTZMQPublishSocket nym_publisher_;
+    mutable std::map<Identifier, OTZMQListenCallback> box_notice_callbacks_;
+    mutable std::map<Identifier, OTZMQSubscribeSocket> box_notice_subscribers_;
+    mutable std::set<ContextID> box_notice_topics_;
+    // topic, nym
+    mutable std::map<std::string, Identifier> box_notice_nyms_;
     // taskID, messageID
     mutable std::map<Identifier, Identifier> task_message_id_;
 
@@ -290,6 +297,9 @@ private:
         std::shared_ptr<const Purse>& recipientCopy,
         std::shared_ptr<const Purse>& senderCopy) const;
 #endif // OT_CASH
+    void process_box_notice(
+        const Identifier& serverID,
+        const opentxs::network::zeromq::Message& message) const;
     bool publish_server_registration(
         const Identifier& nymID,
         const Identifier& serverID,
@@ -319,6 +329,8 @@ private:
     Identifier start_task(const Identifier& taskID, bool success) const;
     void state_machine(const ContextID id, OperationQueue& queue) const;
     ThreadStatus status(const Lock& lock, const Identifier& taskID) const;
+    bool subscribed_box_notices(const ContextID& id) const;
+    void subscribe_box_notices(const ContextID& id) const;
     void update_task(const Identifier& taskID, const ThreadStatus status) const;
     void start_introduction_server(const Identifier& nymID) const;
     Depositability valid_account(
@@ -69,6 +69,8 @@
 #include "Wallet.hpp"
 
 #include <functional>
+#include <unordered_set>
+#include <vector>
 
 #define OT_METHOD "opentxs::api::client::implementation::Wallet::"
 
@@ -78,10 +80,17 @@ namespace opentxs::api::client::implementation
 Wallet::Wallet(Native& ot)
     : ot_(ot)
     , nym_map_()
+    , nym_id_index_()
+    , nym_alias_index_()
     , server_map_()
     , unit_map_()
     , context_map_()
     , issuer_map_()
+    , nym_cache_()
+    , server_cache_()
+    , unit_cache_()
+    , context_cache_()
+    , evictions_(0)
     , nym_map_lock_()
     , server_map_lock_()
     , unit_map_lock_()
@@ -94,24 +103,65 @@ Wallet::Wallet(Native& ot)
 {
 }
 
+Wallet::CacheStatistics Wallet::CacheStats() const
+{
+    CacheStatistics output{};
+    Lock nymLock(nym_map_lock_);
+    output.nyms_ = nym_cache_.Size();
+    output.bytes_ += nym_cache_.Bytes();
+    nymLock.unlock();
+    Lock serverLock(server_map_lock_);
+    output.servers_ = server_cache_.Size();
+    output.bytes_ += server_cache_.Bytes();
+    serverLock.unlock();
+    Lock unitLock(unit_map_lock_);
+    output.units_ = unit_cache_.Size();
+    output.bytes_ += unit_cache_.Bytes();
+    unitLock.unlock();
+    Lock contextLock(context_map_lock_);
+    output.contexts_ = context_cache_.Size();
+    output.bytes_ += context_cache_.Bytes();
+    contextLock.unlock();
+    Lock issuerLock(issuer_map_lock_);
+    output.issuers_ = issuer_map_.size();
+    issuerLock.unlock();
+    Lock peerLock(peer_map_lock_);
+    output.locks_ += peer_lock_.size();
+    peerLock.unlock();
+    Lock nymfileLock(nymfile_map_lock_);
+    output.locks_ += nymfile_lock_.size();
+    nymfileLock.unlock();
+    output.evictions_ = evictions_.load();
+
+    return output;
+}
+
 std::shared_ptr<class Context> Wallet::context(
     const Identifier& localNymID,
     const Identifier& remoteNymID) const
 {
-    const std::string local = localNymID.str();
-    const std::string remote = remoteNymID.str();
-    const ContextID context = {local, remote};
+    const ContextID context = {FixedIdentifier(localNymID),
+                               FixedIdentifier(remoteNymID)};
     auto it = context_map_.find(context);
     const bool inMap = (it != context_map_.end());
 
     if (inMap) {
-        return it->second;
+        auto& entry = it->second;
+
+        if (entry) {
+            context_cache_.Touch(context, [&]() -> std::size_t {
+                return entry->Serialize()->GetSize();
+            });
+        }
+
+        return entry;
     }
 
     // Load from storage, if it exists.
     std::shared_ptr<proto::Context> serialized;
-    const bool loaded =
-        ot_.DB().Load(localNymID.str(), remoteNymID.str(), serialized, true);
+    const std::string local = localNymID.str();
+    const std::string remote = remoteNymID.str();
+    const bool loaded = ot_.DB().Load(local, remote, serialized, true);
 
     if (!loaded) {
         return nullptr;
@@ -161,7 +211,7 @@ std::shared_ptr<class Context> Wallet::context(
                 localNym,
                 remoteNym,
                 connection,
-                nymfile_lock(localNymID)));
+                *nymfile_lock(localNymID)));
         } break;
         case proto::CONSENSUSTYPE_CLIENT: {
             OT_ASSERT(ot_.ServerMode());
@@ -172,7 +222,7 @@ std::shared_ptr<class Context> Wallet::context(
                 localNym,
                 remoteNym,
                 serverID,
-                nymfile_lock(remoteNymID)));
+                *nymfile_lock(remoteNymID)));
         } break;
         default: {
             return nullptr;
@@ -194,6 +244,10 @@ std::shared_ptr<class Context> Wallet::context(
         return nullptr;
     }
 
+    context_cache_.Touch(context, [&]() -> std::size_t {
+        return entry->Serialize()->GetSize();
+    });
+
     return entry;
 }
 
@@ -212,6 +266,8 @@ std::shared_ptr<const class Context> Wallet::Context(
         remote = ServerToNym(serverID);
     }
 
+    Lock lock(context_map_lock_);
+
     return context(local, remote);
 }
 
@@ -222,7 +278,9 @@ std::shared_ptr<const class ClientContext> Wallet::ClientContext(
     OT_ASSERT(ot_.ServerMode());
 
     const auto& serverNymID = ot_.Server().NymID();
+    Lock lock(context_map_lock_);
     auto base = context(serverNymID, remoteNymID);
+    lock.unlock();
     auto output = std::dynamic_pointer_cast<const class ClientContext>(base);
 
     return output;
@@ -234,8 +292,9 @@ std::shared_ptr<const class ServerContext> Wallet::ServerContext(
 {
     Identifier serverID = remoteID;
     auto remoteNymID = ServerToNym(serverID);
+    Lock lock(context_map_lock_);
     auto base = context(localNymID, remoteNymID);
-
+    lock.unlock();
     auto output = std::dynamic_pointer_cast<const class ServerContext>(base);
 
     return output;
@@ -257,9 +316,12 @@ Editor<class Context> Wallet::mutable_Context(
         remote = ServerToNym(serverID);
     }
 
+    Lock lock(context_map_lock_);
     auto base = context(local, remote);
+    lock.unlock();
+    // The callback keeps the context alive while the editor exists
     std::function<void(class Context*)> callback =
-        [&](class Context* in) -> void { this->save(in); };
+        [this, base](class Context* in) -> void { this->save(in); };
 
     OT_ASSERT(base);
 
@@ -276,8 +338,6 @@ Editor<class ClientContext> Wallet::mutable_ClientContext(
     const auto& serverNymID = ot_.Server().NymID();
     Lock lock(context_map_lock_);
     auto base = context(serverNymID, remoteNymID);
-    std::function<void(class Context*)> callback =
-        [&](class Context* in) -> void { this->save(in); };
 
     if (base) {
         OT_ASSERT(proto::CONSENSUSTYPE_CLIENT == base->Type());
@@ -292,15 +352,23 @@ Editor<class ClientContext> Wallet::mutable_ClientContext(
         OT_ASSERT_MSG(remote, "Remote nym does not exist in the wallet.");
 
         // Create a new Context
-        const ContextID contextID = {serverNymID.str(), remoteNymID.str()};
+        const ContextID contextID = {FixedIdentifier(serverNymID),
+                                     FixedIdentifier(remoteNymID)};
         auto& entry = context_map_[contextID];
         entry.reset(new class ClientContext(
-            local, remote, serverID, nymfile_lock(remoteNymID)));
+            local, remote, serverID, *nymfile_lock(remoteNymID)));
         base = entry;
+        context_cache_.Touch(contextID, [&]() -> std::size_t {
+            return entry->Serialize()->GetSize();
+        });
     }
 
     OT_ASSERT(base);
 
+    // The callback keeps the context alive while the editor exists
+    std::function<void(class Context*)> callback =
+        [this, base](class Context* in) -> void { this->save(in); };
+
     auto child = dynamic_cast<class ClientContext*>(base.get());
 
     OT_ASSERT(nullptr != child);
@@ -319,9 +387,6 @@ Editor<class ServerContext> Wallet::mutable_ServerContext(
 
     auto base = context(localNymID, remoteNymID);
 
-    std::function<void(class Context*)> callback =
-        [&](class Context* in) -> void { this->save(in); };
-
     if (base) {
         OT_ASSERT(proto::CONSENSUSTYPE_SERVER == base->Type());
     } else {
@@ -335,7 +400,8 @@ Editor<class ServerContext> Wallet::mutable_ServerContext(
         OT_ASSERT_MSG(remoteNym, "Remote nym does not exist in the wallet.");
 
         // Create a new Context
-        const ContextID contextID = {localNymID.str(), remoteNymID.str()};
+        const ContextID contextID = {FixedIdentifier(localNymID),
+                                     FixedIdentifier(remoteNymID)};
         auto& entry = context_map_[contextID];
         auto& zmq = ot_.ZMQ();
         auto& connection = zmq.Server(serverID.str());
@@ -344,12 +410,19 @@ Editor<class ServerContext> Wallet::mutable_ServerContext(
             remoteNym,
             serverID,
             connection,
-            nymfile_lock(localNymID)));
+            *nymfile_lock(localNymID)));
         base = entry;
+        context_cache_.Touch(contextID, [&]() -> std::size_t {
+            return entry->Serialize()->GetSize();
+        });
     }
 
     OT_ASSERT(base);
 
+    // The callback keeps the context alive while the editor exists
+    std::function<void(class Context*)> callback =
+        [this, base](class Context* in) -> void { this->save(in); };
+
     auto child = dynamic_cast<class ServerContext*>(base.get());
 
     OT_ASSERT(nullptr != child);
@@ -395,13 +468,26 @@ Editor<api::client::Issuer> Wallet::mutable_Issuer(
     return Editor<api::client::Issuer>(lock, pIssuer.get(), callback);
 }
 
+void Wallet::index_nym(
+    const Lock&,
+    const FixedIdentifier& key,
+    const std::string& alias) const
+{
+    nym_id_index_[key.str()] = {key, alias};
+
+    if (false == alias.empty()) {
+        nym_alias_index_.emplace(alias, key);
+    }
+}
+
 Wallet::IssuerLock& Wallet::issuer(
     const Identifier& nymID,
     const Identifier& issuerID,
     const bool create) const
 {
     Lock lock(issuer_map_lock_);
-    auto& output = issuer_map_[{nymID, issuerID}];
+    auto& output =
+        issuer_map_[{FixedIdentifier(nymID), FixedIdentifier(issuerID)}];
     auto & [ issuerMutex, pIssuer ] = output;
     const auto& notUsed[[maybe_unused]] = issuerMutex;
 
@@ -465,19 +551,20 @@ ConstNym Wallet::Nym(
     const Identifier& id,
     const std::chrono::milliseconds& timeout) const
 {
-    const std::string nym = id.str();
+    const FixedIdentifier key(id);
     Lock mapLock(nym_map_lock_);
-    bool inMap = (nym_map_.find(nym) != nym_map_.end());
+    bool inMap = (nym_map_.find(key) != nym_map_.end());
     bool valid = false;
 
     if (!inMap) {
+        const std::string nym = id.str();
         std::shared_ptr<proto::CredentialIndex> serialized;
 
         std::string alias;
         bool loaded = ot_.DB().Load(nym, serialized, alias, true);
 
         if (loaded) {
-            auto& pNym = nym_map_[nym].second;
+            auto& pNym = nym_map_[key].second;
             pNym.reset(new class Nym(id));
 
             if (pNym) {
@@ -486,6 +573,8 @@ ConstNym Wallet::Nym(
                     pNym->alias_ = alias;
                 }
             }
+
+            index_nym(mapLock, key, alias);
         } else {
             ot_.DHT().GetPublicNym(nym);
 
@@ -498,7 +587,7 @@ ConstNym Wallet::Nym(
                 while (std::chrono::high_resolution_clock::now() < end) {
                     std::this_thread::sleep_for(interval);
                     mapLock.lock();
-                    bool found = (nym_map_.find(nym) != nym_map_.end());
+                    bool found = (nym_map_.find(key) != nym_map_.end());
                     mapLock.unlock();
 
                     if (found) {
@@ -510,14 +599,19 @@ ConstNym Wallet::Nym(
             }
         }
     } else {
-        auto& pNym = nym_map_[nym].second;
+        auto& pNym = nym_map_[key].second;
         if (pNym) {
             valid = pNym->VerifyPseudonym();
         }
     }
 
     if (valid) {
-        return nym_map_[nym].second;
+        auto& pNym = nym_map_[key].second;
+        nym_cache_.Touch(key, [&]() -> std::size_t {
+            return proto::ProtoAsData(pNym->asPublicNym())->GetSize();
+        });
+
+        return pNym;
     }
 
     return nullptr;
@@ -545,8 +639,11 @@ ConstNym Wallet::Nym(const proto::CredentialIndex& publicNym) const
 
         if (candidate->VerifyPseudonym()) {
             candidate->WriteCredentials();
+            const FixedIdentifier key(nym);
             Lock mapLock(nym_map_lock_);
-            nym_map_.erase(id);
+            unindex_nym(mapLock, key);
+            nym_cache_.Erase(key);
+            nym_map_.erase(key);
             mapLock.unlock();
         }
     }
@@ -595,7 +692,7 @@ NymData Wallet::mutable_Nym(const Identifier& id) const
     }
 
     Lock mapLock(nym_map_lock_);
-    auto it = nym_map_.find(nym);
+    auto it = nym_map_.find(FixedIdentifier(id));
 
     if (nym_map_.end() == it) {
         OT_FAIL
@@ -608,7 +705,8 @@ std::unique_ptr<const class NymFile> Wallet::Nymfile(
     const Identifier& id,
     const OTPasswordData& reason) const
 {
-    Lock lock(nymfile_lock(id));
+    auto mutex = nymfile_lock(id);
+    Lock lock(*mutex);
     std::unique_ptr<class NymFile> output{nullptr};
     output.reset(
         Nym::LoadPrivateNym(id, false, nullptr, nullptr, &reason, nullptr));
@@ -620,50 +718,70 @@ Editor<class NymFile> Wallet::mutable_Nymfile(
     const Identifier& id,
     const OTPasswordData& reason) const
 {
+    auto mutex = nymfile_lock(id);
+    // The callback keeps the mutex alive while the editor exists
     std::function<void(class NymFile*, Lock&)> callback =
-        [&](class NymFile* in, Lock& lock) -> void { this->save(in, lock); };
+        [this, mutex](class NymFile* in, Lock& lock) -> void {
+        this->save(in, lock);
+    };
     auto nym =
         Nym::LoadPrivateNym(id, false, nullptr, nullptr, &reason, nullptr);
 
-    return Editor<class NymFile>(nymfile_lock(id), nym, callback);
+    return Editor<class NymFile>(*mutex, nym, callback);
 }
 
-std::mutex& Wallet::nymfile_lock(const Identifier& nymID) const
+std::shared_ptr<std::mutex> Wallet::nymfile_lock(
+    const Identifier& nymID) const
 {
     Lock map_lock(nymfile_map_lock_);
-    auto& output = nymfile_lock_[nymID];
-    map_lock.unlock();
+    auto& output = nymfile_lock_[FixedIdentifier(nymID)];
+
+    if (false == bool(output)) {
+        output.reset(new std::mutex);
+    }
 
     return output;
 }
 
 ConstNym Wallet::NymByIDPartialMatch(const std::string& partialId) const
 {
+    const auto size = partialId.size();
+    std::vector<std::shared_ptr<class Nym>> candidates{};
     Lock mapLock(nym_map_lock_);
-    bool inMap = (nym_map_.find(partialId) != nym_map_.end());
-    bool valid = false;
+    const auto exact = nym_map_.find(FixedIdentifier(partialId));
 
-    if (!inMap) {
-        for (auto& it : nym_map_) {
-            if (it.first.compare(0, partialId.length(), partialId) == 0)
-                if (it.second.second->VerifyPseudonym())
-                    return it.second.second;
-        }
-        for (auto& it : nym_map_) {
-            if (it.second.second->Alias().compare(
-                    0, partialId.length(), partialId) == 0)
-                if (it.second.second->VerifyPseudonym())
-                    return it.second.second;
-        }
+    if (nym_map_.end() != exact) {
+        candidates.emplace_back(exact->second.second);
     } else {
-        auto& pNym = nym_map_[partialId].second;
-        if (pNym) {
-            valid = pNym->VerifyPseudonym();
+        // ID matches are preferred over alias matches
+        for (auto it = nym_id_index_.lower_bound(partialId);
+             nym_id_index_.end() != it; ++it) {
+            if (0 != it->first.compare(0, size, partialId)) {
+
+                break;
+            }
+
+            candidates.emplace_back(nym_map_.at(it->second.first).second);
+        }
+
+        for (auto it = nym_alias_index_.lower_bound(partialId);
+             nym_alias_index_.end() != it; ++it) {
+            if (0 != it->first.compare(0, size, partialId)) {
+
+                break;
+            }
+
+            candidates.emplace_back(nym_map_.at(it->second).second);
         }
     }
 
-    if (valid) {
-        return nym_map_[partialId].second;
+    mapLock.unlock();
+
+    for (const auto& nym : candidates) {
+        if (nym && nym->VerifyPseudonym()) {
+
+            return nym;
+        }
     }
 
     return nullptr;
@@ -691,11 +809,14 @@ bool Wallet::NymNameByIndex(const std::size_t index, String& name) const
     return false;
 }
 
-std::mutex& Wallet::peer_lock(const std::string& nymID) const
+std::shared_ptr<std::mutex> Wallet::peer_lock(const std::string& nymID) const
 {
     Lock map_lock(peer_map_lock_);
     auto& output = peer_lock_[nymID];
-    map_lock.unlock();
+
+    if (false == bool(output)) {
+        output.reset(new std::mutex);
+    }
 
     return output;
 }
@@ -706,7 +827,8 @@ std::shared_ptr<proto::PeerReply> Wallet::PeerReply(
     const StorageBox& box) const
 {
     const std::string nymID = nym.str();
-    Lock lock(peer_lock(nymID));
+    auto mutex = peer_lock(nymID);
+    Lock lock(*mutex);
     std::shared_ptr<proto::PeerReply> output;
 
     ot_.DB().Load(nymID, reply.str(), box, output, true);
@@ -718,7 +840,8 @@ bool Wallet::PeerReplyComplete(const Identifier& nym, const Identifier& replyID)
     const
 {
     const std::string nymID = nym.str();
-    Lock lock(peer_lock(nymID));
+    auto mutex = peer_lock(nymID);
+    Lock lock(*mutex);
     std::shared_ptr<proto::PeerReply> reply;
     const bool haveReply = ot_.DB().Load(
         nymID, replyID.str(), StorageBox::SENTPEERREPLY, reply, false);
@@ -761,7 +884,8 @@ bool Wallet::PeerReplyCreate(
     const proto::PeerReply& reply) const
 {
     const std::string nymID = nym.str();
-    Lock lock(peer_lock(nymID));
+    auto mutex = peer_lock(nymID);
+    Lock lock(*mutex);
 
     if (reply.cookie() != request.id()) {
         otErr << OT_METHOD << __FUNCTION__
@@ -815,7 +939,8 @@ bool Wallet::PeerReplyCreateRollback(
     const Identifier& reply) const
 {
     const std::string nymID = nym.str();
-    Lock lock(peer_lock(nymID));
+    auto mutex = peer_lock(nymID);
+    Lock lock(*mutex);
     const std::string requestID = request.str();
     const std::string replyID = reply.str();
     std::shared_ptr<proto::PeerRequest> requestItem;
@@ -868,7 +993,8 @@ bool Wallet::PeerReplyCreateRollback(
 ObjectList Wallet::PeerReplySent(const Identifier& nym) const
 {
     const std::string nymID = nym.str();
-    Lock lock(peer_lock(nymID));
+    auto mutex = peer_lock(nymID);
+    Lock lock(*mutex);
 
     return ot_.DB().NymBoxList(nymID, StorageBox::SENTPEERREPLY);
 }
@@ -876,7 +1002,8 @@ ObjectList Wallet::PeerReplySent(const Identifier& nym) const
 ObjectList Wallet::PeerReplyIncoming(const Identifier& nym) const
 {
     const std::string nymID = nym.str();
-    Lock lock(peer_lock(nymID));
+    auto mutex = peer_lock(nymID);
+    Lock lock(*mutex);
 
     return ot_.DB().NymBoxList(nymID, StorageBox::INCOMINGPEERREPLY);
 }
@@ -884,7 +1011,8 @@ ObjectList Wallet::PeerReplyIncoming(const Identifier& nym) const
 ObjectList Wallet::PeerReplyFinished(const Identifier& nym) const
 {
     const std::string nymID = nym.str();
-    Lock lock(peer_lock(nymID));
+    auto mutex = peer_lock(nymID);
+    Lock lock(*mutex);
 
     return ot_.DB().NymBoxList(nymID, StorageBox::FINISHEDPEERREPLY);
 }
@@ -892,7 +1020,8 @@ ObjectList Wallet::PeerReplyFinished(const Identifier& nym) const
 ObjectList Wallet::PeerReplyProcessed(const Identifier& nym) const
 {
     const std::string nymID = nym.str();
-    Lock lock(peer_lock(nymID));
+    auto mutex = peer_lock(nymID);
+    Lock lock(*mutex);
 
     return ot_.DB().NymBoxList(nymID, StorageBox::PROCESSEDPEERREPLY);
 }
@@ -920,7 +1049,8 @@ bool Wallet::PeerReplyReceive(const Identifier& nym, const PeerObject& reply)
     }
 
     const std::string nymID = nym.str();
-    Lock lock(peer_lock(nymID));
+    auto mutex = peer_lock(nymID);
+    Lock lock(*mutex);
     auto requestID = reply.Request()->ID();
 
     std::shared_ptr<proto::PeerRequest> request;
@@ -980,7 +1110,8 @@ std::shared_ptr<proto::PeerRequest> Wallet::PeerRequest(
     std::time_t& time) const
 {
     const std::string nymID = nym.str();
-    Lock lock(peer_lock(nymID));
+    auto mutex = peer_lock(nymID);
+    Lock lock(*mutex);
     std::shared_ptr<proto::PeerRequest> output;
 
     ot_.DB().Load(nymID, request.str(), box, output, time, true);
@@ -993,7 +1124,8 @@ bool Wallet::PeerRequestComplete(
     const Identifier& replyID) const
 {
     const std::string nymID = nym.str();
-    Lock lock(peer_lock(nymID));
+    auto mutex = peer_lock(nymID);
+    Lock lock(*mutex);
     std::shared_ptr<proto::PeerReply> reply;
     const bool haveReply = ot_.DB().Load(
         nymID, replyID.str(), StorageBox::INCOMINGPEERREPLY, reply, false);
@@ -1035,7 +1167,8 @@ bool Wallet::PeerRequestCreate(
     const proto::PeerRequest& request) const
 {
     const std::string nymID = nym.str();
-    Lock lock(peer_lock(nymID));
+    auto mutex = peer_lock(nymID);
+    Lock lock(*mutex);
 
     return ot_.DB().Store(request, nym.str(), StorageBox::SENTPEERREQUEST);
 }
@@ -1045,7 +1178,8 @@ bool Wallet::PeerRequestCreateRollback(
     const Identifier& request) const
 {
     const std::string nymID = nym.str();
-    Lock lock(peer_lock(nymID));
+    auto mutex = peer_lock(nymID);
+    Lock lock(*mutex);
 
     return ot_.DB().RemoveNymBoxItem(
         nym.str(), StorageBox::SENTPEERREQUEST, request.str());
@@ -1072,7 +1206,8 @@ bool Wallet::PeerRequestDelete(
 ObjectList Wallet::PeerRequestSent(const Identifier& nym) const
 {
     const std::string nymID = nym.str();
-    Lock lock(peer_lock(nymID));
+    auto mutex = peer_lock(nymID);
+    Lock lock(*mutex);
 
     return ot_.DB().NymBoxList(nym.str(), StorageBox::SENTPEERREQUEST);
 }
@@ -1080,7 +1215,8 @@ ObjectList Wallet::PeerRequestSent(const Identifier& nym) const
 ObjectList Wallet::PeerRequestIncoming(const Identifier& nym) const
 {
     const std::string nymID = nym.str();
-    Lock lock(peer_lock(nymID));
+    auto mutex = peer_lock(nymID);
+    Lock lock(*mutex);
 
     return ot_.DB().NymBoxList(nym.str(), StorageBox::INCOMINGPEERREQUEST);
 }
@@ -1088,7 +1224,8 @@ ObjectList Wallet::PeerRequestIncoming(const Identifier& nym) const
 ObjectList Wallet::PeerRequestFinished(const Identifier& nym) const
 {
     const std::string nymID = nym.str();
-    Lock lock(peer_lock(nymID));
+    auto mutex = peer_lock(nymID);
+    Lock lock(*mutex);
 
     return ot_.DB().NymBoxList(nym.str(), StorageBox::FINISHEDPEERREQUEST);
 }
@@ -1096,7 +1233,8 @@ ObjectList Wallet::PeerRequestFinished(const Identifier& nym) const
 ObjectList Wallet::PeerRequestProcessed(const Identifier& nym) const
 {
     const std::string nymID = nym.str();
-    Lock lock(peer_lock(nymID));
+    auto mutex = peer_lock(nymID);
+    Lock lock(*mutex);
 
     return ot_.DB().NymBoxList(nym.str(), StorageBox::PROCESSEDPEERREQUEST);
 }
@@ -1119,7 +1257,8 @@ bool Wallet::PeerRequestReceive(
     }
 
     const std::string nymID = nym.str();
-    Lock lock(peer_lock(nymID));
+    auto mutex = peer_lock(nymID);
+    Lock lock(*mutex);
 
     return ot_.DB().Store(
         request.Request()->Contract(), nymID, StorageBox::INCOMINGPEERREQUEST);
@@ -1147,7 +1286,8 @@ bool Wallet::RemoveServer(const Identifier& id) const
 {
     std::string server(id.str());
     Lock mapLock(server_map_lock_);
-    auto deleted = server_map_.erase(server);
+    server_cache_.Erase(FixedIdentifier(id));
+    auto deleted = server_map_.erase(FixedIdentifier(id));
 
     if (0 != deleted) {
         return ot_.DB().RemoveServer(server);
@@ -1160,7 +1300,8 @@ bool Wallet::RemoveUnitDefinition(const Identifier& id) const
 {
     std::string unit(id.str());
     Lock mapLock(unit_map_lock_);
-    auto deleted = unit_map_.erase(unit);
+    unit_cache_.Erase(FixedIdentifier(id));
+    auto deleted = unit_map_.erase(FixedIdentifier(id));
 
     if (0 != deleted) {
         return ot_.DB().RemoveUnitDefinition(unit);
@@ -1220,12 +1361,13 @@ ConstServerContract Wallet::Server(
     const Identifier& id,
     const std::chrono::milliseconds& timeout) const
 {
-    const std::string server = id.str();
+    const FixedIdentifier key(id);
     Lock mapLock(server_map_lock_);
-    bool inMap = (server_map_.find(server) != server_map_.end());
+    bool inMap = (server_map_.find(key) != server_map_.end());
     bool valid = false;
 
     if (!inMap) {
+        const std::string server = id.str();
         std::shared_ptr<proto::ServerContract> serialized;
 
         std::string alias;
@@ -1239,7 +1381,7 @@ ConstServerContract Wallet::Server(
             }
 
             if (nym) {
-                auto& pServer = server_map_[server];
+                auto& pServer = server_map_[key];
                 pServer.reset(ServerContract::Factory(nym, *serialized));
 
                 if (pServer) {
@@ -1259,8 +1401,7 @@ ConstServerContract Wallet::Server(
                 while (std::chrono::high_resolution_clock::now() < end) {
                     std::this_thread::sleep_for(interval);
                     mapLock.lock();
-                    bool found =
-                        (server_map_.find(server) != server_map_.end());
+                    bool found = (server_map_.find(key) != server_map_.end());
                     mapLock.unlock();
 
                     if (found) {
@@ -1273,14 +1414,19 @@ ConstServerContract Wallet::Server(
             }
         }
     } else {
-        auto& pServer = server_map_[server];
+        auto& pServer = server_map_[key];
         if (pServer) {
             valid = pServer->Validate();
         }
     }
 
     if (valid) {
-        return server_map_[server];
+        auto& entry = server_map_[key];
+        server_cache_.Touch(key, [&]() -> std::size_t {
+            return entry->Serialize()->GetSize();
+        });
+
+        return entry;
     }
 
     return nullptr;
@@ -1295,7 +1441,9 @@ ConstServerContract Wallet::Server(
         if (contract->Validate()) {
             if (ot_.DB().Store(contract->Contract(), contract->Alias())) {
                 Lock mapLock(server_map_lock_);
-                server_map_[server].reset(contract.release());
+                server_cache_.Erase(FixedIdentifier(server));
+                server_map_[FixedIdentifier(server)].reset(
+                    contract.release());
                 mapLock.unlock();
             }
         }
@@ -1321,7 +1469,9 @@ ConstServerContract Wallet::Server(const proto::ServerContract& contract) const
             if (candidate->Validate()) {
                 if (ot_.DB().Store(candidate->Contract(), candidate->Alias())) {
                     Lock mapLock(server_map_lock_);
-                    server_map_[server].reset(candidate.release());
+                    server_cache_.Erase(FixedIdentifier(server));
+                    server_map_[FixedIdentifier(server)].reset(
+                        candidate.release());
                     mapLock.unlock();
                 }
             }
@@ -1366,9 +1516,12 @@ bool Wallet::SetNymAlias(const Identifier& id, const std::string& alias) const
 {
     Lock mapLock(nym_map_lock_);
 
-    auto it = nym_map_.find(id.str());
+    const FixedIdentifier key(id);
+    auto it = nym_map_.find(key);
 
     if (nym_map_.end() != it) {
+        unindex_nym(mapLock, key);
+        nym_cache_.Erase(key);
         nym_map_.erase(it);
     }
 
@@ -1422,7 +1575,8 @@ bool Wallet::SetServerAlias(const Identifier& id, const std::string& alias)
 
     if (saved) {
         Lock mapLock(server_map_lock_);
-        server_map_.erase(server);
+        server_cache_.Erase(FixedIdentifier(id));
+        server_map_.erase(FixedIdentifier(id));
 
         return true;
     }
@@ -1439,7 +1593,8 @@ bool Wallet::SetUnitDefinitionAlias(
 
     if (saved) {
         Lock mapLock(unit_map_lock_);
-        unit_map_.erase(unit);
+        unit_cache_.Erase(FixedIdentifier(id));
+        unit_map_.erase(FixedIdentifier(id));
 
         return true;
     }
@@ -1456,12 +1611,13 @@ const ConstUnitDefinition Wallet::UnitDefinition(
     const Identifier& id,
     const std::chrono::milliseconds& timeout) const
 {
-    const std::string unit = id.str();
+    const FixedIdentifier key(id);
     Lock mapLock(unit_map_lock_);
-    bool inMap = (unit_map_.find(unit) != unit_map_.end());
+    bool inMap = (unit_map_.find(key) != unit_map_.end());
     bool valid = false;
 
     if (!inMap) {
+        const std::string unit = id.str();
         std::shared_ptr<proto::UnitDefinition> serialized;
 
         std::string alias;
@@ -1475,7 +1631,7 @@ const ConstUnitDefinition Wallet::UnitDefinition(
             }
 
             if (nym) {
-                auto& pUnit = unit_map_[unit];
+                auto& pUnit = unit_map_[key];
                 pUnit.reset(UnitDefinition::Factory(nym, *serialized));
 
                 if (pUnit) {
@@ -1495,7 +1651,7 @@ const ConstUnitDefinition Wallet::UnitDefinition(
                 while (std::chrono::high_resolution_clock::now() < end) {
                     std::this_thread::sleep_for(interval);
                     mapLock.lock();
-                    bool found = (unit_map_.find(unit) != unit_map_.end());
+                    bool found = (unit_map_.find(key) != unit_map_.end());
                     mapLock.unlock();
 
                     if (found) {
@@ -1508,14 +1664,19 @@ const ConstUnitDefinition Wallet::UnitDefinition(
             }
         }
     } else {
-        auto& pUnit = unit_map_[unit];
+        auto& pUnit = unit_map_[key];
         if (pUnit) {
             valid = pUnit->Validate();
         }
     }
 
     if (valid) {
-        return unit_map_[unit];
+        auto& entry = unit_map_[key];
+        unit_cache_.Touch(key, [&]() -> std::size_t {
+            return entry->Serialize()->GetSize();
+        });
+
+        return entry;
     }
 
     return nullptr;
@@ -1530,7 +1691,8 @@ ConstUnitDefinition Wallet::UnitDefinition(
         if (contract->Validate()) {
             if (ot_.DB().Store(contract->Contract(), contract->Alias())) {
                 Lock mapLock(unit_map_lock_);
-                unit_map_[unit].reset(contract.release());
+                unit_cache_.Erase(FixedIdentifier(unit));
+                unit_map_[FixedIdentifier(unit)].reset(contract.release());
                 mapLock.unlock();
             }
         }
@@ -1557,7 +1719,9 @@ ConstUnitDefinition Wallet::UnitDefinition(
             if (candidate->Validate()) {
                 if (ot_.DB().Store(candidate->Contract(), candidate->Alias())) {
                     Lock mapLock(unit_map_lock_);
-                    unit_map_[unit].reset(candidate.release());
+                    unit_cache_.Erase(FixedIdentifier(unit));
+                    unit_map_[FixedIdentifier(unit)].reset(
+                        candidate.release());
                     mapLock.unlock();
                 }
             }
@@ -1630,5 +1794,152 @@ ConstUnitDefinition Wallet::UnitDefinition(
     return UnitDefinition(Identifier(unit));
 }
 
+void Wallet::Trim(const std::size_t budget) const
+{
+    std::size_t evicted{0};
+    const auto excess = [&]() -> std::size_t {
+        const auto bytes = CacheStats().bytes_;
+
+        return (bytes > budget) ? (bytes - budget) : 0;
+    };
+    // Entries are only dropped if the map holds the last pointer to them
+    const auto release = [](auto& map) {
+        return [&map](const auto& key) -> bool {
+            auto it = map.find(key);
+
+            if (map.end() == it) {
+
+                return true;
+            }
+
+            if (1 < it->second.use_count()) {
+
+                return false;
+            }
+
+            map.erase(it);
+
+            return true;
+        };
+    };
+    std::size_t bytes = excess();
+
+    if (0 < bytes) {
+        Lock lock(context_map_lock_);
+        evicted += context_cache_.Evict(bytes, release(context_map_));
+        lock.unlock();
+        bytes = excess();
+    }
+
+    if (0 < bytes) {
+        Lock lock(server_map_lock_);
+        evicted += server_cache_.Evict(bytes, release(server_map_));
+        lock.unlock();
+        bytes = excess();
+    }
+
+    if (0 < bytes) {
+        Lock lock(unit_map_lock_);
+        evicted += unit_cache_.Evict(bytes, release(unit_map_));
+        lock.unlock();
+        bytes = excess();
+    }
+
+    if (0 < bytes) {
+        Lock lock(nym_map_lock_);
+        evicted += nym_cache_.Evict(
+            bytes, [&](const FixedIdentifier& key) -> bool {
+                auto it = nym_map_.find(key);
+
+                if (nym_map_.end() == it) {
+
+                    return true;
+                }
+
+                if (1 < it->second.second.use_count()) {
+
+                    return false;
+                }
+
+                unindex_nym(lock, key);
+                nym_map_.erase(it);
+
+                return true;
+            });
+    }
+
+    Lock peerLock(peer_map_lock_);
+
+    for (auto it = peer_lock_.begin(); peer_lock_.end() != it;) {
+        if (1 == it->second.use_count()) {
+            it = peer_lock_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    peerLock.unlock();
+    // A nymfile mutex is also in use while any cached context of its nym
+    // exists. Holding the context lock until the nymfile lock is acquired
+    // keeps new contexts from being created in between.
+    Lock contextLock(context_map_lock_);
+    std::unordered_set<FixedIdentifier> pinned{};
+
+    for (const auto& it : context_map_) {
+        const auto& [local, remote] = it.first;
+        pinned.emplace(local);
+        pinned.emplace(remote);
+    }
+
+    Lock nymfileLock(nymfile_map_lock_);
+    contextLock.unlock();
+
+    for (auto it = nymfile_lock_.begin(); nymfile_lock_.end() != it;) {
+        const bool unused =
+            (1 == it->second.use_count()) && (0 == pinned.count(it->first));
+
+        if (unused) {
+            it = nymfile_lock_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    nymfileLock.unlock();
+
+    if (0 < evicted) {
+        evictions_ += evicted;
+        const auto stats = CacheStats();
+        otInfo << OT_METHOD << __FUNCTION__ << ": Evicted " << evicted
+               << " objects. Resident: " << stats.nyms_ << " nyms, "
+               << stats.servers_ << " servers, " << stats.units_
+               << " units, " << stats.contexts_ << " contexts ("
+               << stats.bytes_ << " bytes)." << std::endl;
+    }
+}
+
+void Wallet::unindex_nym(const Lock&, const FixedIdentifier& key) const
+{
+    const auto it = nym_id_index_.find(key.str());
+
+    if (nym_id_index_.end() == it) {
+
+        return;
+    }
+
+    const auto& alias = it->second.second;
+    auto [entry, end] = nym_alias_index_.equal_range(alias);
+
+    while (end != entry) {
+        if (entry->second == key) {
+            entry = nym_alias_index_.erase(entry);
+        } else {
+            ++entry;
+        }
+    }
+
+    nym_id_index_.erase(it);
+}
+
 Wallet::~Wallet() {}
 }  // namespace opentxs::api
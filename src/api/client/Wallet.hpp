@@ -42,16 +42,22 @@
 #include "opentxs/Internal.hpp"
 
 #include "opentxs/api/client/Wallet.hpp"
+#include "opentxs/core/CacheIndex.hpp"
+#include "opentxs/core/FixedIdentifier.hpp"
 
+#include <atomic>
+#include <functional>
 #include <map>
 #include <mutex>
 #include <tuple>
+#include <unordered_map>
 
 namespace opentxs::api::client::implementation
 {
 class Wallet : virtual public opentxs::api::client::Wallet
 {
 public:
+    CacheStatistics CacheStats() const override;
     std::shared_ptr<const opentxs::Context> Context(
         const Identifier& notaryID,
         const Identifier& clientNymID) const override;
@@ -167,6 +173,7 @@ public:
         const override;
     bool SetUnitDefinitionAlias(const Identifier& id, const std::string& alias)
         const override;
+    void Trim(const std::size_t budget) const override;
     ObjectList UnitDefinitionList() const override;
     const ConstUnitDefinition UnitDefinition(
         const Identifier& id,
@@ -194,38 +201,61 @@ public:
 
 private:
     typedef std::pair<std::mutex, std::shared_ptr<class Nym>> NymLock;
-    typedef std::map<std::string, NymLock> NymMap;
-    typedef std::map<std::string, std::shared_ptr<class ServerContract>>
+    typedef std::unordered_map<FixedIdentifier, NymLock> NymMap;
+    /** nym id string, (key, alias at the time the nym was indexed) */
+    typedef std::map<std::string, std::pair<FixedIdentifier, std::string>>
+        NymIDIndex;
+    typedef std::multimap<std::string, FixedIdentifier> NymAliasIndex;
+    typedef std::unordered_map<
+        FixedIdentifier,
+        std::shared_ptr<class ServerContract>>
         ServerMap;
-    typedef std::map<std::string, std::shared_ptr<class UnitDefinition>>
+    typedef std::unordered_map<
+        FixedIdentifier,
+        std::shared_ptr<class UnitDefinition>>
         UnitMap;
-    typedef std::pair<std::string, std::string> ContextID;
-    typedef std::map<ContextID, std::shared_ptr<class Context>> ContextMap;
-    typedef std::pair<Identifier, Identifier> IssuerID;
+    typedef std::pair<FixedIdentifier, FixedIdentifier> ContextID;
+    typedef std::unordered_map<ContextID, std::shared_ptr<class Context>>
+        ContextMap;
+    typedef std::pair<FixedIdentifier, FixedIdentifier> IssuerID;
     typedef std::pair<std::mutex, std::shared_ptr<api::client::Issuer>>
         IssuerLock;
-    typedef std::map<IssuerID, IssuerLock> IssuerMap;
+    typedef std::unordered_map<IssuerID, IssuerLock> IssuerMap;
 
     friend class opentxs::api::implementation::Native;
 
     Native& ot_;
     mutable NymMap nym_map_;
+    /** Sorted indexes of nym_map_ used for prefix matching. Guarded by
+     *  nym_map_lock_ */
+    mutable NymIDIndex nym_id_index_;
+    mutable NymAliasIndex nym_alias_index_;
     mutable ServerMap server_map_;
     mutable UnitMap unit_map_;
     mutable ContextMap context_map_;
     mutable IssuerMap issuer_map_;
+    mutable CacheIndex<FixedIdentifier> nym_cache_;
+    mutable CacheIndex<FixedIdentifier> server_cache_;
+    mutable CacheIndex<FixedIdentifier> unit_cache_;
+    mutable CacheIndex<ContextID> context_cache_;
+    mutable std::atomic<std::uint64_t> evictions_;
     mutable std::mutex nym_map_lock_;
     mutable std::mutex server_map_lock_;
     mutable std::mutex unit_map_lock_;
     mutable std::mutex context_map_lock_;
     mutable std::mutex issuer_map_lock_;
     mutable std::mutex peer_map_lock_;
-    mutable std::map<std::string, std::mutex> peer_lock_;
+    /** Holders of a per-ID mutex keep the pointer for as long as they use the
+     *  mutex, so entries with no other owner can be dropped by Trim(). */
+    mutable std::map<std::string, std::shared_ptr<std::mutex>> peer_lock_;
     mutable std::mutex nymfile_map_lock_;
-    mutable std::map<Identifier, std::mutex> nymfile_lock_;
+    /** Contexts hold a reference to the nymfile mutex of one of their nyms.
+     *  Trim() keeps the entries of every nym with a cached context. */
+    mutable std::unordered_map<FixedIdentifier, std::shared_ptr<std::mutex>>
+        nymfile_lock_;
 
-    std::mutex& nymfile_lock(const Identifier& nymID) const;
-    std::mutex& peer_lock(const std::string& nymID) const;
+    std::shared_ptr<std::mutex> nymfile_lock(const Identifier& nymID) const;
+    std::shared_ptr<std::mutex> peer_lock(const std::string& nymID) const;
     void save(class Context* context) const;
     void save(const Lock& lock, api::client::Issuer* in) const;
     void save(class NymFile* nym, const Lock& lock) const;
@@ -234,6 +264,10 @@ private:
     std::shared_ptr<class Context> context(
         const Identifier& localNymID,
         const Identifier& remoteNymID) const;
+    void index_nym(
+        const Lock& lock,
+        const FixedIdentifier& key,
+        const std::string& alias) const;
     IssuerLock& issuer(
         const Identifier& nymID,
         const Identifier& issuerID,
@@ -260,6 +294,7 @@ private:
      */
     ConstUnitDefinition UnitDefinition(
         std::unique_ptr<class UnitDefinition>& contract) const;
+    void unindex_nym(const Lock& lock, const FixedIdentifier& key) const;
 
     Wallet(Native& ot);
     Wallet() = delete;
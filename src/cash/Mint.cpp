@@ -63,6 +63,7 @@
 #include <ostream>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace opentxs
 {
@@ -640,6 +641,44 @@ void Mint::UpdateContents()
     m_xmlUnsigned.Concatenate("%s", str_result.c_str());
 }
 
+// Subclasses which are able to sign several tokens at once override this.
+std::vector<bool> Mint::SignTokens(
+    const Nym& theNotary,
+    const std::vector<Token*>& theTokens,
+    std::vector<String>& theOutput,
+    int32_t nTokenIndex)
+{
+    std::vector<bool> output(theTokens.size(), false);
+    theOutput.assign(theTokens.size(), String());
+
+    for (std::size_t i = 0; i < theTokens.size(); ++i) {
+        OT_ASSERT(nullptr != theTokens[i]);
+
+        output[i] =
+            SignToken(theNotary, *theTokens[i], theOutput[i], nTokenIndex);
+    }
+
+    return output;
+}
+
+// Subclasses which are able to verify several tokens at once override this.
+std::vector<bool> Mint::VerifyTokens(
+    const Nym& theNotary,
+    std::vector<String>& theCleartextTokens,
+    const std::vector<int64_t>& theDenominations)
+{
+    OT_ASSERT(theCleartextTokens.size() == theDenominations.size());
+
+    std::vector<bool> output(theCleartextTokens.size(), false);
+
+    for (std::size_t i = 0; i < theCleartextTokens.size(); ++i) {
+        output[i] = VerifyToken(
+            theNotary, theCleartextTokens[i], theDenominations[i]);
+    }
+
+    return output;
+}
+
 // return -1 if error, 0 if nothing, and 1 if the node was processed.
 int32_t Mint::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
 {
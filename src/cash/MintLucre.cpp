@@ -50,6 +50,7 @@
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
 #include "opentxs/core/crypto/OTEnvelope.hpp"
 #include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/util/ParallelFor.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/Nym.hpp"
@@ -59,12 +60,18 @@
 #include <openssl/ossl_typ.h>
 #include <stdio.h>
 #include <sys/types.h>
+#include <cstdint>
+#include <map>
 #include <ostream>
+#include <vector>
 
 #ifdef __APPLE__
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #endif
 
+// Below this many tokens a batch is signed or verified on the calling thread
+#define OT_MINT_PARALLEL_TOKENS 4
+
 namespace opentxs
 {
 
@@ -196,6 +203,51 @@ bool MintLucre::AddDenomination(
 
 #if OT_CRYPTO_USING_OPENSSL
 
+namespace
+{
+// Lucre writes its debug output to one process-wide dumper BIO. A batch
+// points it at a null BIO before any worker starts, and the workers never
+// replace it, so they do not share a stream or race to set the dumper.
+class BatchDumper
+{
+public:
+    BatchDumper()
+        : null_(BIO_new(BIO_s_null()))
+    {
+        OT_ASSERT(nullptr != null_);
+
+        SetDumper(null_);
+    }
+
+    ~BatchDumper()
+    {
+        SetDumper(stderr);
+        BIO_free(null_);
+    }
+
+private:
+    BIO* null_{nullptr};
+
+    BatchDumper(const BatchDumper&) = delete;
+    BatchDumper& operator=(const BatchDumper&) = delete;
+};
+}  // namespace
+
+bool MintLucre::open_private_bank(
+    const Nym& theNotary,
+    int64_t lDenomination,
+    String& theOutput)
+{
+    // The Mint private info is encrypted in m_mapPrivate[lDenomination].
+    // So I need to extract that first before I can use it.
+    OTASCIIArmor thePrivate;
+    GetPrivate(thePrivate, lDenomination);
+    OTEnvelope theEnvelope(thePrivate);
+
+    // Decrypt the Envelope into theOutput
+    return theEnvelope.Open(theNotary, theOutput);
+}
+
 // Lucre step 3: the mint signs the token
 //
 bool MintLucre::SignToken(
@@ -204,28 +256,87 @@ bool MintLucre::SignToken(
     String& theOutput,
     int32_t nTokenIndex)
 {
-    bool bReturnValue = false;
-
     LucreDumper setDumper;
 
-    OpenSSL_BIO bioBank = BIO_new(BIO_s_mem());       // input
-    OpenSSL_BIO bioRequest = BIO_new(BIO_s_mem());    // input
-    OpenSSL_BIO bioSignature = BIO_new(BIO_s_mem());  // output
+    String strContents;  // output from opening the envelope.
 
-    OTASCIIArmor thePrivate;
-    GetPrivate(thePrivate, theToken.GetDenomination());
+    if (!open_private_bank(theNotary, theToken.GetDenomination(), strContents))
+        return false;
 
-    // The Mint private info is encrypted in
-    // m_mapPrivates[theToken.GetDenomination()].
-    // So I need to extract that first before I can use it.
-    OTEnvelope theEnvelope(thePrivate);
+    return sign_token(strContents, theToken, theOutput, nTokenIndex);
+}
 
-    String strContents;  // output from opening the envelope.
-    // Decrypt the Envelope into strContents
-    if (!theEnvelope.Open(theNotary, strContents)) return false;
+// Lucre step 3, for every token in a purse. The private bank information for
+// each denomination is only decrypted once, and the blind signatures are
+// calculated on worker threads.
+std::vector<bool> MintLucre::SignTokens(
+    const Nym& theNotary,
+    const std::vector<Token*>& theTokens,
+    std::vector<String>& theOutput,
+    int32_t nTokenIndex)
+{
+    BatchDumper setDumper;
+
+    // std::vector<bool> is not safe for concurrent writes to different
+    // elements, so the workers record results here.
+    std::vector<std::uint8_t> results(theTokens.size(), 0);
+    std::map<int64_t, String> banks{};
+    theOutput.assign(theTokens.size(), String());
+
+    for (const auto* token : theTokens) {
+        OT_ASSERT(nullptr != token);
+
+        const auto denomination = token->GetDenomination();
 
-    // copy strContents to a BIO
-    BIO_puts(bioBank, strContents.Get());
+        if (banks.end() != banks.find(denomination)) {
+            continue;
+        }
+
+        String strContents;
+
+        if (open_private_bank(theNotary, denomination, strContents)) {
+            banks.emplace(denomination, strContents);
+        } else {
+            otErr << "MintLucre::SignTokens: Unable to open private "
+                     "information for denomination "
+                  << denomination << "\n";
+        }
+    }
+
+    ParallelFor(
+        theTokens.size(),
+        OT_MINT_PARALLEL_TOKENS,
+        OT_PARALLEL_MAX_THREADS,
+        [&](const std::size_t i) {
+            auto& token = *theTokens[i];
+            const auto bank = banks.find(token.GetDenomination());
+
+            if (banks.end() == bank) {
+
+                return;
+            }
+
+            results[i] =
+                sign_token(bank->second, token, theOutput[i], nTokenIndex);
+        });
+
+    return std::vector<bool>(results.begin(), results.end());
+}
+
+bool MintLucre::sign_token(
+    const String& thePrivateBank,
+    Token& theToken,
+    String& theOutput,
+    int32_t nTokenIndex) const
+{
+    bool bReturnValue = false;
+
+    OpenSSL_BIO bioBank = BIO_new(BIO_s_mem());       // input
+    OpenSSL_BIO bioRequest = BIO_new(BIO_s_mem());    // input
+    OpenSSL_BIO bioSignature = BIO_new(BIO_s_mem());  // output
+
+    // copy the private bank info to a BIO
+    BIO_puts(bioBank, thePrivateBank.Get());
 
     // Instantiate the Bank with its private key
     Bank bank(bioBank);
@@ -313,60 +424,111 @@ bool MintLucre::VerifyToken(
     String& theCleartextToken,
     int64_t lDenomination)
 {
-    bool bReturnValue = false;
     LucreDumper setDumper;
 
+    String strContents;  // will contain output from opening the envelope.
+
+    if (!open_private_bank(theNotary, lDenomination, strContents)) return false;
+
+    return verify_token(strContents, theCleartextToken);
+}
+
+// Lucre step 5, for every token in a purse. The private bank information for
+// each denomination is only decrypted once, and the coins are verified on
+// worker threads.
+std::vector<bool> MintLucre::VerifyTokens(
+    const Nym& theNotary,
+    std::vector<String>& theCleartextTokens,
+    const std::vector<int64_t>& theDenominations)
+{
+    OT_ASSERT(theCleartextTokens.size() == theDenominations.size());
+
+    BatchDumper setDumper;
+
+    std::vector<std::uint8_t> results(theCleartextTokens.size(), 0);
+    std::map<int64_t, String> banks{};
+
+    for (const auto& denomination : theDenominations) {
+        if (banks.end() != banks.find(denomination)) {
+            continue;
+        }
+
+        String strContents;
+
+        if (open_private_bank(theNotary, denomination, strContents)) {
+            banks.emplace(denomination, strContents);
+        } else {
+            otErr << "MintLucre::VerifyTokens: Unable to open private "
+                     "information for denomination "
+                  << denomination << "\n";
+        }
+    }
+
+    ParallelFor(
+        theCleartextTokens.size(),
+        OT_MINT_PARALLEL_TOKENS,
+        OT_PARALLEL_MAX_THREADS,
+        [&](const std::size_t i) {
+            const auto bank = banks.find(theDenominations[i]);
+
+            if (banks.end() == bank) {
+
+                return;
+            }
+
+            results[i] = verify_token(bank->second, theCleartextTokens[i]);
+        });
+
+    return std::vector<bool>(results.begin(), results.end());
+}
+
+bool MintLucre::verify_token(
+    const String& thePrivateBank,
+    const String& theCleartextToken) const
+{
+    bool bReturnValue = false;
+
     OpenSSL_BIO bioBank = BIO_new(BIO_s_mem());  // input
     OpenSSL_BIO bioCoin = BIO_new(BIO_s_mem());  // input
 
     // --- copy theCleartextToken to bioCoin so lucre can load it
     BIO_puts(bioCoin, theCleartextToken.Get());
 
-    // --- The Mint private info is encrypted in m_mapPrivate[lDenomination].
-    // So I need to extract that first before I can use it.
-    OTASCIIArmor theArmor;
-    GetPrivate(theArmor, lDenomination);
-    OTEnvelope theEnvelope(theArmor);
+    // copy the private bank info to a BIO
+    BIO_puts(bioBank, thePrivateBank.Get());
 
-    String strContents;  // will contain output from opening the envelope.
-    // Decrypt the Envelope into strContents
-    if (theEnvelope.Open(theNotary, strContents)) {
-        // copy strContents to a BIO
-        BIO_puts(bioBank, strContents.Get());
-
-        // ---- Now the bank and coin bios are both ready to go...
-
-        Bank bank(bioBank);
-        Coin coin(bioCoin);
-
-        if (bank.Verify(coin))  // Here's the boolean output: coin is verified!
-        {
-            bReturnValue = true;
-
-            // (Done): When a token is redeemed, need to store it in the spent
-            // token database.
-            // Right now I can verify the token, but unless I check it against a
-            // database, then
-            // even though the signature verifies, it doesn't stop people from
-            // redeeming the same
-            // token again and again and again.
-            //
-            // (done): also need to make sure issuer has double-entries for
-            // total amount outstanding.
-            //
-            // UPDATE: These are both done now.  The Spent Token database is
-            // implemented in the transaction server,
-            // (not OTLib proper) and the same server also now keeps a cash
-            // account to match all cash withdrawals.
-            // (Meaning, if 10,000 clams total have been withdrawn by various
-            // users, then the server actually has
-            // a clam account containing 10,000 clams. As the cash comes in for
-            // redemption, the server debits it from
-            // this account again before sending it to its final destination.
-            // This way the server tracks total outstanding
-            // amount, as an additional level of security after the blind
-            // signature itself.)
-        }
+    // ---- Now the bank and coin bios are both ready to go...
+
+    Bank bank(bioBank);
+    Coin coin(bioCoin);
+
+    if (bank.Verify(coin))  // Here's the boolean output: coin is verified!
+    {
+        bReturnValue = true;
+
+        // (Done): When a token is redeemed, need to store it in the spent
+        // token database.
+        // Right now I can verify the token, but unless I check it against a
+        // database, then
+        // even though the signature verifies, it doesn't stop people from
+        // redeeming the same
+        // token again and again and again.
+        //
+        // (done): also need to make sure issuer has double-entries for
+        // total amount outstanding.
+        //
+        // UPDATE: These are both done now.  The Spent Token database is
+        // implemented in the transaction server,
+        // (not OTLib proper) and the same server also now keeps a cash
+        // account to match all cash withdrawals.
+        // (Meaning, if 10,000 clams total have been withdrawn by various
+        // users, then the server actually has
+        // a clam account containing 10,000 clams. As the cash comes in for
+        // redemption, the server debits it from
+        // this account again before sending it to its final destination.
+        // This way the server tracks total outstanding
+        // amount, as an additional level of security after the blind
+        // signature itself.)
     }
 
     return bReturnValue;
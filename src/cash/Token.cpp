@@ -50,7 +50,6 @@
 #include "opentxs/core/Instrument.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/Nym.hpp"
-#include "opentxs/core/OTStorage.hpp"
 #include "opentxs/core/OTStringXML.hpp"
 #include "opentxs/core/String.hpp"
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
@@ -58,7 +57,6 @@
 #include "opentxs/core/crypto/OTNymOrSymmetricKey.hpp"
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/util/Common.hpp"
-#include "opentxs/core/util/OTFolders.hpp"
 #include "opentxs/core/util/Tag.hpp"
 
 #include <irrxml/irrXML.hpp>
@@ -455,115 +453,6 @@ Token* Token::TokenFactory(String strInput)
     return nullptr;
 }
 
-// Note: ALL failures will return true, even if the token has NOT already been
-// spent, and the failure was actually due to a directory creation error. Why,
-// you might ask? Because no matter WHAT is causing the failure, any return of
-// false is a signal that the token is SAFE TO ACCEPT AS TENDER. If there was a
-// temporary file system error, someone could suddenly deposit the same token
-// over and over again and this method would return "false" (Token is "not
-// already
-// spent.")
-//
-// We simply cannot risk that, so false is not returned unless execution reaches
-// the very bottom of this method. Every other error acts as if the token is
-// no good, for security reasons. If the token really IS good, the user can
-// submit
-// it again later and it will work.
-//
-bool Token::IsTokenAlreadySpent(String& theCleartextToken)
-{
-    String strInstrumentDefinitionID(GetInstrumentDefinitionID());
-
-    // Calculate the filename (a hash of the Lucre cleartext token ID)
-    Identifier theTokenHash;
-    theTokenHash.CalculateDigest(theCleartextToken);
-
-    // Grab the new hash into a string (for use as a filename)
-    String strTokenHash(theTokenHash);
-
-    String strAssetFolder;
-    strAssetFolder.Format(
-        "%s.%d", strInstrumentDefinitionID.Get(), GetSeries());
-
-    bool bTokenIsPresent = OTDB::Exists(
-        OTFolders::Spent().Get(), strAssetFolder.Get(), strTokenHash.Get());
-
-    if (bTokenIsPresent) {
-        otOut << "\nToken::IsTokenAlreadySpent: Token was already spent: "
-              << OTFolders::Spent() << Log::PathSeparator() << strAssetFolder
-              << Log::PathSeparator() << strTokenHash << "\n";
-        return true;  // all errors must return true in this function.
-                      // But this is not an error. Token really WAS already
-    }                 // spent, and this true is for real. The others are just
-                      // for security reasons because of this one.
-
-    // This is the ideal case: the token was NOT already spent, it was good,
-    // so we can return false and the depositor can be credited appropriately.
-    // IsTokenAlreadySpent?  NO-it was NOT already spent. You can only POSSIBLY
-    // get a false out of this method if you actually reached the bottom (here.)
-    return false;
-}
-
-bool Token::RecordTokenAsSpent(String& theCleartextToken)
-{
-    String strInstrumentDefinitionID(GetInstrumentDefinitionID());
-
-    // Calculate the filename (a hash of the Lucre cleartext token ID)
-    Identifier theTokenHash;
-    theTokenHash.CalculateDigest(theCleartextToken);
-
-    // Grab the new hash into a string (for use as a filename)
-    String strTokenHash(theTokenHash);
-
-    String strAssetFolder;
-    strAssetFolder.Format(
-        "%s.%d", strInstrumentDefinitionID.Get(), GetSeries());
-
-    // See if the spent token file ALREADY EXISTS...
-    bool bTokenIsPresent = OTDB::Exists(
-        OTFolders::Spent().Get(), strAssetFolder.Get(), strTokenHash.Get());
-
-    // If so, we're trying to record a token that was already recorded...
-    if (bTokenIsPresent) {
-        otErr << "Token::RecordTokenAsSpent: Trying to record token as spent,"
-                 " but it was already recorded: "
-              << OTFolders::Spent() << Log::PathSeparator() << strAssetFolder
-              << Log::PathSeparator() << strTokenHash << "\n";
-        return false;
-    }
-
-    // FINISHED:
-    //
-    // We actually save the token itself into the file, which is named based
-    // on a hash of the Lucre data.
-    // The success of that operation is also now the success of this one.
-
-    String strFinal;
-    OTASCIIArmor ascTemp(m_strRawFile);
-
-    if (false ==
-        ascTemp.WriteArmoredString(strFinal, m_strContractType.Get())) {
-        otErr << "Token::RecordTokenAsSpent: Error recording token as "
-                 "spent (failed writing armored string):\n"
-              << OTFolders::Spent() << Log::PathSeparator() << strAssetFolder
-              << Log::PathSeparator() << strTokenHash << "\n";
-        return false;
-    }
-
-    const bool bSaved = OTDB::StorePlainString(
-        strFinal.Get(),
-        OTFolders::Spent().Get(),
-        strAssetFolder.Get(),
-        strTokenHash.Get());
-    if (!bSaved) {
-        otErr << "Token::RecordTokenAsSpent: Error saving file: "
-              << OTFolders::Spent() << Log::PathSeparator() << strAssetFolder
-              << Log::PathSeparator() << strTokenHash << "\n";
-    }
-
-    return bSaved;
-}
-
 // OTSymmetricKey:
 // static bool CreateNewKey(OTString & strOutput, const OTString *
 // pstrDisplay=nullptr, const OTPassword * pAlreadyHavePW=nullptr);
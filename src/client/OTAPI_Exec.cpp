@@ -6817,8 +6817,8 @@ bool OTAPI_Exec::Msg_HarvestTransactionNumbers(
     const bool& bTransactionWasSuccess,
     const bool& bTransactionWasFailure) const
 {
-    rLock lock(lock_);
-
+    // The server ID is not known until the message is parsed, so the context
+    // lock (which must precede the API lock) is taken by each branch below.
     OT_VERIFY_ID_STR(NYM_ID);
     OT_VERIFY_STD_STR(THE_MESSAGE);
 
@@ -6925,6 +6925,8 @@ bool OTAPI_Exec::Msg_HarvestTransactionNumbers(
                 return false;
             }
 
+            rLock contextLock(ot_api_.ContextLock(theNymID, serverID));
+            rLock lock(lock_);
             auto context = wallet_.mutable_ServerContext(theNymID, serverID);
             theRequestBasket.HarvestClosingNumbers(
                 context.It(), serverID, true);
@@ -7246,6 +7248,20 @@ std::string OTAPI_Exec::LoadServerContract(
     return {};
 }
 
+std::string OTAPI_Exec::LoadMarketData(
+    const std::string& NOTARY_ID,
+    const std::string& MARKET_ID,
+    const std::int64_t& INTERVAL) const
+{
+    OT_VERIFY_ID_STR(NOTARY_ID);
+    OT_VERIFY_ID_STR(MARKET_ID);
+
+    const Identifier theNotaryID(NOTARY_ID);
+    const Identifier theMarketID(MARKET_ID);
+
+    return ot_api_.LoadMarketData(theNotaryID, theMarketID, INTERVAL);
+}
+
 // LOAD ACCOUNT / INBOX / OUTBOX   --  (from local storage)
 //
 // Loads an acct, or inbox or outbox, based on account ID, (from local storage)
@@ -11377,13 +11393,13 @@ bool OTAPI_Exec::ResyncNymWithServer(
     const std::string& NYM_ID,
     const std::string& THE_MESSAGE) const
 {
-    rLock lock(lock_);
-
     OT_VERIFY_ID_STR(NOTARY_ID);
     OT_VERIFY_ID_STR(NYM_ID);
     OT_VERIFY_STD_STR(THE_MESSAGE);
 
     Identifier theNotaryID(NOTARY_ID), theNymID(NYM_ID);
+    rLock contextLock(ot_api_.ContextLock(theNymID, theNotaryID));
+    rLock lock(lock_);
     const String strMessage(THE_MESSAGE), strNymID(theNymID);
 
     auto context = wallet_.mutable_ServerContext(theNymID, theNotaryID);
@@ -118,6 +118,7 @@ const std::map<OTAPI_Func_Type, std::string> OTAPI_Func::type_name_{
     {REQUEST_ADMIN, "REQUEST_ADMIN"},
     {SERVER_ADD_CLAIM, "SERVER_ADD_CLAIM"},
     {STORE_SECRET, "STORE_SECRET"},
+    {GET_MARKET_DATA, "GET_MARKET_DATA"},
 };
 
 const std::map<OTAPI_Func_Type, bool> OTAPI_Func::type_type_{
@@ -167,10 +168,11 @@ const std::map<OTAPI_Func_Type, bool> OTAPI_Func::type_type_{
     {REQUEST_ADMIN, false},
     {SERVER_ADD_CLAIM, false},
     {STORE_SECRET, false},
+    {GET_MARKET_DATA, false},
 };
 
 OTAPI_Func::OTAPI_Func(
-    std::recursive_mutex& apiLock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const OTAPI_Exec& exec,
     const OT_API& otapi,
@@ -178,7 +180,7 @@ OTAPI_Func::OTAPI_Func(
     const Identifier& serverID,
     const OTAPI_Func_Type type)
     : type_(type)
-    , api_lock_{apiLock}
+    , context_lock_{contextLock}
     , accountID_(Identifier::Factory())
     , basketID_(Identifier::Factory())
     , currencyAccountID_(Identifier::Factory())
@@ -213,7 +215,9 @@ OTAPI_Func::OTAPI_Func(
     , isPrimary_(false)
     , selling_(false)
     , senderCopyIncluded_(false)
+    , from_(OT_TIME_ZERO)
     , lifetime_(OT_TIME_ZERO)
+    , to_(OT_TIME_ZERO)
     , nRequestNum_(-1)
     , nTransNumsNeeded_(0)
     , wallet_(wallet)
@@ -232,6 +236,7 @@ OTAPI_Func::OTAPI_Func(
     , amount_(0)
     , depth_(0)
     , increment_(0)
+    , interval_(0)
     , quantity_(0)
     , price_(0)
     , scale_(0)
@@ -242,18 +247,18 @@ OTAPI_Func::OTAPI_Func(
     , secretType_(proto::SECRETTYPE_ERROR)
     , unitDefinition_{}
 {
-    OT_ASSERT(verify_lock(api_lock_, apiLock));
+    OT_ASSERT(verify_lock(context_lock_, contextLock));
 }
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
     const OTAPI_Exec& exec,
     const OT_API& otapi)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     if (theType == DELETE_NYM) {
         nTransNumsNeeded_ = 0;           // Is this true?
@@ -273,14 +278,14 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
     const OTAPI_Exec& exec,
     const OT_API& otapi,
     const std::string& password)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     std::string strError =
         "Warning: Empty std::string passed to OTAPI_Func.OTAPI_Func() as: ";
@@ -303,14 +308,14 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
     const OTAPI_Exec& exec,
     const OT_API& otapi,
     const proto::UnitDefinition& unitDefinition)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     switch (theType) {
         case (ISSUE_BASKET):
@@ -327,14 +332,14 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
     const OTAPI_Exec& exec,
     const OT_API& otapi,
     const Identifier& nymID2)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     switch (theType) {
         case CREATE_ASSET_ACCT: {
@@ -369,7 +374,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -377,7 +382,7 @@ OTAPI_Func::OTAPI_Func(
     const OT_API& otapi,
     const Identifier& accountID,
     std::unique_ptr<Ledger>& ledger)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     switch (theType) {
         case PROCESS_INBOX: {
@@ -394,7 +399,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -402,7 +407,7 @@ OTAPI_Func::OTAPI_Func(
     const OT_API& otapi,
     const Identifier& targetID,
     const Identifier& instrumentDefinitionID)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     switch (theType) {
         case INITIATE_BAILMENT: {
@@ -425,7 +430,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -433,7 +438,7 @@ OTAPI_Func::OTAPI_Func(
     const OT_API& otapi,
     const Identifier& accountID,
     std::unique_ptr<Cheque>& cheque)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     switch (theType) {
         case DEPOSIT_CHEQUE: {
@@ -450,7 +455,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -458,7 +463,7 @@ OTAPI_Func::OTAPI_Func(
     const OT_API& otapi,
     const Identifier& nymID2,
     std::unique_ptr<Purse>& purse)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     switch (theType) {
         case DEPOSIT_CASH: {
@@ -480,7 +485,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -488,7 +493,7 @@ OTAPI_Func::OTAPI_Func(
     const OT_API& otapi,
     const Identifier& recipientID,
     std::unique_ptr<OTPaymentPlan>& paymentPlan)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     std::string strError =
         "Warning: Empty std::string passed to OTAPI_Func.OTAPI_Func() as: ";
@@ -508,7 +513,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -516,7 +521,7 @@ OTAPI_Func::OTAPI_Func(
     const OT_API& otapi,
     const Identifier& nymID2,
     const std::int64_t& int64val)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     switch (theType) {
         case ADJUST_USAGE_CREDITS: {
@@ -547,7 +552,35 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
+    const api::client::Wallet& wallet,
+    const Identifier& nymID,
+    const Identifier& serverID,
+    const OTAPI_Exec& exec,
+    const OT_API& otapi,
+    const Identifier& marketID,
+    const std::int64_t& interval,
+    const time64_t from,
+    const time64_t to)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
+{
+    switch (theType) {
+        case GET_MARKET_DATA: {
+            marketID_ = marketID;
+            interval_ = interval;
+            from_ = from;
+            to_ = to;
+        } break;
+        default: {
+            otOut << "ERROR! WRONG TYPE passed to OTAPI_Func.OTAPI_Func()\n";
+            OT_FAIL
+        }
+    }
+}
+
+OTAPI_Func::OTAPI_Func(
+    OTAPI_Func_Type theType,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -555,7 +588,7 @@ OTAPI_Func::OTAPI_Func(
     const OT_API& otapi,
     const Identifier& targetID,
     const proto::ConnectionInfoType& infoType)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     infoType_ = infoType;
 
@@ -581,7 +614,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -590,7 +623,7 @@ OTAPI_Func::OTAPI_Func(
     const Identifier& recipientID,
     const Identifier& requestID,
     const bool ack)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     if (theType == ACKNOWLEDGE_NOTICE) {
         nTransNumsNeeded_ = 0;
@@ -609,7 +642,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -618,7 +651,7 @@ OTAPI_Func::OTAPI_Func(
     const TransactionNumber& transactionNumber,
     const std::string& clause,
     const std::string& parameter)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     std::string strError =
         "Warning: Empty std::string passed to OTAPI_Func.OTAPI_Func() as: ";
@@ -646,7 +679,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -654,7 +687,7 @@ OTAPI_Func::OTAPI_Func(
     const OT_API& otapi,
     const Identifier& recipientID,
     std::unique_ptr<const OTPayment>& payment)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     nTransNumsNeeded_ = 1;
 
@@ -671,7 +704,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -679,7 +712,7 @@ OTAPI_Func::OTAPI_Func(
     const OT_API& otapi,
     const Identifier& recipientID,
     const std::string& message)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     std::string strError =
         "Warning: Empty std::string passed to OTAPI_Func.OTAPI_Func() as: ";
@@ -703,7 +736,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -712,7 +745,7 @@ OTAPI_Func::OTAPI_Func(
     const Identifier& accountID,
     const RemoteBoxType& remoteBoxType,
     const TransactionNumber& transactionNumber)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     nTransNumsNeeded_ = 1;
 
@@ -730,7 +763,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -739,7 +772,7 @@ OTAPI_Func::OTAPI_Func(
     const Identifier& accountID,
     const std::string& agentName,
     std::unique_ptr<OTSmartContract>& contract)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     std::string strError =
         "Warning: Empty std::string passed to OTAPI_Func.OTAPI_Func() as: ";
@@ -774,7 +807,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -783,7 +816,7 @@ OTAPI_Func::OTAPI_Func(
     const Identifier& recipientID,
     const Identifier& requestID,
     const std::string& instructions)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     switch (theType) {
         case ACKNOWLEDGE_BAILMENT: {
@@ -825,7 +858,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -835,7 +868,7 @@ OTAPI_Func::OTAPI_Func(
     const Identifier& targetID,
     const Amount& amount,
     const std::string& message)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     amount_ = amount;
     nTransNumsNeeded_ = 0;
@@ -884,7 +917,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -894,7 +927,7 @@ OTAPI_Func::OTAPI_Func(
     const std::string& primary,
     const std::string& secondary,
     const proto::SecretType& secretType)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     primary_ = primary;
     secondary_ = secondary;
@@ -935,7 +968,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -944,7 +977,7 @@ OTAPI_Func::OTAPI_Func(
     const Identifier& recipientID,
     std::unique_ptr<const Purse>& purse,
     std::unique_ptr<const Purse>& senderPurse)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     nTransNumsNeeded_ = 1;
 
@@ -965,7 +998,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -976,7 +1009,7 @@ OTAPI_Func::OTAPI_Func(
     const Identifier& instrumentDefinitionID,
     const std::string& txid,
     const Amount& amount)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     std::string strError =
         "Warning: Empty std::string passed to OTAPI_Func.OTAPI_Func() as: ";
@@ -1013,7 +1046,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -1023,7 +1056,7 @@ OTAPI_Func::OTAPI_Func(
     const proto::ContactSectionName& sectionName,
     const proto::ContactItemType& itemType,
     const std::string& value)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     const std::string strError =
         "Warning: Empty std::string passed to OTAPI_Func.OTAPI_Func() as: ";
@@ -1049,7 +1082,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -1060,7 +1093,7 @@ OTAPI_Func::OTAPI_Func(
     const Identifier& accountID,
     bool direction,
     std::int32_t nTransNumsNeeded)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     if (EXCHANGE_BASKET == theType) {
         // FYI. This is a transaction.
@@ -1076,7 +1109,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -1089,7 +1122,7 @@ OTAPI_Func::OTAPI_Func(
     const std::string& password,
     const std::string& key,
     bool ack)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     accountID_ = recipientID;
     requestID_ = requestID;
@@ -1143,7 +1176,7 @@ OTAPI_Func::OTAPI_Func(
 
 OTAPI_Func::OTAPI_Func(
     OTAPI_Func_Type theType,
-    std::recursive_mutex& apilock,
+    std::recursive_mutex& contextLock,
     const api::client::Wallet& wallet,
     const Identifier& nymID,
     const Identifier& serverID,
@@ -1159,7 +1192,7 @@ OTAPI_Func::OTAPI_Func(
     const time64_t lifetime,
     const Amount& activationPrice,
     const std::string& stopSign)
-    : OTAPI_Func(apilock, wallet, exec, otapi, nymID, serverID, theType)
+    : OTAPI_Func(contextLock, wallet, exec, otapi, nymID, serverID, theType)
 {
     if (VerifyStringVal(stopSign)) {
         stopSign_ = stopSign;
@@ -1416,6 +1449,10 @@ void OTAPI_Func::run()
         case GET_MARKET_RECENT_TRADES: {
             last_attempt_ = otapi_.getMarketRecentTrades(context_, marketID_);
         } break;
+        case GET_MARKET_DATA: {
+            last_attempt_ = otapi_.getMarketData(
+                context_, marketID_, interval_, from_, to_);
+        } break;
         case CREATE_MARKET_OFFER: {
             const Identifier ASSET_ACCT_ID(accountID_);
             const Identifier CURRENCY_ACCT_ID(currencyAccountID_);
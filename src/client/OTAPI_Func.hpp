@@ -107,7 +107,8 @@ typedef enum {
     REGISTER_CONTRACT_UNIT = 44,
     REQUEST_ADMIN = 45,
     SERVER_ADD_CLAIM = 46,
-    STORE_SECRET = 47
+    STORE_SECRET = 47,
+    GET_MARKET_DATA = 48
 } OTAPI_Func_Type;
 
 class OTAPI_Func : virtual public opentxs::client::ServerAction, Lockable
@@ -115,7 +116,7 @@ class OTAPI_Func : virtual public opentxs::client::ServerAction, Lockable
 public:
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -123,7 +124,7 @@ public:
         const OT_API& otapi);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -132,7 +133,7 @@ public:
         const std::string& password);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -141,7 +142,7 @@ public:
         const proto::UnitDefinition& unitDefinition);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -150,7 +151,7 @@ public:
         const Identifier& nymID2);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -160,7 +161,7 @@ public:
         const proto::ConnectionInfoType& infoType);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -170,7 +171,19 @@ public:
         const std::int64_t& int64Val);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
+        const api::client::Wallet& wallet,
+        const Identifier& nymID,
+        const Identifier& serverID,
+        const OTAPI_Exec& exec,
+        const OT_API& otapi,
+        const Identifier& marketID,
+        const std::int64_t& interval,
+        const time64_t from,
+        const time64_t to);
+    explicit OTAPI_Func(
+        OTAPI_Func_Type theType,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -180,7 +193,7 @@ public:
         std::unique_ptr<Ledger>& ledger);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -190,7 +203,7 @@ public:
         const Identifier& instrumentDefinitionID);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -200,7 +213,7 @@ public:
         std::unique_ptr<Cheque>& cheque);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -210,7 +223,7 @@ public:
         std::unique_ptr<Purse>& purse);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -220,7 +233,7 @@ public:
         std::unique_ptr<OTPaymentPlan>& paymentPlan);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -231,7 +244,7 @@ public:
         const std::string& parameter);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -241,7 +254,7 @@ public:
         std::unique_ptr<const OTPayment>& payment);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -251,7 +264,7 @@ public:
         const std::string& message);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -262,7 +275,7 @@ public:
         const TransactionNumber& transactionNumber);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -273,7 +286,7 @@ public:
         std::unique_ptr<OTSmartContract>& contract);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -284,7 +297,7 @@ public:
         const std::string& instructions);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -295,7 +308,7 @@ public:
         const bool ack);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -307,7 +320,7 @@ public:
         const std::string& message);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -319,7 +332,7 @@ public:
         const proto::SecretType& secretType);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -330,7 +343,7 @@ public:
         std::unique_ptr<const Purse>& senderPurse);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -343,7 +356,7 @@ public:
         const Amount& amount);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -355,7 +368,7 @@ public:
         const std::string& value);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -368,7 +381,7 @@ public:
         std::int32_t nTransNumsNeeded);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -383,7 +396,7 @@ public:
         bool ack);
     explicit OTAPI_Func(
         OTAPI_Func_Type theType,
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const Identifier& nymID,
         const Identifier& serverID,
@@ -416,7 +429,7 @@ private:
     static const std::map<OTAPI_Func_Type, bool> type_type_;
 
     OTAPI_Func_Type type_{NO_FUNC};
-    rLock api_lock_;
+    rLock context_lock_;
     OTIdentifier accountID_;
     OTIdentifier basketID_;
     OTIdentifier currencyAccountID_;
@@ -451,7 +464,9 @@ private:
     bool isPrimary_{false};
     bool selling_{false};
     bool senderCopyIncluded_{false};
+    time64_t from_{OT_TIME_ZERO};
     time64_t lifetime_{OT_TIME_ZERO};
+    time64_t to_{OT_TIME_ZERO};
     std::int32_t nRequestNum_{-1};
     std::int32_t nTransNumsNeeded_{0};
     const api::client::Wallet& wallet_;
@@ -470,6 +485,7 @@ private:
     Amount amount_{0};
     Amount depth_{0};
     Amount increment_{0};
+    std::int64_t interval_{0};
     Amount quantity_{0};
     Amount price_{0};
     Amount scale_{0};
@@ -490,7 +506,7 @@ private:
     std::string send_transaction(const std::size_t totalRetries);
 
     explicit OTAPI_Func(
-        std::recursive_mutex& apilock,
+        std::recursive_mutex& contextLock,
         const api::client::Wallet& wallet,
         const OTAPI_Exec& exec,
         const OT_API& otapi,
@@ -94,6 +94,7 @@
 #include <cstdio>
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <string>
 
 #define OT_METHOD "opentxs::OTClient::"
@@ -5794,6 +5795,51 @@ bool OTClient::processServerReplyGetMarketOffers(const Message& theReply)
     return true;
 }
 
+bool OTClient::processServerReplyGetMarketData(const Message& theReply)
+{
+    const String& strMarketID = theReply.m_strNymID2;  // market ID stored here.
+    String strData;
+
+    if ((theReply.m_ascPayload.GetLength() <= 2) ||
+        (false == theReply.m_ascPayload.GetString(strData))) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Unable to decode payload in getMarketDataResponse reply."
+              << std::endl;
+
+        return true;
+    }
+
+    // The first line of the payload names the interval which was queried
+    std::istringstream header(strData.Get());
+    std::string label{};
+    std::int64_t interval{-1};
+    header >> label >> interval;
+
+    if (("interval" != label) || (0 > interval)) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Invalid header in getMarketDataResponse reply."
+              << std::endl;
+
+        return true;
+    }
+
+    const std::string filename =
+        std::string(strMarketID.Get()) + "_" + std::to_string(interval);
+    const bool bSuccessStore = OTDB::StorePlainString(
+        strData.Get(),
+        OTFolders::Market().Get(),     // "markets"
+        theReply.m_strNotaryID.Get(),  // "markets/<notaryID>"
+        "data",                        // "markets/<notaryID>/data"
+        filename);  // "markets/<notaryID>/data/<marketID>_<interval>"
+
+    if (false == bSuccessStore) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Error storing " << filename
+              << " to market folder." << std::endl;
+    }
+
+    return true;
+}
+
 bool OTClient::processServerReplyGetMarketRecentTrades(const Message& theReply)
 {
     const String& strMarketID = theReply.m_strNymID2;  // market ID stored here.
@@ -6280,6 +6326,9 @@ bool OTClient::processServerReply(
         return processServerReplyGetMint(theReply);
 #endif  // OT_CASH
     }
+    if (theReply.m_strCommand.Compare("getMarketDataResponse")) {
+        return processServerReplyGetMarketData(theReply);
+    }
     if (theReply.m_strCommand.Compare("getMarketListResponse")) {
         return processServerReplyGetMarketList(theReply);
     }
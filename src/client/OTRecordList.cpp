@@ -42,6 +42,7 @@
 
 #include "opentxs/api/client/Cash.hpp"
 #include "opentxs/api/client/ServerAction.hpp"
+#include "opentxs/api/client/Wallet.hpp"
 #include "opentxs/api/Activity.hpp"
 #include "opentxs/api/Api.hpp"
 #include "opentxs/api/ContactManager.hpp"
@@ -54,6 +55,7 @@
 #include "opentxs/client/ServerAction.hpp"
 #include "opentxs/client/SwigWrap.hpp"
 #include "opentxs/client/Utility.hpp"
+#include "opentxs/consensus/ServerContext.hpp"
 #include "opentxs/contact/Contact.hpp"
 #include "opentxs/contact/ContactData.hpp"
 #include "opentxs/core/contract/UnitDefinition.hpp"
@@ -61,6 +63,8 @@
 #include "opentxs/core/script/OTSmartContract.hpp"
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/util/Common.hpp"
+#include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/util/ParallelFor.hpp"
 #include "opentxs/core/Account.hpp"
 #include "opentxs/core/Cheque.hpp"
 #include "opentxs/core/Identifier.hpp"
@@ -68,6 +72,7 @@
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/Message.hpp"
 #include "opentxs/core/Nym.hpp"
+#include "opentxs/core/OTStorage.hpp"
 #include "opentxs/core/String.hpp"
 #include "opentxs/ext/Helpers.hpp"
 #include "opentxs/ext/OTPayment.hpp"
@@ -76,12 +81,14 @@
 
 #include <inttypes.h>
 #include <stdint.h>
+#include <algorithm>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <ostream>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace
 {
@@ -109,11 +116,54 @@ const std::string& GetTypeString(int theType)
     return Instrument_TypeStrings[theType];
 }
 
+std::string box_folder(const opentxs::Ledger::ledgerType type)
+{
+    switch (type) {
+        case opentxs::Ledger::inbox: {
+
+            return opentxs::OTFolders::Inbox().Get();
+        }
+        case opentxs::Ledger::outbox: {
+
+            return opentxs::OTFolders::Outbox().Get();
+        }
+        case opentxs::Ledger::paymentInbox: {
+
+            return opentxs::OTFolders::PaymentInbox().Get();
+        }
+        case opentxs::Ledger::recordBox: {
+
+            return opentxs::OTFolders::RecordBox().Get();
+        }
+        case opentxs::Ledger::expiredBox: {
+
+            return opentxs::OTFolders::ExpiredBox().Get();
+        }
+        default: {
+
+            return {};
+        }
+    }
+}
+
+// Same layout as the box's own storage location: folder/notary/owner
+std::string box_key(
+    const opentxs::Ledger::ledgerType type,
+    const std::string& notary,
+    const std::string& owner)
+{
+    return box_folder(type) + "/" + notary + "/" + owner;
+}
+
 }  // namespace
 
 namespace opentxs
 {
 
+#define OT_RECORD_LIST_PARALLEL_BOXES 2
+
+#define OT_METHOD "opentxs::OTRecordList::"
+
 // DISPLAY FORMATTING FOR "TO:" AND "FROM:"
 #define MC_UI_TEXT_TO "%s"
 #define MC_UI_TEXT_FROM "%s"
@@ -421,6 +471,7 @@ void OTRecordList::SetNotaryID(std::string str_id)
 
 void OTRecordList::AddNotaryID(std::string str_id)
 {
+    ResetIndex();
     m_servers.insert(m_servers.end(), str_id);
 }
 
@@ -429,6 +480,7 @@ void OTRecordList::AddNotaryID(std::string str_id)
 void OTRecordList::ClearServers()
 {
     ClearContents();
+    ResetIndex();
     m_servers.clear();
 }
 
@@ -469,6 +521,7 @@ void OTRecordList::AddInstrumentDefinitionID(std::string str_id)
         str_asset_name = SwigWrap::GetAssetType_Name(
             str_id);  // Otherwise we try to grab the name.
     // (Otherwise we just leave it blank. The ID is too big to cram in here.)
+    ResetIndex();
     m_assets.insert(
         std::pair<std::string, std::string>(str_id, str_asset_name));
 }
@@ -476,6 +529,7 @@ void OTRecordList::AddInstrumentDefinitionID(std::string str_id)
 void OTRecordList::ClearAssets()
 {
     ClearContents();
+    ResetIndex();
     m_assets.clear();
 }
 
@@ -487,12 +541,14 @@ void OTRecordList::SetNymID(std::string str_id)
 
 void OTRecordList::AddNymID(std::string str_id)
 {
+    ResetIndex();
     m_nyms.insert(m_nyms.end(), str_id);
 }
 
 void OTRecordList::ClearNyms()
 {
     ClearContents();
+    ResetIndex();
     m_nyms.clear();
 }
 
@@ -971,7 +1027,8 @@ std::int32_t OTRecordList::depositCheque( // a static method
 
     std::string response;
     {
-        rLock lock(opentxs::OT::App().API().Lock());
+        rLock lock(OT::App().API().OTAPI().ContextLock(
+            Identifier(mynym), Identifier(server)));
         response = OT::App()
                           .API()
                           .ServerAction()
@@ -993,7 +1050,8 @@ std::int32_t OTRecordList::depositCheque( // a static method
     }
 
     {
-        rLock lock(opentxs::OT::App().API().Lock());
+        rLock lock(OT::App().API().OTAPI().ContextLock(
+            Identifier(mynym), Identifier(server)));
         if (!OT::App().API().ServerAction().DownloadAccount(
                 Identifier(mynym), Identifier(server), Identifier(myacct), true)) {
             otOut << "Error retrieving intermediary files for account.\n";
@@ -1104,7 +1162,8 @@ std::int32_t OTRecordList::confirmPaymentPlan_lowLevel( // a static method
     }
 
     {
-        rLock lock(opentxs::OT::App().API().Lock());
+        rLock lock(OT::App().API().OTAPI().ContextLock(
+            Identifier(senderUser), Identifier(server)));
         if (!OT::App().API().ServerAction().GetTransactionNumbers(
                 Identifier(senderUser), Identifier(server), 2)) {
             otOut << "Error: cannot reserve transaction numbers.\n";
@@ -1130,7 +1189,8 @@ std::int32_t OTRecordList::confirmPaymentPlan_lowLevel( // a static method
 
     std::string response;
     {
-        rLock lock(opentxs::OT::App().API().Lock());
+        rLock lock(OT::App().API().OTAPI().ContextLock(
+            Identifier(senderUser), Identifier(server)));
         response = OT::App()
             .API()
             .ServerAction()
@@ -1159,7 +1219,8 @@ std::int32_t OTRecordList::confirmPaymentPlan_lowLevel( // a static method
     }
 
     {
-        rLock lock(opentxs::OT::App().API().Lock());
+        rLock lock(OT::App().API().OTAPI().ContextLock(
+            Identifier(senderUser), Identifier(server)));
         if (!OT::App().API().ServerAction().DownloadAccount(
                 Identifier(senderUser),
                 Identifier(server),
@@ -1545,7 +1606,8 @@ std::int32_t OTRecordList::cancel_outgoing_payments(
             contract->LoadContractFromString(String(payment));
             std::string response;
             {
-                rLock lock(opentxs::OT::App().API().Lock());
+                rLock lock(OT::App().API().OTAPI().ContextLock(
+                    theNymID, theNotaryID));
                 response = OT::App()
                                   .API()
                                   .ServerAction()
@@ -1590,7 +1652,8 @@ std::int32_t OTRecordList::cancel_outgoing_payments(
             plan->LoadContractFromString(String(payment));
             std::string response;
             {
-                rLock lock(opentxs::OT::App().API().Lock());
+                rLock lock(OT::App().API().OTAPI().ContextLock(
+                    theNymID, theNotaryID));
                 response = OT::App()
                     .API()
                     .ServerAction()
@@ -1725,7 +1788,7 @@ std::int32_t OTRecordList::acceptFromInbox( // a static method
     const Identifier theNotaryID{server}, theNymID{mynym}, theAcctID{myacct};
 
     {
-        rLock lock(opentxs::OT::App().API().Lock());
+        rLock lock(OT::App().API().OTAPI().ContextLock(theNymID, theNotaryID));
         if (!OT::App().API().ServerAction().GetTransactionNumbers(
             theNymID, theNotaryID, 10)) {
             otOut << "Error: cannot reserve transaction numbers.\n";
@@ -1859,7 +1922,7 @@ std::int32_t OTRecordList::acceptFromInbox( // a static method
     // ----------------------------------------------
     std::string notary_response;
     {
-        rLock lock(opentxs::OT::App().API().Lock());
+        rLock lock(OT::App().API().OTAPI().ContextLock(theNymID, theNotaryID));
         notary_response = OT::App()
             .API()
             .ServerAction()
@@ -1878,7 +1941,7 @@ std::int32_t OTRecordList::acceptFromInbox( // a static method
     // the inbox. Might as well refresh our copy with the new changes.
     //
     {
-        rLock lock(opentxs::OT::App().API().Lock());
+        rLock lock(OT::App().API().OTAPI().ContextLock(theNymID, theNotaryID));
         if (!OT::App().API().ServerAction().DownloadAccount(
             theNymID, theNotaryID, theAcctID, true)) {
             otOut << __FUNCTION__
@@ -1902,12 +1965,14 @@ std::int32_t OTRecordList::acceptFromInbox( // a static method
 
 void OTRecordList::AddAccountID(std::string str_id)
 {
+    ResetIndex();
     m_accounts.insert(m_accounts.end(), str_id);
 }
 
 void OTRecordList::ClearAccounts()
 {
     ClearContents();
+    ResetIndex();
     m_accounts.clear();
 }
 
@@ -2475,7 +2540,8 @@ bool OTRecordList::PerformAutoAccept()
                             20;  // I'm just hardcoding: "Make sure I have at
                                  // least 20 transaction numbers."
                         {
-                            rLock lock(api_lock_);
+                            rLock lock(OT::App().API().OTAPI().ContextLock(
+                                theNymID, theNotaryID));
                             if (!OT::App()
                                  .API()
                                  .ServerAction()
@@ -2558,7 +2624,8 @@ bool OTRecordList::PerformAutoAccept()
 
                 std::string strResponse;
                 {
-                    rLock lock(api_lock_);
+                    rLock lock(OT::App().API().OTAPI().ContextLock(
+                        theNymID, theNotaryID));
                     strResponse = OT::App()
                         .API()
                         .ServerAction()
@@ -2580,7 +2647,8 @@ bool OTRecordList::PerformAutoAccept()
                     // inbox, outbox, etc)
                     // since they have probably changed from this operation.
                     //
-                    rLock lock(api_lock_);
+                    rLock lock(OT::App().API().OTAPI().ContextLock(
+                        theNymID, theNotaryID));
                     bool bRetrieved =
                         OT::App().API().ServerAction().DownloadAccount(
                             theNymID,
@@ -2604,6 +2672,243 @@ bool OTRecordList::PerformAutoAccept()
 
 // Populates m_contents from OT API. Calls ClearContents().
 
+struct OTRecordList::PreparedBox {
+    Ledger::ledgerType type_{Ledger::error_state};
+    std::string key_{};
+    std::string notary_{};
+    std::string nym_{};
+    std::string owner_{};
+    std::string hash_{};
+    bool unchanged_{false};
+    bool loaded_{false};
+    std::unique_ptr<Ledger> ledger_{nullptr};
+};
+
+// Records which a box produced on this pass are remembered under the digest of
+// the contents they were parsed from. Later passes over the same box in this
+// call reuse them as well.
+void OTRecordList::index_box(
+    PreparedBoxes& boxes,
+    const std::string& key,
+    const std::size_t first)
+{
+    const auto it = boxes.find(key);
+
+    if (boxes.end() == it) {
+
+        return;
+    }
+
+    auto& box = *it->second;
+
+    if (box.unchanged_) {
+
+        return;
+    }
+
+    if (false == box.loaded_) {
+        m_index.erase(key);
+
+        return;
+    }
+
+    m_index[key] = {
+        box.hash_,
+        vec_OTRecordList(m_contents.begin() + first, m_contents.end())};
+    box.unchanged_ = true;
+}
+
+// Reads a box and, unless its digest matches the indexed one, parses (and in
+// normal mode verifies) it the same way the OT_API box loaders do.
+void OTRecordList::prepare_box(PreparedBox& box) const
+{
+    const auto folder = box_folder(box.type_);
+
+    if (false == OTDB::Exists(folder, box.notary_, box.owner_)) {
+
+        return;
+    }
+
+    const String contents(
+        OTDB::QueryPlainString(folder, box.notary_, box.owner_));
+    Identifier digest{};
+
+    if (digest.CalculateDigest(contents)) {
+        box.hash_ = digest.str();
+    }
+
+    const auto indexed = m_index.find(box.key_);
+
+    if ((false == box.hash_.empty()) && (m_index.end() != indexed) &&
+        (indexed->second.first == box.hash_)) {
+        box.unchanged_ = true;
+
+        return;
+    }
+
+    if (m_bRunFast && (false == OT::App().Wallet().IsLocalNym(box.nym_))) {
+
+        return;
+    }
+
+    const Identifier nymID(box.nym_);
+    const Identifier ownerID(box.owner_);
+    const Identifier notaryID(box.notary_);
+    std::unique_ptr<Ledger> ledger{
+        Ledger::GenerateLedger(nymID, ownerID, notaryID, box.type_)};
+
+    OT_ASSERT(ledger);
+
+    bool loaded{false};
+
+    switch (box.type_) {
+        case Ledger::inbox: {
+            loaded = ledger->LoadInboxFromString(contents);
+        } break;
+        case Ledger::outbox: {
+            loaded = ledger->LoadOutboxFromString(contents);
+        } break;
+        case Ledger::paymentInbox: {
+            loaded = ledger->LoadPaymentInboxFromString(contents);
+        } break;
+        case Ledger::recordBox: {
+            loaded = ledger->LoadRecordBoxFromString(contents);
+        } break;
+        case Ledger::expiredBox: {
+            loaded = ledger->LoadExpiredBoxFromString(contents);
+        } break;
+        default: {
+        }
+    }
+
+    if (loaded && (false == m_bRunFast)) {
+        const auto context = OT::App().Wallet().ServerContext(nymID, notaryID);
+        loaded = bool(context) && ledger->VerifyAccount(*context->Nym());
+    }
+
+    if (false == loaded) {
+        otWarn << OT_METHOD << __FUNCTION__ << ": Unable to load or verify "
+               << box.key_ << std::endl;
+
+        return;
+    }
+
+    box.ledger_.reset(ledger.release());
+    box.loaded_ = true;
+}
+
+void OTRecordList::prepare_boxes(OTWallet& wallet, PreparedBoxes& boxes) const
+{
+    auto add = [&](
+        const Ledger::ledgerType type,
+        const std::string& notary,
+        const std::string& nym,
+        const std::string& owner) -> void {
+        const auto key = box_key(type, notary, owner);
+
+        if (0 < boxes.count(key)) {
+
+            return;
+        }
+
+        std::unique_ptr<PreparedBox> box(new PreparedBox);
+        box->type_ = type;
+        box->key_ = key;
+        box->notary_ = notary;
+        box->nym_ = nym;
+        box->owner_ = owner;
+        boxes.emplace(key, std::move(box));
+    };
+
+    for (const auto& nym : m_nyms) {
+        if (nym.empty()) {
+            continue;
+        }
+
+        if (nullptr == OT::App().Wallet().Nym(Identifier(nym))) {
+            continue;
+        }
+
+        for (const auto& server : m_servers) {
+            if (false == bool(OT::App().Wallet().Server(Identifier(server)))) {
+                continue;
+            }
+
+            add(Ledger::paymentInbox, server, nym, nym);
+            add(Ledger::recordBox, server, nym, nym);
+            add(Ledger::expiredBox, server, nym, nym);
+        }
+    }
+
+    for (const auto& account : m_accounts) {
+        const auto pAccount = wallet.GetAccount(Identifier(account));
+
+        if (false == bool(pAccount)) {
+            continue;
+        }
+
+        const std::string nym(String(pAccount->GetNymID()).Get());
+        const std::string notary(
+            String(pAccount->GetPurportedNotaryID()).Get());
+        const std::string unit(
+            String(pAccount->GetInstrumentDefinitionID()).Get());
+        const bool wanted =
+            (m_nyms.end() != std::find(m_nyms.begin(), m_nyms.end(), nym)) &&
+            (m_servers.end() !=
+             std::find(m_servers.begin(), m_servers.end(), notary)) &&
+            (m_assets.end() != m_assets.find(unit));
+
+        if (nym.empty() || (false == wanted)) {
+            continue;
+        }
+
+        add(Ledger::inbox, notary, nym, account);
+        add(Ledger::outbox, notary, nym, account);
+        add(Ledger::recordBox, notary, nym, account);
+    }
+
+    std::vector<PreparedBox*> pending{};
+
+    for (auto& it : boxes) {
+        pending.push_back(it.second.get());
+    }
+
+    ParallelFor(
+        pending.size(),
+        OT_RECORD_LIST_PARALLEL_BOXES,
+        OT_PARALLEL_MAX_THREADS,
+        [&](const std::size_t i) { prepare_box(*pending.at(i)); });
+}
+
+// Hands over the ledger which prepare_boxes parsed for this box. If the box
+// is unchanged its indexed records are appended instead, and no ledger is
+// returned.
+Ledger* OTRecordList::take_box(
+    PreparedBoxes& boxes,
+    const std::string& key,
+    bool& unchanged)
+{
+    unchanged = false;
+    const auto it = boxes.find(key);
+
+    if (boxes.end() == it) {
+
+        return nullptr;
+    }
+
+    auto& box = *it->second;
+
+    if (box.unchanged_) {
+        const auto& records = m_index.at(key).second;
+        m_contents.insert(m_contents.end(), records.begin(), records.end());
+        unchanged = true;
+
+        return nullptr;
+    }
+
+    return box.ledger_.release();
+}
+
 bool OTRecordList::Populate()
 {
     OT_ASSERT(nullptr != m_pLookup);
@@ -2627,6 +2932,11 @@ bool OTRecordList::Populate()
     // automatically.
     //
     PerformAutoAccept();
+    // Read every box this list covers and parse the ones which changed since
+    // the previous call. The records of unchanged boxes are reused below.
+    //
+    PreparedBoxes boxes{};
+    prepare_boxes(*pWallet, boxes);
     // OUTPAYMENTS, OUTMAIL, MAIL, PAYMENTS INBOX, and RECORD BOX (2 kinds.)
     // Loop through the Nyms.
     //
@@ -3236,13 +3546,13 @@ bool OTRecordList::Populate()
             // will, however, work
             // either way.
             Ledger* pInbox{nullptr};
+            const auto inboxKey =
+                box_key(Ledger::paymentInbox, it_server, str_nym_id);
+            const auto inboxFirst = m_contents.size();
+            bool inboxUnchanged{false};
 
             if (false == theNymID.empty()) {
-                pInbox = m_bRunFast
-                             ? OT::App().API().OTAPI().LoadPaymentInboxNoVerify(
-                                   theNotaryID, theNymID)
-                             : OT::App().API().OTAPI().LoadPaymentInbox(
-                                   theNotaryID, theNymID);
+                pInbox = take_box(boxes, inboxKey, inboxUnchanged);
             }
 
             std::unique_ptr<Ledger> theInboxAngel(pInbox);
@@ -3555,23 +3865,25 @@ bool OTRecordList::Populate()
                     m_contents.push_back(sp_Record);
 
                 }  // looping through inbox.
-            } else
+            } else if (false == inboxUnchanged)
                 otWarn << __FUNCTION__
                        << ": Failed loading payments inbox. "
                           "(Probably just doesn't exist yet.)\n";
+
+            index_box(boxes, inboxKey, inboxFirst);
             nIndex = (-1);
 
             // Also loop through its record box. For this record box, pass the
             // NYM_ID twice, since it's the recordbox for the Nym.
             // OPTIMIZE FYI: m_bRunFast impacts run speed here.
             Ledger* pRecordbox{nullptr};
+            const auto recordKey =
+                box_key(Ledger::recordBox, it_server, str_nym_id);  // twice.
+            const auto recordFirst = m_contents.size();
+            bool recordUnchanged{false};
 
             if (false == theNymID.empty()) {
-                pRecordbox =
-                    m_bRunFast ? OT::App().API().OTAPI().LoadRecordBoxNoVerify(
-                                     theNotaryID, theNymID, theNymID)  // twice.
-                               : OT::App().API().OTAPI().LoadRecordBox(
-                                     theNotaryID, theNymID, theNymID);
+                pRecordbox = take_box(boxes, recordKey, recordUnchanged);
             }
 
             std::unique_ptr<Ledger> theRecordBoxAngel(pRecordbox);
@@ -4167,25 +4479,27 @@ bool OTRecordList::Populate()
                     m_contents.push_back(sp_Record);
 
                 }  // Loop through Recordbox
-            } else
+            } else if (false == recordUnchanged)
                 otWarn << __FUNCTION__
                        << ": Failed loading payments record "
                           "box. (Probably just doesn't exist "
                           "yet.)\n";
 
+            index_box(boxes, recordKey, recordFirst);
+
             // EXPIRED RECORDS:
             nIndex = (-1);
 
             // Also loop through its expired record box.
             // OPTIMIZE FYI: m_bRunFast impacts run speed here.
             Ledger* pExpiredbox{nullptr};
+            const auto expiredKey =
+                box_key(Ledger::expiredBox, it_server, str_nym_id);
+            const auto expiredFirst = m_contents.size();
+            bool expiredUnchanged{false};
 
             if (false == theNymID.empty()) {
-                pExpiredbox =
-                    m_bRunFast ? OT::App().API().OTAPI().LoadExpiredBoxNoVerify(
-                                     theNotaryID, theNymID)
-                               : OT::App().API().OTAPI().LoadExpiredBox(
-                                     theNotaryID, theNymID);
+                pExpiredbox = take_box(boxes, expiredKey, expiredUnchanged);
             }
 
             std::unique_ptr<Ledger> theExpiredBoxAngel(pExpiredbox);
@@ -4745,11 +5059,13 @@ bool OTRecordList::Populate()
                     m_contents.push_back(sp_Record);
 
                 }  // Loop through ExpiredBox
-            } else
+            } else if (false == expiredUnchanged)
                 otWarn << __FUNCTION__
                        << ": Failed loading expired payments box. "
                           "(Probably just doesn't exist yet.)\n";
 
+            index_box(boxes, expiredKey, expiredFirst);
+
         }  // Loop through servers for each Nym.
     }      // Loop through Nyms.
            // ASSET ACCOUNT -- INBOX/OUTBOX + RECORD BOX
@@ -4836,12 +5152,13 @@ bool OTRecordList::Populate()
         // Populating.
         //
         Ledger* pInbox{nullptr};
+        const auto inboxKey =
+            box_key(Ledger::inbox, str_notary_id, str_account_id);
+        const auto inboxFirst = m_contents.size();
+        bool inboxUnchanged{false};
 
         if (false == theNymID.empty()) {
-            pInbox = m_bRunFast ? OT::App().API().OTAPI().LoadInboxNoVerify(
-                                      theNotaryID, theNymID, theAccountID)
-                                : OT::App().API().OTAPI().LoadInbox(
-                                      theNotaryID, theNymID, theAccountID);
+            pInbox = take_box(boxes, inboxKey, inboxUnchanged);
         }
 
         std::unique_ptr<Ledger> theInboxAngel(pInbox);
@@ -5119,6 +5436,8 @@ bool OTRecordList::Populate()
                 m_contents.push_back(sp_Record);
             }
         }
+
+        index_box(boxes, inboxKey, inboxFirst);
         // OPTIMIZE FYI:
         // NOTE: LoadOutbox is much SLOWER than LoadOutboxNoVerify, but it also
         // lets you get
@@ -5127,12 +5446,13 @@ bool OTRecordList::Populate()
         // return for FASTER PERFORMANCE, then call SetFastMode() before running
         // Populate.
         Ledger* pOutbox{nullptr};
+        const auto outboxKey =
+            box_key(Ledger::outbox, str_notary_id, str_account_id);
+        const auto outboxFirst = m_contents.size();
+        bool outboxUnchanged{false};
 
         if (false == theNymID.empty()) {
-            pOutbox = m_bRunFast ? OT::App().API().OTAPI().LoadOutboxNoVerify(
-                                       theNotaryID, theNymID, theAccountID)
-                                 : OT::App().API().OTAPI().LoadOutbox(
-                                       theNotaryID, theNymID, theAccountID);
+            pOutbox = take_box(boxes, outboxKey, outboxUnchanged);
         }
 
         std::unique_ptr<Ledger> theOutboxAngel(pOutbox);
@@ -5313,6 +5633,8 @@ bool OTRecordList::Populate()
                 m_contents.push_back(sp_Record);
             }
         }
+
+        index_box(boxes, outboxKey, outboxFirst);
         // For this record box, pass a NymID AND an AcctID,
         // since it's the recordbox for a specific account.
         //
@@ -5324,13 +5646,13 @@ bool OTRecordList::Populate()
         // return for FASTER PERFORMANCE, then call SetFastMode() before
         // Populating.
         Ledger* pRecordbox{nullptr};
+        const auto recordKey =
+            box_key(Ledger::recordBox, str_notary_id, str_account_id);
+        const auto recordFirst = m_contents.size();
+        bool recordUnchanged{false};
 
         if (false == theNymID.empty()) {
-            pRecordbox = m_bRunFast
-                             ? OT::App().API().OTAPI().LoadRecordBoxNoVerify(
-                                   theNotaryID, theNymID, theAccountID)
-                             : OT::App().API().OTAPI().LoadRecordBox(
-                                   theNotaryID, theNymID, theAccountID);
+            pRecordbox = take_box(boxes, recordKey, recordUnchanged);
         }
 
         std::unique_ptr<Ledger> theRecordBoxAngel(pRecordbox);
@@ -5830,6 +6152,7 @@ bool OTRecordList::Populate()
             }
         }
 
+        index_box(boxes, recordKey, recordFirst);
     }  // loop through the accounts.
     // SORT the vector.
     //
@@ -6030,6 +6353,8 @@ OTRecordList::~OTRecordList()
 
 void OTRecordList::ClearContents() { m_contents.clear(); }
 
+void OTRecordList::ResetIndex() { m_index.clear(); }
+
 // RETRIEVE:
 //
 
@@ -542,7 +542,8 @@ OT_API::OT_API(
     , m_pWallet(nullptr)
     , m_pClient(nullptr)
     , lock_(lock)
-
+    , context_lock_map_lock_()
+    , context_locks_()
 {
     pid_.reset(new Pid);
 
@@ -870,6 +871,27 @@ std::set<Identifier> OT_API::LocalNymList() const
     return wallet_.LocalNyms();
 }
 
+std::recursive_mutex& OT_API::ContextLock(
+    const Identifier& nymID,
+    const Identifier& serverID) const
+{
+    Lock lock(context_lock_map_lock_);
+    auto& output = context_locks_[{nymID, serverID}];
+
+    if (false == bool(output)) {
+        output.reset(new std::recursive_mutex);
+    }
+
+    OT_ASSERT(output)
+
+    return *output;
+}
+
+std::recursive_mutex& OT_API::context_lock(const ServerContext& context) const
+{
+    return ContextLock(context.Nym()->ID(), context.Server());
+}
+
 std::set<AccountInfo> OT_API::Accounts() const
 {
     auto wallet = GetWallet(__FUNCTION__);
@@ -3003,6 +3025,7 @@ bool OT_API::SmartContract_ConfirmParty(
                               // party.
                               // (For now, until I code entities)
 {
+    rLock contextLock(ContextLock(NYM_ID, NOTARY_ID));
     rLock lock(lock_);
     auto context = wallet_.mutable_ServerContext(NYM_ID, NOTARY_ID);
 
@@ -3984,6 +4007,7 @@ bool OT_API::Msg_HarvestTransactionNumbers(
     bool bTransactionWasSuccess,        // false until positively asserted.
     bool bTransactionWasFailure) const  // false until positively asserted.
 {
+    rLock contextLock(ContextLock(NYM_ID, Identifier(theMsg.m_strNotaryID)));
     rLock lock(lock_);
     auto context =
         wallet_.mutable_ServerContext(NYM_ID, Identifier(theMsg.m_strNotaryID));
@@ -4039,6 +4063,7 @@ bool OT_API::HarvestClosingNumbers(
     const Identifier& NYM_ID,
     const String& THE_CRON_ITEM) const
 {
+    rLock contextLock(ContextLock(NYM_ID, NOTARY_ID));
     rLock lock(lock_);
     auto context = wallet_.mutable_ServerContext(NYM_ID, NOTARY_ID);
 
@@ -4085,6 +4110,7 @@ bool OT_API::HarvestAllNumbers(
     const Identifier& NYM_ID,
     const String& THE_CRON_ITEM) const
 {
+    rLock contextLock(ContextLock(NYM_ID, NOTARY_ID));
     rLock lock(lock_);
     auto context = wallet_.mutable_ServerContext(NYM_ID, NOTARY_ID);
 
@@ -4223,6 +4249,7 @@ Cheque* OT_API::WriteCheque(
     const String& CHEQUE_MEMO,
     const Identifier* pRECIPIENT_NYM_ID) const
 {
+    rLock contextLock(ContextLock(SENDER_NYM_ID, NOTARY_ID));
     rLock lock(lock_);
     auto context = wallet_.mutable_ServerContext(SENDER_NYM_ID, NOTARY_ID);
     auto nymfile = context.It().mutable_Nymfile(__FUNCTION__);
@@ -4381,6 +4408,7 @@ OTPaymentPlan* OT_API::ProposePaymentPlan(
     std::int32_t PAYMENT_PLAN_MAX_PAYMENTS  // expires, or after the maximum
     ) const                                 // number of payments. These last
 {                                           // two arguments are optional.
+    rLock lock(ContextLock(RECIPIENT_NYM_ID, NOTARY_ID));
     auto context = wallet_.mutable_ServerContext(RECIPIENT_NYM_ID, NOTARY_ID);
     auto nymfile = context.It().mutable_Nymfile(__FUNCTION__);
 
@@ -4573,6 +4601,7 @@ bool OT_API::ConfirmPaymentPlan(
     const Identifier& RECIPIENT_NYM_ID,
     OTPaymentPlan& thePlan) const
 {
+    rLock contextLock(ContextLock(SENDER_NYM_ID, NOTARY_ID));
     rLock lock(lock_);
     auto context = wallet_.mutable_ServerContext(SENDER_NYM_ID, NOTARY_ID);
     auto nymfile = context.It().mutable_Nymfile(__FUNCTION__);
@@ -5785,6 +5814,27 @@ Mint* OT_API::LoadMint(
 }
 #endif  // OT_CASH
 
+std::string OT_API::LoadMarketData(
+    const Identifier& NOTARY_ID,
+    const Identifier& MARKET_ID,
+    const std::int64_t interval) const
+{
+    const std::string notaryID = String(NOTARY_ID).Get();
+    const std::string filename =
+        std::string(String(MARKET_ID).Get()) + "_" + std::to_string(interval);
+
+    if (false == OTDB::Exists(
+                     OTFolders::Market().Get(), notaryID, "data", filename)) {
+        otOut << OT_METHOD << __FUNCTION__ << ": No market data for "
+              << filename << " on notary " << notaryID << std::endl;
+
+        return {};
+    }
+
+    return OTDB::QueryPlainString(
+        OTFolders::Market().Get(), notaryID, "data", filename);
+}
+
 // LOAD ASSET ACCOUNT
 //
 // Caller is NOT responsible to delete -- I add it to the wallet!
@@ -6509,6 +6559,7 @@ bool OT_API::RecordPayment(
                           // outpayments box) and moves to record box.
     bool bSaveCopy) const
 {
+    rLock contextLock(ContextLock(NYM_ID, NOTARY_ID));
     rLock lock(lock_);
     auto context = wallet_.mutable_ServerContext(NYM_ID, NOTARY_ID);
     auto nymfile = context.It().mutable_Nymfile(__FUNCTION__);
@@ -8021,6 +8072,7 @@ void OT_API::FlushSentMessages(
     const Identifier& NYM_ID,
     const Ledger& THE_NYMBOX) const
 {
+    rLock contextLock(ContextLock(NYM_ID, NOTARY_ID));
     rLock lock(lock_);
     auto context = wallet_.mutable_ServerContext(NYM_ID, NOTARY_ID);
     auto nym = wallet_.Nym(NYM_ID);
@@ -8288,7 +8340,7 @@ CommandResult OT_API::issueBasket(
     ServerContext& context,
     const proto::UnitDefinition& basket) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -8332,6 +8384,7 @@ Basket* OT_API::GenerateBasketExchange(
     const Identifier& accountID,
     std::int32_t TRANSFER_MULTIPLE) const
 {
+    rLock contextLock(ContextLock(NYM_ID, NOTARY_ID));
     rLock lock(lock_);
     auto context = wallet_.mutable_ServerContext(NYM_ID, NOTARY_ID);
     auto nym = context.It().Nym();
@@ -8415,6 +8468,7 @@ bool OT_API::AddBasketExchangeItem(
     const Identifier& INSTRUMENT_DEFINITION_ID,
     const Identifier& ASSET_ACCOUNT_ID) const
 {
+    rLock contextLock(ContextLock(NYM_ID, NOTARY_ID));
     rLock lock(lock_);
     auto context = wallet_.mutable_ServerContext(NYM_ID, NOTARY_ID);
     auto nym = context.It().Nym();
@@ -8608,7 +8662,7 @@ CommandResult OT_API::exchangeBasket(
     bool bExchangeInOrOut  // exchanging in == true, out == false.
     ) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -8781,7 +8835,7 @@ CommandResult OT_API::exchangeBasket(
 
 CommandResult OT_API::getTransactionNumbers(ServerContext& context) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -8826,7 +8880,7 @@ CommandResult OT_API::notarizeWithdrawal(
     const Identifier& accountID,
     const Amount amount) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -9055,7 +9109,7 @@ CommandResult OT_API::notarizeDeposit(
     const Identifier& accountID,
     const String& THE_PURSE) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -9298,7 +9352,7 @@ CommandResult OT_API::payDividend(
                                            // PER SHARE (multiplied by total
                                            // number of shares issued.)
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -9570,7 +9624,7 @@ CommandResult OT_API::withdrawVoucher(
     const String& CHEQUE_MEMO,
     const Amount amount) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -9774,6 +9828,7 @@ bool OT_API::DiscardCheque(
     const Identifier& accountID,
     const String& THE_CHEQUE) const
 {
+    rLock contextLock(ContextLock(NYM_ID, NOTARY_ID));
     rLock lock(lock_);
     auto context = wallet_.mutable_ServerContext(NYM_ID, NOTARY_ID);
     auto nym = context.It().Nym();
@@ -9853,7 +9908,7 @@ CommandResult OT_API::depositCheque(
     const Identifier& accountID,
     const String& THE_CHEQUE) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -10091,7 +10146,7 @@ CommandResult OT_API::depositPaymentPlan(
     ServerContext& context,
     const String& THE_PAYMENT_PLAN) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -10225,7 +10280,7 @@ CommandResult OT_API::triggerClause(
     const String& strClauseName,
     const String* pStrParam) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -10266,7 +10321,7 @@ CommandResult OT_API::activateSmartContract(
     ServerContext& context,
     const String& THE_SMART_CONTRACT) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -10616,7 +10671,7 @@ CommandResult OT_API::cancelCronItem(
     const Identifier& ASSET_ACCOUNT_ID,
     const TransactionNumber& lTransactionNum) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -10745,7 +10800,7 @@ CommandResult OT_API::issueMarketOffer(
     const Amount ACTIVATION_PRICE) const  // For stop orders, this is
                                           // threshhold price.
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -11066,7 +11121,7 @@ CommandResult OT_API::issueMarketOffer(
 /// the reply to storage, for your convenience.)
 CommandResult OT_API::getMarketList(ServerContext& context) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -11103,7 +11158,7 @@ CommandResult OT_API::getMarketOffers(
     const Identifier& MARKET_ID,
     const std::int64_t& lDepth) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -11146,7 +11201,7 @@ CommandResult OT_API::getMarketRecentTrades(
     ServerContext& context,
     const Identifier& MARKET_ID) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -11175,6 +11230,50 @@ CommandResult OT_API::getMarketRecentTrades(
     return output;
 }
 
+///-------------------------------------------------------
+/// GET TRADES OR OHLCV BARS FOR A SPECIFIC MARKET ID
+///
+/// An interval of 0 requests the individual trades within [from, to).
+/// Otherwise the interval must be one of TradeLog::Intervals(), in seconds.
+CommandResult OT_API::getMarketData(
+    ServerContext& context,
+    const Identifier& MARKET_ID,
+    const std::int64_t interval,
+    const time64_t from,
+    const time64_t to) const
+{
+    rLock lock(context_lock(context));
+    CommandResult output{};
+    auto & [ requestNum, transactionNum, result ] = output;
+    auto & [ status, reply ] = result;
+    requestNum = -1;
+    transactionNum = 0;
+    status = SendResult::ERROR;
+    reply.reset();
+    auto[newRequestNumber, message] = context.InitializeServerCommand(
+        MessageType::getMarketData, requestNum);
+    requestNum = newRequestNumber;
+
+    if (false == bool(message)) {
+
+        return output;
+    }
+
+    message->m_strNymID2 = String(MARKET_ID);
+    message->m_lDepth = interval;
+    message->m_lRangeStart = OTTimeGetSecondsFromTime(from);
+    message->m_lRangeEnd = OTTimeGetSecondsFromTime(to);
+
+    if (false == context.FinalizeServerCommand(*message)) {
+
+        return output;
+    }
+
+    result = send_message({}, context, *message);
+
+    return output;
+}
+
 ///-------------------------------------------------------
 /// GET ALL THE ACTIVE (in Cron) MARKET OFFERS FOR A SPECIFIC NYM. (ON A
 /// SPECIFIC SERVER, OBVIOUSLY.) Remember to use Flush/Call/Wait/Pop to check
@@ -11183,7 +11282,7 @@ CommandResult OT_API::getMarketRecentTrades(
 /// after that...
 CommandResult OT_API::getNymMarketOffers(ServerContext& context) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -11218,7 +11317,7 @@ CommandResult OT_API::notarizeTransfer(
     const Amount amount,
     const String& NOTE) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -11379,7 +11478,7 @@ CommandResult OT_API::notarizeTransfer(
 // Grab a copy of my nymbox (contains messages and new transaction numbers)
 CommandResult OT_API::getNymbox(ServerContext& context) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -11408,7 +11507,7 @@ CommandResult OT_API::getNymbox(ServerContext& context) const
 
 CommandResult OT_API::processNymbox(ServerContext& context) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -11474,7 +11573,7 @@ CommandResult OT_API::processInbox(
     const Identifier& accountID,
     const String& ACCT_LEDGER) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -11517,7 +11616,7 @@ CommandResult OT_API::registerInstrumentDefinition(
     ServerContext& context,
     const proto::UnitDefinition& THE_CONTRACT) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -11562,7 +11661,7 @@ CommandResult OT_API::getInstrumentDefinition(
     ServerContext& context,
     const Identifier& INSTRUMENT_DEFINITION_ID) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -11595,7 +11694,7 @@ CommandResult OT_API::getMint(
     ServerContext& context,
     const Identifier& INSTRUMENT_DEFINITION_ID) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -11644,7 +11743,7 @@ CommandResult OT_API::queryInstrumentDefinitions(
     ServerContext& context,
     const OTASCIIArmor& ENCODED_MAP) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -11682,7 +11781,7 @@ CommandResult OT_API::registerAccount(
     ServerContext& context,
     const Identifier& INSTRUMENT_DEFINITION_ID) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -11722,7 +11821,7 @@ CommandResult OT_API::deleteAssetAccount(
     ServerContext& context,
     const Identifier& ACCOUNT_ID) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -11787,7 +11886,7 @@ CommandResult OT_API::getBoxReceipt(
     std::int32_t nBoxType,         // 0/nymbox, 1/inbox, 2/outbox
     const TransactionNumber& lTransactionNum) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -11836,7 +11935,7 @@ CommandResult OT_API::getAccountData(
     ServerContext& context,
     const Identifier& accountID) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -11879,7 +11978,7 @@ CommandResult OT_API::usageCredits(
     const Identifier& NYM_ID_CHECK,
     std::int64_t lAdjustment) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -11915,7 +12014,7 @@ CommandResult OT_API::checkNym(
     ServerContext& context,
     const Identifier& targetNymID) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -11947,7 +12046,7 @@ CommandResult OT_API::registerContract(
     const ContractType TYPE,
     const Identifier& CONTRACT) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -12030,7 +12129,7 @@ CommandResult OT_API::sendNymObject(
     const PeerObject& object,
     const RequestNumber provided) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -12192,7 +12291,7 @@ CommandResult OT_API::sendNymInstrument(
     const OTPayment& instrument,
     const OTPayment* senderCopy) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -12812,6 +12911,7 @@ bool OT_API::Transaction_CreateResponse(
     OT_VERIFY_OT_ID(theNymID);
     OT_VERIFY_OT_ID(accountID);
 
+    rLock contextLock(ContextLock(theNymID, theNotaryID));
     rLock lock(lock_);
     auto context = wallet_.mutable_ServerContext(theNymID, theNotaryID);
     const auto& nym = context.It().Nym();
@@ -12887,6 +12987,7 @@ bool OT_API::Ledger_FinalizeResponse(
     OT_VERIFY_OT_ID(theNymID);
     OT_VERIFY_OT_ID(accountID);
 
+    rLock contextLock(ContextLock(theNymID, theNotaryID));
     rLock lock(lock_);
     auto context = wallet_.mutable_ServerContext(theNymID, theNotaryID);
     const auto& nym = context.It().Nym();
@@ -12960,7 +13061,7 @@ bool OT_API::Ledger_FinalizeResponse(
 
 CommandResult OT_API::registerNym(ServerContext& context) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -13007,7 +13108,7 @@ CommandResult OT_API::registerNym(ServerContext& context) const
 
 CommandResult OT_API::unregisterNym(ServerContext& context) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -13034,7 +13135,7 @@ NetworkReplyMessage OT_API::send_message(
     ServerContext& context,
     Message& message) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
 
     m_pClient->QueueOutgoingMessage(message);
     auto result = context.Connection().Send(message);
@@ -13179,7 +13280,7 @@ CommandResult OT_API::requestAdmin(
     ServerContext& context,
     const std::string& PASSWORD) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -13215,7 +13316,7 @@ CommandResult OT_API::serverAddClaim(
     const std::string& value,
     const bool primary) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     CommandResult output{};
     auto & [ requestNum, transactionNum, result ] = output;
     auto & [ status, reply ] = result;
@@ -13304,7 +13405,7 @@ OT_API::ProcessInbox OT_API::CreateProcessInbox(
     const Identifier& accountID,
     const ServerContext& context) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     const std::string account = accountID.str();
     const auto& serverID = context.Server();
     const auto& nym = *context.Nym();
@@ -13340,7 +13441,7 @@ bool OT_API::IncludeResponse(
     OTTransaction& source,
     Ledger& response) const
 {
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     const auto serverID = context.Server();
     const auto type = source.GetType();
 
@@ -13439,7 +13540,7 @@ bool OT_API::FinalizeProcessInbox(
         TransactionNumber number_{0};
     };
 
-    rLock lock(lock_);
+    rLock lock(context_lock(context));
     auto nym = context.Nym();
     auto& nymID = nym->GetConstID();
     auto& serverID = context.Server();
@@ -2376,6 +2376,15 @@ std::string SwigWrap::LoadServerContract(const std::string& NOTARY_ID)
     return OT::App().API().Exec().LoadServerContract(NOTARY_ID);
 }
 
+std::string SwigWrap::LoadMarketData(
+    const std::string& NOTARY_ID,
+    const std::string& MARKET_ID,
+    const std::int64_t& INTERVAL)
+{
+    return OT::App().API().Exec().LoadMarketData(
+        NOTARY_ID, MARKET_ID, INTERVAL);
+}
+
 std::string SwigWrap::LoadAssetAccount(
     const std::string& NOTARY_ID,
     const std::string& NYM_ID,
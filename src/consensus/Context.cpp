@@ -115,7 +115,7 @@ std::set<RequestNumber> Context::AcknowledgedNumbers() const
 {
     Lock lock(lock_);
 
-    return acknowledged_request_numbers_;
+    return acknowledged_request_numbers_.Set();
 }
 
 bool Context::add_acknowledged_number(const Lock& lock, const RequestNumber req)
@@ -126,7 +126,7 @@ bool Context::add_acknowledged_number(const Lock& lock, const RequestNumber req)
 
     while (OT_MAX_ACK_NUMS < acknowledged_request_numbers_.size()) {
         acknowledged_request_numbers_.erase(
-            acknowledged_request_numbers_.begin());
+            *acknowledged_request_numbers_.begin());
     }
 
     return output.second;
@@ -271,23 +271,18 @@ std::unique_ptr<TransactionStatement> ServerContext::generate_statement(
 {
     OT_ASSERT(verify_write_lock(lock));
 
-    std::set<TransactionNumber> issued;
-    std::set<TransactionNumber> available;
+    IntervalSet issued = issued_transaction_numbers_;
 
-    for (const auto& number : issued_transaction_numbers_) {
-        const bool include = (0 == without.count(number));
-
-        if (include) {
-            issued.insert(number);
-            available.insert(number);
-        }
+    for (const auto& number : without) {
+        issued.erase(number);
     }
 
     for (const auto& number : adding) {
         issued.insert(number);
-        available.insert(number);
     }
 
+    const IntervalSet& available = issued;
+
     std::unique_ptr<TransactionStatement> output(
         new TransactionStatement(String(server_id_).Get(), issued, available));
 
@@ -344,7 +339,7 @@ std::pair<RequestNumber, std::unique_ptr<Message>> ServerContext::
     message->m_strRequestNum = std::to_string(requestNumber).c_str();
 
     if (withAcknowledgments) {
-        message->SetAcknowledgments(acknowledged_request_numbers_);
+        message->SetAcknowledgments(acknowledged_request_numbers_.Set());
     }
 
     if (withNymboxHash) {
@@ -436,9 +431,8 @@ ServerContext::ManagedNumber ServerContext::NextTransactionNumber(
         return ManagedNumber(0, *this);
     }
 
-    auto first = available_transaction_numbers_.begin();
-    const auto output = *first;
-    available_transaction_numbers_.erase(first);
+    const auto output = *available_transaction_numbers_.begin();
+    available_transaction_numbers_.erase(output);
 
     return ManagedNumber(output, *this);
 }
@@ -892,6 +886,11 @@ bool ServerContext::Verify(const TransactionStatement& statement) const
 {
     Lock lock(lock_);
 
+    if (statement.Issued().Contains(issued_transaction_numbers_)) {
+
+        return true;
+    }
+
     for (const auto& number : issued_transaction_numbers_) {
         const bool missing = (1 != statement.Issued().count(number));
 
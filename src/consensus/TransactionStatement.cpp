@@ -45,7 +45,6 @@
 #include "opentxs/core/Contract.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Log.hpp"
-#include "opentxs/core/NumList.hpp"
 #include "opentxs/core/OTStringXML.hpp"
 
 #include <irrxml/irrXML.hpp>
@@ -54,8 +53,8 @@ namespace opentxs
 {
 TransactionStatement::TransactionStatement(
     const std::string& notary,
-    const std::set<TransactionNumber>& issued,
-    const std::set<TransactionNumber>& available)
+    const IntervalSet& issued,
+    const IntervalSet& available)
     : version_("1.0")
     , nym_id_("")
     , notary_(notary)
@@ -99,22 +98,13 @@ TransactionStatement::TransactionStatement(const String& serialized)
                         break;
                     }
 
-                    NumList numlist;
-
                     if (!list.empty()) {
-                        numlist.Add(list);
+                        IntervalSet::Parse(list.Get(), available_, false);
                     }
 
-                    TransactionNumber number = 0;
-
-                    while (numlist.Peek(number)) {
-                        numlist.Pop();
-
-                        otLog3 << "Transaction Number " << number
-                               << " ready-to-use for NotaryID: " << notary_
-                               << std::endl;
-                        available_.insert(number);
-                    }
+                    otLog3 << "Transaction Numbers " << available_.Serialize()
+                           << " ready-to-use for NotaryID: " << notary_
+                           << std::endl;
                 } else if (nodeName.Compare("issuedNums")) {
                     notary_ = xml->getAttributeValue("notaryID");
                     String list;
@@ -128,22 +118,13 @@ TransactionStatement::TransactionStatement(const String& serialized)
                         break;
                     }
 
-                    NumList numlist;
-
                     if (!list.empty()) {
-                        numlist.Add(list);
+                        IntervalSet::Parse(list.Get(), issued_, false);
                     }
 
-                    TransactionNumber number = 0;
-
-                    while (numlist.Peek(number)) {
-                        numlist.Pop();
-
-                        otLog3 << "Currently liable for issued trans# "
-                               << number << " at NotaryID: " << notary_
-                               << std::endl;
-                        issued_.insert(number);
-                    }
+                    otLog3 << "Currently liable for issued trans# "
+                           << issued_.Serialize()
+                           << " at NotaryID: " << notary_ << std::endl;
                 } else {
                     otErr << "Unknown element type in " << __FUNCTION__ << ": "
                           << nodeName << std::endl;
@@ -167,19 +148,16 @@ TransactionStatement::operator String() const
     serialized.add_attribute("version", version_);
     serialized.add_attribute("nymID", nym_id_);
 
+    // Statements are read by older peers, which only accept plain lists
     if (0 < issued_.size()) {
-        NumList issuedList(issued_);
-        String issued;
-        issuedList.Output(issued);
+        String issued(issued_.Serialize(false));
         TagPtr issuedTag(new Tag("issuedNums", OTASCIIArmor(issued).Get()));
         issuedTag->add_attribute("notaryID", notary_);
         serialized.add_tag(issuedTag);
     }
 
     if (0 < available_.size()) {
-        NumList availableList(available_);
-        String available;
-        availableList.Output(available);
+        String available(available_.Serialize(false));
         TagPtr availableTag(
             new Tag("transactionNums", OTASCIIArmor(available).Get()));
         availableTag->add_attribute("notaryID", notary_);
@@ -192,7 +170,7 @@ TransactionStatement::operator String() const
     return result.c_str();
 }
 
-const std::set<TransactionNumber>& TransactionStatement::Issued() const
+const IntervalSet& TransactionStatement::Issued() const
 {
     return issued_;
 }
@@ -45,12 +45,25 @@
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Log.hpp"
 
+#include <atomic>
+#include <map>
+#include <set>
 #include <sstream>
+#include <tuple>
 
 #define OT_METHOD "opentxs::ContactData::"
 
 namespace opentxs
 {
+struct ContactData::Index {
+    typedef std::
+        tuple<proto::ContactSectionName, proto::ContactItemType, std::string>
+            Value;
+
+    std::map<Identifier, std::shared_ptr<ContactItem>> claims_{};
+    std::set<Value> values_{};
+};
+
 ContactData::ContactData(
     const std::string& nym,
     const std::uint32_t version,
@@ -59,6 +72,7 @@ ContactData::ContactData(
     : version_(check_version(version, targetVersion))
     , nym_(nym)
     , sections_(sections)
+    , index_(nullptr)
 {
     if (0 == version) {
         otErr << OT_METHOD << __FUNCTION__ << ": Warning: malformed version. "
@@ -78,6 +92,22 @@ ContactData::ContactData(
 {
 }
 
+ContactData::ContactData(const ContactData& rhs)
+    : version_(rhs.version_)
+    , nym_(rhs.nym_)
+    , sections_(rhs.sections_)
+    , index_(std::atomic_load(&rhs.index_))
+{
+}
+
+ContactData::ContactData(ContactData&& rhs)
+    : version_(rhs.version_)
+    , nym_(rhs.nym_)
+    , sections_(rhs.sections_)
+    , index_(std::atomic_load(&rhs.index_))
+{
+}
+
 ContactData ContactData::operator+(const ContactData& rhs) const
 {
     auto map = sections_;
@@ -275,20 +305,15 @@ std::uint32_t ContactData::check_version(
 
 std::shared_ptr<ContactItem> ContactData::Claim(const Identifier& item) const
 {
-    for (const auto& it : sections_) {
-        const auto& section = it.second;
-
-        OT_ASSERT(section);
+    const auto index = this->index();
+    const auto it = index->claims_.find(item);
 
-        auto claim = section->Claim(item);
+    if (index->claims_.end() == it) {
 
-        if (claim) {
-
-            return claim;
-        }
+        return {};
     }
 
-    return {};
+    return it->second;
 }
 
 std::set<Identifier> ContactData::Contracts(
@@ -318,32 +343,29 @@ std::set<Identifier> ContactData::Contracts(
 
 ContactData ContactData::Delete(const Identifier& id) const
 {
-    bool deleted{false};
-    auto map = sections_;
+    const auto claim = Claim(id);
 
-    for (auto& it : map) {
-        auto& section = it.second;
+    if (false == bool(claim)) {
 
-        OT_ASSERT(section);
+        return *this;
+    }
 
-        if (section->HaveClaim(id)) {
-            section.reset(new ContactSection(section->Delete(id)));
+    const auto& sectionID = claim->Section();
+    auto map = sections_;
+    auto it = map.find(sectionID);
 
-            OT_ASSERT(section);
+    OT_ASSERT(map.end() != it);
 
-            deleted = true;
+    auto& section = it->second;
 
-            if (0 == section->Size()) {
-                map.erase(it.first);
-            }
+    OT_ASSERT(section);
 
-            break;
-        }
-    }
+    section.reset(new ContactSection(section->Delete(id)));
 
-    if (false == deleted) {
+    OT_ASSERT(section);
 
-        return *this;
+    if (0 == section->Size()) {
+        map.erase(it);
     }
 
     return ContactData(nym_, version_, version_, map);
@@ -384,16 +406,7 @@ std::shared_ptr<ContactGroup> ContactData::Group(
 
 bool ContactData::HaveClaim(const Identifier& item) const
 {
-    for (const auto& section : sections_) {
-        OT_ASSERT(section.second);
-
-        if (section.second->HaveClaim(item)) {
-
-            return true;
-        }
-    }
-
-    return false;
+    return 1 == index()->claims_.count(item);
 }
 
 bool ContactData::HaveClaim(
@@ -401,25 +414,45 @@ bool ContactData::HaveClaim(
     const proto::ContactItemType& type,
     const std::string& value) const
 {
-    auto group = Group(section, type);
+    return 1 == index()->values_.count(std::make_tuple(section, type, value));
+}
 
-    if (false == bool(group)) {
+std::shared_ptr<const ContactData::Index> ContactData::index() const
+{
+    auto output = std::atomic_load(&index_);
 
-        return false;
+    if (output) {
+
+        return output;
     }
 
-    for (const auto it : *group) {
-        OT_ASSERT(it.second);
+    auto index = std::make_shared<Index>();
+
+    OT_ASSERT(index);
+
+    for (const auto& section : sections_) {
+        OT_ASSERT(section.second);
+
+        for (const auto& group : *section.second) {
+            OT_ASSERT(group.second);
 
-        const auto& claim = *it.second;
+            for (const auto& it : *group.second) {
+                const auto& item = it.second;
 
-        if (value == claim.Value()) {
+                OT_ASSERT(item);
 
-            return true;
+                index->claims_.emplace(it.first, item);
+                index->values_.emplace(
+                    section.first, group.first, item->Value());
+            }
         }
     }
 
-    return false;
+    // Two threads may both build an index. Either one is correct.
+    output = index;
+    std::atomic_store(&index_, output);
+
+    return output;
 }
 
 std::string ContactData::Name() const
@@ -40,6 +40,8 @@
 
 #include "opentxs/core/Account.hpp"
 
+#include "opentxs/api/Native.hpp"
+#include "opentxs/api/Server.hpp"
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/util/Common.hpp"
@@ -59,6 +61,7 @@
 #include "opentxs/core/OTStringXML.hpp"
 #include "opentxs/core/OTTransactionType.hpp"
 #include "opentxs/core/String.hpp"
+#include "opentxs/OT.hpp"
 
 #include <inttypes.h>
 #include <stdint.h>
@@ -310,14 +313,63 @@ bool Account::LoadContract()
 {
     String id;
     GetIdentifier(id);
-    return Contract::LoadContract(OTFolders::Account().Get(), id.Get());
+
+    if (false == OT::App().ServerMode()) {
+
+        return Contract::LoadContract(OTFolders::Account().Get(), id.Get());
+    }
+
+    // The notary reads accounts through its write-back cache
+    const String contents(
+        OT::App().Server().QueryFile(OTFolders::Account().Get(), id.Get(), ""));
+
+    if (false == contents.Exists()) {
+        otErr << __FUNCTION__ << ": Failed loading account file: "
+              << OTFolders::Account() << Log::PathSeparator() << id << "\n";
+
+        return false;
+    }
+
+    const bool loaded = LoadContractFromString(contents);
+    m_strFoldername = OTFolders::Account().Get();
+    m_strFilename = id.Get();
+
+    return loaded;
 }
 
 bool Account::SaveAccount()
 {
     String id;
     GetIdentifier(id);
-    return SaveContract(OTFolders::Account().Get(), id.Get());
+
+    if (false == OT::App().ServerMode()) {
+
+        return SaveContract(OTFolders::Account().Get(), id.Get());
+    }
+
+    m_strFoldername = OTFolders::Account().Get();
+    m_strFilename = id.Get();
+
+    if (false == m_strRawFile.Exists()) {
+        otErr << __FUNCTION__ << ": Error saving account (contents are empty): "
+              << id << "\n";
+
+        return false;
+    }
+
+    String strFinal;
+    OTASCIIArmor ascTemp(m_strRawFile);
+
+    if (false ==
+        ascTemp.WriteArmoredString(strFinal, m_strContractType.Get())) {
+        otErr << __FUNCTION__ << ": Error saving account (failed writing "
+              << "armored string): " << id << "\n";
+
+        return false;
+    }
+
+    return OT::App().Server().StoreFile(
+        strFinal.Get(), m_strFoldername.Get(), m_strFilename.Get(), "");
 }
 
 // Debit a certain amount from the account (presumably the same amount is being
@@ -0,0 +1,141 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/core/FixedIdentifier.hpp"
+
+#include "opentxs/core/Identifier.hpp"
+
+#include <algorithm>
+
+namespace opentxs
+{
+FixedIdentifier::FixedIdentifier()
+    : bytes_()
+    , size_(0)
+    , type_(ID::ERROR)
+    , hash_(calculate_hash(nullptr, 0, ID::ERROR))
+{
+    bytes_.fill(0);
+}
+
+FixedIdentifier::FixedIdentifier(const Identifier& id)
+    : FixedIdentifier()
+{
+    const auto size = id.GetSize();
+
+    if ((0 == size) || (MaxSize < size)) {
+        return;
+    }
+
+    std::memcpy(bytes_.data(), id.GetPointer(), size);
+    size_ = static_cast<std::uint8_t>(size);
+    type_ = id.Type();
+    hash_ = calculate_hash(bytes_.data(), size_, type_);
+}
+
+FixedIdentifier::FixedIdentifier(const std::string& id)
+    : FixedIdentifier(Identifier(id))
+{
+}
+
+bool FixedIdentifier::operator<(const FixedIdentifier& rhs) const
+{
+    if (type_ != rhs.type_) {
+        return type_ < rhs.type_;
+    }
+
+    const auto compare = std::memcmp(
+        bytes_.data(), rhs.bytes_.data(), std::min(size_, rhs.size_));
+
+    if (0 != compare) {
+        return 0 > compare;
+    }
+
+    return size_ < rhs.size_;
+}
+
+// Identifiers are digests, so any word of the value is already uniformly
+// distributed. Shorter values fall back to FNV-1a.
+std::size_t FixedIdentifier::calculate_hash(
+    const std::uint8_t* data,
+    const std::size_t size,
+    const ID type)
+{
+    std::size_t output{0};
+
+    if (sizeof(output) <= size) {
+        std::memcpy(&output, data, sizeof(output));
+    } else {
+        std::uint64_t fnv{14695981039346656037ULL};
+
+        for (std::size_t i = 0; i < size; ++i) {
+            fnv ^= data[i];
+            fnv *= 1099511628211ULL;
+        }
+
+        output = static_cast<std::size_t>(fnv);
+    }
+
+    return output ^ (static_cast<std::size_t>(type) << 1) ^ size;
+}
+
+OTIdentifier FixedIdentifier::Get() const
+{
+    auto output = Identifier::Factory();
+
+    if (empty()) {
+        return output;
+    }
+
+    output->Assign(bytes_.data(), size_);
+    output->type_ = type_;
+
+    return output;
+}
+
+std::string FixedIdentifier::str() const
+{
+    if (empty()) {
+        return {};
+    }
+
+    return Get()->str();
+}
+}  // namespace opentxs
@@ -54,6 +54,8 @@
 #include "opentxs/core/String.hpp"
 #include "opentxs/OT.hpp"
 
+#include <cstring>
+
 namespace opentxs
 {
 OTIdentifier Identifier::Factory() { return OTIdentifier(new Identifier()); }
@@ -218,16 +220,30 @@ Identifier& Identifier::operator=(Identifier&& rhs)
     return *this;
 }
 
+// Equal encoded strings imply equal type and bytes, so equality does not
+// need to run the base58 encoder. Ordering still follows the string form.
 bool Identifier::operator==(const Identifier& s2) const
 {
-    const String ots1(*this), ots2(s2);
-    return ots1.Compare(ots2);
+    const auto size = GetSize();
+
+    if (size != s2.GetSize()) {
+        return false;
+    }
+
+    if (0 == size) {
+        return true;
+    }
+
+    if (type_ != s2.type_) {
+        return false;
+    }
+
+    return 0 == std::memcmp(GetPointer(), s2.GetPointer(), size);
 }
 
 bool Identifier::operator!=(const Identifier& s2) const
 {
-    const String ots1(*this), ots2(s2);
-    return !(ots1.Compare(ots2));
+    return false == (*this == s2);
 }
 
 bool Identifier::operator>(const Identifier& s2) const
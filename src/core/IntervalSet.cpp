@@ -0,0 +1,476 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/core/IntervalSet.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace opentxs
+{
+namespace
+{
+using Number = IntervalSet::value_type;
+
+// True if a run ending at last can be merged with a run starting at first
+bool touches(const Number last, const Number first)
+{
+    if (first <= last) {
+
+        return true;
+    }
+
+    return (std::numeric_limits<Number>::max() != last) && (first == last + 1);
+}
+
+std::size_t width(const Number first, const Number last)
+{
+    return static_cast<std::size_t>(last - first) + 1;
+}
+
+bool is_digit(const char c)
+{
+    return 0 != std::isdigit(static_cast<unsigned char>(c));
+}
+
+bool is_separator(const char c)
+{
+    return (',' == c) || (0 != std::isspace(static_cast<unsigned char>(c)));
+}
+
+bool parse_number(const std::string& input, std::size_t& pos, Number& output)
+{
+    const auto start = pos;
+    output = 0;
+
+    while ((pos < input.size()) && is_digit(input[pos])) {
+        const Number digit = input[pos] - '0';
+
+        if (output > (std::numeric_limits<Number>::max() - digit) / 10) {
+
+            return false;
+        }
+
+        output = (output * 10) + digit;
+        ++pos;
+    }
+
+    return (pos > start);
+}
+}  // namespace
+
+IntervalSet::IntervalSet(const std::set<value_type>& numbers)
+    : ranges_()
+    , size_(0)
+{
+    auto hint = ranges_.end();
+
+    for (const auto& number : numbers) {
+        if ((ranges_.end() != hint) && touches(hint->second, number)) {
+            hint->second = number;
+        } else {
+            hint = ranges_.emplace_hint(ranges_.end(), number, number);
+        }
+    }
+
+    size_ = numbers.size();
+}
+
+IntervalSet::IntervalSet(std::set<value_type>&& numbers)
+    : IntervalSet(static_cast<const std::set<value_type>&>(numbers))
+{
+    numbers.clear();
+}
+
+IntervalSet::const_iterator::const_iterator(
+    const Ranges::const_iterator range,
+    const Ranges::const_iterator end,
+    const value_type value)
+    : range_(range)
+    , end_(end)
+    , value_(value)
+{
+}
+
+IntervalSet::const_iterator& IntervalSet::const_iterator::operator++()
+{
+    if (range_ == end_) {
+
+        return *this;
+    }
+
+    if (value_ < range_->second) {
+        ++value_;
+    } else {
+        ++range_;
+        value_ = (range_ == end_) ? 0 : range_->first;
+    }
+
+    return *this;
+}
+
+IntervalSet::const_iterator IntervalSet::const_iterator::operator++(int)
+{
+    auto output = *this;
+    ++(*this);
+
+    return output;
+}
+
+bool IntervalSet::const_iterator::operator==(const const_iterator& rhs) const
+{
+    return (range_ == rhs.range_) && (value_ == rhs.value_);
+}
+
+bool IntervalSet::const_iterator::operator!=(const const_iterator& rhs) const
+{
+    return false == (*this == rhs);
+}
+
+IntervalSet::const_iterator IntervalSet::begin() const
+{
+    if (ranges_.empty()) {
+
+        return end();
+    }
+
+    return const_iterator(
+        ranges_.cbegin(), ranges_.cend(), ranges_.cbegin()->first);
+}
+
+void IntervalSet::clear()
+{
+    ranges_.clear();
+    size_ = 0;
+}
+
+bool IntervalSet::Contains(const IntervalSet& rhs) const
+{
+    if (rhs.size_ > size_) {
+
+        return false;
+    }
+
+    // Runs are always maximal, so every run of rhs must fit inside exactly one
+    // run of *this.
+    for (const auto & [ first, last ] : rhs.ranges_) {
+        const auto it = find_range(first);
+
+        if ((ranges_.cend() == it) || (it->second < last)) {
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::size_t IntervalSet::count(const value_type number) const
+{
+    return (ranges_.cend() == find_range(number)) ? 0 : 1;
+}
+
+IntervalSet::const_iterator IntervalSet::end() const
+{
+    return const_iterator(ranges_.cend(), ranges_.cend(), 0);
+}
+
+std::size_t IntervalSet::erase(const value_type number)
+{
+    const auto found = find_range(number);
+
+    if (ranges_.cend() == found) {
+
+        return 0;
+    }
+
+    const auto first = found->first;
+    const auto last = found->second;
+    auto it = ranges_.erase(found);
+
+    if (first < number) {
+        it = ranges_.emplace_hint(it, first, number - 1);
+        ++it;
+    }
+
+    if (number < last) {
+        ranges_.emplace_hint(it, number + 1, last);
+    }
+
+    --size_;
+
+    return 1;
+}
+
+IntervalSet::const_iterator IntervalSet::find(const value_type number) const
+{
+    const auto it = find_range(number);
+
+    if (ranges_.cend() == it) {
+
+        return end();
+    }
+
+    return const_iterator(it, ranges_.cend(), number);
+}
+
+IntervalSet::Ranges::const_iterator IntervalSet::find_range(
+    const value_type number) const
+{
+    auto it = ranges_.upper_bound(number);
+
+    if (ranges_.cbegin() == it) {
+
+        return ranges_.cend();
+    }
+
+    --it;
+
+    if (it->second < number) {
+
+        return ranges_.cend();
+    }
+
+    return it;
+}
+
+std::pair<IntervalSet::const_iterator, bool> IntervalSet::insert(
+    const value_type number)
+{
+    const bool added = (1 == InsertRange(number, number));
+
+    return {find(number), added};
+}
+
+std::size_t IntervalSet::Insert(const IntervalSet& rhs)
+{
+    std::size_t output{0};
+
+    for (const auto & [ first, last ] : rhs.ranges_) {
+        output += InsertRange(first, last);
+    }
+
+    return output;
+}
+
+std::size_t IntervalSet::InsertRange(
+    const value_type first,
+    const value_type last)
+{
+    if (last < first) {
+
+        return 0;
+    }
+
+    auto it = ranges_.upper_bound(first);
+
+    if (ranges_.begin() != it) {
+        auto previous = std::prev(it);
+
+        if (touches(previous->second, first)) {
+            it = previous;
+        }
+    }
+
+    auto mergedFirst = first;
+    auto mergedLast = last;
+    std::size_t present{0};
+
+    while ((ranges_.end() != it) && touches(last, it->first)) {
+        const auto overlapFirst = std::max(first, it->first);
+        const auto overlapLast = std::min(last, it->second);
+
+        if (overlapFirst <= overlapLast) {
+            present += width(overlapFirst, overlapLast);
+        }
+
+        mergedFirst = std::min(mergedFirst, it->first);
+        mergedLast = std::max(mergedLast, it->second);
+        it = ranges_.erase(it);
+    }
+
+    ranges_.emplace_hint(it, mergedFirst, mergedLast);
+    const auto added = width(first, last) - present;
+    size_ += added;
+
+    return added;
+}
+
+bool IntervalSet::Intersects(const IntervalSet& rhs) const
+{
+    const auto& smaller = (ranges_.size() < rhs.ranges_.size()) ? *this : rhs;
+    const auto& larger = (&smaller == this) ? rhs : *this;
+
+    for (const auto & [ first, last ] : smaller.ranges_) {
+        auto it = larger.ranges_.upper_bound(last);
+
+        if (larger.ranges_.cbegin() == it) {
+
+            continue;
+        }
+
+        --it;
+
+        if (it->second >= first) {
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool IntervalSet::operator==(const IntervalSet& rhs) const
+{
+    return (size_ == rhs.size_) && (ranges_ == rhs.ranges_);
+}
+
+bool IntervalSet::operator!=(const IntervalSet& rhs) const
+{
+    return false == (*this == rhs);
+}
+
+bool IntervalSet::Parse(
+    const std::string& input,
+    IntervalSet& output,
+    const bool ranges)
+{
+    std::size_t pos{0};
+
+    for (;;) {
+        while ((pos < input.size()) && is_separator(input[pos])) {
+            ++pos;
+        }
+
+        if (pos >= input.size()) {
+
+            return true;
+        }
+
+        Number first{0};
+        Number last{0};
+
+        if (false == parse_number(input, pos, first)) {
+
+            return false;
+        }
+
+        last = first;
+
+        if ((pos < input.size()) && ('-' == input[pos])) {
+            if (false == ranges) {
+
+                return false;
+            }
+
+            ++pos;
+
+            if (false == parse_number(input, pos, last)) {
+
+                return false;
+            }
+
+            if (last < first) {
+
+                return false;
+            }
+        }
+
+        if ((pos < input.size()) && (false == is_separator(input[pos]))) {
+
+            return false;
+        }
+
+        output.InsertRange(first, last);
+    }
+}
+
+std::string IntervalSet::Serialize(const bool ranges) const
+{
+    std::string output{};
+
+    for (const auto & [ first, last ] : ranges_) {
+        if (false == output.empty()) {
+            output += ',';
+        }
+
+        output += std::to_string(first);
+
+        if (first == last) {
+            continue;
+        }
+
+        if (ranges) {
+            output += '-';
+            output += std::to_string(last);
+        } else {
+            for (auto number = first; number < last;) {
+                output += ',';
+                output += std::to_string(++number);
+            }
+        }
+    }
+
+    return output;
+}
+
+std::set<IntervalSet::value_type> IntervalSet::Set() const
+{
+    std::set<value_type> output{};
+
+    for (const auto & [ first, last ] : ranges_) {
+        for (auto number = first;; ++number) {
+            output.emplace_hint(output.end(), number);
+
+            if (number == last) {
+                break;
+            }
+        }
+    }
+
+    return output;
+}
+}  // namespace opentxs
@@ -40,13 +40,17 @@
 
 #include "opentxs/core/Ledger.hpp"
 
+#include "opentxs/api/Native.hpp"
+#include "opentxs/api/Server.hpp"
 #include "opentxs/consensus/ServerContext.hpp"
 #include "opentxs/consensus/TransactionStatement.hpp"
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
+#include "opentxs/core/crypto/OTSignature.hpp"
 #include "opentxs/core/transaction/Helpers.hpp"
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/util/Common.hpp"
 #include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/util/ParallelFor.hpp"
 #include "opentxs/core/util/Tag.hpp"
 #include "opentxs/core/Account.hpp"
 #include "opentxs/core/Cheque.hpp"
@@ -61,6 +65,7 @@
 #include "opentxs/core/OTTransaction.hpp"
 #include "opentxs/core/OTTransactionType.hpp"
 #include "opentxs/core/String.hpp"
+#include "opentxs/OT.hpp"
 #include "opentxs/Types.hpp"
 
 #include <stdlib.h>
@@ -72,6 +77,11 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
+
+// Boxes with fewer abbreviated receipts than this are loaded on the calling
+// thread
+#define OT_LEDGER_PARALLEL_RECEIPTS 32
 
 namespace opentxs
 {
@@ -145,7 +155,74 @@ bool Ledger::VerifyAccount(const Nym& theNym)
             return false;
     }
 
-    return OTTransactionType::VerifyAccount(theNym);
+    if (false == loaded_from_cache_) {
+
+        return OTTransactionType::VerifyAccount(theNym);
+    }
+
+    // The notary verifies the same box once for every transaction in a
+    // request. Only the first of those needs to check the signature, unless
+    // the box has changed in between.
+    String strID;
+    GetIdentifier(strID);
+    const String strNotaryID(GetRealNotaryID());
+    const auto& server = OT::App().Server();
+
+    if (server.VerifiedFile(
+            m_strFoldername.Get(), strNotaryID.Get(), strID.Get())) {
+
+        return VerifyContractID();
+    }
+
+    const bool verified = OTTransactionType::VerifyAccount(theNym);
+
+    if (verified) {
+        server.SetVerifiedFile(
+            m_strFoldername.Get(), strNotaryID.Get(), strID.Get());
+    }
+
+    return verified;
+}
+
+bool Ledger::SignContract(const Nym& theNym, const OTPasswordData* pPWData)
+{
+    deferred_signer_ = nullptr;
+
+    if ((false == cached_box(GetType())) ||
+        (false == OT::App().Server().BatchingBoxes())) {
+
+        return ot_super::SignContract(theNym, pPWData);
+    }
+
+    // The contents are serialized now, exactly as signing would, so that
+    // hashes calculated before the box is saved stay correct. SaveGeneric
+    // hands the signature to the notary, which applies it once the request
+    // is complete. Until then an empty signature keeps the stored box
+    // parseable, and it never verifies.
+    UpdateContents();
+    m_strSigHashType = theNym.GetPrivateSignKey().SigHashType();
+    m_listSignatures.push_back(new OTSignature);
+    deferred_signer_ = &theNym;
+
+    return true;
+}
+
+bool Ledger::VerifySignature(const Nym& theNym, const OTPasswordData* pPWData)
+    const
+{
+    if (loaded_from_cache_) {
+        String strID;
+        GetIdentifier(strID);
+        const String strNotaryID(GetRealNotaryID());
+
+        if (OT::App().Server().VerifiedFile(
+                m_strFoldername.Get(), strNotaryID.Get(), strID.Get())) {
+
+            return true;
+        }
+    }
+
+    return ot_super::VerifySignature(theNym, pPWData);
 }
 
 // This makes sure that ALL transactions inside the ledger are saved as box
@@ -226,69 +303,84 @@ bool Ledger::DeleteBoxReceipt(const int64_t& lTransactionNum)
 // if psetUnloaded passed in, then use it to return the #s that weren't there.
 bool Ledger::LoadBoxReceipts(std::set<int64_t>* psetUnloaded)
 {
-    // Grab a copy of all the transaction #s stored inside this ledger.
+    // Grab all the abbreviated transactions stored inside this ledger, in
+    // transaction number order.
     //
-    std::set<int64_t> the_set;
+    std::vector<OTTransaction*> abbreviated{};
 
     for (auto& it : m_mapTransactions) {
         OTTransaction* pTransaction = it.second;
         OT_ASSERT(nullptr != pTransaction);
-        the_set.insert(pTransaction->GetTransactionNum());
+
+        if (pTransaction->IsAbbreviated()) {
+            abbreviated.push_back(pTransaction);
+        }
     }
 
-    // Now iterate through those numbers and for each, load the box receipt.
+    // Reading, hashing and parsing each receipt is independent of the
+    // others, so it happens up front (possibly in parallel.) Replacing the
+    // abbreviated versions modifies the ledger, so that happens here, one at
+    // a time.
     //
+    auto loaded = load_box_receipts(abbreviated);
     bool bRetVal = true;
 
-    for (auto& it : the_set) {
-        int64_t lSetNum = it;
+    for (std::size_t i = 0; i < abbreviated.size(); ++i) {
+        const int64_t lSetNum = abbreviated.at(i)->GetTransactionNum();
+        auto& pBoxReceipt = loaded.at(i);
 
-        OTTransaction* pTransaction = GetTransaction(lSetNum);
-        OT_ASSERT(nullptr != pTransaction);
+        if (pBoxReceipt) {
+            // Remove the existing, abbreviated receipt, and replace it with
+            // the actual receipt.
+            //
+            RemoveTransaction(lSetNum);  // this deletes abbreviated.at(i)
+            AddTransaction(*pBoxReceipt.release());  // takes ownership.
+
+            continue;
+        }
 
         // Failed loading the boxReceipt
         //
-        if ((true == pTransaction->IsAbbreviated()) &&
-            (false == LoadBoxReceipt(lSetNum))) {
-            // WARNING: pTransaction must be re-Get'd below this point if
-            // needed, since pointer
-            // is bad if success on LoadBoxReceipt() call.
-            //
-            pTransaction = nullptr;
-            bRetVal = false;
-            OTLogStream* pLog = &otOut;
+        bRetVal = false;
+        OTLogStream* pLog = &otOut;
 
-            if (nullptr != psetUnloaded) {
-                psetUnloaded->insert(lSetNum);
-                pLog = &otLog3;
-            }
-            *pLog << "OTLedger::LoadBoxReceipts: Failed calling LoadBoxReceipt "
-                     "on "
-                     "abbreviated transaction number:"
-                  << lSetNum << ".\n";
-            // If psetUnloaded is passed in, then we don't want to break,
-            // because we want to
-            // populate it with the conmplete list of IDs that wouldn't load as
-            // a Box Receipt.
-            // Thus, we only break if psetUnloaded is nullptr, which is better
-            // optimization in that case.
-            // (If not building a list of all failures, then we can return at
-            // first sign of failure.)
-            //
-            if (nullptr == psetUnloaded) break;
+        if (nullptr != psetUnloaded) {
+            psetUnloaded->insert(lSetNum);
+            pLog = &otLog3;
         }
-        // else (success), no need for a block in that case.
+        *pLog << "OTLedger::LoadBoxReceipts: Failed calling LoadBoxReceipt "
+                 "on "
+                 "abbreviated transaction number:"
+              << lSetNum << ".\n";
+        // If psetUnloaded is passed in, then we don't want to break,
+        // because we want to
+        // populate it with the conmplete list of IDs that wouldn't load as
+        // a Box Receipt.
+        // Thus, we only break if psetUnloaded is nullptr.
+        //
+        if (nullptr == psetUnloaded) break;
     }
 
-    // You might ask, why didn't I just iterate through the transactions
-    // directly and just call
-    // LoadBoxReceipt on each one? Answer: Because that function actually
-    // deletes the transaction
-    // and replaces it with a different object, if successful.
-
     return bRetVal;
 }
 
+std::vector<std::unique_ptr<OTTransaction>> Ledger::load_box_receipts(
+    const std::vector<OTTransaction*>& abbreviated) const
+{
+    const auto type = static_cast<int64_t>(GetType());
+    std::vector<std::unique_ptr<OTTransaction>> output(abbreviated.size());
+    ParallelFor(
+        abbreviated.size(),
+        OT_LEDGER_PARALLEL_RECEIPTS,
+        OT_PARALLEL_MAX_THREADS,
+        [&](const std::size_t i) {
+            output.at(i).reset(
+                ::opentxs::LoadBoxReceipt(*abbreviated.at(i), type));
+        });
+
+    return output;
+}
+
 /*
  While the box itself is stored at (for example) "nymbox/NOTARY_ID/NYM_ID"
  the box receipts for that box may be stored at: "nymbox/NOTARY_ID/NYM_ID.r"
@@ -454,6 +546,7 @@ bool Ledger::LoadExpiredBoxFromString(const String& strBox)
 bool Ledger::LoadGeneric(Ledger::ledgerType theType, const String* pString)
 {
     m_Type = theType;
+    loaded_from_cache_ = false;
 
     const char* pszType = GetTypeString();
     const char* pszFolder = nullptr;
@@ -522,10 +615,14 @@ bool Ledger::LoadGeneric(Ledger::ledgerType theType, const String* pString)
 
         // Try to load the ledger from local storage.
         //
-        std::string strFileContents(OTDB::QueryPlainString(
-            szFolder1name,
-            szFolder2name,
-            szFilename));  // <=== LOADING FROM DATA STORE.
+        std::string strFileContents(
+            cached_box(theType)
+                ? OT::App().Server().QueryFile(
+                      szFolder1name, szFolder2name, szFilename)
+                : OTDB::QueryPlainString(
+                      szFolder1name,
+                      szFolder2name,
+                      szFilename));  // <=== LOADING FROM DATA STORE.
 
         if (strFileContents.length() < 2) {
             otErr << "OTLedger::LoadGeneric: Error reading file: "
@@ -547,6 +644,8 @@ bool Ledger::LoadGeneric(Ledger::ledgerType theType, const String* pString)
     }
 
     bool bSuccess = LoadContractFromString(strRawFile);
+    loaded_from_cache_ =
+        bSuccess && (nullptr == pString) && cached_box(theType);
 
     if (!bSuccess) {
         otErr << "Failed loading " << pszType << " "
@@ -646,16 +745,36 @@ bool Ledger::SaveGeneric(Ledger::ledgerType theType)
         return false;
     }
 
-    bool bSaved = OTDB::StorePlainString(
-        strFinal.Get(),
-        szFolder1name,
-        szFolder2name,
-        szFilename);  // <=== SAVING TO DATA STORE.
+    bool bSaved =
+        cached_box(theType)
+            ? OT::App().Server().StoreFile(
+                  strFinal.Get(), szFolder1name, szFolder2name, szFilename)
+            : OTDB::StorePlainString(
+                  strFinal.Get(),
+                  szFolder1name,
+                  szFolder2name,
+                  szFilename);  // <=== SAVING TO DATA STORE.
     if (!bSaved) {
         otErr << "OTLedger::SaveGeneric: Error writing " << pszType
               << " to file: " << szFolder1name << Log::PathSeparator()
               << szFolder2name << Log::PathSeparator() << szFilename << "\n";
         return false;
+    }
+
+    if ((nullptr != deferred_signer_) && cached_box(theType)) {
+        const auto& signer = *deferred_signer_;
+        const String contents(m_xmlUnsigned);
+        const std::string folder(szFolder1name);
+        const std::string notaryID(szFolder2name);
+        const std::string boxID(szFilename);
+        OT::App().Server().DeferBoxSignature(
+            folder,
+            notaryID,
+            boxID,
+            [theType, &signer, contents, folder, notaryID, boxID]() -> bool {
+                return sign_deferred(
+                    theType, signer, contents, folder, notaryID, boxID);
+            });
     } else
         otInfo << "Successfully saved " << pszType << ": " << szFolder1name
                << Log::PathSeparator() << szFolder2name << Log::PathSeparator()
@@ -664,6 +783,45 @@ bool Ledger::SaveGeneric(Ledger::ledgerType theType)
     return bSaved;
 }
 
+bool Ledger::sign_deferred(
+    const ledgerType type,
+    const Nym& signer,
+    const String& contents,
+    const std::string& folder,
+    const std::string& notaryID,
+    const std::string& boxID)
+{
+    Ledger box;
+    box.m_Type = type;
+    box.m_xmlUnsigned.Set(contents);
+    box.sign_as_is_ = true;
+
+    if (false == box.ot_super::SignContract(signer)) {
+
+        return false;
+    }
+
+    box.sign_as_is_ = false;
+    String strRawFile;
+    String strFinal;
+
+    if (false == (box.SaveContract() && box.SaveContractRaw(strRawFile))) {
+
+        return false;
+    }
+
+    OTASCIIArmor ascTemp(strRawFile);
+
+    if (false ==
+        ascTemp.WriteArmoredString(strFinal, box.m_strContractType.Get())) {
+
+        return false;
+    }
+
+    return OT::App().Server().StoreFile(
+        strFinal.Get(), folder, notaryID, boxID);
+}
+
 // If you know you have an inbox, outbox, or nymbox, then call
 // CalculateInboxHash,
 // CalculateOutboxHash, or CalculateNymboxHash. Otherwise, if in doubt, call
@@ -747,6 +905,10 @@ bool Ledger::SaveNymbox(Identifier* pNymboxHash)  // If you pass
         // nymbox hash.\n";
     }
 
+    if (bSaved) {
+        publish_change(pNymboxHash);
+    }
+
     return bSaved;
 }
 
@@ -792,6 +954,10 @@ bool Ledger::SaveInbox(Identifier* pInboxHash)  // If you pass the
                      "hash.\n";
     }
 
+    if (bSaved) {
+        publish_change(pInboxHash);
+    }
+
     return bSaved;
 }
 
@@ -824,9 +990,48 @@ bool Ledger::SaveOutbox(Identifier* pOutboxHash)  // If you pass
                      "hash.\n";
     }
 
+    if (bSaved) {
+        publish_change(pOutboxHash);
+    }
+
     return bSaved;
 }
 
+bool Ledger::cached_box(const ledgerType type)
+{
+    switch (type) {
+        case Ledger::nymbox:
+        case Ledger::inbox:
+        case Ledger::outbox: {
+
+            return OT::App().ServerMode();
+        }
+        default: {
+
+            return false;
+        }
+    }
+}
+
+void Ledger::publish_change(const Identifier* pHash)
+{
+    if (false == OT::App().ServerMode()) {
+
+        return;
+    }
+
+    Identifier hash{};
+
+    if (nullptr != pHash) {
+        hash = *pHash;
+    } else if (false == CalculateHash(hash)) {
+
+        return;
+    }
+
+    OT::App().Server().PublishBoxChange(GetNymID(), GetTypeString(), hash);
+}
+
 // If you're going to save this, make sure you sign it first.
 bool Ledger::SavePaymentInbox()
 {
@@ -1048,6 +1253,7 @@ Ledger::Ledger(
     : OTTransactionType(theNymID, theAccountID, theNotaryID)
     , m_Type(Ledger::message)
     , m_bLoadedLegacyData(false)
+    , loaded_from_cache_(false)
 {
     InitLedger();
 }
@@ -1063,6 +1269,7 @@ Ledger::Ledger(const Identifier& theAccountID, const Identifier& theNotaryID)
     : OTTransactionType()
     , m_Type(Ledger::message)
     , m_bLoadedLegacyData(false)
+    , loaded_from_cache_(false)
 {
     InitLedger();
 
@@ -1075,6 +1282,7 @@ Ledger::Ledger()
     : OTTransactionType()
     , m_Type(Ledger::message)
     , m_bLoadedLegacyData(false)
+    , loaded_from_cache_(false)
 {
     InitLedger();
 }
@@ -1722,6 +1930,11 @@ bool Ledger::LoadLedgerFromString(const String& theStr)
 void Ledger::UpdateContents()  // Before transmission or serialization, this is
                                // where the ledger saves its contents
 {
+    if (sign_as_is_) {
+
+        return;
+    }
+
     switch (GetType()) {
         case Ledger::message:
         case Ledger::nymbox:
@@ -2419,7 +2632,12 @@ void Ledger::ReleaseTransactions()
     }
 }
 
-void Ledger::Release_Ledger() { ReleaseTransactions(); }
+void Ledger::Release_Ledger()
+{
+    ReleaseTransactions();
+    loaded_from_cache_ = false;
+    deferred_signer_ = nullptr;
+}
 
 void Ledger::Release()
 {
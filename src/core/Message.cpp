@@ -130,6 +130,8 @@
 #define REQUEST_ADMIN_RESPONSE "requestAdminResponse"
 #define ADD_CLAIM "addClaim"
 #define ADD_CLAIM_RESPONSE "addClaimResponse"
+#define GET_MARKET_DATA "getMarketData"
+#define GET_MARKET_DATA_RESPONSE "getMarketDataResponse"
 
 // PROTOCOL DOCUMENT
 
@@ -211,6 +213,8 @@ const Message::TypeMap Message::message_names_{
     {MessageType::requestAdminR, REQUEST_ADMIN_RESPONSE},
     {MessageType::addClaim, ADD_CLAIM},
     {MessageType::addClaimR, ADD_CLAIM_RESPONSE},
+    {MessageType::getMarketData, GET_MARKET_DATA},
+    {MessageType::getMarketDataR, GET_MARKET_DATA_RESPONSE},
 };
 
 const std::map<MessageType, MessageType> Message::reply_message_{
@@ -247,6 +251,7 @@ const std::map<MessageType, MessageType> Message::reply_message_{
     {MessageType::registerContract, MessageType::registerContractR},
     {MessageType::requestAdmin, MessageType::requestAdminR},
     {MessageType::addClaim, MessageType::addClaimR},
+    {MessageType::getMarketData, MessageType::getMarketDataR},
 };
 
 const Message::ReverseTypeMap Message::message_types_ = make_reverse_map();
@@ -436,6 +441,10 @@ void Message::UpdateContents()
     tag.add_attribute("version", m_strVersion.Get());
     tag.add_attribute("dateSigned", formatTimestamp(m_lTime));
 
+    if (m_bStarting) {
+        tag.add_attribute("starting", formatBool(true));
+    }
+
     if (!updateContentsByType(tag)) {
         TagPtr pTag(new Tag(m_strCommand.Get()));
         pTag->add_attribute("requestNum", m_strRequestNum.Get());
@@ -560,6 +569,8 @@ int32_t Message::processXmlNodeNotaryMessage(
 
     if (strDateSigned.Exists()) m_lTime = parseTimestamp(strDateSigned.Get());
 
+    m_bStarting = String(xml->getAttributeValue("starting")).Compare("true");
+
     otInfo << "\n===> Loading XML for Message into memory structures...\n";
 
     return 1;
@@ -660,8 +671,11 @@ Message::Message()
     , m_lNewRequestNum(0)
     , m_lDepth(0)
     , m_lTransactionNum(0)
+    , m_lRangeStart(0)
+    , m_lRangeEnd(0)
     , m_bSuccess(false)
     , m_bBool(false)
+    , m_bStarting(false)
     , m_lTime(0)
 
 {
@@ -933,6 +947,141 @@ RegisterStrategy StrategyGetMarketRecentTradesResponse::reg(
     "getMarketRecentTradesResponse",
     new StrategyGetMarketRecentTradesResponse());
 
+class StrategyGetMarketData : public OTMessageStrategy
+{
+public:
+    virtual void writeXml(Message& m, Tag& parent)
+    {
+        TagPtr pTag(new Tag(m.m_strCommand.Get()));
+
+        pTag->add_attribute("requestNum", m.m_strRequestNum.Get());
+        pTag->add_attribute("nymID", m.m_strNymID.Get());
+        pTag->add_attribute("notaryID", m.m_strNotaryID.Get());
+        pTag->add_attribute("marketID", m.m_strNymID2.Get());
+        pTag->add_attribute("interval", formatLong(m.m_lDepth));
+        pTag->add_attribute("from", formatLong(m.m_lRangeStart));
+        pTag->add_attribute("to", formatLong(m.m_lRangeEnd));
+
+        parent.add_tag(pTag);
+    }
+
+    int32_t processXml(Message& m, irr::io::IrrXMLReader*& xml)
+    {
+        m.m_strCommand = xml->getNodeName();  // Command
+        m.m_strNymID = xml->getAttributeValue("nymID");
+        m.m_strNotaryID = xml->getAttributeValue("notaryID");
+        m.m_strRequestNum = xml->getAttributeValue("requestNum");
+        m.m_strNymID2 = xml->getAttributeValue("marketID");
+
+        String strInterval = xml->getAttributeValue("interval");
+        String strFrom = xml->getAttributeValue("from");
+        String strTo = xml->getAttributeValue("to");
+
+        if (strInterval.GetLength() > 0) m.m_lDepth = strInterval.ToLong();
+        if (strFrom.GetLength() > 0) m.m_lRangeStart = strFrom.ToLong();
+        if (strTo.GetLength() > 0) m.m_lRangeEnd = strTo.ToLong();
+
+        otWarn << "\nCommand: " << m.m_strCommand
+               << "\nNymID:    " << m.m_strNymID
+               << "\nNotaryID: " << m.m_strNotaryID
+               << "\n Market ID: " << m.m_strNymID2
+               << "\n Interval: " << m.m_lDepth
+               << "\n From: " << m.m_lRangeStart << "\n To: " << m.m_lRangeEnd
+               << "\n Request #: " << m.m_strRequestNum << "\n";
+
+        return 1;
+    }
+    static RegisterStrategy reg;
+};
+RegisterStrategy StrategyGetMarketData::reg(
+    "getMarketData",
+    new StrategyGetMarketData());
+
+class StrategyGetMarketDataResponse : public OTMessageStrategy
+{
+public:
+    virtual void writeXml(Message& m, Tag& parent)
+    {
+        TagPtr pTag(new Tag(m.m_strCommand.Get()));
+
+        pTag->add_attribute("success", formatBool(m.m_bSuccess));
+        pTag->add_attribute("requestNum", m.m_strRequestNum.Get());
+        pTag->add_attribute("nymID", m.m_strNymID.Get());
+        pTag->add_attribute("notaryID", m.m_strNotaryID.Get());
+        pTag->add_attribute("depth", formatLong(m.m_lDepth));
+        pTag->add_attribute("marketID", m.m_strNymID2.Get());
+
+        // The payload always names the interval, even if it holds no rows
+        if (m.m_bSuccess && (m.m_ascPayload.GetLength() > 2)) {
+            pTag->add_tag("messagePayload", m.m_ascPayload.Get());
+        } else if (!m.m_bSuccess && (m.m_ascInReferenceTo.GetLength() > 2)) {
+            pTag->add_tag("inReferenceTo", m.m_ascInReferenceTo.Get());
+        }
+
+        parent.add_tag(pTag);
+    }
+
+    virtual int32_t processXml(Message& m, irr::io::IrrXMLReader*& xml)
+    {
+        processXmlSuccess(m, xml);
+
+        m.m_strCommand = xml->getNodeName();  // Command
+        m.m_strRequestNum = xml->getAttributeValue("requestNum");
+        m.m_strNymID = xml->getAttributeValue("nymID");
+        m.m_strNotaryID = xml->getAttributeValue("notaryID");
+        m.m_strNymID2 = xml->getAttributeValue("marketID");
+
+        String strDepth = xml->getAttributeValue("depth");
+
+        if (strDepth.GetLength() > 0) m.m_lDepth = strDepth.ToLong();
+
+        const char* pElementExpected = nullptr;
+        if (m.m_bSuccess)
+            pElementExpected = "messagePayload";
+        else if (!m.m_bSuccess)
+            pElementExpected = "inReferenceTo";
+
+        if (nullptr != pElementExpected) {
+            OTASCIIArmor ascTextExpected;
+
+            if (!Contract::LoadEncodedTextFieldByName(
+                    xml, ascTextExpected, pElementExpected)) {
+                otErr << "Error in OTMessage::ProcessXMLNode: "
+                         "Expected "
+                      << pElementExpected << " element with text field, for "
+                      << m.m_strCommand << ".\n";
+                return (-1);  // error condition
+            }
+
+            if (m.m_bSuccess)
+                m.m_ascPayload.Set(ascTextExpected);
+            else
+                m.m_ascInReferenceTo = ascTextExpected;
+        }
+
+        if (m.m_bSuccess)
+            otWarn << "\nCommand: " << m.m_strCommand << "   "
+                   << (m.m_bSuccess ? "SUCCESS" : "FAILED")
+                   << "\nNymID:    " << m.m_strNymID
+                   << "\n NotaryID: " << m.m_strNotaryID
+                   << "\n MarketID: " << m.m_strNymID2
+                   << "\n\n";  // m_ascPayload.Get()
+        else
+            otWarn << "\nCommand: " << m.m_strCommand << "   "
+                   << (m.m_bSuccess ? "SUCCESS" : "FAILED")
+                   << "\nNymID:    " << m.m_strNymID
+                   << "\n NotaryID: " << m.m_strNotaryID
+                   << "\n MarketID: " << m.m_strNymID2
+                   << "\n\n";  // m_ascInReferenceTo.Get()
+
+        return 1;
+    }
+    static RegisterStrategy reg;
+};
+RegisterStrategy StrategyGetMarketDataResponse::reg(
+    "getMarketDataResponse",
+    new StrategyGetMarketDataResponse());
+
 class StrategyGetNymMarketOffers : public OTMessageStrategy
 {
 public:
@@ -1190,6 +1339,8 @@ public:
         pTag->add_attribute("requestNum", m.m_strRequestNum.Get());
         pTag->add_attribute("nymID", m.m_strNymID.Get());
         pTag->add_attribute("notaryID", m.m_strNotaryID.Get());
+        // The port on which box change notices are published
+        pTag->add_attribute("depth", formatLong(m.m_lDepth));
 
         parent.add_tag(pTag);
     }
@@ -1203,6 +1354,10 @@ public:
         m.m_strNymID = xml->getAttributeValue("nymID");
         m.m_strNotaryID = xml->getAttributeValue("notaryID");
 
+        String strDepth = xml->getAttributeValue("depth");
+
+        if (strDepth.GetLength() > 0) m.m_lDepth = strDepth.ToLong();
+
         otWarn << "\nCommand: " << m.m_strCommand
                << "\nSuccess: " << (m.m_bSuccess ? "true" : "false")
                << "\nNymID:    " << m.m_strNymID
@@ -44,9 +44,10 @@
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/String.hpp"
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstdint>
-#include <locale>
+#include <limits>
 #include <ostream>
 #include <set>
 #include <string>
@@ -97,7 +98,8 @@ bool NumList::Add(const std::string& strNumbers)  // if false, means the
 
 // This function is private, so you can't use it without passing an OTString.
 // (For security reasons.) It takes a comma-separated list of numbers, and adds
-// them to *this.
+// them to *this. Ranges are rejected: NumLists arrive from peers, and a single
+// range could name more numbers than the receiver can expand.
 //
 bool NumList::Add(const char* szNumbers)  // if false, means the numbers were
                                           // already there. (At least one of
@@ -105,68 +107,19 @@ bool NumList::Add(const char* szNumbers)  // if false, means the numbers were
 {
     OT_ASSERT(nullptr != szNumbers);  // Should never happen.
 
-    bool bSuccess = true;
-    int64_t lNum = 0;
-    const char* pChar = szNumbers;
-    std::locale loc;
-
-    // Skip any whitespace.
-    while (std::isspace(*pChar, loc)) pChar++;
-
-    bool bStartedANumber =
-        false;  // During the loop, set this to true when processing a digit,
-                // and set to false when anything else. That way when we go to
-                // add the number to the list, and it's "0", we'll know it's a
-                // real number we're supposed to add, and not just a default
-                // value.
-
-    for (;;)  // We already know it's not null, due to the assert. (So at least
-              // one iteration will happen.)
-    {
-        if (std::isdigit(*pChar, loc)) {
-            bStartedANumber = true;
-
-            int32_t nDigit = (*pChar - '0');
-
-            lNum *= 10;  // Move it up a decimal place.
-            lNum += nDigit;
-        }
-        // if separator, or end of string, either way, add lNum to *this.
-        else if (
-            (',' == *pChar) || ('\0' == *pChar) ||
-            std::isspace(*pChar, loc))  // first sign of a space, and we are
-                                        // done with current number. (On to
-                                        // the next.)
-        {
-            if ((lNum > 0) || (bStartedANumber && (0 == lNum))) {
-                if (!Add(lNum))  // <=========
-                {
-                    bSuccess = false;  // We still go ahead and try to add them
-                                       // all, and then return this sort of
-                                       // status when it's all done.
-                }
-            }
-
-            lNum = 0;  // reset for the next transaction number (in the
-                       // comma-separated list.)
-            bStartedANumber = false;  // reset
-        } else {
-            otErr << "OTNumList::Add: Error: Unexpected character found in "
-                     "erstwhile comma-separated list of longs: "
-                  << *pChar << "\n";
-            bSuccess = false;
-            break;
-        }
+    IntervalSet parsed;
+    bool bSuccess = IntervalSet::Parse(szNumbers, parsed, false);
 
-        // End of the road.
-        if ('\0' == *pChar) break;
-
-        pChar++;
-
-        // Skip any whitespace.
-        while (std::isspace(*pChar, loc)) pChar++;
+    if (!bSuccess) {
+        otErr << "OTNumList::Add: Error: Unexpected character found in "
+                 "erstwhile comma-separated list of longs: "
+              << szNumbers << "\n";
+    }
 
-    }  // while
+    // Whatever was parsed before an error is still added, as before.
+    if (m_setData.Insert(parsed) != parsed.size()) {
+        bSuccess = false;
+    }
 
     return bSuccess;
 }
@@ -174,14 +127,7 @@ bool NumList::Add(const char* szNumbers)  // if false, means the numbers were
 bool NumList::Add(const int64_t& theValue)  // if false, means the value was
                                             // already there.
 {
-    auto it = m_setData.find(theValue);
-
-    if (m_setData.end() == it)  // it's not already there, so add it.
-    {
-        m_setData.insert(theValue);
-        return true;
-    }
-    return false;  // it was already there.
+    return m_setData.insert(theValue).second;
 }
 
 bool NumList::Peek(int64_t& lPeek) const
@@ -202,7 +148,7 @@ bool NumList::Pop()
 
     if (m_setData.end() != it)  // it's there.
     {
-        m_setData.erase(it);
+        m_setData.erase(*it);
         return true;
     }
     return false;
@@ -211,14 +157,8 @@ bool NumList::Pop()
 bool NumList::Remove(const int64_t& theValue)  // if false, means the value was
                                                // NOT already there.
 {
-    auto it = m_setData.find(theValue);
-
-    if (m_setData.end() != it)  // it's there.
-    {
-        m_setData.erase(it);
-        return true;
-    }
-    return false;  // it wasn't there (so how could you remove it then?)
+    // if false, it wasn't there (so how could you remove it then?)
+    return 1 == m_setData.erase(theValue);
 }
 
 bool NumList::Verify(const int64_t& theValue) const  // returns true/false
@@ -251,34 +191,22 @@ bool NumList::Verify(const std::set<int64_t>& theNumbers) const
 ///
 bool NumList::Verify(const NumList& rhs) const
 {
-    // Verify they have the same number of elements.
-    //
-    if (Count() != rhs.Count()) return false;
-
-    // Verify each value on *this is also found on rhs.
-    //
-    for (auto& it : m_setData) {
-        if (!rhs.Verify(it)) return false;
-    }
-
-    return true;
+    return m_setData == rhs.m_setData;
 }
 
 /// True/False, based on whether ANY of the numbers in rhs are found in *this.
 ///
 bool NumList::VerifyAny(const NumList& rhs) const
 {
-    return rhs.VerifyAny(m_setData);
+    return m_setData.Intersects(rhs.m_setData);
 }
 
 /// Verify whether ANY of the numbers on *this are found in setData.
 ///
 bool NumList::VerifyAny(const std::set<int64_t>& setData) const
 {
-    for (const auto& it : m_setData) {
-        auto it_find = setData.find(it);
-
-        if (it_find != setData.end())  // found a match.
+    for (const auto& it : setData) {
+        if (1 == m_setData.count(it))  // found a match.
             return true;
     }
 
@@ -289,10 +217,9 @@ bool NumList::Add(const NumList& theNumList)  // if false, means the numbers
                                               // were already there. (At
                                               // least one of them.)
 {
-    std::set<int64_t> theOutput;
-    theNumList.Output(theOutput);  // returns false if the numlist was empty.
+    const auto& theNumbers = theNumList.m_setData;
 
-    return Add(theOutput);
+    return theNumbers.size() == m_setData.Insert(theNumbers);
 }
 
 bool NumList::Add(const std::set<int64_t>& theNumbers)  // if false, means the
@@ -333,7 +260,7 @@ bool NumList::Output(std::set<int64_t>& theOutput) const  // returns false if
                                                           // the numlist was
                                                           // empty.
 {
-    theOutput = m_setData;
+    theOutput = m_setData.Set();
 
     return !m_setData.empty();
 }
@@ -362,7 +289,9 @@ bool NumList::Output(String& strOutput) const  // returns false if the
 
 int32_t NumList::Count() const
 {
-    return static_cast<int32_t>(m_setData.size());
+    const std::size_t max = std::numeric_limits<int32_t>::max();
+
+    return static_cast<int32_t>(std::min(m_setData.size(), max));
 }
 
 void NumList::Release() { m_setData.clear(); }
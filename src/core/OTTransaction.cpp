@@ -40,6 +40,8 @@
 
 #include "opentxs/core/OTTransaction.hpp"
 
+#include "opentxs/api/Native.hpp"
+#include "opentxs/api/Server.hpp"
 #include "opentxs/consensus/ServerContext.hpp"
 #include "opentxs/consensus/TransactionStatement.hpp"
 #include "opentxs/core/cron/OTCronItem.hpp"
@@ -51,6 +53,7 @@
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/util/Common.hpp"
 #include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/util/ParallelFor.hpp"
 #include "opentxs/core/util/Tag.hpp"
 #include "opentxs/core/Account.hpp"
 #include "opentxs/core/Cheque.hpp"
@@ -66,10 +69,12 @@
 #include "opentxs/core/OTStringXML.hpp"
 #include "opentxs/core/OTTransactionType.hpp"
 #include "opentxs/core/String.hpp"
+#include "opentxs/OT.hpp"
 #include "opentxs/Types.hpp"
 
 #include <irrxml/irrXML.hpp>
 #include <stdint.h>
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
@@ -77,6 +82,10 @@
 #include <string>
 #include <vector>
 
+// Transactions with fewer items than this have their item signatures verified
+// on the calling thread
+#define OT_PARALLEL_ITEM_SIGNATURES 32
+
 #define OT_METHOD "opentxs::OTTransaction::"
 
 namespace opentxs
@@ -2687,12 +2696,20 @@ bool OTTransaction::DeleteBoxReceipt(Ledger& theLedger)
             "(Transaction was already empty -- strange.)",
             "MARKED_FOR_DELETION");  // todo hardcoded.
 
-    bool bDeleted = OTDB::StorePlainString(
-        strOutput.Get(),
-        strFolder1name.Get(),
-        strFolder2name.Get(),
-        strFolder3name.Get(),
-        strFilename.Get());
+    bool bDeleted =
+        CachedBoxReceipt(static_cast<int64_t>(theLedger.GetType()))
+            ? OT::App().Server().StoreFile(
+                  strOutput.Get(),
+                  strFolder1name.Get(),
+                  strFolder2name.Get(),
+                  strFolder3name.Get(),
+                  strFilename.Get())
+            : OTDB::StorePlainString(
+                  strOutput.Get(),
+                  strFolder1name.Get(),
+                  strFolder2name.Get(),
+                  strFolder3name.Get(),
+                  strFilename.Get());
     if (!bDeleted)
         otErr << __FUNCTION__
               << ": Error deleting (writing over) file: " << strFolder1name
@@ -2761,12 +2778,19 @@ bool OTTransaction::SaveBoxReceipt(int64_t lLedgerType)
         return false;
     }
 
-    bool bSaved = OTDB::StorePlainString(
-        strFinal.Get(),
-        strFolder1name.Get(),
-        strFolder2name.Get(),
-        strFolder3name.Get(),
-        strFilename.Get());
+    bool bSaved = CachedBoxReceipt(lLedgerType)
+                      ? OT::App().Server().StoreFile(
+                            strFinal.Get(),
+                            strFolder1name.Get(),
+                            strFolder2name.Get(),
+                            strFolder3name.Get(),
+                            strFilename.Get())
+                      : OTDB::StorePlainString(
+                            strFinal.Get(),
+                            strFolder1name.Get(),
+                            strFolder2name.Get(),
+                            strFolder3name.Get(),
+                            strFilename.Get());
 
     if (!bSaved)
         otErr << __FUNCTION__ << ": Error writing file: " << strFolder1name
@@ -2879,7 +2903,7 @@ bool OTTransaction::VerifyBoxReceipt(OTTransaction& theFullVersion)
 // make sure that the items on it also have the right owner, as well as that
 // owner's signature, and a matching transaction number to boot.
 //
-bool OTTransaction::VerifyItems(Nym& theNym)
+bool OTTransaction::VerifyItems(const Nym& theNym)
 {
     const Identifier NYM_ID(theNym);
 
@@ -2894,9 +2918,8 @@ bool OTTransaction::VerifyItems(Nym& theNym)
     // items
     // and the transaction both have the same owner: Nym.
 
-    // if pointer not null, and it's a withdrawal, and it's an acknowledgement
-    // (not a rejection or error)
-    //
+    std::vector<const Item*> items{};
+
     for (auto& it : GetItemList()) {
         // loop through the ALL items that make up this transaction and check
         // to see if a response to deposit.
@@ -2907,16 +2930,25 @@ bool OTTransaction::VerifyItems(Nym& theNym)
 
         if (NYM_ID != pItem->GetNymID()) return false;
 
-        if (!pItem->VerifySignature(theNym))  // NO need to call
-                                              // VerifyAccount since
-                                              // VerifyContractID is
-                                              // ALREADY called and now
-                                              // here's
-                                              // VerifySignature().
-            return false;
+        items.push_back(pItem);
     }
 
-    return true;
+    // NO need to call VerifyAccount since VerifyContractID is ALREADY called
+    // and now here's VerifySignature(). The signatures are independent of
+    // each other, so large transactions (such as a processInbox accepting
+    // many receipts) check them on several threads.
+    std::atomic<bool> verified{true};
+    ParallelFor(
+        items.size(),
+        OT_PARALLEL_ITEM_SIGNATURES,
+        OT_PARALLEL_MAX_THREADS,
+        [&](const std::size_t i) {
+            if (verified && (false == items.at(i)->VerifySignature(theNym))) {
+                verified = false;
+            }
+        });
+
+    return verified;
 }
 
 // private and hopefully not needed
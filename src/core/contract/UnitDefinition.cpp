@@ -68,10 +68,13 @@
 #include <iomanip>
 #include <map>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <string>
 #include <utility>
 
+#define OT_METHOD "opentxs::UnitDefinition::"
+
 namespace opentxs
 {
 
@@ -292,50 +295,219 @@ bool UnitDefinition::DisplayStatistics(String& strContents) const
     return true;
 }
 
-// currently only "user" accounts (normal user asset accounts) are added to
-// this list Any "special" accounts, such as basket reserve accounts, or voucher
-// reserve accounts, or cash reserve accounts, are not included on this list.
-bool UnitDefinition::VisitAccountRecords(AccountVisitor& visitor) const
+std::map<std::string, std::string> UnitDefinition::account_records(
+    const Lock& lock,
+    const std::size_t shard) const
+{
+    OT_ASSERT(verify_write_lock(lock));
+
+    std::map<std::string, std::string> output{};
+    const auto folder = account_records_folder(lock);
+    String strShard{};
+    strShard.Format("%02zx", shard);
+
+    if (false ==
+        OTDB::Exists(OTFolders::Contract().Get(), folder, strShard.Get())) {
+
+        return output;
+    }
+
+    std::unique_ptr<OTDB::Storable> pStorable(OTDB::QueryObject(
+        OTDB::STORED_OBJ_STRING_MAP,
+        OTFolders::Contract().Get(),
+        folder,
+        strShard.Get()));
+    auto pMap = dynamic_cast<OTDB::StringMap*>(pStorable.get());
+
+    if (nullptr == pMap) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to load account records shard " << strShard
+              << " for instrument definition "
+              << String(id(lock)) << std::endl;
+
+        return output;
+    }
+
+    output.swap(pMap->the_map);
+
+    return output;
+}
+
+std::string UnitDefinition::account_records_folder(const Lock& lock) const
+{
+    return String(id(lock)).Get() + std::string(".accounts");
+}
+
+std::size_t UnitDefinition::AccountRecordShard(const std::string& accountID)
+{
+    // FNV-1a. The shard an account lands in is part of the storage layout, so
+    // this must not change between builds or platforms.
+    std::uint32_t hash{2166136261};
+
+    for (const auto& c : accountID) {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= 16777619;
+    }
+
+    return hash % AccountRecordShards;
+}
+
+std::set<std::string> UnitDefinition::AccountRecords(
+    const std::size_t shard) const
 {
     Lock lock(lock_);
+    std::set<std::string> output{};
+
+    if (AccountRecordShards <= shard) {
+
+        return output;
+    }
+
+    migrate_account_records(lock);
+    const String strInstrumentDefinitionID(id(lock));
+
+    for (const auto& it : account_records(lock, shard)) {
+        const auto& accountID = it.first;
+        const auto& unitID = it.second;
+
+        if (false == strInstrumentDefinitionID.Compare(unitID.c_str())) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Error: wrong instrument definition ID (" << unitID
+                  << ") when expecting: " << strInstrumentDefinitionID
+                  << std::endl;
+
+            continue;
+        }
+
+        output.emplace(accountID);
+    }
+
+    return output;
+}
+
+// Older versions kept every account for a unit in a single "<unit>.a" file.
+// Move those records into the sharded layout the first time they are touched.
+bool UnitDefinition::migrate_account_records(const Lock& lock) const
+{
+    OT_ASSERT(verify_write_lock(lock));
 
     const String strInstrumentDefinitionID(id(lock));
     String strAcctRecordFile;
     strAcctRecordFile.Format("%s.a", strInstrumentDefinitionID.Get());
 
+    if (false ==
+        OTDB::Exists(OTFolders::Contract().Get(), strAcctRecordFile.Get())) {
+
+        return true;
+    }
+
     std::unique_ptr<OTDB::Storable> pStorable(OTDB::QueryObject(
         OTDB::STORED_OBJ_STRING_MAP,
         OTFolders::Contract().Get(),
         strAcctRecordFile.Get()));
+    auto pMap = dynamic_cast<OTDB::StringMap*>(pStorable.get());
 
-    OTDB::StringMap* pMap = dynamic_cast<OTDB::StringMap*>(pStorable.get());
+    if (nullptr == pMap) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to load legacy account records file for instrument "
+              << "definition " << strInstrumentDefinitionID << std::endl;
 
-    // There was definitely a StringMap loaded from local storage.
-    // (Even an empty one, possibly.) This is the only block that matters in
-    // this function.
-    //
-    if (nullptr != pMap) {
-        Identifier* pNotaryID = visitor.GetNotaryID();
-        OT_ASSERT_MSG(
-            nullptr != pNotaryID,
-            "Assert: nullptr Notary ID on functor. "
-            "(How did you even construct the "
-            "thing?)");
-
-        auto& theMap = pMap->the_map;
-
-        // todo: optimize: will probably have to use a database for this,
-        // int64_t term.
-        // (What if there are a million acct IDs in this flat file? Not
-        // scaleable.)
-        //
-        for (auto& it : theMap) {
+        return false;
+    }
+
+    std::map<std::size_t, std::map<std::string, std::string>> shards{};
+
+    for (const auto& it : pMap->the_map) {
+        const auto shard = AccountRecordShard(it.first);
+        auto existing = shards.find(shard);
+
+        if (shards.end() == existing) {
+            existing =
+                shards.emplace(shard, account_records(lock, shard)).first;
+        }
+
+        existing->second.emplace(it.first, it.second);
+    }
+
+    for (const auto& it : shards) {
+        if (false == save_account_records(lock, it.first, it.second)) {
+
+            return false;
+        }
+    }
+
+    OTDB::EraseValueByKey(OTFolders::Contract().Get(), strAcctRecordFile.Get());
+    otWarn << OT_METHOD << __FUNCTION__ << ": Migrated "
+           << pMap->the_map.size() << " account records for instrument "
+           << "definition " << strInstrumentDefinitionID << std::endl;
+
+    return true;
+}
+
+bool UnitDefinition::save_account_records(
+    const Lock& lock,
+    const std::size_t shard,
+    const std::map<std::string, std::string>& records) const
+{
+    OT_ASSERT(verify_write_lock(lock));
+
+    std::unique_ptr<OTDB::Storable> pStorable(
+        OTDB::CreateObject(OTDB::STORED_OBJ_STRING_MAP));
+    auto pMap = dynamic_cast<OTDB::StringMap*>(pStorable.get());
+
+    OT_ASSERT(nullptr != pMap);
+
+    pMap->the_map = records;
+    String strShard{};
+    strShard.Format("%02zx", shard);
+
+    if (false == OTDB::StoreObject(
+                     *pMap,
+                     OTFolders::Contract().Get(),
+                     account_records_folder(lock),
+                     strShard.Get())) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to save account "
+              << "records shard " << strShard << " for instrument definition "
+              << String(id(lock)) << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
+// currently only "user" accounts (normal user asset accounts) are added to
+// this list Any "special" accounts, such as basket reserve accounts, or voucher
+// reserve accounts, or cash reserve accounts, are not included on this list.
+//
+// The records are read one shard at a time, so memory use does not grow with
+// the number of accounts. Callers that need to checkpoint or parallelize a
+// long walk should iterate AccountRecords() themselves.
+bool UnitDefinition::VisitAccountRecords(AccountVisitor& visitor) const
+{
+    Lock lock(lock_);
+
+    if (false == migrate_account_records(lock)) {
+
+        return false;
+    }
+
+    const String strInstrumentDefinitionID(id(lock));
+    Identifier* pNotaryID = visitor.GetNotaryID();
+    OT_ASSERT_MSG(
+        nullptr != pNotaryID,
+        "Assert: nullptr Notary ID on functor. "
+        "(How did you even construct the "
+        "thing?)");
+    mapOfAccounts* pLoadedAccounts = visitor.GetLoadedAccts();
+
+    for (std::size_t shard = 0; shard < AccountRecordShards; ++shard) {
+        for (const auto& it : account_records(lock, shard)) {
             const std::string& str_acct_id =
                 it.first;  // Containing the account ID.
             const std::string& str_instrument_definition_id =
                 it.second;  // Containing the instrument definition ID. (Just in
-                            // case
-                            // someone copied the wrong file here...)
+                            // case someone copied the wrong file here...)
 
             if (!strInstrumentDefinitionID.Compare(
                     str_instrument_definition_id.c_str())) {
@@ -344,60 +516,56 @@ bool UnitDefinition::VisitAccountRecords(AccountVisitor& visitor) const
                       << str_instrument_definition_id
                       << ") when expecting: " << strInstrumentDefinitionID
                       << "\n";
-            } else {
-                Account* pAccount = nullptr;
-                std::unique_ptr<Account> theAcctAngel;
 
-                const Identifier theAccountID(str_acct_id);
+                continue;
+            }
 
-                // Before loading it from local storage, let's first make sure
-                // it's not already loaded.
-                // (visitor functor has a list of 'already loaded' accounts,
-                // just in case.)
-                //
-                mapOfAccounts* pLoadedAccounts = visitor.GetLoadedAccts();
-
-                if (nullptr !=
-                    pLoadedAccounts)  // there are some accounts already loaded,
-                {  // let's see if the one we're looking for is there...
-                    auto found_it = pLoadedAccounts->find(str_acct_id);
-
-                    if (pLoadedAccounts->end() != found_it)  // FOUND IT.
-                    {
-                        pAccount = found_it->second;
-                        OT_ASSERT(nullptr != pAccount);
-
-                        if (theAccountID != pAccount->GetPurportedAccountID()) {
-                            otErr << "Error: the actual account didn't have "
-                                     "the ID that the std::map SAID it had! "
-                                     "(Should never happen.)\n";
-                            pAccount = nullptr;
-                        }
+            Account* pAccount = nullptr;
+            std::unique_ptr<Account> theAcctAngel;
+
+            const Identifier theAccountID(str_acct_id);
+
+            // Before loading it from local storage, let's first make sure
+            // it's not already loaded.
+            // (visitor functor has a list of 'already loaded' accounts,
+            // just in case.)
+            //
+            if (nullptr != pLoadedAccounts) {
+                auto found_it = pLoadedAccounts->find(str_acct_id);
+
+                if (pLoadedAccounts->end() != found_it)  // FOUND IT.
+                {
+                    pAccount = found_it->second;
+                    OT_ASSERT(nullptr != pAccount);
+
+                    if (theAccountID != pAccount->GetPurportedAccountID()) {
+                        otErr << "Error: the actual account didn't have "
+                                 "the ID that the std::map SAID it had! "
+                                 "(Should never happen.)\n";
+                        pAccount = nullptr;
                     }
                 }
+            }
 
-                // I guess it wasn't already loaded...
-                // Let's try to load it.
-                //
-                if (nullptr == pAccount) {
-                    pAccount =
-                        Account::LoadExistingAccount(theAccountID, *pNotaryID);
-                    theAcctAngel.reset(pAccount);
-                }
+            // I guess it wasn't already loaded...
+            // Let's try to load it.
+            //
+            if (nullptr == pAccount) {
+                pAccount =
+                    Account::LoadExistingAccount(theAccountID, *pNotaryID);
+                theAcctAngel.reset(pAccount);
+            }
 
-                bool bSuccessLoadingAccount =
-                    ((pAccount != nullptr) ? true : false);
-                if (bSuccessLoadingAccount) {
-                    bool bTriggerSuccess = visitor.Trigger(*pAccount);
-                    if (!bTriggerSuccess)
-                        otErr << __FUNCTION__ << ": Error: Trigger Failed.";
-                } else {
-                    otErr << __FUNCTION__ << ": Error: Failed Loading Account!";
-                }
+            if (nullptr != pAccount) {
+                bool bTriggerSuccess = visitor.Trigger(*pAccount);
+                if (!bTriggerSuccess)
+                    otErr << __FUNCTION__ << ": Error: Trigger Failed.";
+            } else {
+                otErr << __FUNCTION__ << ": Error: Failed Loading Account!";
             }
         }
-        return true;
     }
+
     return true;
 }
 
@@ -411,10 +579,10 @@ bool UnitDefinition::AddAccountRecord(const Account& theAccount) const  // adds
 // is
 // created.)
 {
-    //  Load up account list StringMap. Create it if doesn't already exist.
-    //  See if account is already there in the map. Add it otherwise.
-    //  Save the StringMap back again. (The account records list for a given
-    // instrument definition.)
+    //  Load up the shard of the account list which holds this account. See if
+    //  account is already there in the map. Add it otherwise. Save the shard
+    //  back again. (The account records list for a given instrument
+    //  definition.)
 
     Lock lock(lock_);
     const char* szFunc = "OTUnitDefinition::AddAccountRecord";
@@ -425,62 +593,26 @@ bool UnitDefinition::AddAccountRecord(const Account& theAccount) const  // adds
         return false;
     }
 
-    const Identifier theAcctID(theAccount);
-    const String strAcctID(theAcctID);
+    if (false == migrate_account_records(lock)) {
 
-    const String strInstrumentDefinitionID(id(lock));
-    String strAcctRecordFile;
-    strAcctRecordFile.Format("%s.a", strInstrumentDefinitionID.Get());
-
-    OTDB::Storable* pStorable = nullptr;
-    std::unique_ptr<OTDB::Storable> theAngel;
-    OTDB::StringMap* pMap = nullptr;
-
-    if (OTDB::Exists(
-            OTFolders::Contract().Get(),
-            strAcctRecordFile.Get()))  // the file already exists; let's
-                                       // try to load it up.
-        pStorable = OTDB::QueryObject(
-            OTDB::STORED_OBJ_STRING_MAP,
-            OTFolders::Contract().Get(),
-            strAcctRecordFile.Get());
-    else  // the account records file (for this instrument definition) doesn't
-          // exist.
-        pStorable = OTDB::CreateObject(
-            OTDB::STORED_OBJ_STRING_MAP);  // this asserts already, on failure.
-
-    theAngel.reset(pStorable);
-    pMap = (nullptr == pStorable) ? nullptr
-                                  : dynamic_cast<OTDB::StringMap*>(pStorable);
-
-    // It exists.
-    //
-    if (nullptr == pMap) {
-        otErr << szFunc
-              << ": Error: failed trying to load or create the account records "
-                 "file for instrument definition: "
-              << strInstrumentDefinitionID << "\n";
         return false;
     }
 
-    auto& theMap = pMap->the_map;
+    const Identifier theAcctID(theAccount);
+    const String strAcctID(theAcctID);
+    const String strInstrumentDefinitionID(id(lock));
+    const auto shard = AccountRecordShard(strAcctID.Get());
+    auto theMap = account_records(lock, shard);
     auto map_it = theMap.find(strAcctID.Get());
 
     if (theMap.end() != map_it)  // we found it.
     {                            // We were ADDING IT, but it was ALREADY THERE.
         // (Thus, we're ALREADY DONE.)
         // Let's just make sure the right instrument definition ID is associated
-        // with this
-        // account
-        // (it better be, since we loaded the account records file based on the
-        // instrument definition ID as its filename...)
+        // with this account (it better be, since we loaded the account records
+        // file based on the instrument definition ID as its filename...)
         //
-        const std::string& str2 = map_it->second;  // Containing the instrument
-                                                   // definition ID. (Just in
-                                                   // case
-        // someone copied the wrong file here,
-        // --------------------------------          // every account should map
-        // to the SAME instrument definition id.)
+        const std::string& str2 = map_it->second;
 
         if (false == strInstrumentDefinitionID.Compare(str2.c_str()))  // should
                                                                        // never
@@ -509,8 +641,7 @@ bool UnitDefinition::AddAccountRecord(const Account& theAccount) const  // adds
 
     // Then save it back to local storage:
     //
-    if (!OTDB::StoreObject(
-            *pMap, OTFolders::Contract().Get(), strAcctRecordFile.Get())) {
+    if (false == save_account_records(lock, shard, theMap)) {
         otErr << szFunc
               << ": Failed trying to StoreObject, while saving updated "
                  "account records file for instrument definition: "
@@ -528,71 +659,38 @@ bool UnitDefinition::EraseAccountRecord(const Identifier& theAcctID)
     const  // removes the account from the list. (When
            // account is deleted.)
 {
-    //  Load up account list StringMap. Create it if doesn't already exist.
-    //  See if account is already there in the map. Erase it, if it is.
-    //  Save the StringMap back again. (The account records list for a given
-    // instrument definition.)
+    //  Load up the shard of the account list which holds this account. See if
+    //  account is already there in the map. Erase it, if it is. Save the shard
+    //  back again. (The account records list for a given instrument
+    //  definition.)
 
     Lock lock(lock_);
     const char* szFunc = "OTUnitDefinition::EraseAccountRecord";
 
-    const String strAcctID(theAcctID);
+    if (false == migrate_account_records(lock)) {
 
-    const String strInstrumentDefinitionID(id(lock));
-    String strAcctRecordFile;
-    strAcctRecordFile.Format("%s.a", strInstrumentDefinitionID.Get());
-
-    OTDB::Storable* pStorable = nullptr;
-    std::unique_ptr<OTDB::Storable> theAngel;
-    OTDB::StringMap* pMap = nullptr;
-
-    if (OTDB::Exists(
-            OTFolders::Contract().Get(),
-            strAcctRecordFile.Get()))  // the file already exists; let's
-                                       // try to load it up.
-        pStorable = OTDB::QueryObject(
-            OTDB::STORED_OBJ_STRING_MAP,
-            OTFolders::Contract().Get(),
-            strAcctRecordFile.Get());
-    else  // the account records file (for this instrument definition) doesn't
-          // exist.
-        pStorable = OTDB::CreateObject(
-            OTDB::STORED_OBJ_STRING_MAP);  // this asserts already, on failure.
-
-    theAngel.reset(pStorable);
-    pMap = (nullptr == pStorable) ? nullptr
-                                  : dynamic_cast<OTDB::StringMap*>(pStorable);
-
-    // It exists.
-    //
-    if (nullptr == pMap) {
-        otErr << szFunc
-              << ": Error: failed trying to load or create the account records "
-                 "file for instrument definition: "
-              << strInstrumentDefinitionID << "\n";
         return false;
     }
 
-    // Before we can erase it, let's see if it's even there....
-    //
-    auto& theMap = pMap->the_map;
+    const String strAcctID(theAcctID);
+    const String strInstrumentDefinitionID(id(lock));
+    const auto shard = AccountRecordShard(strAcctID.Get());
+    auto theMap = account_records(lock, shard);
     auto map_it = theMap.find(strAcctID.Get());
 
-    // we found it!
-    if (theMap.end() != map_it)  //  Acct ID was already there...
-    {
-        theMap.erase(map_it);  // remove it
+    // If it wasn't already on the list, it's like success, since the end
+    // result is, acct ID will not appear on this list--whether it was there or
+    // not beforehand, it's definitely not there now.
+    if (theMap.end() == map_it) {
+
+        return true;
     }
 
-    // it wasn't already on the list...
-    // (So it's like success, since the end result is, acct ID will not appear
-    // on this list--whether
-    // it was there or not beforehand, it's definitely not there now.)
+    theMap.erase(map_it);
 
     // Then save it back to local storage:
     //
-    if (!OTDB::StoreObject(
-            *pMap, OTFolders::Contract().Get(), strAcctRecordFile.Get())) {
+    if (false == save_account_records(lock, shard, theMap)) {
         otErr << szFunc
               << ": Failed trying to StoreObject, while saving updated "
                  "account records file for instrument definition: "
@@ -46,6 +46,7 @@
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/util/Common.hpp"
 #include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/util/ParallelFor.hpp"
 #include "opentxs/core/util/StringUtils.hpp"
 #include "opentxs/core/util/Tag.hpp"
 #include "opentxs/core/util/Timer.hpp"
@@ -65,6 +66,11 @@
 #include <ostream>
 #include <string>
 #include <utility>
+#include <vector>
+
+// Below these counts the cron file is loaded on the calling thread
+#define OT_CRON_PARALLEL_ITEMS 32
+#define OT_CRON_PARALLEL_MARKETS 4
 
 namespace opentxs
 {
@@ -96,13 +102,160 @@ bool OTCron::LoadCron()
 
     OT_ASSERT(nullptr != GetServerNym());
 
+    m_vecPendingItems.clear();
     bool bSuccess = LoadContract(szFoldername, szFilename);
 
     if (bSuccess) bSuccess = VerifySignature(*(GetServerNym()));
 
+    if (bSuccess) bSuccess = load_items();
+
+    m_vecPendingItems.clear();
+
     return bSuccess;
 }
 
+// Instantiates and verifies the cron items found by ProcessXMLNode. This is
+// where nearly all of the time spent loading cron goes, so the items are
+// parsed and verified in parallel and then added to cron in file order.
+bool OTCron::load_items()
+{
+    const auto count = m_vecPendingItems.size();
+    std::vector<std::unique_ptr<OTCronItem>> items(count);
+    ParallelFor(
+        count,
+        OT_CRON_PARALLEL_ITEMS,
+        OT_PARALLEL_MAX_THREADS,
+        [&](const std::size_t i) {
+            std::unique_ptr<OTCronItem> pItem(
+                OTCronItem::NewCronItem(m_vecPendingItems.at(i).second));
+
+            if (false == bool(pItem)) {
+                otErr << "Unable to create cron item from data in cron "
+                         "file.\n";
+
+                return;
+            }
+
+            // Why not do this here (when loading from storage), as well as
+            // when first adding the item to cron, and thus save myself the
+            // trouble of verifying the signature EVERY ITERATION of
+            // ProcessCron().
+            if (false == pItem->VerifySignature(*m_pServerNym)) {
+                otErr << "OTCron::" << __FUNCTION__
+                      << ": ERROR SECURITY: Server signature failed to "
+                         "verify on a cron item while loading: "
+                      << pItem->GetTransactionNum() << "\n";
+
+                return;
+            }
+
+            items.at(i) = std::move(pItem);
+        });
+
+    for (std::size_t i = 0; i < count; ++i) {
+        auto& pItem = items.at(i);
+
+        if (false == bool(pItem)) {
+
+            return false;
+        }
+
+        // bSaveReceipt=false. The receipt is only saved once: When item FIRST
+        // added to cron... But here, the item was ALREADY in cron, and is
+        // merely being loaded from disk.
+        const auto& added = m_vecPendingItems.at(i).first;
+
+        if (false == AddCronItem(*pItem, nullptr, false, added)) {
+            otErr << "OTCron::" << __FUNCTION__
+                  << ": Though loaded / verified successfully, unable to add "
+                     "cron item (from cron file) to cron list.\n";
+
+            return false;
+        }
+
+        pItem.release();
+        otInfo << "Successfully loaded cron item and added to list.\n";
+    }
+
+    return true;
+}
+
+OTMarket* OTCron::load_market(const std::string& id)
+{
+    auto it = m_mapUnloadedMarkets.find(id);
+
+    if (m_mapUnloadedMarkets.end() == it) {
+
+        return nullptr;
+    }
+
+    const auto& [unit, currency, scale] = it->second;
+    std::unique_ptr<OTMarket> pMarket(new OTMarket(
+        m_NOTARY_ID, Identifier(unit), Identifier(currency), scale));
+
+    OT_ASSERT(pMarket);
+
+    pMarket->SetCronPointer(*this);
+
+    // LoadMarket verifies the server signature on the market file.
+    // AddMarket normally saves to file, but we don't want that when we're
+    // LOADING from file. It also removes the entry from the unloaded list, so
+    // a market which fails to load keeps its place in the cron file.
+    if (false == pMarket->LoadMarket() || false == AddMarket(*pMarket, false)) {
+        otErr << "OTCron::" << __FUNCTION__
+              << ": Error loading, verifying, or adding market " << id
+              << ".\n";
+
+        return nullptr;
+    }
+
+    otWarn << "Loaded market " << id << " from its market file.\n";
+
+    return pMarket.release();
+}
+
+// Materializes every market that has not been accessed yet. Only needed by
+// requests which report across all markets.
+void OTCron::load_markets()
+{
+    if (m_mapUnloadedMarkets.empty()) {
+
+        return;
+    }
+
+    std::vector<std::unique_ptr<OTMarket>> markets{};
+
+    for (const auto& it : m_mapUnloadedMarkets) {
+        const auto& [unit, currency, scale] = it.second;
+        markets.emplace_back(new OTMarket(
+            m_NOTARY_ID, Identifier(unit), Identifier(currency), scale));
+
+        OT_ASSERT(markets.back());
+
+        markets.back()->SetCronPointer(*this);
+    }
+
+    ParallelFor(
+        markets.size(),
+        OT_CRON_PARALLEL_MARKETS,
+        OT_PARALLEL_MAX_THREADS,
+        [&](const std::size_t i) {
+            if (false == markets.at(i)->LoadMarket()) {
+                markets.at(i).reset();
+            }
+        });
+
+    for (auto& pMarket : markets) {
+        if (pMarket && AddMarket(*pMarket, false)) {
+            pMarket.release();
+        } else {
+            otErr << "OTCron::" << __FUNCTION__
+                  << ": Error loading, verifying, or adding market while "
+                     "loading all markets. Its cron entry is kept.\n";
+        }
+    }
+}
+
 bool OTCron::SaveCron()
 {
     const char* szFoldername = OTFolders::Cron().Get();
@@ -133,6 +286,7 @@ bool OTCron::GetNym_OfferList(
     int32_t& nOfferCount)
 {
     nOfferCount = 0;  // Outputs the number of offers on this nym.
+    load_markets();
 
     std::unique_ptr<OTDB::OfferListNym> pOfferList(
         dynamic_cast<OTDB::OfferListNym*>(
@@ -209,6 +363,7 @@ bool OTCron::GetMarketList(OTASCIIArmor& ascOutput, int32_t& nMarketCount)
 {
     nMarketCount = 0;  // This parameter is set to zero here, and incremented in
                        // the loop below.
+    load_markets();
 
     OTMarket* pMarket = nullptr;
 
@@ -410,57 +565,11 @@ int32_t OTCron::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
             otErr << "Error in OTCron::ProcessXMLNode: cronItem field without "
                      "value.\n";
             return (-1);  // error condition
-        } else {
-            OTCronItem* pItem = OTCronItem::NewCronItem(strData);
-
-            if (nullptr == pItem) {
-                otErr << "Unable to create cron item from data in cron file.\n";
-                return (-1);
-            }
-
-            // Why not do this here (when loading from storage), as well as when
-            // first adding the item to cron,
-            // and thus save myself the trouble of verifying the signature EVERY
-            // ITERATION of ProcessCron().
-            //
-            if (!pItem->VerifySignature(*m_pServerNym)) {
-                otErr << "OTCron::ProcessXMLNode: ERROR SECURITY: Server "
-                         "signature failed to "
-                         "verify on a cron item while loading: "
-                      << pItem->GetTransactionNum() << "\n";
-                delete pItem;
-                pItem = nullptr;
-                return (-1);
-            } else if (AddCronItem(
-                           *pItem,
-                           nullptr,
-                           false,          // bSaveReceipt=false. The receipt is
-                                           // only saved once: When item FIRST
-                                           // added to cron...
-                           tDateAdded)) {  // ...But here, the item was
-                                           // ALREADY in cron, and is
-                                           // merely being loaded from
-                                           // disk.
-                // Thus, it would be wrong to try to create the "original
-                // record" as if it were brand
-                // new and still had the user's signature on it. (Once added to
-                // Cron, the signatures are
-                // released and the SERVER signs it from there. That's why the
-                // user's version is saved
-                // as a receipt in the first place -- so we have a record of the
-                // user's authorization.)
-                otInfo << "Successfully loaded cron item and added to list.\n";
-            } else {
-                otErr << "OTCron::ProcessXMLNode: Though loaded / verified "
-                         "successfully, "
-                         "unable to add cron item (from cron file) to cron "
-                         "list.\n";
-                delete pItem;
-                pItem = nullptr;
-                return (-1);
-            }
         }
 
+        // Instantiated by LoadCron, in parallel, after the signature on the
+        // cron file has been verified.
+        m_vecPendingItems.emplace_back(tDateAdded, strData);
         nReturnVal = 1;
     } else if (!strcmp("market", xml->getNodeName())) {
         const String strMarketID(xml->getAttributeValue("marketID"));
@@ -471,36 +580,14 @@ int32_t OTCron::ProcessXMLNode(irr::io::IrrXMLReader*& xml)
         const int64_t lScale =
             String::StringToLong(xml->getAttributeValue("marketScale"));
 
-        const Identifier INSTRUMENT_DEFINITION_ID(strInstrumentDefinitionID),
-            CURRENCY_ID(strCurrencyID);
-
         otWarn << "Loaded cron entry for Market:\n" << strMarketID << ".\n";
 
-        // LoadMarket() needs this info to do its thing.
-        OTMarket* pMarket = new OTMarket(
-            m_NOTARY_ID, INSTRUMENT_DEFINITION_ID, CURRENCY_ID, lScale);
-
-        OT_ASSERT(nullptr != pMarket);
-
-        pMarket->SetCronPointer(
-            *this);  // This way every Market has a pointer to Cron.
-
-        //    AddMarket normally saves to file, but we don't want that when
-        // we're LOADING from file, now do we?
-        if (!pMarket->LoadMarket() ||
-            !pMarket->VerifySignature(*GetServerNym()) ||
-            !AddMarket(*pMarket, false))  // bSaveFile=false: don't save this
-                                          // file WHILE loading it!!!
-        {
-            otErr << "Somehow error while loading, verifying, or adding market "
-                     "while loading Cron file.\n";
-            delete pMarket;
-            pMarket = nullptr;
-            return (-1);
-        } else {
-            otWarn << "Loaded market entry from cronfile, and also loaded the "
-                      "market file itself.\n";
-        }
+        // The market file itself is loaded by GetMarket, the first time the
+        // market is needed.
+        m_mapUnloadedMarkets[strMarketID.Get()] = std::make_tuple(
+            std::string(strInstrumentDefinitionID.Get()),
+            std::string(strCurrencyID.Get()),
+            lScale);
         nReturnVal = 1;
     }
 
@@ -542,6 +629,18 @@ void OTCron::UpdateContents()
         tag.add_tag(tagMarket);
     }
 
+    // Markets which have not been needed since the cron file was loaded keep
+    // their entries unchanged.
+    for (const auto& it : m_mapUnloadedMarkets) {
+        const auto& [unit, currency, scale] = it.second;
+        TagPtr tagMarket(new Tag("market"));
+        tagMarket->add_attribute("marketID", it.first);
+        tagMarket->add_attribute("instrumentDefinitionID", unit);
+        tagMarket->add_attribute("currencyID", currency);
+        tagMarket->add_attribute("marketScale", formatLong(scale));
+        tag.add_tag(tagMarket);
+    }
+
     // Save the Cron Items
     for (auto& it : m_multimapCronItems) {
         OTCronItem* pItem = it.second;
@@ -972,6 +1071,7 @@ bool OTCron::AddMarket(OTMarket& theMarket, bool bSaveMarketFile)
         }
 
         m_mapMarkets[std_MARKET_ID] = &theMarket;
+        m_mapUnloadedMarkets.erase(std_MARKET_ID);
 
         bool bSuccess = true;
 
@@ -1029,6 +1129,20 @@ OTMarket* OTCron::GetOrCreateMarket(
         return pExistingMarket;
     }
 
+    // The market is listed in the cron file but its market file failed to
+    // load. Creating an empty market in its place would overwrite the offers
+    // it contains.
+    const String strMarketID(MARKET_ID);
+
+    if (0 < m_mapUnloadedMarkets.count(strMarketID.Get())) {
+        otErr << "OTCron::" << __FUNCTION__ << ": Market " << strMarketID
+              << " exists but could not be loaded.\n";
+        delete pMarket;
+        pMarket = nullptr;
+
+        return nullptr;
+    }
+
     // If we got this far, it means the Market does NOT already exist in this
     // Cron.
     // So let's add it...
@@ -1057,8 +1171,8 @@ OTMarket* OTCron::GetMarket(const Identifier& MARKET_ID)
     auto it = m_mapMarkets.find(std_MARKET_ID);
 
     if (it == m_mapMarkets.end()) {
-        // nothing found.
-        return nullptr;
+        // Either it was never loaded, or it does not exist.
+        return load_market(std_MARKET_ID);
     }
     // Found it!
     else {
@@ -1083,6 +1197,8 @@ OTMarket* OTCron::GetMarket(const Identifier& MARKET_ID)
 OTCron::OTCron()
     : Contract()
     , m_mapMarkets()
+    , m_mapUnloadedMarkets()
+    , m_vecPendingItems()
     , m_mapCronItems()
     , m_multimapCronItems()
     , m_NOTARY_ID(Identifier::Factory())
@@ -1098,6 +1214,8 @@ OTCron::OTCron()
 OTCron::OTCron(const Identifier& NOTARY_ID)
     : Contract()
     , m_mapMarkets()
+    , m_mapUnloadedMarkets()
+    , m_vecPendingItems()
     , m_mapCronItems()
     , m_multimapCronItems()
     , m_NOTARY_ID(Identifier::Factory())
@@ -1114,6 +1232,8 @@ OTCron::OTCron(const Identifier& NOTARY_ID)
 OTCron::OTCron(const char* szFilename)
     : Contract()
     , m_mapMarkets()
+    , m_mapUnloadedMarkets()
+    , m_vecPendingItems()
     , m_mapCronItems()
     , m_multimapCronItems()
     , m_NOTARY_ID(Identifier::Factory())
@@ -1173,6 +1293,9 @@ void OTCron::Release_Cron()
         delete pMarket;
         pMarket = nullptr;
     }
+
+    m_mapUnloadedMarkets.clear();
+    m_vecPendingItems.clear();
 }
 
 }  // namespace opentxs
@@ -129,30 +129,10 @@ bool Ecdsa::DecryptSessionKeyECDH(
     const OTPasswordData& password,
     SymmetricKey& sessionKey) const
 {
-    auto publicDHKey = Data::Factory();
-
-    if (!publicKey.GetKey(publicDHKey)) {
-        otErr << __FUNCTION__ << ": Failed to get public key." << std::endl;
-
-        return false;
-    }
-
-    OTPassword privateDHKey;
-
-    if (!AsymmetricKeyToECPrivatekey(privateKey, password, privateDHKey)) {
-        otErr << __FUNCTION__ << ": Failed to get private key." << std::endl;
-
-        return false;
-    }
-
-    // Calculate ECDH shared secret
     BinarySecret ECDHSecret(
         OT::App().Crypto().AES().InstantiateBinarySecretSP());
-    bool haveECDH = ECDH(publicDHKey, privateDHKey, *ECDHSecret);
 
-    if (!haveECDH) {
-        otErr << __FUNCTION__ << ": ECDH shared secret negotiation failed."
-              << std::endl;
+    if (!SessionKeySecretECDH(privateKey, publicKey, password, *ECDHSecret)) {
 
         return false;
     }
@@ -332,6 +312,38 @@ bool Ecdsa::PrivateToPublic(
     return ScalarBaseMultiply(*plaintextKey, publicKey);
 }
 
+bool Ecdsa::SessionKeySecretECDH(
+    const AsymmetricKeyEC& privateKey,
+    const AsymmetricKeyEC& publicKey,
+    const OTPasswordData& password,
+    OTPassword& secret) const
+{
+    auto publicDHKey = Data::Factory();
+
+    if (!publicKey.GetKey(publicDHKey)) {
+        otErr << __FUNCTION__ << ": Failed to get public key." << std::endl;
+
+        return false;
+    }
+
+    OTPassword privateDHKey;
+
+    if (!AsymmetricKeyToECPrivatekey(privateKey, password, privateDHKey)) {
+        otErr << __FUNCTION__ << ": Failed to get private key." << std::endl;
+
+        return false;
+    }
+
+    if (!ECDH(publicDHKey, privateDHKey, secret)) {
+        otErr << __FUNCTION__ << ": ECDH shared secret negotiation failed."
+              << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
 bool Ecdsa::SeedToCurveKey(
     __attribute__((unused)) const OTPassword& seed,
     __attribute__((unused)) OTPassword& privateKey,
@@ -62,6 +62,7 @@
 #include "opentxs/core/crypto/OTAsymmetricKey.hpp"
 #include "opentxs/core/crypto/OTEnvelope.hpp"
 #include "opentxs/core/crypto/OTKeypair.hpp"
+#include "opentxs/core/crypto/OTPassword.hpp"
 #include "opentxs/core/crypto/OTPasswordData.hpp"
 #include "opentxs/core/crypto/SymmetricKey.hpp"
 #include "opentxs/core/util/Assert.hpp"
@@ -391,13 +392,39 @@ bool Letter::Open(
                 OTAsymmetricKey::KeyFactory(ephemeralPubkey)));
         }
 
+        if (false == bool(dhPublicKey)) {
+            otErr << __FUNCTION__ << ": Invalid ephemeral public key."
+                  << std::endl;
+
+            return false;
+        }
+
+        // Every session key in the letter was wrapped with the same ephemeral
+        // key, so the ECDH secret only needs to be computed once. Session keys
+        // wrapped by one Seal() call share a salt, so the key derived from
+        // that secret is cached too, which leaves a single AEAD check for
+        // each entry that belongs to another recipient.
+        OTPassword secret;
+        const bool haveSecret = ecKey->ECDSA().SessionKeySecretECDH(
+            *ecKey, *dhPublicKey, keyPassword, secret);
+
+        if (false == haveSecret) {
+            otErr << __FUNCTION__ << ": Unable to compute ECDH secret."
+                  << std::endl;
+
+            return false;
+        }
+
+        OTPasswordData unlockPassword("");
+        unlockPassword.SetOverride(secret);
+        SymmetricKey::DerivedKeys derived{};
+
         // The only way to know which session key (might) belong to us to try
         // them all
         for (auto& it : serialized.sessionkey()) {
             key = OT::App().Crypto().Symmetric().Key(
                 it, serialized.ciphertext().mode());
-            haveSessionKey = ecKey->ECDSA().DecryptSessionKeyECDH(
-                *ecKey, *dhPublicKey, keyPassword, *key);
+            haveSessionKey = key->Unlock(unlockPassword, derived);
 
             if (haveSessionKey) {
                 break;
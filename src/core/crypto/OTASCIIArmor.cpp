@@ -198,7 +198,7 @@ OTASCIIArmor& OTASCIIArmor::operator=(const OTASCIIArmor& strValue)
  * the binary data. */
 std::string OTASCIIArmor::compress_string(
     const std::string& str,
-    int32_t compressionlevel = Z_BEST_COMPRESSION) const
+    int32_t compressionlevel)
 {
     z_stream zs;  // z_stream is zlib's control structure
     memset(&zs, 0, sizeof(zs));
@@ -238,7 +238,7 @@ std::string OTASCIIArmor::compress_string(
 }
 
 /** Decompress an STL string using zlib and return the original data. */
-std::string OTASCIIArmor::decompress_string(const std::string& str) const
+std::string OTASCIIArmor::decompress_string(const std::string& str)
 {
     z_stream zs;  // z_stream is zlib's control structure
     memset(&zs, 0, sizeof(zs));
@@ -355,7 +355,8 @@ bool OTASCIIArmor::SetString(const String& strData, bool bLineBreaks)  //=true
 
     if (strData.GetLength() < 1) return true;
 
-    std::string str_compressed = compress_string(strData.Get());
+    std::string str_compressed =
+        compress_string(strData.Get(), Z_BEST_COMPRESSION);
 
     // "Success"
     if (str_compressed.size() == 0) {
@@ -50,39 +50,14 @@
 #include "opentxs/core/String.hpp"
 #include "opentxs/OT.hpp"
 
-// For SecureZeroMemory
-#ifdef _WIN32
-#else  // not _WIN32
-
-#include <sys/mman.h>
-
-#ifndef PAGESIZE
-#include <unistd.h>
+#include "SecureArena.hpp"
 
-#include <stdint.h>
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <ostream>
 #include <string>
 
-#define PAGESIZE sysconf(_SC_PAGESIZE)
-#endif
-
-// FT: Credit to the Bitcoin team for the mlock / munlock defines.
-
-#define mlock(a, b)                                                            \
-    mlock(                                                                     \
-        (reinterpret_cast<void*>(                                              \
-            (reinterpret_cast<size_t>(a)) & (~((PAGESIZE)-1)))),               \
-        ((((reinterpret_cast<size_t>(a)) + (b)-1) | ((PAGESIZE)-1)) + 1) -     \
-            ((reinterpret_cast<size_t>(a)) & (~((PAGESIZE)-1))))
-#define munlock(a, b)                                                          \
-    munlock(                                                                   \
-        (reinterpret_cast<void*>(                                              \
-            (reinterpret_cast<size_t>(a)) & (~((PAGESIZE)-1)))),               \
-        ((((reinterpret_cast<size_t>(a)) + (b)-1) | ((PAGESIZE)-1)) + 1) -     \
-            ((reinterpret_cast<size_t>(a)) & (~((PAGESIZE)-1))))
-#endif
-
 namespace opentxs
 {
 
@@ -121,77 +96,23 @@ void* ot_secure_memset(void* v, uint8_t c, uint32_t n)
 // way to do this without duplication,
 // as I get deeper into it.
 
-// THE PURPOSE OF LOCKING A PAGE:
-//
-// "So that it won't get swapped to disk, where the secret
-// could be recovered maliciously from the swap file."
-//
-bool OTPassword::ot_lockPage(void* addr, size_t len)
-{
-#ifdef _WIN32
-// return VirtualLock(addr, len);
-#elif defined(PREDEF_PLATFORM_UNIX)
-    static bool bWarned = false;
-    if (mlock(addr, len) && !bWarned) {
-        bWarned = true;
-        otErr << "ot_lockPage: WARNING: unable to lock memory. \n"
-                 "   (Passwords / secret keys may be swapped to disk!)\n";
-    }
-    return true;
-#else
-    OT_FAIL_MSG("ASSERT: ot_lockPage unable to lock memory.");
-#endif
-    return false;
-}
-
-// TODO:  Note: may need to add directives here so that mlock and munlock are
-// not
-// used except where the user is running as a privileged process. (Because that
-// may be the only way we CAN use those functions...)
-
-bool OTPassword::ot_unlockPage(void* addr, size_t len)
-{
-#ifdef _WIN32
-//    return VirtualUnlock(addr, len);
-#elif defined(PREDEF_PLATFORM_UNIX)
-    static bool bWarned = false;
-    if (munlock(addr, len) && !bWarned) {
-        bWarned = true;
-        otErr << "ot_unlockPage: WARNING: unable to unlock memory used for "
-                 "storing secrets.\n";
-    }
-    return true;
-#else
-    OT_FAIL_MSG("ASSERT: ot_unlockPage unable to unlock secret memory.");
-#endif
-    return false;
-}
-
 // PURPOSE OF ZERO'ING MEMORY:
 //
 // So the secret is not stored in memory any longer than absolutely necessary.
 // Once it has been used, we want to wipe it from memory ASAP. (The least amount
 // of time spent in memory, the better.)
 
+// Only the bytes which have ever been written or exposed through a writable
+// pointer are wiped. The rest of the slot is still zero from the arena.
 void OTPassword::zeroMemory()
 {
     size_ = 0;
 
-    OTPassword::zeroMemory(static_cast<void*>(&(data_[0])), getBlockSize());
-
-//
-#ifndef _WIN32
-    // UNLOCK the page, now that we're AFTER the point where
-    // the memory was safely ZERO'd out.
-    //
-    if (isPageLocked_) {
-        if (ot_unlockPage(static_cast<void*>(&(data_[0])), getBlockSize())) {
-            isPageLocked_ = false;
-        } else
-            otErr << "OTPassword::zeroMemory: Error: Memory page was locked, "
-                     "but then failed to unlock it.\n";
+    if (0 < dirty_) {
+        OTPassword::zeroMemory(
+            static_cast<void*>(data_), static_cast<uint32_t>(dirty_));
+        dirty_ = 0;
     }
-#endif
 }
 
 // static
@@ -354,11 +275,23 @@ OTPassword* OTPassword::CreateTextBuffer()  // asserts already.
     return pPassUserInput;
 }
 
+std::uint8_t* OTPassword::allocate()
+{
+    return static_cast<std::uint8_t*>(
+        SecureArena::Allocate(OT_DEFAULT_MEMSIZE));
+}
+
+void OTPassword::mark_dirty(const std::size_t size)
+{
+    dirty_ = std::min<std::size_t>(std::max(dirty_, size), OT_DEFAULT_MEMSIZE);
+}
+
 OTPassword::OTPassword()
     : size_(0)
+    , data_(allocate())
+    , dirty_(0)
     , isText_(true)
     , isBinary_(false)
-    , isPageLocked_(false)
 {
     data_[0] = '\0';
     setPassword_uint8(reinterpret_cast<const uint8_t*>(""), 0);
@@ -377,9 +310,10 @@ OTPassword& OTPassword::operator=(const OTPassword& rhs)
 
 OTPassword::OTPassword(const OTPassword& rhs)
     : size_(0)
+    , data_(allocate())
+    , dirty_(0)
     , isText_(rhs.isPassword())
     , isBinary_(rhs.isMemory())
-    , isPageLocked_(false)
     , blockSize_(
           rhs.blockSize_)  // The buffer has this size+1 as its static size.
 {
@@ -393,9 +327,10 @@ OTPassword::OTPassword(const OTPassword& rhs)
 
 OTPassword::OTPassword(const char* szInput, uint32_t nInputSize)
     : size_(0)
+    , data_(allocate())
+    , dirty_(0)
     , isText_(true)
     , isBinary_(false)
-    , isPageLocked_(false)
 {
     data_[0] = '\0';
 
@@ -404,9 +339,10 @@ OTPassword::OTPassword(const char* szInput, uint32_t nInputSize)
 
 OTPassword::OTPassword(const uint8_t* szInput, uint32_t nInputSize)
     : size_(0)
+    , data_(allocate())
+    , dirty_(0)
     , isText_(true)
     , isBinary_(false)
-    , isPageLocked_(false)
 {
     data_[0] = '\0';
 
@@ -415,16 +351,18 @@ OTPassword::OTPassword(const uint8_t* szInput, uint32_t nInputSize)
 
 OTPassword::OTPassword(const void* vInput, uint32_t nInputSize)
     : size_(0)
+    , data_(allocate())
+    , dirty_(0)
     , isText_(false)
     , isBinary_(true)
-    , isPageLocked_(false)
 {
     setMemory(vInput, nInputSize);
 }
 
 OTPassword::~OTPassword()
 {
-    if (size_ > 0) zeroMemory();
+    SecureArena::Free(data_, OT_DEFAULT_MEMSIZE, dirty_);
+    data_ = nullptr;
 }
 
 bool OTPassword::isPassword() const { return isText_; }
@@ -447,16 +385,29 @@ const uint8_t* OTPassword::getPassword_uint8() const
 uint8_t* OTPassword::getPasswordWritable()
 {
     OT_ASSERT(isText_);
-    return (size_ <= 0)
-               ? nullptr
-               : static_cast<uint8_t*>(static_cast<void*>(&(data_[0])));
+
+    if (size_ <= 0) {
+
+        return nullptr;
+    }
+
+    mark_dirty(OT_DEFAULT_MEMSIZE);
+
+    return data_;
 }
 
 char* OTPassword::getPasswordWritable_char()
 {
     OT_ASSERT(isText_);
-    return (size_ <= 0) ? nullptr
-                        : static_cast<char*>(static_cast<void*>(&(data_[0])));
+
+    if (size_ <= 0) {
+
+        return nullptr;
+    }
+
+    mark_dirty(OT_DEFAULT_MEMSIZE);
+
+    return reinterpret_cast<char*>(data_);
 }
 
 // getMemory returns nullptr if empty, otherwise returns the password.
@@ -476,7 +427,15 @@ const uint8_t* OTPassword::getMemory_uint8() const
 void* OTPassword::getMemoryWritable()
 {
     OT_ASSERT(isBinary_);
-    return (size_ <= 0) ? nullptr : static_cast<void*>(&(data_[0]));
+
+    if (size_ <= 0) {
+
+        return nullptr;
+    }
+
+    mark_dirty(OT_DEFAULT_MEMSIZE);
+
+    return static_cast<void*>(data_);
 }
 
 std::size_t OTPassword::getBlockSize() const { return blockSize_; }
@@ -500,6 +459,7 @@ bool OTPassword::addChar(uint8_t theChar)
         data_[size_] = theChar;
         ++size_;
         data_[size_] = '\0';
+        mark_dirty(size_ + 1);
         return true;
     }
     return false;
@@ -586,23 +546,7 @@ int32_t OTPassword::setPassword_uint8(
         return (-1);
     }
 
-#ifndef _WIN32
-
-    //
-    // Lock the memory page, before we copy the data over.
-    // (If it's not already locked, which I doubt it will be.)
-    //
-    // it won't be locked already, since we just zero'd it
-    // (above.) But I check this anyway...
-    if (!isPageLocked_) {
-        if (ot_lockPage(static_cast<void*>(&(data_[0])), getBlockSize())) {
-            isPageLocked_ = true;
-        } else {
-            otErr << szFunc
-                  << ": Error: Failed attempting to lock memory page.\n";
-        }
-    }
-#endif
+    mark_dirty(nInputSize + 1);
 
 #ifdef _WIN32
     strncpy_s(
@@ -654,6 +598,7 @@ bool OTPassword::SetSize(uint32_t uSize)
         }
         // The actual null-terminator.
         data_[uSize] = '\0';
+        mark_dirty(uSize + 1);
         // If size is 3, the terminator is at
         size_ = uSize;
         // data_[3] (which is the 4th byte.)
@@ -721,22 +666,7 @@ int32_t OTPassword::randomizePassword(uint32_t nNewSize)
     //
     if (nSize > getBlockSize())
         nSize = getBlockSize();  // Truncated password beyond max size.
-#ifndef _WIN32
-    //
-    // Lock the memory page, before we randomize 'size bytes' of the data.
-    // (If it's not already locked, which I doubt it will be.)
-    //
-    if (!isPageLocked_)  // it won't be locked already, since we just zero'd it
-                         // (above.) But I check this anyway...
-    {
-        if (ot_lockPage(static_cast<void*>(&(data_[0])), getBlockSize())) {
-            isPageLocked_ = true;
-        } else {
-            otErr << __FUNCTION__
-                  << ": Error: Failed attempting to lock memory page.\n";
-        }
-    }
-#endif
+    mark_dirty(nSize + 1);
 
     //
     if (!OTPassword::randomizePassword_uint8(
@@ -789,22 +719,7 @@ int32_t OTPassword::randomizeMemory(uint32_t nNewSize)
     if (nSize > getBlockSize())
         nSize = getBlockSize();  // Truncated password beyond max size.
 
-#ifndef _WIN32
-    //
-    // Lock the memory page, before we randomize 'size bytes' of the data.
-    // (If it's not already locked, which I doubt it will be.)
-    //
-    if (!isPageLocked_)  // it won't be locked already, since we just zero'd it
-                         // (above.) But I check this anyway...
-    {
-        if (ot_lockPage(static_cast<void*>(&(data_[0])), getBlockSize())) {
-            isPageLocked_ = true;
-        } else {
-            otErr << __FUNCTION__
-                  << ": Error: Failed attempting to lock memory page.\n";
-        }
-    }
-#endif
+    mark_dirty(nSize);
 
     //
     if (!OTPassword::randomizeMemory_uint8(&(data_[0]), nSize)) {
@@ -856,13 +771,8 @@ int32_t OTPassword::addMemory(const void* vAppend, uint32_t nAppendSize)
     // onto the
     // existing memory of this object will not exceed the total allowed block
     // size.
-    //
-    // Because we use setMemory when empty, and only use addMemory when we KNOW
-    // something
-    // is already there, therefore we know the page is already locked, so no
-    // need to go
-    // trying to lock it again.
 
+    mark_dirty(size_ + nAppendSize);
     OTPassword::safe_memcpy(
         static_cast<void*>(&(data_[size_])),
         nAppendSize,  // dest size is based on the source
@@ -914,22 +824,7 @@ int32_t OTPassword::setMemory(const void* vInput, uint32_t nInputSize)
     if (nInputSize > getBlockSize())
         nInputSize = getBlockSize();  // Truncated password beyond max size.
 
-#ifndef _WIN32
-    //
-    // Lock the memory page, before we copy the data over.
-    // (If it's not already locked, which I doubt it will be.)
-    //
-    if (!isPageLocked_)  // it won't be locked already, since we just zero'd it
-                         // (above.) But I check this anyway...
-    {
-        if (ot_lockPage(static_cast<void*>(&(data_[0])), getBlockSize())) {
-            isPageLocked_ = true;
-        } else {
-            otErr << __FUNCTION__
-                  << ": Error: Failed attempting to lock memory page.\n";
-        }
-    }
-#endif
+    mark_dirty(nInputSize);
 
     OTPassword::safe_memcpy(
         static_cast<void*>(&(data_[0])),
@@ -0,0 +1,230 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "SecureArena.hpp"
+
+#include "opentxs/core/crypto/OTPassword.hpp"
+#include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/Types.hpp"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#define OT_METHOD "opentxs::SecureArena::"
+
+namespace opentxs
+{
+// Every OTPassword holds an OT_DEFAULT_MEMSIZE buffer, so that size rounded up
+// to 16 bytes gets a class of its own instead of wasting half a 512 byte slot.
+const std::array<std::size_t, SecureArena::BinCount> SecureArena::slot_sizes_{
+    {32, 64, 128, 272, 512, 1024, 2048, 4096}};
+
+SecureArena::SecureArena()
+    : bins_{{{slot_sizes_[0]},
+             {slot_sizes_[1]},
+             {slot_sizes_[2]},
+             {slot_sizes_[3]},
+             {slot_sizes_[4]},
+             {slot_sizes_[5]},
+             {slot_sizes_[6]},
+             {slot_sizes_[7]}}}
+#ifdef _WIN32
+    , page_size_(4096)
+#else
+    , page_size_(static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)))
+#endif
+{
+    static_assert(OT_DEFAULT_MEMSIZE <= 272, "Update the OTPassword class");
+}
+
+void* SecureArena::Allocate(const std::size_t size)
+{
+    auto& arena = instance();
+    auto* pool = arena.bin(size);
+
+    if (nullptr == pool) {
+
+        return arena.map_region(size);
+    }
+
+    Lock lock(pool->lock_);
+
+    if (pool->free_.empty()) {
+        arena.refill(*pool);
+    }
+
+    auto* output = pool->free_.back();
+    pool->free_.pop_back();
+
+    return output;
+}
+
+SecureArena::Bin* SecureArena::bin(const std::size_t size)
+{
+    for (auto& pool : bins_) {
+        if (size <= pool.slot_size_) {
+
+            return &pool;
+        }
+    }
+
+    return nullptr;
+}
+
+void SecureArena::Free(
+    void* slot,
+    const std::size_t size,
+    const std::size_t used)
+{
+    if (nullptr == slot) {
+
+        return;
+    }
+
+    OT_ASSERT(used <= size);
+
+    if (0 < used) {
+        OTPassword::zeroMemory(slot, static_cast<std::uint32_t>(used));
+    }
+
+    auto& arena = instance();
+    auto* pool = arena.bin(size);
+
+    if (nullptr == pool) {
+        arena.unmap_region(slot, size);
+
+        return;
+    }
+
+    Lock lock(pool->lock_);
+    pool->free_.push_back(slot);
+}
+
+// Never destroyed, so that secrets held by static objects can still be
+// released during shutdown.
+SecureArena& SecureArena::instance()
+{
+    static auto* arena = new SecureArena;
+
+    return *arena;
+}
+
+void* SecureArena::map_region(const std::size_t size) const
+{
+    const auto usable = round_to_page(size);
+#ifdef _WIN32
+    auto* output = ::operator new(usable);
+    std::memset(output, 0, usable);
+
+    return output;
+#else
+    const auto total = usable + (2 * page_size_);
+    auto* region =
+        ::mmap(nullptr, total, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (MAP_FAILED == region) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to map " << total
+              << " bytes." << std::endl;
+
+        throw std::bad_alloc();
+    }
+
+    auto* output = static_cast<std::uint8_t*>(region) + page_size_;
+
+    if (0 != ::mprotect(output, usable, PROT_READ | PROT_WRITE)) {
+        ::munmap(region, total);
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to make secure memory writable." << std::endl;
+
+        throw std::bad_alloc();
+    }
+
+    if (0 != ::mlock(output, usable)) {
+        static bool warned{false};
+
+        if (false == warned) {
+            warned = true;
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": WARNING: unable to lock memory. Passwords and secret "
+                  << "keys may be swapped to disk." << std::endl;
+        }
+    }
+
+    return output;
+#endif
+}
+
+void SecureArena::refill(Bin& pool)
+{
+    const auto chunk = ChunkPages * page_size_;
+    auto* region = static_cast<std::uint8_t*>(map_region(chunk));
+    const auto count = chunk / pool.slot_size_;
+    pool.free_.reserve(pool.free_.size() + count);
+
+    // Hand out the lowest addresses first
+    for (std::size_t i = count; i > 0; --i) {
+        pool.free_.push_back(region + ((i - 1) * pool.slot_size_));
+    }
+}
+
+std::size_t SecureArena::round_to_page(const std::size_t size) const
+{
+    return ((size + page_size_ - 1) / page_size_) * page_size_;
+}
+
+void SecureArena::unmap_region(void* region, const std::size_t size) const
+{
+#ifdef _WIN32
+    ::operator delete(region);
+#else
+    const auto usable = round_to_page(size);
+    auto* start = static_cast<std::uint8_t*>(region) - page_size_;
+    ::munlock(region, usable);
+    ::munmap(start, usable + (2 * page_size_));
+#endif
+}
+}  // namespace opentxs
@@ -0,0 +1,106 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_CORE_CRYPTO_SECUREARENA_HPP
+#define OPENTXS_CORE_CRYPTO_SECUREARENA_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace opentxs
+{
+/** Page pooled allocator for secret material
+ *
+ *  Requests are rounded up to one of a few size classes. Each class carves
+ *  its slots out of pool chunks that are locked into RAM once, when the chunk
+ *  is mapped, and are bounded by inaccessible guard pages. Chunks are never
+ *  returned to the system. Free slots are always zero, so releasing a slot
+ *  only wipes the bytes the caller reports having used. Requests larger than
+ *  the biggest class get a dedicated guarded mapping. */
+class SecureArena
+{
+public:
+    /** Returns a zeroed block of at least size bytes */
+    static void* Allocate(const std::size_t size);
+    /** Wipes the first used bytes of slot and returns it to its pool */
+    static void Free(
+        void* slot,
+        const std::size_t size,
+        const std::size_t used);
+
+private:
+    struct Bin {
+        const std::size_t slot_size_;
+        std::mutex lock_;
+        std::vector<void*> free_;
+
+        Bin(const std::size_t size)
+            : slot_size_(size)
+            , lock_()
+            , free_()
+        {
+        }
+    };
+
+    static const std::size_t BinCount{8};
+    static const std::size_t ChunkPages{8};
+    static const std::array<std::size_t, BinCount> slot_sizes_;
+
+    std::array<Bin, BinCount> bins_;
+    const std::size_t page_size_;
+
+    static SecureArena& instance();
+
+    Bin* bin(const std::size_t size);
+    void* map_region(const std::size_t size) const;
+    std::size_t round_to_page(const std::size_t size) const;
+    void unmap_region(void* region, const std::size_t size) const;
+    void refill(Bin& bin);
+
+    SecureArena();
+    SecureArena(const SecureArena&) = delete;
+    SecureArena(SecureArena&&) = delete;
+    SecureArena& operator=(const SecureArena&) = delete;
+    SecureArena& operator=(SecureArena&&) = delete;
+};
+}  // namespace opentxs
+#endif  // OPENTXS_CORE_CRYPTO_SECUREARENA_HPP
@@ -617,7 +617,7 @@ bool SymmetricKey::Serialize(proto::SymmetricKey& output) const
     return proto::Validate(output, VERBOSE);
 }
 
-bool SymmetricKey::Unlock(const OTPasswordData& keyPassword)
+bool SymmetricKey::prepare_unlock()
 {
     if (false == bool(encrypted_key_)) {
         otErr << OT_METHOD << __FUNCTION__ << ": Master key not loaded."
@@ -641,27 +641,62 @@ bool SymmetricKey::Unlock(const OTPasswordData& keyPassword)
         }
     }
 
-    OTPassword key;
-
-    if (false == GetPassword(keyPassword, key)) {
-        otErr << OT_METHOD << __FUNCTION__
-              << ": Unable to obtain master password." << std::endl;
-
-        return false;
-    }
-
-    SymmetricKey secondaryKey(
-        engine_,
-        key,
-        *salt_,
-        engine_.KeySize(encrypted_key_->mode()),
-        OT_SYMMETRIC_KEY_DEFAULT_OPERATIONS,
-        OT_SYMMETRIC_KEY_DEFAULT_DIFFICULTY);
+    return true;
+}
 
+bool SymmetricKey::unlock(const SymmetricKey& secondaryKey)
+{
     return engine_.Decrypt(
         *encrypted_key_,
         secondaryKey.plaintext_key_->getMemory_uint8(),
         secondaryKey.plaintext_key_->getMemorySize(),
         static_cast<std::uint8_t*>(plaintext_key_->getMemoryWritable()));
 }
+
+bool SymmetricKey::Unlock(const OTPasswordData& keyPassword)
+{
+    DerivedKeys derived{};
+
+    return Unlock(keyPassword, derived);
+}
+
+bool SymmetricKey::Unlock(
+    const OTPasswordData& keyPassword,
+    DerivedKeys& derived)
+{
+    if (false == prepare_unlock()) {
+
+        return false;
+    }
+
+    const std::size_t size = engine_.KeySize(encrypted_key_->mode());
+    const auto index =
+        *salt_ +
+        std::string(reinterpret_cast<const char*>(&size), sizeof(size));
+    auto& secondaryKey = derived[index];
+
+    if (false == bool(secondaryKey)) {
+        OTPassword key;
+
+        if (false == GetPassword(keyPassword, key)) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Unable to obtain master password." << std::endl;
+            derived.erase(index);
+
+            return false;
+        }
+
+        secondaryKey.reset(new SymmetricKey(
+            engine_,
+            key,
+            *salt_,
+            size,
+            OT_SYMMETRIC_KEY_DEFAULT_OPERATIONS,
+            OT_SYMMETRIC_KEY_DEFAULT_DIFFICULTY));
+    }
+
+    OT_ASSERT(secondaryKey);
+
+    return unlock(*secondaryKey);
+}
 }  // namespace opentxs
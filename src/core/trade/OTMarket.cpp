@@ -71,9 +71,13 @@
 #include <map>
 #include <memory>
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <utility>
 
+// The most rows a single market data query will return
+#define MARKET_DATA_MAX_ROWS 1000
+
 namespace opentxs
 {
 
@@ -400,6 +404,51 @@ bool OTMarket::GetRecentTradeList(OTASCIIArmor& ascOutput, int32_t& nTradeCount)
     return false;
 }
 
+bool OTMarket::GetMarketData(
+    const int64_t interval,
+    const time64_t from,
+    const time64_t to,
+    String& output,
+    int32_t& count)
+{
+    count = 0;
+    std::ostringstream data{};
+    data << "interval " << interval << "\n";
+
+    if (0 == interval) {
+        const auto trades = trade_log().Trades(from, to, MARKET_DATA_MAX_ROWS);
+
+        for (const auto& trade : trades) {
+            data << trade.time_ << " " << trade.price_ << " " << trade.amount_
+                 << " " << trade.offer_ << " " << trade.other_offer_ << "\n";
+        }
+
+        count = static_cast<int32_t>(trades.size());
+    } else {
+        if (0 == TradeLog::Intervals().count(interval)) {
+            otErr << __FUNCTION__ << ": Unsupported interval " << interval
+                  << std::endl;
+
+            return false;
+        }
+
+        const auto bars =
+            trade_log().Bars(interval, from, to, MARKET_DATA_MAX_ROWS);
+
+        for (const auto& bar : bars) {
+            data << bar.start_ << " " << bar.open_ << " " << bar.high_ << " "
+                 << bar.low_ << " " << bar.close_ << " " << bar.volume_ << " "
+                 << bar.trades_ << "\n";
+        }
+
+        count = static_cast<int32_t>(bars.size());
+    }
+
+    output.Set(data.str().c_str());
+
+    return true;
+}
+
 // OTDB::OfferListMarket
 //
 bool OTMarket::GetOfferList(
@@ -836,6 +885,11 @@ bool OTMarket::SaveMarket()
                   << Log::PathSeparator() << szFilename << "\n";
     }
 
+    // Also informational.
+    if (trade_log_) {
+        trade_log_->Save();
+    }
+
     return true;
 }
 
@@ -1938,6 +1992,12 @@ void OTMarket::ProcessTrade(
                     while (m_pTradeList->GetTradeDataMarketCount() >
                            MAX_MARKET_QUERY_DEPTH)
                         m_pTradeList->RemoveTradeDataMarket(0);
+
+                    trade_log().Add({theDate,
+                                     lPriceLimit,
+                                     lAmountSold,
+                                     lTransactionNum,
+                                     theOtherOffer.GetTransactionNum()});
                 }
 
                 // Account balances have changed based on these trades that we
@@ -2801,6 +2861,7 @@ OTMarket::OTMarket(const char* szFilename)
     : Contract()
     , m_pCron(nullptr)
     , m_pTradeList(nullptr)
+    , trade_log_(nullptr)
     , m_mapBids()
     , m_mapAsks()
     , m_mapOffers()
@@ -2823,6 +2884,7 @@ OTMarket::OTMarket()
     : Contract()
     , m_pCron(nullptr)
     , m_pTradeList(nullptr)
+    , trade_log_(nullptr)
     , m_mapBids()
     , m_mapAsks()
     , m_mapOffers()
@@ -2844,6 +2906,7 @@ OTMarket::OTMarket(
     : Contract()
     , m_pCron(nullptr)
     , m_pTradeList(nullptr)
+    , trade_log_(nullptr)
     , m_mapBids()
     , m_mapAsks()
     , m_mapOffers()
@@ -2860,6 +2923,17 @@ OTMarket::OTMarket(
 
 OTMarket::~OTMarket() { Release_Market(); }
 
+TradeLog& OTMarket::trade_log()
+{
+    if (false == bool(trade_log_)) {
+        trade_log_.reset(new TradeLog(String(Identifier(*this)).Get()));
+    }
+
+    OT_ASSERT(trade_log_)
+
+    return *trade_log_;
+}
+
 void OTMarket::InitMarket() { m_strContractType = "MARKET"; }
 
 void OTMarket::Release_Market()
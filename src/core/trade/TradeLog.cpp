@@ -0,0 +1,629 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/core/trade/TradeLog.hpp"
+
+#include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/OTStorage.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+#define TRADE_LOG_CACHED_PARTITIONS 24
+#define TRADE_LOG_DAYS "days"
+#define TRADE_LOG_FOLDER "trades"
+#define TRADE_LOG_INDEX "index"
+#define TRADE_LOG_INDEX_SECONDS 86400
+#define TRADE_LOG_PARTITION_SECONDS 3600
+
+#define OT_METHOD "opentxs::TradeLog::"
+
+namespace opentxs
+{
+TradeLog::TradeLog(const std::string& marketID)
+    : market_id_(marketID)
+    , lock_()
+    , bars_()
+    , partitions_()
+    , days_()
+    , dirty_days_()
+    , days_dirty_(false)
+{
+    OT_ASSERT(false == market_id_.empty())
+
+    for (const auto& interval : Intervals()) {
+        if (TRADE_LOG_PARTITION_SECONDS <= interval) {
+            bars_[interval];
+        }
+    }
+
+    Lock lock(lock_);
+    load_index(lock);
+}
+
+void TradeLog::add(Bar& bar, const time64_t start, const Trade& trade)
+{
+    if (0 == bar.trades_) {
+        bar.start_ = start;
+        bar.open_ = trade.price_;
+        bar.high_ = trade.price_;
+        bar.low_ = trade.price_;
+    }
+
+    bar.high_ = std::max(bar.high_, trade.price_);
+    bar.low_ = std::min(bar.low_, trade.price_);
+    bar.close_ = trade.price_;
+    bar.volume_ += trade.amount_;
+    ++bar.trades_;
+}
+
+void TradeLog::Add(const Trade& trade)
+{
+    Lock lock(lock_);
+    const auto start = floor(trade.time_, TRADE_LOG_PARTITION_SECONDS);
+    auto partition = load(lock, start);
+
+    OT_ASSERT(partition)
+
+    partition->time_.push_back(trade.time_);
+    partition->price_.push_back(trade.price_);
+    partition->amount_.push_back(trade.amount_);
+    partition->offer_.push_back(trade.offer_);
+    partition->other_offer_.push_back(trade.other_offer_);
+
+    for (auto& [interval, bars] : partition->bars_) {
+        const auto bucket = floor(trade.time_, interval);
+        add(bars[bucket], bucket, trade);
+    }
+
+    for (auto& [interval, bars] : bars_) {
+        const auto bucket = floor(trade.time_, interval);
+        add(bars[bucket], bucket, trade);
+    }
+
+    partition->dirty_ = true;
+    mark_dirty(lock, start);
+}
+
+std::vector<TradeLog::Bar> TradeLog::Bars(
+    const std::int64_t interval,
+    const time64_t from,
+    const time64_t to,
+    const std::size_t limit) const
+{
+    std::vector<Bar> output{};
+
+    if (0 == Intervals().count(interval)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Unsupported interval "
+              << interval << std::endl;
+
+        return output;
+    }
+
+    Lock lock(lock_);
+    // Bars are collected newest first so that the search stops once the
+    // limit is reached, and are put back in order at the end
+    const auto collect = [&](const std::map<time64_t, Bar>& bars) {
+        auto it = bars.lower_bound(to);
+
+        while ((bars.begin() != it) && (output.size() < limit)) {
+            --it;
+
+            if (it->first < from) {
+                break;
+            }
+
+            output.push_back(it->second);
+        }
+    };
+
+    if (TRADE_LOG_PARTITION_SECONDS <= interval) {
+        collect(bars_.at(interval));
+    } else {
+        const auto& index = bars_.at(TRADE_LOG_PARTITION_SECONDS);
+        const auto first = floor(from, TRADE_LOG_PARTITION_SECONDS);
+        auto it = index.lower_bound(to);
+
+        while ((index.begin() != it) && (output.size() < limit)) {
+            --it;
+
+            if (it->first < first) {
+                break;
+            }
+
+            const auto partition = load(lock, it->first);
+
+            OT_ASSERT(partition)
+
+            collect(partition->bars_.at(interval));
+            trim(lock);
+        }
+    }
+
+    std::reverse(output.begin(), output.end());
+
+    return output;
+}
+
+time64_t TradeLog::floor(const time64_t time, const std::int64_t interval)
+{
+    OT_ASSERT(0 < interval)
+
+    const auto remainder = time % interval;
+
+    if (0 > remainder) {
+
+        return time - remainder - interval;
+    }
+
+    return time - remainder;
+}
+
+const std::set<std::int64_t>& TradeLog::Intervals()
+{
+    static const std::set<std::int64_t> output{60, 300, 900, 3600, 86400};
+
+    return output;
+}
+
+std::shared_ptr<TradeLog::Partition> TradeLog::load(
+    const Lock& lock,
+    const time64_t start) const
+{
+    OT_ASSERT(lock.owns_lock())
+
+    auto it = partitions_.find(start);
+
+    if (partitions_.end() != it) {
+
+        return it->second;
+    }
+
+    auto partition = std::make_shared<Partition>();
+
+    OT_ASSERT(partition)
+
+    for (const auto& interval : Intervals()) {
+        if (TRADE_LOG_PARTITION_SECONDS > interval) {
+            partition->bars_[interval];
+        }
+    }
+
+    partitions_.emplace(start, partition);
+    const auto name = std::to_string(start);
+
+    // The partition files are written before the index, so a partition may
+    // exist which the index does not list yet
+    if (false == OTDB::Exists(
+                     OTFolders::Market().Get(),
+                     TRADE_LOG_FOLDER,
+                     market_id_,
+                     name)) {
+
+        return partition;
+    }
+
+    const auto serialized = OTDB::QueryPlainString(
+        OTFolders::Market().Get(), TRADE_LOG_FOLDER, market_id_, name);
+    std::istringstream lines(serialized);
+    std::string line{};
+    std::vector<std::vector<std::int64_t>> columns{};
+
+    while (std::getline(lines, line)) {
+        std::istringstream values(line);
+        std::vector<std::int64_t> column{};
+        std::int64_t value{0};
+
+        while (values >> value) {
+            column.push_back(value);
+        }
+
+        columns.emplace_back(std::move(column));
+    }
+
+    const bool valid = (5 == columns.size()) &&
+                       std::all_of(
+                           columns.begin(),
+                           columns.end(),
+                           [&columns](const auto& column) {
+                               return column.size() == columns[0].size();
+                           });
+
+    if (false == valid) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Partition " << name
+              << " of market " << market_id_ << " is corrupt" << std::endl;
+
+        return partition;
+    }
+
+    partition->time_ = std::move(columns[0]);
+    partition->price_ = std::move(columns[1]);
+    partition->amount_ = std::move(columns[2]);
+    partition->offer_ = std::move(columns[3]);
+    partition->other_offer_ = std::move(columns[4]);
+    Bar total{};
+    total.start_ = start;
+
+    for (std::size_t i = 0; i < partition->time_.size(); ++i) {
+        const Trade trade{partition->time_[i],
+                          partition->price_[i],
+                          partition->amount_[i],
+                          partition->offer_[i],
+                          partition->other_offer_[i]};
+
+        for (auto& [interval, bars] : partition->bars_) {
+            const auto bucket = floor(trade.time_, interval);
+            add(bars[bucket], bucket, trade);
+        }
+
+        add(total, start, trade);
+    }
+
+    auto& index = bars_.at(TRADE_LOG_PARTITION_SECONDS);
+    const auto entry = index.find(start);
+    const auto listed = (index.end() == entry) ? Bar{} : entry->second;
+
+    if ((listed.trades_ != total.trades_) ||
+        (listed.volume_ != total.volume_)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Repairing index entry "
+              << name << " of market " << market_id_ << std::endl;
+        index[start] = total;
+        mark_dirty(lock, start);
+        roll_up(lock);
+    }
+
+    return partition;
+}
+
+std::string TradeLog::index_name(const time64_t day)
+{
+    return std::string(TRADE_LOG_INDEX) + "_" + std::to_string(day);
+}
+
+void TradeLog::load_index(const Lock& lock)
+{
+    OT_ASSERT(lock.owns_lock())
+
+    if (OTDB::Exists(
+            OTFolders::Market().Get(),
+            TRADE_LOG_FOLDER,
+            market_id_,
+            TRADE_LOG_DAYS)) {
+        std::istringstream days(OTDB::QueryPlainString(
+            OTFolders::Market().Get(),
+            TRADE_LOG_FOLDER,
+            market_id_,
+            TRADE_LOG_DAYS));
+        time64_t day{0};
+
+        while (days >> day) {
+            days_.insert(day);
+            read_index(lock, index_name(day));
+        }
+    } else if (OTDB::Exists(
+                   OTFolders::Market().Get(),
+                   TRADE_LOG_FOLDER,
+                   market_id_,
+                   TRADE_LOG_INDEX)) {
+        // Markets saved before the index was split by day are rewritten in
+        // the new layout on the next save
+        read_index(lock, TRADE_LOG_INDEX);
+
+        for (const auto& [start, bar] :
+             bars_.at(TRADE_LOG_PARTITION_SECONDS)) {
+            mark_dirty(lock, start);
+        }
+    }
+
+    roll_up(lock);
+}
+
+void TradeLog::mark_dirty(const Lock& lock, const time64_t start) const
+{
+    OT_ASSERT(lock.owns_lock())
+
+    const auto day = floor(start, TRADE_LOG_INDEX_SECONDS);
+    dirty_days_.insert(day);
+
+    if (days_.insert(day).second) {
+        days_dirty_ = true;
+    }
+}
+
+void TradeLog::read_index(const Lock& lock, const std::string& name)
+{
+    OT_ASSERT(lock.owns_lock())
+
+    if (false == OTDB::Exists(
+                     OTFolders::Market().Get(),
+                     TRADE_LOG_FOLDER,
+                     market_id_,
+                     name)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Missing " << name
+              << " of market " << market_id_ << std::endl;
+
+        return;
+    }
+
+    const auto serialized = OTDB::QueryPlainString(
+        OTFolders::Market().Get(), TRADE_LOG_FOLDER, market_id_, name);
+    std::istringstream lines(serialized);
+    std::string line{};
+    auto& partitions = bars_.at(TRADE_LOG_PARTITION_SECONDS);
+
+    while (std::getline(lines, line)) {
+        std::istringstream values(line);
+        Bar bar{};
+        values >> bar.start_ >> bar.open_ >> bar.high_ >> bar.low_ >>
+            bar.close_ >> bar.volume_ >> bar.trades_;
+
+        if (values.fail()) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Invalid index entry for "
+                  << "market " << market_id_ << std::endl;
+
+            continue;
+        }
+
+        partitions[bar.start_] = bar;
+    }
+}
+
+void TradeLog::roll_up(const Lock& lock) const
+{
+    OT_ASSERT(lock.owns_lock())
+
+    const auto& partitions = bars_.at(TRADE_LOG_PARTITION_SECONDS);
+
+    // Bars longer than a partition are rolled up from the index
+    for (auto& [interval, bars] : bars_) {
+        if (TRADE_LOG_PARTITION_SECONDS == interval) {
+            continue;
+        }
+
+        bars.clear();
+
+        for (const auto& [start, partition] : partitions) {
+            const auto bucket = floor(start, interval);
+            auto& bar = bars[bucket];
+
+            if (0 == bar.trades_) {
+                bar = partition;
+                bar.start_ = bucket;
+            } else {
+                bar.high_ = std::max(bar.high_, partition.high_);
+                bar.low_ = std::min(bar.low_, partition.low_);
+                bar.close_ = partition.close_;
+                bar.volume_ += partition.volume_;
+                bar.trades_ += partition.trades_;
+            }
+        }
+    }
+}
+
+bool TradeLog::Save()
+{
+    Lock lock(lock_);
+    bool output{true};
+
+    for (auto& [start, partition] : partitions_) {
+        OT_ASSERT(partition)
+
+        if (false == partition->dirty_) {
+            continue;
+        }
+
+        const bool saved = OTDB::StorePlainString(
+            serialize(*partition),
+            OTFolders::Market().Get(),
+            TRADE_LOG_FOLDER,
+            market_id_,
+            std::to_string(start));
+
+        if (saved) {
+            partition->dirty_ = false;
+        } else {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to save partition "
+                  << start << " of market " << market_id_ << std::endl;
+            output = false;
+        }
+    }
+
+    // The index is written after the partitions so that every partition it
+    // lists exists on disk, and the list of days is written last so that
+    // every day it lists exists on disk. Only the days which changed are
+    // rewritten.
+    const auto& index = bars_.at(TRADE_LOG_PARTITION_SECONDS);
+    auto day = dirty_days_.begin();
+
+    while (output && (dirty_days_.end() != day)) {
+        const std::map<time64_t, Bar> bars(
+            index.lower_bound(*day),
+            index.lower_bound(*day + TRADE_LOG_INDEX_SECONDS));
+        const bool saved = OTDB::StorePlainString(
+            serialize(bars),
+            OTFolders::Market().Get(),
+            TRADE_LOG_FOLDER,
+            market_id_,
+            index_name(*day));
+
+        if (saved) {
+            day = dirty_days_.erase(day);
+        } else {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to save index "
+                  << *day << " of market " << market_id_ << std::endl;
+            output = false;
+        }
+    }
+
+    if (days_dirty_ && output) {
+        std::ostringstream days{};
+
+        for (const auto& start : days_) {
+            days << start << '\n';
+        }
+
+        days_dirty_ = false == OTDB::StorePlainString(
+                                   days.str(),
+                                   OTFolders::Market().Get(),
+                                   TRADE_LOG_FOLDER,
+                                   market_id_,
+                                   TRADE_LOG_DAYS);
+
+        if (days_dirty_) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed to save index of market " << market_id_
+                  << std::endl;
+            output = false;
+        }
+    }
+
+    trim(lock);
+
+    return output;
+}
+
+std::string TradeLog::serialize(const Partition& partition)
+{
+    std::ostringstream output{};
+    const auto column = [&output](const auto& values) {
+        bool first{true};
+
+        for (const auto& value : values) {
+            if (false == first) {
+                output << ' ';
+            }
+
+            output << value;
+            first = false;
+        }
+
+        output << '\n';
+    };
+
+    column(partition.time_);
+    column(partition.price_);
+    column(partition.amount_);
+    column(partition.offer_);
+    column(partition.other_offer_);
+
+    return output.str();
+}
+
+std::string TradeLog::serialize(const std::map<time64_t, Bar>& bars)
+{
+    std::ostringstream output{};
+
+    for (const auto& [start, bar] : bars) {
+        output << start << ' ' << bar.open_ << ' ' << bar.high_ << ' '
+               << bar.low_ << ' ' << bar.close_ << ' ' << bar.volume_ << ' '
+               << bar.trades_ << '\n';
+    }
+
+    return output.str();
+}
+
+std::vector<TradeLog::Trade> TradeLog::Trades(
+    const time64_t from,
+    const time64_t to,
+    const std::size_t limit) const
+{
+    std::vector<Trade> output{};
+    Lock lock(lock_);
+    const auto& index = bars_.at(TRADE_LOG_PARTITION_SECONDS);
+    const auto first = floor(from, TRADE_LOG_PARTITION_SECONDS);
+    auto it = index.lower_bound(to);
+
+    // Trades are collected newest first, like Bars()
+    while ((index.begin() != it) && (output.size() < limit)) {
+        --it;
+
+        if (it->first < first) {
+            break;
+        }
+
+        const auto partition = load(lock, it->first);
+
+        OT_ASSERT(partition)
+
+        const auto& time = partition->time_;
+
+        for (auto i = time.size(); (0 < i) && (output.size() < limit); --i) {
+            const auto n = i - 1;
+
+            if ((time[n] < from) || (time[n] >= to)) {
+                continue;
+            }
+
+            output.push_back({time[n],
+                              partition->price_[n],
+                              partition->amount_[n],
+                              partition->offer_[n],
+                              partition->other_offer_[n]});
+        }
+
+        trim(lock);
+    }
+
+    std::reverse(output.begin(), output.end());
+
+    return output;
+}
+
+void TradeLog::trim(const Lock& lock) const
+{
+    OT_ASSERT(lock.owns_lock())
+
+    // Oldest partitions are dropped first. Unsaved partitions are kept.
+    auto it = partitions_.begin();
+
+    while ((TRADE_LOG_CACHED_PARTITIONS < partitions_.size()) &&
+           (partitions_.end() != it)) {
+        OT_ASSERT(it->second)
+
+        if (it->second->dirty_) {
+            ++it;
+        } else {
+            it = partitions_.erase(it);
+        }
+    }
+}
+}  // namespace opentxs
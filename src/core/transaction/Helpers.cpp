@@ -40,6 +40,8 @@
 
 #include "opentxs/core/transaction/Helpers.hpp"
 
+#include "opentxs/api/Native.hpp"
+#include "opentxs/api/Server.hpp"
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/util/Common.hpp"
 #include "opentxs/core/util/OTFolders.hpp"
@@ -52,6 +54,7 @@
 #include "opentxs/core/OTTransaction.hpp"
 #include "opentxs/core/OTTransactionType.hpp"
 #include "opentxs/core/String.hpp"
+#include "opentxs/OT.hpp"
 #include "opentxs/Types.hpp"
 
 #include <inttypes.h>
@@ -350,6 +353,22 @@ bool VerifyBoxReceiptExists(
     return bExists;
 }
 
+bool CachedBoxReceipt(int64_t lLedgerType)
+{
+    switch (lLedgerType) {
+        case 0:  // nymbox
+        case 1:  // inbox
+        case 2: {  // outbox
+
+            return OT::App().ServerMode();
+        }
+        default: {
+
+            return false;
+        }
+    }
+}
+
 OTTransaction* LoadBoxReceipt(OTTransaction& theAbbrev, Ledger& theLedger)
 {
     const int64_t lLedgerType = static_cast<int64_t>(theLedger.GetType());
@@ -405,11 +424,18 @@ OTTransaction* LoadBoxReceipt(OTTransaction& theAbbrev, int64_t lLedgerType)
 
     // Try to load the box receipt from local storage.
     //
-    std::string strFileContents(OTDB::QueryPlainString(
-        strFolder1name.Get(),  // <=== LOADING FROM DATA STORE.
-        strFolder2name.Get(),
-        strFolder3name.Get(),
-        strFilename.Get()));
+    std::string strFileContents(
+        CachedBoxReceipt(lLedgerType)
+            ? OT::App().Server().QueryFile(
+                  strFolder1name.Get(),
+                  strFolder2name.Get(),
+                  strFolder3name.Get(),
+                  strFilename.Get())
+            : OTDB::QueryPlainString(
+                  strFolder1name.Get(),  // <=== LOADING FROM DATA STORE.
+                  strFolder2name.Get(),
+                  strFolder3name.Get(),
+                  strFilename.Get()));
     if (strFileContents.length() < 2) {
         otErr << __FUNCTION__ << ": Error reading file: " << strFolder1name
               << Log::PathSeparator() << strFolder2name << Log::PathSeparator()
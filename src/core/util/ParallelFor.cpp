@@ -0,0 +1,84 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/core/util/ParallelFor.hpp"
+
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace opentxs
+{
+void ParallelFor(
+    const std::size_t count,
+    const std::size_t threshold,
+    const std::size_t maxThreads,
+    const std::function<void(const std::size_t)>& function)
+{
+    const std::size_t hardware = std::thread::hardware_concurrency();
+    const std::size_t threads =
+        (threshold > count)
+            ? 1
+            : std::max<std::size_t>(
+                  1, std::min({maxThreads, hardware, count}));
+    auto run = [&](const std::size_t first) {
+        for (auto i = first; i < count; i += threads) {
+            function(i);
+        }
+    };
+
+    if (1 == threads) {
+        run(0);
+
+        return;
+    }
+
+    std::vector<std::future<void>> workers{};
+
+    for (std::size_t thread = 0; thread < threads; ++thread) {
+        workers.emplace_back(std::async(std::launch::async, run, thread));
+    }
+
+    for (auto& worker : workers) {
+        worker.get();
+    }
+}
+}  // namespace opentxs
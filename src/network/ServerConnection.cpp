@@ -51,13 +51,14 @@
 #include "opentxs/core/Message.hpp"
 #include "opentxs/core/String.hpp"
 #include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/DealerSocket.hpp"
 #include "opentxs/network/zeromq/Message.hpp"
-#include "opentxs/network/zeromq/RequestSocket.hpp"
 #include "opentxs/OT.hpp"
 #include "opentxs/Proto.hpp"
 
 #include <chrono>
 #include <cstdint>
+#include <future>
 
 #define OT_METHOD "opentxs::ServerConnection::"
 
@@ -82,8 +83,9 @@ ServerConnection::ServerConnection(
     , address_type_(zmq.DefaultAddressType())
     , remote_contract_(OT::App().Wallet().Server(Identifier(serverID)))
     , thread_(nullptr)
-    , socket_(zmq.Context().RequestSocket())
+    , socket_(zmq.Context().DealerSocket())
     , last_activity_(std::time(nullptr))
+    , generation_(0)
     , socket_ready_(Flag::Factory(false))
     , status_(Flag::Factory(false))
     , use_proxy_(Flag::Factory(false))
@@ -143,12 +145,13 @@ std::string ServerConnection::endpoint() const
     return endpoint;
 }
 
-zeromq::RequestSocket& ServerConnection::get_socket(const Lock& lock)
+zeromq::DealerSocket& ServerConnection::get_socket(const Lock& lock)
 {
     OT_ASSERT(verify_lock(lock))
 
     if (false == socket_ready_.get()) {
         socket_ = socket(lock);
+        ++generation_;
         socket_ready_->On();
     }
 
@@ -167,9 +170,10 @@ void ServerConnection::reset_timer()
     last_activity_.store(std::time(nullptr));
 }
 
-NetworkReplyRaw ServerConnection::Send(const std::string& input)
+NetworkReplyRaw ServerConnection::process_reply(
+    const std::uint64_t generation,
+    zeromq::Socket::MessageSendResult&& result)
 {
-    Lock lock(lock_);
     NetworkReplyRaw output{SendResult::ERROR, nullptr};
     auto& status = output.first;
     auto& reply = output.second;
@@ -177,19 +181,20 @@ NetworkReplyRaw ServerConnection::Send(const std::string& input)
 
     OT_ASSERT(reply);
 
-    auto result =
-        get_socket(lock).SendRequest(network::zeromq::Message::Factory(input));
     status = result.first;
     network::zeromq::Message& message = result.second;
 
     switch (status) {
-        case SendResult::ERROR: {
-            status_->Off();
-            reset_socket(lock);
-        } break;
+        case SendResult::ERROR:
         case SendResult::TIMEOUT: {
+            Lock lock(lock_);
             status_->Off();
-            reset_socket(lock);
+
+            // Replacing a socket fails every request still pending on it.
+            // Only failures on the current socket may replace it again.
+            if (generation == generation_) {
+                reset_socket(lock);
+            }
         } break;
         case SendResult::VALID_REPLY: {
             status_->On();
@@ -206,6 +211,11 @@ NetworkReplyRaw ServerConnection::Send(const std::string& input)
     return output;
 }
 
+NetworkReplyRaw ServerConnection::Send(const std::string& input)
+{
+    return SendAsync(input).get();
+}
+
 NetworkReplyString ServerConnection::Send(const String& message)
 {
     OTASCIIArmor envelope(message);
@@ -240,33 +250,84 @@ NetworkReplyString ServerConnection::Send(const String& message)
 
 NetworkReplyMessage ServerConnection::Send(const Message& message)
 {
-    NetworkReplyMessage output{SendResult::ERROR, nullptr};
-    auto& status = output.first;
-    auto& reply = output.second;
-    reply.reset(new Message);
+    return SendAsync(message).get();
+}
 
-    OT_ASSERT(reply);
+std::future<NetworkReplyRaw> ServerConnection::SendAsync(
+    const std::string& input)
+{
+    // The lock only protects socket_ replacement. It is released before the
+    // reply arrives so other nyms can send to this notary in the meantime.
+    Lock lock(lock_);
+    auto pending = get_socket(lock).SendRequest(input);
+    const auto generation = generation_;
+    lock.unlock();
+
+    return std::async(
+        std::launch::deferred,
+        [ this, generation, future = std::move(pending) ]() mutable
+        ->NetworkReplyRaw {
+            return process_reply(generation, future.get());
+        });
+}
 
+std::future<NetworkReplyMessage> ServerConnection::SendAsync(
+    const Message& message)
+{
     String input;
     message.SaveContractRaw(input);
-    auto rawOutput = Send(input);
-    status = rawOutput.first;
+    OTASCIIArmor envelope(input);
 
-    if (SendResult::VALID_REPLY == status) {
-        if (false == reply->LoadContractFromString(*rawOutput.second)) {
-            otErr << OT_METHOD << __FUNCTION__ << ": Received server reply, "
-                  << "but unable to instantiate it as a Message." << std::endl;
-            reply.reset();
-            status = SendResult::INVALID_REPLY;
-        }
+    if (false == envelope.Exists()) {
+        std::promise<NetworkReplyMessage> failed{};
+        failed.set_value(NetworkReplyMessage{SendResult::ERROR,
+                                             std::make_shared<Message>()});
+
+        return failed.get_future();
     }
 
-    return output;
+    return std::async(
+        std::launch::deferred,
+        [future = SendAsync(std::string(envelope.Get()))]() mutable
+        ->NetworkReplyMessage {
+            auto rawOutput = future.get();
+            NetworkReplyMessage output{rawOutput.first, nullptr};
+            auto& status = output.first;
+            auto& reply = output.second;
+            reply.reset(new Message);
+
+            OT_ASSERT(reply);
+
+            if (SendResult::VALID_REPLY != status) {
+
+                return output;
+            }
+
+            OTASCIIArmor armored;
+            armored.Set(rawOutput.second->c_str());
+            String serialized;
+
+            if (false == armored.GetString(serialized)) {
+                otErr << OT_METHOD << "SendAsync"
+                      << ": Received server reply, but unable to decode it "
+                      << "into a String." << std::endl;
+                reply.reset();
+                status = SendResult::INVALID_REPLY;
+            } else if (false == reply->LoadContractFromString(serialized)) {
+                otErr << OT_METHOD << "SendAsync"
+                      << ": Received server reply, but unable to instantiate "
+                      << "it as a Message." << std::endl;
+                reply.reset();
+                status = SendResult::INVALID_REPLY;
+            }
+
+            return output;
+        });
 }
 
 void ServerConnection::set_curve(
     const Lock& lock,
-    zeromq::RequestSocket& socket) const
+    zeromq::DealerSocket& socket) const
 {
     OT_ASSERT(verify_lock(lock));
 
@@ -277,7 +338,7 @@ void ServerConnection::set_curve(
 
 void ServerConnection::set_proxy(
     const Lock& lock,
-    zeromq::RequestSocket& socket) const
+    zeromq::DealerSocket& socket) const
 {
     OT_ASSERT(verify_lock(lock));
 
@@ -297,7 +358,7 @@ void ServerConnection::set_proxy(
 
 void ServerConnection::set_timeouts(
     const Lock& lock,
-    zeromq::RequestSocket& socket) const
+    zeromq::DealerSocket& socket) const
 {
     OT_ASSERT(verify_lock(lock));
 
@@ -307,9 +368,9 @@ void ServerConnection::set_timeouts(
     OT_ASSERT(set);
 }
 
-OTZMQRequestSocket ServerConnection::socket(const Lock& lock) const
+OTZMQDealerSocket ServerConnection::socket(const Lock& lock) const
 {
-    auto output = zmq_.Context().RequestSocket();
+    auto output = zmq_.Context().DealerSocket();
     set_proxy(lock, output);
     set_timeouts(lock, output);
     set_curve(lock, output);
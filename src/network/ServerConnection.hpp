@@ -43,10 +43,13 @@
 
 #include "opentxs/core/Flag.hpp"
 #include "opentxs/core/Lockable.hpp"
+#include "opentxs/network/zeromq/Socket.hpp"
 #include "opentxs/network/ServerConnection.hpp"
 
 #include <atomic>
+#include <cstdint>
 #include <ctime>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -63,6 +66,8 @@ public:
     NetworkReplyRaw Send(const std::string& message) override;
     NetworkReplyString Send(const String& message) override;
     NetworkReplyMessage Send(const Message& message) override;
+    std::future<NetworkReplyRaw> SendAsync(const std::string& message) override;
+    std::future<NetworkReplyMessage> SendAsync(const Message& message) override;
     bool Status() const override;
 
     ~ServerConnection();
@@ -75,20 +80,25 @@ private:
     proto::AddressType address_type_{proto::ADDRESSTYPE_ERROR};
     std::shared_ptr<const ServerContract> remote_contract_{nullptr};
     std::unique_ptr<std::thread> thread_{nullptr};
-    OTZMQRequestSocket socket_;
+    OTZMQDealerSocket socket_;
     std::atomic<std::time_t> last_activity_{0};
+    // Incremented each time socket_ is replaced. Protected by lock_.
+    std::uint64_t generation_{0};
     OTFlag socket_ready_;
     OTFlag status_;
     OTFlag use_proxy_;
 
     std::string endpoint() const;
-    void set_curve(const Lock& lock, zeromq::RequestSocket& socket) const;
-    void set_proxy(const Lock& lock, zeromq::RequestSocket& socket) const;
-    void set_timeouts(const Lock& lock, zeromq::RequestSocket& socket) const;
-    OTZMQRequestSocket socket(const Lock& lock) const;
+    void set_curve(const Lock& lock, zeromq::DealerSocket& socket) const;
+    void set_proxy(const Lock& lock, zeromq::DealerSocket& socket) const;
+    void set_timeouts(const Lock& lock, zeromq::DealerSocket& socket) const;
+    OTZMQDealerSocket socket(const Lock& lock) const;
 
     void activity_timer();
-    zeromq::RequestSocket& get_socket(const Lock& lock);
+    zeromq::DealerSocket& get_socket(const Lock& lock);
+    NetworkReplyRaw process_reply(
+        const std::uint64_t generation,
+        zeromq::Socket::MessageSendResult&& result);
     void reset_socket(const Lock& lock);
     void reset_timer();
 
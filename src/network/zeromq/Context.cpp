@@ -41,6 +41,7 @@
 #include "Context.hpp"
 
 #include "opentxs/core/Log.hpp"
+#include "opentxs/network/zeromq/DealerSocket.hpp"
 #include "opentxs/network/zeromq/PairSocket.hpp"
 #include "opentxs/network/zeromq/Proxy.hpp"
 #include "opentxs/network/zeromq/PublishSocket.hpp"
@@ -48,6 +49,7 @@
 #include "opentxs/network/zeromq/PushSocket.hpp"
 #include "opentxs/network/zeromq/ReplySocket.hpp"
 #include "opentxs/network/zeromq/RequestSocket.hpp"
+#include "opentxs/network/zeromq/RouterSocket.hpp"
 #include "opentxs/network/zeromq/SubscribeSocket.hpp"
 
 #include "PairEventListener.hpp"
@@ -75,6 +77,11 @@ Context::operator void*() const { return context_; }
 
 Context* Context::clone() const { return new Context; }
 
+OTZMQDealerSocket Context::DealerSocket() const
+{
+    return DealerSocket::Factory(*this);
+}
+
 OTZMQSubscribeSocket Context::PairEventListener(
     const PairEventCallback& callback) const
 {
@@ -140,6 +147,11 @@ OTZMQRequestSocket Context::RequestSocket() const
     return RequestSocket::Factory(*this);
 }
 
+OTZMQRouterSocket Context::RouterSocket(const ReplyCallback& callback) const
+{
+    return RouterSocket::Factory(*this, callback);
+}
+
 OTZMQSubscribeSocket Context::SubscribeSocket(
     const ListenCallback& callback) const
 {
@@ -50,6 +50,7 @@ class Context : virtual public zeromq::Context
 public:
     operator void*() const override;
 
+    OTZMQDealerSocket DealerSocket() const override;
     OTZMQSubscribeSocket PairEventListener(
         const PairEventCallback& callback) const override;
     OTZMQPairSocket PairSocket(const opentxs::network::zeromq::ListenCallback&
@@ -71,6 +72,8 @@ public:
     OTZMQPushSocket PushSocket(const bool client) const override;
     OTZMQReplySocket ReplySocket(const ReplyCallback& callback) const override;
     OTZMQRequestSocket RequestSocket() const override;
+    OTZMQRouterSocket RouterSocket(
+        const ReplyCallback& callback) const override;
     OTZMQSubscribeSocket SubscribeSocket(
         const ListenCallback& callback) const override;
 
@@ -0,0 +1,415 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "DealerSocket.hpp"
+
+#include "opentxs/core/Log.hpp"
+#include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
+#include "opentxs/OT.hpp"
+
+#include <zmq.h>
+
+#define DEALER_QUEUE_ENDPOINT_PREFIX "inproc://opentxs/dealerqueue/"
+#define POLL_MILLISECONDS 100
+
+#define OT_METHOD "opentxs::network::zeromq::implementation::DealerSocket::"
+
+namespace opentxs::network::zeromq
+{
+OTZMQDealerSocket DealerSocket::Factory(const class Context& context)
+{
+    return OTZMQDealerSocket(
+        new implementation::DealerSocket(context, OT::Running()));
+}
+}  // namespace opentxs::network::zeromq
+
+namespace opentxs::network::zeromq::implementation
+{
+std::atomic<std::uint64_t> DealerSocket::instance_counter_{0};
+
+DealerSocket::DealerSocket(const zeromq::Context& context, const Flag& running)
+    : ot_super(context, SocketType::Dealer)
+    , CurveClient(lock_, socket_)
+    , running_(running)
+    , queue_endpoint_(
+          DEALER_QUEUE_ENDPOINT_PREFIX + std::to_string(++instance_counter_))
+    , queue_push_(zmq_socket(context, ZMQ_PUSH))
+    , queue_pull_(zmq_socket(context, ZMQ_PULL))
+    , queue_lock_()
+    , next_request_(0)
+    , pending_lock_()
+    , pending_()
+    , dealer_run_(Flag::Factory(true))
+    , dealer_thread_(nullptr)
+{
+    OT_ASSERT(nullptr != queue_push_);
+    OT_ASSERT(nullptr != queue_pull_);
+
+    const int linger{0};
+    zmq_setsockopt(queue_push_, ZMQ_LINGER, &linger, sizeof(linger));
+    zmq_setsockopt(queue_pull_, ZMQ_LINGER, &linger, sizeof(linger));
+
+    const auto bound = zmq_bind(queue_pull_, queue_endpoint_.c_str());
+
+    OT_ASSERT(0 == bound);
+
+    const auto connected = zmq_connect(queue_push_, queue_endpoint_.c_str());
+
+    OT_ASSERT(0 == connected);
+}
+
+DealerSocket* DealerSocket::clone() const
+{
+    return new DealerSocket(context_, running_);
+}
+
+void DealerSocket::expire_requests(const Lock& lock) const
+{
+    OT_ASSERT(verify_lock(lock))
+
+    const auto now = Clock::now();
+    Lock pendingLock(pending_lock_);
+
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        auto& [deadline, promise] = it->second;
+
+        if (now > deadline) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Request " << it->first
+                  << " timed out." << std::endl;
+            promise.set_value(
+                MessageSendResult{SendResult::TIMEOUT, Message::Factory()});
+            it = pending_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void DealerSocket::fail_requests() const
+{
+    Lock lock(pending_lock_);
+
+    for (auto& it : pending_) {
+        auto& promise = it.second.second;
+        promise.set_value(
+            MessageSendResult{SendResult::ERROR, Message::Factory()});
+    }
+
+    pending_.clear();
+}
+
+void DealerSocket::finish_request(
+    const RequestID id,
+    const SendResult status,
+    OTZMQMessage&& reply) const
+{
+    Lock lock(pending_lock_);
+    auto it = pending_.find(id);
+
+    if (pending_.end() == it) {
+        otWarn << OT_METHOD << __FUNCTION__ << ": Discarding reply to unknown "
+               << "or expired request " << id << std::endl;
+
+        return;
+    }
+
+    it->second.second.set_value(MessageSendResult{status, std::move(reply)});
+    pending_.erase(it);
+}
+
+void DealerSocket::forward_requests(const Lock& lock) const
+{
+    OT_ASSERT(verify_lock(lock))
+
+    while (true) {
+        RequestID id{0};
+        const auto bytes =
+            zmq_recv(queue_pull_, &id, sizeof(id), ZMQ_DONTWAIT);
+
+        if (-1 == bytes) {
+
+            return;
+        }
+
+        if ((sizeof(id) != static_cast<std::size_t>(bytes)) ||
+            (false == more(queue_pull_))) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Invalid queued request"
+                  << std::endl;
+            skip_frames(queue_pull_);
+
+            continue;
+        }
+
+        auto body = Message::Factory();
+        Message& request = body;
+
+        if (-1 == zmq_msg_recv(request, queue_pull_, 0)) {
+            finish_request(id, SendResult::ERROR, Message::Factory());
+
+            continue;
+        }
+
+        // The request must be timed from the moment it reaches the wire,
+        // otherwise a long queue would count against its receive timeout
+        start_timer(lock, id);
+        // The empty delimiter makes the correlation ID part of the envelope,
+        // which REP and ROUTER peers both return unmodified with the reply
+        const bool sent =
+            (-1 !=
+             zmq_send(socket_, &id, sizeof(id), ZMQ_SNDMORE | ZMQ_DONTWAIT)) &&
+            (-1 != zmq_send(socket_, nullptr, 0, ZMQ_SNDMORE | ZMQ_DONTWAIT)) &&
+            (-1 != zmq_msg_send(request, socket_, ZMQ_DONTWAIT));
+
+        if (false == sent) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Send error:\n"
+                  << zmq_strerror(zmq_errno()) << std::endl;
+            finish_request(id, SendResult::ERROR, Message::Factory());
+        }
+    }
+}
+
+bool DealerSocket::more(void* socket) const
+{
+    int more{0};
+    std::size_t size{sizeof(more)};
+    zmq_getsockopt(socket, ZMQ_RCVMORE, &more, &size);
+
+    return (1 == more);
+}
+
+void DealerSocket::receive_replies(const Lock& lock) const
+{
+    OT_ASSERT(verify_lock(lock))
+
+    while (true) {
+        RequestID id{0};
+        const auto bytes = zmq_recv(socket_, &id, sizeof(id), ZMQ_DONTWAIT);
+
+        if (-1 == bytes) {
+
+            return;
+        }
+
+        if ((sizeof(id) != static_cast<std::size_t>(bytes)) ||
+            (false == more(socket_))) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Reply is missing "
+                  << "correlation ID" << std::endl;
+            skip_frames(socket_);
+
+            continue;
+        }
+
+        // The reply body is the last frame, after the empty delimiter
+        auto reply = Message::Factory();
+        bool received{true};
+
+        while (received && more(socket_)) {
+            reply = Message::Factory();
+            Message& message = reply;
+            received = (-1 != zmq_msg_recv(message, socket_, 0));
+        }
+
+        if (false == received) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Receive error: " << zmq_strerror(zmq_errno())
+                  << std::endl;
+            skip_frames(socket_);
+            finish_request(id, SendResult::ERROR, Message::Factory());
+
+            continue;
+        }
+
+        finish_request(id, SendResult::VALID_REPLY, std::move(reply));
+    }
+}
+
+std::future<Socket::MessageSendResult> DealerSocket::SendRequest(
+    const std::string& input) const
+{
+    auto copy = input;
+
+    return SendRequest(Message::Factory(copy));
+}
+
+std::future<Socket::MessageSendResult> DealerSocket::SendRequest(
+    zeromq::Message& request) const
+{
+    const RequestID id = ++next_request_;
+    std::future<MessageSendResult> output{};
+
+    {
+        Lock lock(pending_lock_);
+        auto& [deadline, promise] = pending_[id];
+        deadline = Clock::time_point::max();
+        output = promise.get_future();
+    }
+
+    Lock lock(queue_lock_);
+    const bool queued =
+        (-1 != zmq_send(queue_push_, &id, sizeof(id), ZMQ_SNDMORE)) &&
+        (-1 != zmq_send(queue_push_, request.data(), request.size(), 0));
+    lock.unlock();
+
+    if (false == queued) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to queue request:\n"
+              << zmq_strerror(zmq_errno()) << std::endl;
+        finish_request(id, SendResult::ERROR, Message::Factory());
+    }
+
+    return output;
+}
+
+bool DealerSocket::SetCurve(const ServerContract& contract) const
+{
+    return set_curve(contract);
+}
+
+bool DealerSocket::SetSocksProxy(const std::string& proxy) const
+{
+    return set_socks_proxy(proxy);
+}
+
+void DealerSocket::skip_frames(void* socket) const
+{
+    while (more(socket)) {
+        zmq_msg_t frame;
+        zmq_msg_init(&frame);
+        zmq_msg_recv(&frame, socket, 0);
+        zmq_msg_close(&frame);
+    }
+}
+
+// The socket thread is not started until the socket is connected so that
+// options set beforehand never wait for it to release lock_
+bool DealerSocket::Start(const std::string& endpoint) const
+{
+    Lock lock(lock_);
+
+    if (false == start_client(lock, endpoint)) {
+
+        return false;
+    }
+
+    if (false == bool(dealer_thread_)) {
+        dealer_thread_.reset(new std::thread(&DealerSocket::thread, this));
+
+        OT_ASSERT(dealer_thread_)
+    }
+
+    return true;
+}
+
+void DealerSocket::start_timer(const Lock& lock, const RequestID id) const
+{
+    OT_ASSERT(verify_lock(lock))
+
+    Lock pendingLock(pending_lock_);
+    auto it = pending_.find(id);
+
+    if (pending_.end() == it) {
+
+        return;
+    }
+
+    if (0 > receive_timeout_) {
+
+        return;
+    }
+
+    it->second.first =
+        Clock::now() + std::chrono::milliseconds(receive_timeout_);
+}
+
+// All socket_ operations happen on this thread so that callers of
+// SendRequest never contend with each other for the socket
+void DealerSocket::thread() const
+{
+    zmq_pollitem_t poll[2];
+
+    while (running_ && dealer_run_.get()) {
+        poll[0].socket = socket_;
+        poll[0].events = ZMQ_POLLIN;
+        poll[1].socket = queue_pull_;
+        poll[1].events = ZMQ_POLLIN;
+        // lock_ is not held while waiting, so that setting options on the
+        // socket never waits for a poll to time out
+        const auto events = zmq_poll(poll, 2, POLL_MILLISECONDS);
+        Lock lock(lock_);
+
+        if (0 > events) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Poll error: " << zmq_strerror(zmq_errno())
+                  << std::endl;
+        } else if (0 < events) {
+            if (ZMQ_POLLIN & poll[1].revents) {
+                forward_requests(lock);
+            }
+
+            if (ZMQ_POLLIN & poll[0].revents) {
+                receive_replies(lock);
+            }
+        }
+
+        expire_requests(lock);
+        lock.unlock();
+        std::this_thread::yield();
+    }
+
+    fail_requests();
+}
+
+DealerSocket::~DealerSocket()
+{
+    dealer_run_->Off();
+
+    if (dealer_thread_ && dealer_thread_->joinable()) {
+        dealer_thread_->join();
+        dealer_thread_.reset();
+    }
+
+    fail_requests();
+    Lock lock(queue_lock_);
+    zmq_close(queue_push_);
+    zmq_close(queue_pull_);
+    queue_push_ = nullptr;
+    queue_pull_ = nullptr;
+}
+}  // namespace opentxs::network::zeromq::implementation
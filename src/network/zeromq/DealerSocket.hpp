@@ -0,0 +1,120 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_NETWORK_ZEROMQ_IMPLEMENTATION_DEALERSOCKET_HPP
+#define OPENTXS_NETWORK_ZEROMQ_IMPLEMENTATION_DEALERSOCKET_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include "opentxs/core/Flag.hpp"
+#include "opentxs/network/zeromq/DealerSocket.hpp"
+
+#include "CurveClient.hpp"
+#include "Socket.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace opentxs::network::zeromq::implementation
+{
+class DealerSocket : virtual public zeromq::DealerSocket,
+                     public Socket,
+                     CurveClient
+{
+public:
+    std::future<MessageSendResult> SendRequest(
+        const std::string& message) const override;
+    std::future<MessageSendResult> SendRequest(
+        zeromq::Message& message) const override;
+    bool SetCurve(const ServerContract& contract) const override;
+    bool SetSocksProxy(const std::string& proxy) const override;
+    bool Start(const std::string& endpoint) const override;
+
+    ~DealerSocket();
+
+private:
+    friend opentxs::network::zeromq::DealerSocket;
+    typedef Socket ot_super;
+    using RequestID = std::uint64_t;
+    using Clock = std::chrono::steady_clock;
+    using PendingRequest =
+        std::pair<Clock::time_point, std::promise<MessageSendResult>>;
+
+    static std::atomic<std::uint64_t> instance_counter_;
+
+    const Flag& running_;
+    const std::string queue_endpoint_;
+    // Requests are handed to the socket thread through this inproc pair so
+    // that callers never touch socket_ directly
+    void* queue_push_{nullptr};
+    void* queue_pull_{nullptr};
+    mutable std::mutex queue_lock_;
+    mutable std::atomic<RequestID> next_request_{0};
+    mutable std::mutex pending_lock_;
+    mutable std::map<RequestID, PendingRequest> pending_;
+    OTFlag dealer_run_;
+    mutable std::unique_ptr<std::thread> dealer_thread_{nullptr};
+
+    DealerSocket* clone() const override;
+    void expire_requests(const Lock& lock) const;
+    void fail_requests() const;
+    void finish_request(
+        const RequestID id,
+        const SendResult status,
+        OTZMQMessage&& reply) const;
+    void forward_requests(const Lock& lock) const;
+    bool more(void* socket) const;
+    void receive_replies(const Lock& lock) const;
+    void skip_frames(void* socket) const;
+    void start_timer(const Lock& lock, const RequestID id) const;
+    void thread() const;
+
+    DealerSocket(const zeromq::Context& context, const Flag& running);
+    DealerSocket() = delete;
+    DealerSocket(const DealerSocket&) = delete;
+    DealerSocket(DealerSocket&&) = delete;
+    DealerSocket& operator=(const DealerSocket&) = delete;
+    DealerSocket& operator=(DealerSocket&&) = delete;
+};
+}  // namespace opentxs::network::zeromq::implementation
+#endif  // OPENTXS_NETWORK_ZEROMQ_IMPLEMENTATION_DEALERSOCKET_HPP
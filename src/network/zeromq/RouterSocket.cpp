@@ -0,0 +1,176 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "RouterSocket.hpp"
+
+#include "opentxs/core/Log.hpp"
+#include "opentxs/network/zeromq/ReplyCallback.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
+
+#include <zmq.h>
+
+#define OT_METHOD "opentxs::network::zeromq::implementation::RouterSocket::"
+
+namespace opentxs::network::zeromq
+{
+OTZMQRouterSocket RouterSocket::Factory(
+    const class Context& context,
+    const ReplyCallback& callback)
+{
+    return OTZMQRouterSocket(
+        new implementation::RouterSocket(context, callback));
+}
+}  // namespace opentxs::network::zeromq
+
+namespace opentxs::network::zeromq::implementation
+{
+RouterSocket::RouterSocket(
+    const zeromq::Context& context,
+    const ReplyCallback& callback)
+    : ot_super(context, SocketType::Router)
+    , CurveServer(lock_, socket_)
+    , Receiver(lock_, socket_, true)
+    , callback_(callback)
+{
+}
+
+RouterSocket* RouterSocket::clone() const
+{
+    return new RouterSocket(context_, callback_);
+}
+
+bool RouterSocket::have_callback() const { return true; }
+
+// The first frame, which has already been received, is the routing ID of the
+// peer. The remaining envelope is an empty delimiter for RequestSocket peers
+// or a correlation ID and an empty delimiter for DealerSocket peers, and the
+// last frame is the request body. The entire envelope is returned unmodified
+// with the reply.
+void RouterSocket::process_incoming(const Lock& lock, Message& message)
+{
+    std::vector<OTZMQMessage> frames{};
+
+    if (false == receive_frames(lock, frames)) {
+
+        return;
+    }
+
+    if (frames.empty()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Missing request body"
+              << std::endl;
+
+        return;
+    }
+
+    auto output = callback_.Process(frames.back().get());
+
+    if (false == send_frame(lock, message, true)) {
+
+        return;
+    }
+
+    for (std::size_t i = 0; i < (frames.size() - 1); ++i) {
+        if (false == send_frame(lock, frames.at(i), true)) {
+
+            return;
+        }
+    }
+
+    send_frame(lock, output, false);
+}
+
+bool RouterSocket::receive_frames(
+    const Lock& lock,
+    std::vector<OTZMQMessage>& frames)
+{
+    OT_ASSERT(verify_lock(lock))
+
+    int more{0};
+    std::size_t size{sizeof(more)};
+    zmq_getsockopt(socket_, ZMQ_RCVMORE, &more, &size);
+
+    while (1 == more) {
+        frames.emplace_back(Message::Factory());
+        Message& frame = frames.back();
+
+        if (-1 == zmq_msg_recv(frame, socket_, 0)) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Receive error: " << zmq_strerror(zmq_errno())
+                  << std::endl;
+
+            return false;
+        }
+
+        size = sizeof(more);
+        zmq_getsockopt(socket_, ZMQ_RCVMORE, &more, &size);
+    }
+
+    return true;
+}
+
+bool RouterSocket::send_frame(const Lock& lock, Message& frame, const bool more)
+{
+    OT_ASSERT(verify_lock(lock))
+
+    const auto sent =
+        (-1 != zmq_msg_send(frame, socket_, (more) ? ZMQ_SNDMORE : 0));
+
+    if (false == sent) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Send error:\n"
+              << zmq_strerror(zmq_errno()) << std::endl;
+    }
+
+    return sent;
+}
+
+bool RouterSocket::SetCurve(const OTPassword& key) const
+{
+    return set_curve(key);
+}
+
+bool RouterSocket::Start(const std::string& endpoint) const
+{
+    Lock lock(lock_);
+
+    return bind(lock, endpoint);
+}
+
+RouterSocket::~RouterSocket() {}
+}  // namespace opentxs::network::zeromq::implementation
@@ -0,0 +1,88 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#ifndef OPENTXS_NETWORK_ZEROMQ_IMPLEMENTATION_ROUTERSOCKET_HPP
+#define OPENTXS_NETWORK_ZEROMQ_IMPLEMENTATION_ROUTERSOCKET_HPP
+
+#include "opentxs/Forward.hpp"
+
+#include "opentxs/network/zeromq/RouterSocket.hpp"
+
+#include "CurveServer.hpp"
+#include "Receiver.hpp"
+#include "Socket.hpp"
+
+#include <vector>
+
+namespace opentxs::network::zeromq::implementation
+{
+class RouterSocket : virtual public zeromq::RouterSocket,
+                     public Socket,
+                     CurveServer,
+                     Receiver
+{
+public:
+    bool SetCurve(const OTPassword& key) const override;
+    bool Start(const std::string& endpoint) const override;
+
+    ~RouterSocket();
+
+private:
+    friend opentxs::network::zeromq::RouterSocket;
+    typedef Socket ot_super;
+
+    const ReplyCallback& callback_;
+
+    RouterSocket* clone() const override;
+    bool have_callback() const override;
+    bool receive_frames(const Lock& lock, std::vector<OTZMQMessage>& frames);
+    bool send_frame(const Lock& lock, Message& frame, const bool more);
+
+    void process_incoming(const Lock& lock, Message& message) override;
+
+    RouterSocket(
+        const zeromq::Context& context,
+        const ReplyCallback& callback);
+    RouterSocket() = delete;
+    RouterSocket(const RouterSocket&) = delete;
+    RouterSocket(RouterSocket&&) = delete;
+    RouterSocket& operator=(const RouterSocket&) = delete;
+    RouterSocket& operator=(RouterSocket&&) = delete;
+};
+}  // namespace opentxs::network::zeromq::implementation
+#endif  // OPENTXS_NETWORK_ZEROMQ_IMPLEMENTATION_ROUTERSOCKET_HPP
@@ -70,8 +70,9 @@ SubscribeSocket::SubscribeSocket(
     , CurveClient(lock_, socket_)
     , Receiver(lock_, socket_, true)
     , callback_(callback)
+    , subscribe_all_(true)
 {
-    // subscribe to all messages until filtering is implemented
+    // subscribe to all messages until a topic filter is requested
     const auto set = zmq_setsockopt(socket_, ZMQ_SUBSCRIBE, "", 0);
 
     OT_ASSERT(0 == set);
@@ -110,5 +111,35 @@ bool SubscribeSocket::Start(const std::string& endpoint) const
     return start_client(lock, endpoint);
 }
 
+bool SubscribeSocket::Subscribe(const std::string& topic) const
+{
+    Lock lock(lock_);
+
+    if (subscribe_all_) {
+        const auto removed = zmq_setsockopt(socket_, ZMQ_UNSUBSCRIBE, "", 0);
+
+        if (0 != removed) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed to remove default subscription." << std::endl;
+
+            return false;
+        }
+
+        subscribe_all_ = false;
+    }
+
+    const auto set =
+        zmq_setsockopt(socket_, ZMQ_SUBSCRIBE, topic.data(), topic.size());
+
+    if (0 != set) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to subscribe to topic."
+              << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
 SubscribeSocket::~SubscribeSocket() {}
 }  // namespace opentxs::network::zeromq::implementation
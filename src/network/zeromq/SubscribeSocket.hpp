@@ -58,6 +58,7 @@ public:
     bool SetCurve(const ServerContract& contract) const override;
     bool SetSocksProxy(const std::string& proxy) const override;
     bool Start(const std::string& endpoint) const override;
+    bool Subscribe(const std::string& topic) const override;
 
     virtual ~SubscribeSocket();
 
@@ -72,6 +73,8 @@ private:
     friend opentxs::network::zeromq::SubscribeSocket;
     typedef Socket ot_super;
 
+    mutable bool subscribe_all_;
+
     SubscribeSocket* clone() const override;
     bool have_callback() const override;
 
@@ -0,0 +1,597 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/server/BoxCache.hpp"
+
+#include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/OTStorage.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/server/Metrics.hpp"
+
+#include <algorithm>
+#include <memory>
+
+#define BOX_CACHE_JOURNAL_FILE "boxcache.journal"
+#define BOX_CACHE_JOURNAL_FOLDER "."
+#define BOX_CACHE_REPORT_FLUSHES 1000
+
+#define OT_METHOD "opentxs::server::BoxCache::"
+
+namespace opentxs::server
+{
+BoxCache::Batch::Batch(const BoxCache& cache)
+    : cache_(cache)
+{
+    cache_.begin_batch();
+}
+
+BoxCache::Batch::~Batch() { cache_.end_batch(); }
+
+BoxCache::BoxCache(const std::size_t capacity)
+    : capacity_(capacity)
+    , lock_()
+    , entries_()
+    , dirty_()
+    , lru_()
+    , verified_()
+    , stats_()
+    , journal_(false)
+    , batch_()
+    , deferred_()
+{
+}
+
+bool BoxCache::Batching() const
+{
+    Lock lock(lock_);
+
+    return std::this_thread::get_id() == batch_;
+}
+
+void BoxCache::begin_batch() const
+{
+    Lock lock(lock_);
+
+    OT_ASSERT(std::thread::id() == batch_)
+
+    batch_ = std::this_thread::get_id();
+}
+
+bool BoxCache::Commit() const
+{
+    Lock lock(lock_);
+
+    if (false == prepare(lock)) {
+
+        return false;
+    }
+
+    return flush(lock);
+}
+
+void BoxCache::Defer(
+    const std::string& folder,
+    const std::string& one,
+    const std::string& two,
+    const std::function<bool()>& sign) const
+{
+    Lock lock(lock_);
+
+    OT_ASSERT(std::this_thread::get_id() == batch_)
+
+    deferred_[key(folder, one, two)] = sign;
+}
+
+void BoxCache::end_batch() const
+{
+    Lock lock(lock_);
+    std::map<std::string, std::function<bool()>> deferred{};
+    deferred.swap(deferred_);
+    batch_ = std::thread::id();
+    lock.unlock();
+
+    // Each function stores the signed box, so the lock must not be held
+    for (auto it = deferred.begin(); it != deferred.end();) {
+        if (it->second()) {
+            it = deferred.erase(it);
+        } else {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to sign "
+                  << it->first << std::endl;
+            ++it;
+        }
+    }
+
+    if (deferred.empty()) {
+
+        return;
+    }
+
+    // Unsigned contents must never reach storage, so failures stay pending
+    // and are retried when the next batch closes
+    lock.lock();
+
+    for (auto& it : deferred) {
+        deferred_.emplace(it.first, std::move(it.second));
+    }
+}
+
+void BoxCache::evict(const Lock& lock) const
+{
+    OT_ASSERT(lock.owns_lock())
+
+    auto it = lru_.begin();
+
+    while ((entries_.size() > capacity_) && (lru_.end() != it)) {
+        auto entry = entries_.find(*it);
+
+        OT_ASSERT(entries_.end() != entry)
+
+        // Dirty entries are never evicted before they are flushed
+        if (entry->second.dirty_) {
+            ++it;
+
+            continue;
+        }
+
+        verified_.erase(entry->first);
+        entries_.erase(entry);
+        it = lru_.erase(it);
+    }
+}
+
+bool BoxCache::Flush() const
+{
+    Lock lock(lock_);
+
+    return flush(lock);
+}
+
+bool BoxCache::flush(const Lock& lock) const
+{
+    OT_ASSERT(lock.owns_lock())
+
+    Metrics::Timer timer(Metrics::Phase::BoxIO);
+    const auto start = std::chrono::steady_clock::now();
+    bool output{true};
+    std::size_t written{0};
+
+    for (auto id = dirty_.begin(); id != dirty_.end();) {
+        if (0 < deferred_.count(*id)) {
+            ++id;
+
+            continue;
+        }
+
+        auto it = entries_.find(*id);
+
+        OT_ASSERT(entries_.end() != it)
+
+        auto& entry = it->second;
+        const auto saved = OTDB::StorePlainString(
+            entry.contents_,
+            entry.folder_,
+            entry.one_,
+            entry.two_,
+            entry.three_);
+
+        if (saved) {
+            entry.dirty_ = false;
+            id = dirty_.erase(id);
+            ++written;
+        } else {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to write " << *id
+                  << std::endl;
+            ++stats_.flush_errors_;
+            output = false;
+            ++id;
+        }
+    }
+
+    // The journal only ever describes the latest contents, so it may be
+    // removed as soon as everything it holds has been written
+    if (journal_ && dirty_.empty()) {
+        const auto erased = OTDB::EraseValueByKey(
+            BOX_CACHE_JOURNAL_FOLDER, BOX_CACHE_JOURNAL_FILE);
+        journal_ = (false == erased);
+    }
+
+    if (0 == written) {
+
+        return output;
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    ++stats_.flushes_;
+    stats_.last_flush_ = elapsed;
+    stats_.total_flush_ += elapsed;
+    stats_.max_flush_ = std::max(stats_.max_flush_, elapsed);
+
+    if (0 == (stats_.flushes_ % BOX_CACHE_REPORT_FLUSHES)) {
+        otWarn << OT_METHOD << __FUNCTION__ << ": hits " << stats_.hits_
+               << ", misses " << stats_.misses_ << ", writes "
+               << stats_.writes_ << ", coalesced " << stats_.coalesced_writes_
+               << ", verifications skipped " << stats_.verifications_skipped_
+               << ", flushes " << stats_.flushes_ << ", mean flush "
+               << (stats_.total_flush_.count() / stats_.flushes_)
+               << " us, max flush " << stats_.max_flush_.count() << " us"
+               << std::endl;
+    }
+
+    evict(lock);
+
+    return output;
+}
+
+OTIdentifier BoxCache::hash(const std::string& contents)
+{
+    auto output = Identifier::Factory();
+    output->CalculateDigest(String(contents));
+
+    return output;
+}
+
+std::string BoxCache::key(
+    const std::string& folder,
+    const std::string& one,
+    const std::string& two,
+    const std::string& three)
+{
+    return folder + '/' + one + '/' + two + '/' + three;
+}
+
+BoxCache::Entry* BoxCache::load(
+    const Lock& lock,
+    const std::string& folder,
+    const std::string& one,
+    const std::string& two,
+    const std::string& three) const
+{
+    OT_ASSERT(lock.owns_lock())
+
+    const auto id = key(folder, one, two, three);
+    auto it = entries_.find(id);
+
+    if (entries_.end() != it) {
+        ++stats_.hits_;
+        touch(lock, it->second);
+
+        return &it->second;
+    }
+
+    ++stats_.misses_;
+    Metrics::Timer timer(Metrics::Phase::BoxIO);
+
+    if (false == OTDB::Exists(folder, one, two, three)) {
+
+        return nullptr;
+    }
+
+    auto contents = OTDB::QueryPlainString(folder, one, two, three);
+
+    if (contents.empty()) {
+
+        return nullptr;
+    }
+
+    evict(lock);
+    auto& entry = entries_[id];
+    entry.folder_ = folder;
+    entry.one_ = one;
+    entry.two_ = two;
+    entry.three_ = three;
+    entry.hash_ = hash(contents);
+    entry.contents_.swap(contents);
+    entry.dirty_ = false;
+    entry.position_ = lru_.insert(lru_.end(), id);
+
+    return &entry;
+}
+
+bool BoxCache::Prepare() const
+{
+    Lock lock(lock_);
+
+    return prepare(lock);
+}
+
+bool BoxCache::prepare(const Lock& lock) const
+{
+    OT_ASSERT(lock.owns_lock())
+
+    if (dirty_.empty()) {
+
+        return true;
+    }
+
+    std::unique_ptr<OTDB::Storable> pStorable(
+        OTDB::CreateObject(OTDB::STORED_OBJ_STRING_MAP));
+    auto pMap = dynamic_cast<OTDB::StringMap*>(pStorable.get());
+
+    OT_ASSERT(nullptr != pMap);
+
+    auto& map = pMap->the_map;
+    std::size_t index{0};
+
+    for (const auto& id : dirty_) {
+        if (0 < deferred_.count(id)) {
+
+            continue;
+        }
+
+        const auto& entry = entries_.at(id);
+        const auto suffix = "." + std::to_string(index++);
+        map["folder" + suffix] = entry.folder_;
+        map["one" + suffix] = entry.one_;
+        map["two" + suffix] = entry.two_;
+        map["three" + suffix] = entry.three_;
+        map["contents" + suffix] = entry.contents_;
+    }
+
+    map["count"] = std::to_string(index);
+    const auto encoded = OTDB::EncodeObject(*pMap);
+
+    // The digest detects a journal which was only partly written, in which
+    // case none of its entries had been applied yet
+    const String digest(hash(encoded));
+    journal_ = OTDB::StorePlainString(
+        std::string(digest.Get()) + "\n" + encoded,
+        BOX_CACHE_JOURNAL_FOLDER,
+        BOX_CACHE_JOURNAL_FILE);
+
+    if (false == journal_) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to write journal"
+              << std::endl;
+        ++stats_.flush_errors_;
+    }
+
+    return journal_;
+}
+
+std::string BoxCache::Query(
+    const std::string& folder,
+    const std::string& one,
+    const std::string& two,
+    const std::string& three) const
+{
+    Lock lock(lock_);
+    const auto entry = load(lock, folder, one, two, three);
+
+    if (nullptr == entry) {
+
+        return {};
+    }
+
+    return entry->contents_;
+}
+
+bool BoxCache::Recover() const
+{
+    Lock lock(lock_);
+
+    if (false ==
+        OTDB::Exists(BOX_CACHE_JOURNAL_FOLDER, BOX_CACHE_JOURNAL_FILE)) {
+
+        return true;
+    }
+
+    const auto journal = OTDB::QueryPlainString(
+        BOX_CACHE_JOURNAL_FOLDER, BOX_CACHE_JOURNAL_FILE);
+    const auto split = journal.find('\n');
+    const auto encoded = (std::string::npos == split)
+                             ? std::string{}
+                             : journal.substr(split + 1);
+    const bool complete =
+        (std::string::npos != split) &&
+        (journal.substr(0, split) == String(hash(encoded)).Get());
+    std::unique_ptr<OTDB::Storable> pStorable{};
+
+    if (complete) {
+        pStorable.reset(
+            OTDB::DecodeObject(OTDB::STORED_OBJ_STRING_MAP, encoded));
+    }
+
+    auto pMap = dynamic_cast<OTDB::StringMap*>(pStorable.get());
+
+    if (nullptr == pMap) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Discarding incomplete journal" << std::endl;
+
+        return OTDB::EraseValueByKey(
+            BOX_CACHE_JOURNAL_FOLDER, BOX_CACHE_JOURNAL_FILE);
+    }
+
+    auto& map = pMap->the_map;
+    std::size_t count{0};
+
+    try {
+        count = std::stoull(map["count"]);
+    } catch (...) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Invalid journal" << std::endl;
+    }
+
+    bool output{true};
+
+    for (std::size_t index = 0; index < count; ++index) {
+        const auto suffix = "." + std::to_string(index);
+        const auto saved = OTDB::StorePlainString(
+            map["contents" + suffix],
+            map["folder" + suffix],
+            map["one" + suffix],
+            map["two" + suffix],
+            map["three" + suffix]);
+
+        if (false == saved) {
+            otErr << OT_METHOD << __FUNCTION__ << ": Failed to write "
+                  << key(map["folder" + suffix],
+                         map["one" + suffix],
+                         map["two" + suffix],
+                         map["three" + suffix])
+                  << std::endl;
+            output = false;
+        }
+    }
+
+    otWarn << OT_METHOD << __FUNCTION__ << ": Applied " << count
+           << " journaled writes" << std::endl;
+
+    if (output) {
+        output = OTDB::EraseValueByKey(
+            BOX_CACHE_JOURNAL_FOLDER, BOX_CACHE_JOURNAL_FILE);
+    }
+
+    return output;
+}
+
+void BoxCache::SetVerified(
+    const std::string& folder,
+    const std::string& one,
+    const std::string& two) const
+{
+    Lock lock(lock_);
+    const auto entry = load(lock, folder, one, two);
+
+    if (nullptr == entry) {
+
+        return;
+    }
+
+    verified_[key(folder, one, two)] = entry->hash_;
+}
+
+BoxCache::Statistics BoxCache::Stats() const
+{
+    Lock lock(lock_);
+
+    return stats_;
+}
+
+bool BoxCache::Store(
+    const std::string& contents,
+    const std::string& folder,
+    const std::string& one,
+    const std::string& two,
+    const std::string& three) const
+{
+    Lock lock(lock_);
+    const auto id = key(folder, one, two, three);
+    auto it = entries_.find(id);
+    ++stats_.writes_;
+    // Contents which are still unsigned are deferred again by the caller
+    deferred_.erase(id);
+
+    if (entries_.end() == it) {
+        Metrics::Timer timer(Metrics::Phase::BoxIO);
+
+        // New files are written through so that they exist in storage
+        if (false == OTDB::Exists(folder, one, two, three)) {
+
+            return OTDB::StorePlainString(contents, folder, one, two, three);
+        }
+
+        auto& entry = entries_[id];
+        entry.folder_ = folder;
+        entry.one_ = one;
+        entry.two_ = two;
+        entry.three_ = three;
+        entry.position_ = lru_.insert(lru_.end(), id);
+        it = entries_.find(id);
+    } else if (it->second.dirty_) {
+        ++stats_.coalesced_writes_;
+    }
+
+    auto& entry = it->second;
+    entry.contents_ = contents;
+    entry.hash_ = hash(contents);
+    entry.dirty_ = true;
+    dirty_.insert(id);
+
+    if (three.empty()) {
+        verified_[id] = entry.hash_;
+    }
+
+    touch(lock, entry);
+
+    return true;
+}
+
+void BoxCache::touch(const Lock& lock, Entry& entry) const
+{
+    OT_ASSERT(lock.owns_lock())
+
+    lru_.splice(lru_.end(), lru_, entry.position_);
+}
+
+bool BoxCache::Verified(
+    const std::string& folder,
+    const std::string& one,
+    const std::string& two) const
+{
+    Lock lock(lock_);
+    const auto entry = load(lock, folder, one, two);
+
+    if (nullptr == entry) {
+
+        return false;
+    }
+
+    const auto it = verified_.find(key(folder, one, two));
+
+    if (verified_.end() == it) {
+
+        return false;
+    }
+
+    const bool output = (it->second == entry->hash_);
+
+    if (output) {
+        ++stats_.verifications_skipped_;
+    }
+
+    return output;
+}
+
+BoxCache::~BoxCache()
+{
+    Lock lock(lock_);
+    flush(lock);
+}
+}  // namespace opentxs::server
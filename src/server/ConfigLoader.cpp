@@ -193,6 +193,42 @@ bool ConfigLoader::load(
             static_cast<int32_t>(lValue));
     }
 
+    // METRICS
+
+    {
+        const char* szComment = ";; METRICS\n";
+
+        bool bSectionExist = false;
+        config.CheckSetSection("metrics", szComment, bSectionExist);
+    }
+
+    {
+        const char* szComment =
+            "; endpoint is where a report of request latencies is served.\n"
+            "; Send any message to get the report, or \"reset\" to get it "
+            "and then clear it.\n"
+            "; Use a local endpoint such as ipc:///tmp/notary-metrics or\n"
+            "; tcp://127.0.0.1:7086. Leave empty to disable.\n"
+            "; Other endpoints are refused unless allow_remote is true, in "
+            "which case\n"
+            "; \"reset\" is ignored.\n";
+
+        bool bIsNewKey = false;
+        std::string strValue{};
+        config.CheckSet_str(
+            "metrics",
+            "endpoint",
+            String(ServerSettings::GetMetricsEndpoint()),
+            strValue,
+            bIsNewKey,
+            szComment);
+        ServerSettings::SetMetricsEndpoint(strValue);
+        bool bValue = false;
+        config.CheckSet_bool(
+            "metrics", "allow_remote", false, bValue, bIsNewKey);
+        ServerSettings::SetMetricsAllowRemote(bValue);
+    }
+
     // PERMISSIONS
 
     {
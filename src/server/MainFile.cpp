@@ -557,27 +557,16 @@ bool MainFile::LoadServerUserAndContract()
     //      m_nymServer.SaveSignedNymfile(m_nymServer); // Uncomment this if
     // you want to create the file. NORMALLY LEAVE IT OUT!!!! DANGEROUS!!!
 
-    Log::vOutput(
-        0,
-        "%s: Loaded server certificate and keys.\nNext, loading Cron...\n",
-        szFunc);
-    // Load Cron (now that we have the server Nym.
-    // (I WAS loading this erroneously in Server.Init(), before
-    // the Nym had actually been loaded from disk. That didn't work.)
-    //
+    Log::vOutput(0, "%s: Loaded server certificate and keys.\n", szFunc);
     const Identifier NOTARY_ID(server_.m_strNotaryID);
 
     // Make sure the Cron object has a pointer to the server's Nym.
-    // (For signing stuff...)
+    // (For signing stuff...) Cron itself is loaded in the background by
+    // Server::ActivateCron, once the server is accepting requests.
     //
     server_.m_Cron.SetNotaryID(NOTARY_ID);
     server_.m_Cron.SetServerNym(&serverNym);
 
-    if (!server_.m_Cron.LoadCron())
-        Log::vError(
-            "%s: Failed loading Cron file. (Did you just create "
-            "this server?)\n",
-            szFunc);
     Log::vOutput(0, "%s: Loading the server contract...\n", szFunc);
 
     auto pContract = wallet_.Server(NOTARY_ID);
@@ -40,6 +40,7 @@
 
 #include "opentxs/server/MessageProcessor.hpp"
 
+#include "opentxs/api/client/Wallet.hpp"
 #include "opentxs/api/network/ZMQ.hpp"
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
 #include "opentxs/core/util/Assert.hpp"
@@ -52,12 +53,15 @@
 #include "opentxs/network/zeromq/Message.hpp"
 #include "opentxs/network/zeromq/ReplyCallback.hpp"
 #include "opentxs/network/zeromq/ReplySocket.hpp"
+#include "opentxs/network/zeromq/RouterSocket.hpp"
 #include "opentxs/server/Server.hpp"
+#include "opentxs/server/ServerSettings.hpp"
 #include "opentxs/server/UserCommandProcessor.hpp"
 
 #include <stddef.h>
 #include <sys/types.h>
 #include <ostream>
+#include <sstream>
 #include <string>
 
 #define OT_METHOD "opentxs::MessageProcessor::"
@@ -76,7 +80,14 @@ MessageProcessor::MessageProcessor(
           [this](const network::zeromq::Message& incoming) -> OTZMQMessage {
               return this->processSocket(incoming);
           }))
-    , reply_socket_(context.ReplySocket(reply_socket_callback_.get()))
+    , router_socket_(context.RouterSocket(reply_socket_callback_.get()))
+    , metrics_()
+    , metrics_callback_(network::zeromq::ReplyCallback::Factory(
+          [this](const network::zeromq::Message& incoming) -> OTZMQMessage {
+              return this->processMetrics(incoming);
+          }))
+    , metrics_socket_(context.ReplySocket(metrics_callback_.get()))
+    , metrics_reset_(false)
     , thread_(nullptr)
 {
 }
@@ -95,14 +106,49 @@ void MessageProcessor::init(const int port, const OTPassword& privkey)
         OT_FAIL;
     }
 
-    const auto set = reply_socket_->SetCurve(privkey);
+    const auto set = router_socket_->SetCurve(privkey);
 
     OT_ASSERT(set);
 
     const auto endpoint = std::string("tcp://*:") + std::to_string(port);
-    const auto bound = reply_socket_->Start(endpoint);
+    const auto bound = router_socket_->Start(endpoint);
 
     OT_ASSERT(bound);
+
+    const auto& metrics = ServerSettings::GetMetricsEndpoint();
+
+    if (metrics.empty()) {
+
+        return;
+    }
+
+    const bool local = is_local(metrics);
+    const bool allowed = local || ServerSettings::GetMetricsAllowRemote();
+
+    if (false == allowed) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Refusing to bind metrics "
+              << "socket to non-local endpoint " << metrics << std::endl;
+
+        return;
+    }
+
+    metrics_reset_ = local;
+
+    if (false == metrics_socket_->Start(metrics)) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to bind metrics socket to " << metrics << std::endl;
+    }
+}
+
+bool MessageProcessor::is_local(const std::string& endpoint)
+{
+    const auto starts = [&endpoint](const std::string& prefix) -> bool {
+        return 0 == endpoint.compare(0, prefix.size(), prefix);
+    };
+
+    return starts("ipc://") || starts("inproc://") ||
+           starts("tcp://127.") || starts("tcp://localhost:") ||
+           starts("tcp://[::1]:");
 }
 
 void MessageProcessor::run()
@@ -115,19 +161,56 @@ void MessageProcessor::run()
             // ProcessCron and processSocket must not run simultaneously
             Lock lock(lock_);
             server_.ProcessCron();
+            server_.cache_.Flush();
         }
 
         Log::Sleep(std::chrono::milliseconds(50));
     }
 }
 
+OTZMQMessage MessageProcessor::processMetrics(
+    const network::zeromq::Message& incoming)
+{
+    const auto cache = server_.cache_.Stats();
+    const auto wallet = server_.wallet_.CacheStats();
+    std::stringstream report{};
+    report << metrics_.Report() << "box_cache hits=" << cache.hits_
+           << " misses=" << cache.misses_ << " writes=" << cache.writes_
+           << " coalesced_writes=" << cache.coalesced_writes_
+           << " verifications_skipped=" << cache.verifications_skipped_
+           << " flushes=" << cache.flushes_
+           << " flush_errors=" << cache.flush_errors_
+           << " max_flush_us=" << cache.max_flush_.count() << "\n"
+           << "wallet_cache nyms=" << wallet.nyms_
+           << " servers=" << wallet.servers_ << " units=" << wallet.units_
+           << " contexts=" << wallet.contexts_
+           << " issuers=" << wallet.issuers_ << " locks=" << wallet.locks_
+           << " bytes=" << wallet.bytes_ << " evictions=" << wallet.evictions_
+           << "\n"
+           << server_.StartupReport();
+
+    if (metrics_reset_ && ("reset" == std::string(incoming))) {
+        metrics_.Reset();
+    }
+
+    return network::zeromq::Message::Factory(report.str());
+}
+
 OTZMQMessage MessageProcessor::processSocket(
     const network::zeromq::Message& incoming)
 {
     // ProcessCron and processSocket must not run simultaneously
     Lock lock(lock_);
+    Metrics::Request metrics(metrics_);
     std::string reply{};
-    bool error = processMessage(std::string(incoming), reply);
+    bool error = processMessage(std::string(incoming), reply, metrics);
+    // Nothing may be acknowledged to the client before it reaches storage
+    if (false == server_.cache_.Flush()) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to persist changes. Withholding reply."
+              << std::endl;
+        error = true;
+    }
 
     if (error) {
         reply = "";
@@ -138,19 +221,24 @@ OTZMQMessage MessageProcessor::processSocket(
 
 bool MessageProcessor::processMessage(
     const std::string& messageString,
-    std::string& reply)
+    std::string& reply,
+    Metrics::Request& metrics)
 {
     if (messageString.size() < 1) {
 
         return true;
     }
 
-    OTASCIIArmor armored;
-    armored.MemSet(messageString.data(), messageString.size());
     String serialized;
-    armored.GetString(serialized);
     Message request;
 
+    {
+        Metrics::Timer timer(Metrics::Phase::Decode);
+        OTASCIIArmor armored;
+        armored.MemSet(messageString.data(), messageString.size());
+        armored.GetString(serialized);
+    }
+
     if (false == serialized.Exists()) {
         otErr << OT_METHOD << __FUNCTION__ << ": Empty serialized request."
               << std::endl;
@@ -158,13 +246,19 @@ bool MessageProcessor::processMessage(
         return true;
     }
 
-    if (false == request.LoadContractFromString(serialized)) {
-        otErr << OT_METHOD << __FUNCTION__
-              << ": Failed to deserialized request." << std::endl;
+    {
+        Metrics::Timer timer(Metrics::Phase::Parse);
 
-        return true;
+        if (false == request.LoadContractFromString(serialized)) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed to deserialized request." << std::endl;
+
+            return true;
+        }
     }
 
+    metrics.SetType(Message::Type(request.m_strCommand.Get()));
+
     Message repy{};
     const bool processed =
         server_.userCommandProcessor_.ProcessUserCommand(request, repy);
@@ -180,6 +274,7 @@ bool MessageProcessor::processMessage(
                << request.m_strCommand << std::endl;
     }
 
+    Metrics::Timer timer(Metrics::Phase::Encode);
     String serializedReply(repy);
 
     if (false == serializedReply.Exists()) {
@@ -0,0 +1,336 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/server/Metrics.hpp"
+
+#include "opentxs/core/Message.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+// Largest power of two microseconds with its own buckets. Anything slower is
+// counted in the last bucket.
+#define METRICS_MAX_EXPONENT 39
+
+namespace opentxs::server
+{
+namespace
+{
+thread_local Metrics::Request* current_request_{nullptr};
+}  // namespace
+
+Metrics::Request::Request(Metrics& metrics)
+    : metrics_(metrics)
+    , parent_(current_request_)
+    , start_(std::chrono::steady_clock::now())
+    , type_(MessageType::badID)
+    , phases_()
+{
+    phases_.fill(std::chrono::nanoseconds(0));
+    current_request_ = this;
+}
+
+void Metrics::Request::SetType(const MessageType type) { type_ = type; }
+
+Metrics::Request::~Request()
+{
+    current_request_ = parent_;
+    phases_.at(static_cast<std::size_t>(Phase::Total)) =
+        std::chrono::steady_clock::now() - start_;
+    metrics_.record(*this);
+}
+
+Metrics::Timer::Timer(const Phase phase)
+    : request_(current_request_)
+    , phase_(phase)
+    , start_(
+          (nullptr == request_) ? std::chrono::steady_clock::time_point{}
+                                : std::chrono::steady_clock::now())
+{
+}
+
+Metrics::Timer::~Timer()
+{
+    if (nullptr == request_) {
+
+        return;
+    }
+
+    request_->phases_.at(static_cast<std::size_t>(phase_)) +=
+        std::chrono::steady_clock::now() - start_;
+}
+
+std::uint64_t Metrics::Histogram::Percentile(
+    const std::uint64_t count,
+    const double fraction) const
+{
+    const auto target = static_cast<std::uint64_t>(fraction * count);
+    std::uint64_t seen{0};
+
+    for (std::size_t i = 0; i < Buckets; ++i) {
+        seen += buckets_.at(i).load(std::memory_order_relaxed);
+
+        if (seen > target) {
+
+            return bucket_limit(i);
+        }
+    }
+
+    return max_.load(std::memory_order_relaxed);
+}
+
+void Metrics::Histogram::Record(const std::uint64_t microseconds)
+{
+    buckets_.at(bucket(microseconds)).fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    total_.fetch_add(microseconds, std::memory_order_relaxed);
+    auto max = max_.load(std::memory_order_relaxed);
+
+    while ((microseconds > max) &&
+           (false == max_.compare_exchange_weak(
+                         max, microseconds, std::memory_order_relaxed))) {
+    }
+}
+
+void Metrics::Histogram::Reset()
+{
+    for (auto& it : buckets_) {
+        it.store(0, std::memory_order_relaxed);
+    }
+
+    count_.store(0, std::memory_order_relaxed);
+    total_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+Metrics::Metrics()
+    : histograms_()
+{
+    for (auto& it : histograms_) {
+        it.store(nullptr);
+    }
+}
+
+std::size_t Metrics::bucket(const std::uint64_t microseconds)
+{
+    if (16 > microseconds) {
+
+        return static_cast<std::size_t>(microseconds);
+    }
+
+    std::size_t exponent{4};
+
+    while ((METRICS_MAX_EXPONENT > exponent) &&
+           (0 != (microseconds >> (exponent + 1)))) {
+        ++exponent;
+    }
+
+    const auto sub =
+        std::min<std::uint64_t>(7, (microseconds >> (exponent - 3)) - 8);
+
+    return static_cast<std::size_t>(16 + ((exponent - 4) * 8) + sub);
+}
+
+std::uint64_t Metrics::bucket_limit(const std::size_t bucket)
+{
+    if (16 > bucket) {
+
+        return bucket;
+    }
+
+    const auto exponent = 4 + ((bucket - 16) / 8);
+    const auto sub = (bucket - 16) % 8;
+    const std::uint64_t width = std::uint64_t(1) << (exponent - 3);
+
+    return ((8 + sub) * width) + width - 1;
+}
+
+Metrics::Histograms& Metrics::get(const MessageType type) const
+{
+    auto& slot = histograms_.at(static_cast<std::size_t>(type));
+    auto* output = slot.load(std::memory_order_acquire);
+
+    if (nullptr != output) {
+
+        return *output;
+    }
+
+    auto* created = new Histograms();
+
+    if (slot.compare_exchange_strong(
+            output, created, std::memory_order_acq_rel)) {
+
+        return *created;
+    }
+
+    // Another thread allocated the histograms first
+    delete created;
+
+    return *output;
+}
+
+std::string Metrics::phase_name(const Phase phase)
+{
+    switch (phase) {
+        case Phase::Decode: {
+
+            return "decode";
+        }
+        case Phase::Parse: {
+
+            return "parse";
+        }
+        case Phase::CheckNym: {
+
+            return "check_nym";
+        }
+        case Phase::LoadContext: {
+
+            return "load_context";
+        }
+        case Phase::Handler: {
+
+            return "handler";
+        }
+        case Phase::BoxIO: {
+
+            return "box_io";
+        }
+        case Phase::Sign: {
+
+            return "sign";
+        }
+        case Phase::Encode: {
+
+            return "encode";
+        }
+        case Phase::Total:
+        default: {
+
+            return "total";
+        }
+    }
+}
+
+void Metrics::record(const Request& request)
+{
+    auto& histograms = get(request.type_);
+
+    for (std::size_t i = 0; i < PhaseCount; ++i) {
+        const auto& elapsed = request.phases_.at(i);
+        const bool total = (static_cast<std::size_t>(Phase::Total) == i);
+
+        // Phases which did not run for this request are not recorded
+        if ((0 == elapsed.count()) && (false == total)) {
+
+            continue;
+        }
+
+        histograms.at(i).Record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+                .count()));
+    }
+}
+
+std::string Metrics::Report() const
+{
+    std::stringstream output{};
+
+    for (std::size_t type = 0; type < Types; ++type) {
+        const auto* histograms =
+            histograms_.at(type).load(std::memory_order_acquire);
+
+        if (nullptr == histograms) {
+
+            continue;
+        }
+
+        const auto name =
+            (0 == type) ? std::string("unknown")
+                        : Message::Command(static_cast<MessageType>(type));
+
+        for (std::size_t phase = 0; phase < PhaseCount; ++phase) {
+            const auto& histogram = histograms->at(phase);
+            const auto count =
+                histogram.count_.load(std::memory_order_relaxed);
+
+            if (0 == count) {
+
+                continue;
+            }
+
+            const auto total =
+                histogram.total_.load(std::memory_order_relaxed);
+            output << name << " " << phase_name(static_cast<Phase>(phase))
+                   << " count=" << count << " mean_us=" << (total / count)
+                   << " p50_us=" << histogram.Percentile(count, 0.5)
+                   << " p90_us=" << histogram.Percentile(count, 0.9)
+                   << " p99_us=" << histogram.Percentile(count, 0.99)
+                   << " max_us="
+                   << histogram.max_.load(std::memory_order_relaxed) << "\n";
+        }
+    }
+
+    return output.str();
+}
+
+void Metrics::Reset()
+{
+    for (auto& it : histograms_) {
+        auto* histograms = it.load(std::memory_order_acquire);
+
+        if (nullptr == histograms) {
+
+            continue;
+        }
+
+        for (auto& histogram : *histograms) {
+            histogram.Reset();
+        }
+    }
+}
+
+Metrics::~Metrics()
+{
+    for (auto& it : histograms_) {
+        delete it.exchange(nullptr);
+    }
+}
+}  // namespace opentxs::server
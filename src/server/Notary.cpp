@@ -62,6 +62,7 @@
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/util/Common.hpp"
 #include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/util/ParallelFor.hpp"
 #include "opentxs/core/Account.hpp"
 #include "opentxs/core/Cheque.hpp"
 #include "opentxs/core/Identifier.hpp"
@@ -75,7 +76,7 @@
 #include "opentxs/ext/OTPayment.hpp"
 #include "opentxs/server/Macros.hpp"
 #include "opentxs/server/Server.hpp"
-#include "opentxs/server/PayDividendVisitor.hpp"
+#include "opentxs/server/PayoutEngine.hpp"
 #include "opentxs/server/ServerSettings.hpp"
 #include "opentxs/server/Transactor.hpp"
 
@@ -83,10 +84,16 @@
 #include <cstdint>
 #include <deque>
 #include <list>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
+
+// processInbox requests with fewer receipts than this are parsed on the
+// calling thread
+#define OT_PROCESS_INBOX_PARALLEL_ITEMS 32
 
 #define OT_METHOD "opentxs::Notary::"
 
@@ -105,6 +112,9 @@ Notary::Notary(
     : server_(server)
     , mint_(mint)
     , wallet_(wallet)
+#if OT_CASH
+    , spent_tokens_()
+#endif  // OT_CASH
 {
 }
 
@@ -1166,6 +1176,19 @@ void Notary::NotarizeWithdrawal(
                     Item::acknowledgement);  // the transaction agreement was
                                              // successful.
 
+                // The blind signatures for every token in the purse are
+                // calculated in one batch per mint after all the tokens have
+                // been checked. The account is then debited token by token.
+                struct PendingToken
+                {
+                    Token* token_{nullptr};
+                    std::shared_ptr<Mint> mint_{nullptr};
+                    Account* reserve_{nullptr};
+                    String signature_{};
+                    bool signed_{false};
+                };
+                std::vector<PendingToken> pending{};
+
                 // Pull the token(s) out of the purse that was received from the
                 // client.
                 while ((pToken = thePurse.Pop(server_.m_nymServer)) !=
@@ -1213,127 +1236,143 @@ void Notary::NotarizeWithdrawal(
                             strInstrumentDefinitionID.Get());
                         bSuccess = false;
                         break;  // Once there's a failure, we ditch the loop.
+                    } else if (
+                        pToken->GetInstrumentDefinitionID() !=
+                        INSTRUMENT_DEFINITION_ID) {
+                        const String str1(pToken->GetInstrumentDefinitionID()),
+                            str2(INSTRUMENT_DEFINITION_ID);
+                        bSuccess = false;
+                        Log::vError(
+                            "%s: ERROR while signing token: "
+                            "Expected instrument definition id "
+                            "%s but found %s "
+                            "instead. (Failure.)\n",
+                            __FUNCTION__,
+                            str2.Get(),
+                            str1.Get());
+                        break;
                     } else {
-                        String theStringReturnVal;
+                        PendingToken item{};
+                        item.token_ = pToken;
+                        item.mint_ = pMint;
+                        item.reserve_ = pMintCashReserveAcct;
+                        pending.emplace_back(std::move(item));
+                        bSuccess = true;
+                    }
+                }  // While success popping token out of the purse...
 
-                        if (pToken->GetInstrumentDefinitionID() !=
-                            INSTRUMENT_DEFINITION_ID) {
-                            const String str1(
-                                pToken->GetInstrumentDefinitionID()),
-                                str2(INSTRUMENT_DEFINITION_ID);
-                            bSuccess = false;
-                            Log::vError(
-                                "%s: ERROR while signing token: "
-                                "Expected instrument definition id "
-                                "%s but found %s "
-                                "instead. (Failure.)\n",
-                                __FUNCTION__,
-                                str2.Get(),
-                                str1.Get());
-                            break;
+                if (bSuccess) {
+                    std::map<Mint*, std::vector<PendingToken*>> batches{};
+
+                    for (auto& item : pending) {
+                        batches[item.mint_.get()].push_back(&item);
+                    }
+
+                    for (auto& [mint, items] : batches) {
+                        std::vector<Token*> tokens{};
+                        std::vector<String> signatures{};
+
+                        for (const auto* item : items) {
+                            tokens.push_back(item->token_);
                         }
+
                         // TokenIndex is for cash systems that send multiple
-                        // proto-tokens, so the Mint
-                        // knows which proto-token has been chosen for signing.
-                        // But Lucre only uses a single proto-token, so the
-                        // token index is always 0.
-                        //
-                        else if (!(pMint->SignToken(
-                                     server_.m_nymServer,
-                                     *pToken,
-                                     theStringReturnVal,
-                                     0)))  // nTokenIndex = 0 //
-                        // ******************************************
-                        {
+                        // proto-tokens, so the Mint knows which proto-token
+                        // has been chosen for signing. But Lucre only uses a
+                        // single proto-token, so the token index is always 0.
+                        const auto results = mint->SignTokens(
+                            server_.m_nymServer, tokens, signatures, 0);
+
+                        for (std::size_t i = 0; i < items.size(); ++i) {
+                            items[i]->signed_ = results[i];
+                            items[i]->signature_ = signatures[i];
+                        }
+                    }
+                }
+
+                for (auto& item : pending) {
+                    if (false == bSuccess) {
+                        break;
+                    }
+
+                    pToken = item.token_;
+                    pMintCashReserveAcct = item.reserve_;
+
+                    if (false == item.signed_) {
+                        bSuccess = false;
+                        Log::vError(
+                            "%s: Failure in call: "
+                            "pMint->SignTokens(server_.m_nymServer, "
+                            "tokens, signatures, 0). "
+                            "(Returning.)\n",
+                            __FUNCTION__);
+                        break;
+                    }
+
+                    OTASCIIArmor theArmorReturnVal(item.signature_);
+
+                    pToken->ReleaseSignatures();  // this releases the normal
+                                                  // signatures, not the Lucre
+                                                  // signed token from the Mint,
+                                                  // above.
+
+                    pToken->SetSignature(theArmorReturnVal, 0);  // nTokenIndex
+                                                                 // = 0
+
+                    // Sign and Save the token
+                    pToken->SignContract(server_.m_nymServer);
+                    pToken->SaveContract();
+
+                    // Now the token is in signedToken mode, and the other
+                    // prototokens have been released.
+
+                    // Deduct the amount from the account...
+                    if (theAccount.Debit(pToken->GetDenomination())) {
+                        // todo need to be able to "roll back" if anything
+                        // inside this block fails.
+                        bSuccess = true;
+
+                        // Credit the server's cash account for this instrument
+                        // definition in the same amount that was debited. When
+                        // the token is deposited again, Debit that same server
+                        // cash account and deposit in the depositor's acct.
+                        // Why, you might ask? Because if the token expires, the
+                        // money will stay in the bank's cash account instead of
+                        // being lost (and screwing up the overall issuer
+                        // balance, with the issued money disappearing
+                        // forever.) The bank knows that once the series
+                        // expires, whatever funds are left in that cash account
+                        // are for the bank to keep. They can be transferred to
+                        // another account and kept, instead of being lost.
+                        if (!pMintCashReserveAcct->Credit(
+                                pToken->GetDenomination())) {
+                            Log::Error("Error crediting mint cash "
+                                       "reserve account...\n");
+
+                            // Reverse the account debit (even though we're not
+                            // going to save it anyway.)
+                            if (false ==
+                                theAccount.Credit(pToken->GetDenomination()))
+                                Log::vError(
+                                    "%s: Failed crediting "
+                                    "user account back.\n",
+                                    __FUNCTION__);
+
                             bSuccess = false;
-                            Log::vError(
-                                "%s: Failure in call: "
-                                "pMint->SignToken(server_.m_nymServer, "
-                                "*pToken, theStringReturnVal, 0). "
-                                "(Returning.)\n",
-                                __FUNCTION__);
                             break;
-                        } else {
-                            OTASCIIArmor theArmorReturnVal(theStringReturnVal);
-
-                            pToken->ReleaseSignatures();  // this releases the
-                                                          // normal signatures,
-                            // not the Lucre signed
-                            // token from the Mint,
-                            // above.
-
-                            pToken->SetSignature(
-                                theArmorReturnVal,
-                                0);  // nTokenIndex = 0
-
-                            // Sign and Save the token
-                            pToken->SignContract(server_.m_nymServer);
-                            pToken->SaveContract();
-
-                            // Now the token is in signedToken mode, and the
-                            // other prototokens have been released.
-
-                            // Deduct the amount from the account...
-                            if (theAccount.Debit(
-                                    pToken->GetDenomination())) {  // todo need
-                                                                   // to be able
-                                                                   // to "roll
-                                                                   // back" if
-                                                                   // anything
-                                // inside this
-                                // block
-                                // fails.
-                                bSuccess = true;
-
-                                // Credit the server's cash account for this
-                                // instrument definition in the same
-                                // amount that was debited. When the token is
-                                // deposited again, Debit that same
-                                // server cash account and deposit in the
-                                // depositor's acct.
-                                // Why, you might ask? Because if the token
-                                // expires, the money will stay in
-                                // the bank's cash account instead of being lost
-                                // (and screwing up the overall
-                                // issuer balance, with the issued money
-                                // disappearing forever.) The bank knows
-                                // that once the series expires, whatever funds
-                                // are left in that cash account are
-                                // for the bank to keep. They can be transferred
-                                // to another account and kept, instead
-                                // of being lost.
-                                if (!pMintCashReserveAcct->Credit(
-                                        pToken->GetDenomination())) {
-                                    Log::Error("Error crediting mint cash "
-                                               "reserve account...\n");
-
-                                    // Reverse the account debit (even though
-                                    // we're not going to save it anyway.)
-                                    if (false == theAccount.Credit(
-                                                     pToken->GetDenomination()))
-                                        Log::vError(
-                                            "%s: Failed crediting "
-                                            "user account back.\n",
-                                            __FUNCTION__);
-
-                                    bSuccess = false;
-                                    break;
-                                }
-                            } else {
-                                bSuccess = false;
-                                Log::vOutput(
-                                    0,
-                                    "%s: Unable to debit account "
-                                    "%s in the amount of: %" PRId64 "\n",
-                                    __FUNCTION__,
-                                    strAccountID.Get(),
-                                    pToken->GetDenomination());
-                                break;  // Once there's a failure, we ditch the
-                                        // loop.
-                            }
                         }
+                    } else {
+                        bSuccess = false;
+                        Log::vOutput(
+                            0,
+                            "%s: Unable to debit account "
+                            "%s in the amount of: %" PRId64 "\n",
+                            __FUNCTION__,
+                            strAccountID.Get(),
+                            pToken->GetDenomination());
+                        break;  // Once there's a failure, we ditch the loop.
                     }
-                }  // While success popping token out of the purse...
+                }
 
                 if (bSuccess) {
                     while (!theDeque.empty()) {
@@ -1983,62 +2022,45 @@ void Notary::NotarizePayDividend(
                                         strVoucherAcctID.Get(),
                                         &theVoucherReserveAcct));
 
-                                PayDividendVisitor actionPayDividend(
-                                    NOTARY_ID,
-                                    NYM_ID,
-                                    PAYOUT_INSTRUMENT_DEFINITION_ID,
-                                    VOUCHER_ACCOUNT_ID,
-                                    strInReferenceTo,  // Memo for each voucher
-                                                       // (containing original
-                                                       // payout request pItem)
-                                    server_,
-                                    lAmountPerShare,
-                                    &theAccounts);
-
-                                // Loops through all the accounts for a given
-                                // instrument definition
-                                // (PAYOUT_INSTRUMENT_DEFINITION_ID),
-                                // and triggers
-                                // actionPayDividend for each one. This sends
-                                // the owner nym for each, a voucher drawn on
+                                // Loops through all the accounts for the
+                                // shares instrument definition, and sends
+                                // the owner of each a voucher drawn on
                                 // VOUCHER_ACCOUNT_ID. (In the amount of
                                 // lAmountPerShare * number of shares in
-                                // account.)
+                                // account.) Anything left over is returned
+                                // to the sender. The payout is checkpointed
+                                // as it goes, so if the server stops part
+                                // way through it is resumed on the next
+                                // start.
                                 //
+                                PayoutEngine::Payout payout{};
+                                payout.id_ =
+                                    std::to_string(tranIn.GetTransactionNum());
+                                payout.nym_ = String(NYM_ID).Get();
+                                payout.shares_ =
+                                    String(SHARES_INSTRUMENT_DEFINITION_ID)
+                                        .Get();
+                                payout.payout_unit_ =
+                                    String(PAYOUT_INSTRUMENT_DEFINITION_ID)
+                                        .Get();
+                                payout.voucher_account_ =
+                                    strVoucherAcctID.Get();
+                                payout.memo_ = strInReferenceTo.Get();
+                                payout.per_share_ = lAmountPerShare;
+                                payout.total_ = lTotalCostOfDividend;
                                 const bool bForEachAcct =
-                                    pSharesContract->VisitAccountRecords(
-                                        actionPayDividend);  // <================
-                                                             // pay all the
-                                                             // dividends here.
+                                    server_.payout_.Pay(payout, &theAccounts);
 
                                 // TODO: Since the above line of code loops
                                 // through all the accounts and loads them
                                 // up, transforms them, and saves them again, we
                                 // cannot use our own loaded accounts below
                                 // this point. (They could overwrite
-                                // themselves.) theSourceAccount especially, was
-                                // passed in
-                                // from above -- so how can we possible warn the
-                                // caller than he cannot save this account
-                                // without
-                                // overwriting work we have done in this
-                                // function?
-                                //
-                                // Aside from any more elegant solution, the
-                                // only way to make it work in this case would
-                                // be to
-                                // make a map or list of all the accounts that
-                                // are already loaded in memory (such as
-                                // theSourceAccount)
-                                // and PASS THEM IN to the above
-                                // VisitAccountRecords call. This way it would
-                                // have the option to use
-                                // the "already loaded" versions, where
-                                // appropriate, instead of loading them twice.
-                                // (As it is,
-                                // theSourceAccount is not used below this
-                                // point, though we couldn't preven the caller
-                                // from using it.)
+                                // themselves.) The accounts which were already
+                                // loaded are passed in via theAccounts so they
+                                // are not loaded twice, but we can't prevent
+                                // the caller from saving theSourceAccount
+                                // afterwards.
                                 //
                                 // Therefore we need to have some central system
                                 // where accounts can be loaded, locked, saved,
@@ -2059,208 +2081,6 @@ void Notary::NotarizePayDividend(
                                         "to the payout recipients.\n",
                                         szFunc);
                                 }
-                                //
-                                // REFUND ANY LEFTOVERS
-                                //
-                                const int64_t lLeftovers =
-                                    lTotalCostOfDividend -
-                                    (actionPayDividend.GetAmountPaidOut() +
-                                     actionPayDividend.GetAmountReturned());
-                                if (lLeftovers > 0) {
-                                    // Of the total amount removed from the
-                                    // sender's account, and after paying all
-                                    // dividends,
-                                    // there was a leftover amount that wasn't
-                                    // paid to anybody. Therefore, we should pay
-                                    // it back
-                                    // to the sender himself, now.
-                                    //
-                                    Log::vOutput(
-                                        0,
-                                        "%s: After dividend payout, with "
-                                        "%" PRId64 " units removed initially, "
-                                        "there were %" PRId64
-                                        " units remaining. "
-                                        "(Returning them to sender...)\n",
-                                        szFunc,
-                                        lTotalCostOfDividend,
-                                        lLeftovers);
-                                    Cheque theVoucher(
-                                        NOTARY_ID,
-                                        PAYOUT_INSTRUMENT_DEFINITION_ID);
-
-                                    // 10 minutes ==    600 Seconds
-                                    // 1 hour    ==     3600 Seconds
-                                    // 1 day    ==    86400 Seconds
-                                    // 30 days    ==  2592000 Seconds
-                                    // 3 months ==  7776000 Seconds
-                                    // 6 months == 15552000 Seconds
-
-                                    const time64_t VALID_FROM =
-                                        OTTimeGetCurrentTime();  // This time is
-                                                                 // set to TODAY
-                                                                 // NOW
-                                    const time64_t VALID_TO =
-                                        OTTimeAddTimeInterval(
-                                            VALID_FROM,
-                                            OTTimeGetSecondsFromTime(
-                                                OT_TIME_SIX_MONTHS_IN_SECONDS));  // This time occurs in 180 days (6 months).  Todo hardcoding.
-
-                                    int64_t lNewTransactionNumber = 0;
-                                    const bool bGotNextTransNum =
-                                        server_.transactor_
-                                            .issueNextTransactionNumberToNym(
-                                                context, lNewTransactionNumber);
-                                    // We save the
-                                    // transaction
-                                    // number on the server Nym (normally we'd
-                                    // discard it) because
-                                    // when the cheque is deposited, the server
-                                    // nym, as the owner of
-                                    // the voucher account, needs to verify the
-                                    // transaction # on the
-                                    // cheque (to prevent double-spending of
-                                    // cheques.)
-                                    if (bGotNextTransNum) {
-                                        const Identifier NOTARY_NYM_ID(
-                                            server_.m_nymServer);
-                                        const bool bIssueVoucher =
-                                            theVoucher.IssueCheque(
-                                                lLeftovers,  // The amount of
-                                                             // the
-                                                             // cheque.
-                                                lNewTransactionNumber,  // Requiring
-                                                                        // a
-                                                // transaction
-                                                // number
-                                                // prevents
-                                                // double-spending
-                                                // of
-                                                // cheques.
-                                                VALID_FROM,  // The expiration
-                                                             // date
-                                                // (valid from/to dates)
-                                                // of the cheque
-                                                VALID_TO,  // Vouchers are
-                                                // automatically starting
-                                                // today and lasting 6
-                                                // months.
-                                                VOUCHER_ACCOUNT_ID,  // The
-                                                                     // asset
-                                                // account the
-                                                // cheque is
-                                                // drawn on.
-                                                NOTARY_NYM_ID,  // Nym ID of the
-                                                // sender (in this
-                                                // case the server
-                                                // nym.)
-                                                strInReferenceTo,  // Optional
-                                                                   // memo
-                                                // field. Includes
-                                                // item note and
-                                                // request memo.
-                                                &NYM_ID);
-
-                                        // All account crediting / debiting
-                                        // happens in the caller, in Server.
-                                        //    (AND it happens only ONCE, to
-                                        // cover ALL vouchers.)
-                                        // Then in here, the voucher either gets
-                                        // send to the recipient, or if error,
-                                        // sent back home to
-                                        // the issuer Nym. (ALL the funds are
-                                        // removed, then the vouchers are sent
-                                        // one way or the other.)
-                                        // Any returned vouchers, obviously
-                                        // serve to notify the dividend payer of
-                                        // where the errors were
-                                        // (as well as give him the opportunity
-                                        // to get his money back.)
-                                        //
-                                        bool bSent = false;
-                                        if (bIssueVoucher) {
-                                            theVoucher.SetAsVoucher(
-                                                NOTARY_NYM_ID,
-                                                VOUCHER_ACCOUNT_ID);  // All
-                                                                      // this
-                                                                      // does is
-                                                                      // set the
-                                            // voucher's
-                                            // internal
-                                            // contract
-                                            // string
-                                            theVoucher.SignContract(
-                                                server_.m_nymServer);  // to
-                                            // "VOUCHER"
-                                            // instead of
-                                            // "CHEQUE".
-                                            theVoucher.SaveContract();
-
-                                            // Send the voucher to the payments
-                                            // inbox of the recipient.
-                                            //
-                                            const String strVoucher(theVoucher);
-                                            OTPayment thePayment(strVoucher);
-
-                                            // calls DropMessageToNymbox
-                                            bSent = server_.SendInstrumentToNym(
-                                                NOTARY_ID,
-                                                NOTARY_NYM_ID,  // sender
-                                                                // nym
-                                                NYM_ID,         // recipient nym
-                                                                // (returning to
-                                                // original sender.)
-                                                &thePayment,
-                                                "payDividend");  // todo:
-                                            // hardcoding.
-                                        }
-                                        // If we didn't send it, then we need to
-                                        // return the funds to where they came
-                                        // from.
-                                        //
-                                        if (!bSent) {
-                                            const String
-                                                strPayoutInstrumentDefinitionID(
-                                                    PAYOUT_INSTRUMENT_DEFINITION_ID),
-                                                strSenderNymID(NYM_ID);
-                                            Log::vError(
-                                                "%s: ERROR failed issuing "
-                                                "voucher (to return leftovers "
-                                                "back to "
-                                                "the dividend payout "
-                                                "initiator.) WAS TRYING TO PAY "
-                                                "%" PRId64 " of instrument "
-                                                "definition %s to "
-                                                "Nym "
-                                                "%s.\n",
-                                                szFunc,
-                                                lLeftovers,
-                                                strPayoutInstrumentDefinitionID
-                                                    .Get(),
-                                                strSenderNymID.Get());
-                                        }   // if !bSent
-                                    } else  // !bGotNextTransNum
-                                    {
-                                        const String
-                                            strPayoutInstrumentDefinitionID(
-                                                PAYOUT_INSTRUMENT_DEFINITION_ID),
-                                            strRecipientNymID(NYM_ID);
-                                        Log::vError(
-                                            "%s: ERROR!! Failed issuing next "
-                                            "transaction "
-                                            "number while trying to send a "
-                                            "voucher (while returning leftover "
-                                            "funds, after paying dividends.) "
-                                            "WAS TRYING TO PAY %" PRId64
-                                            " of asset "
-                                            "type %s to Nym %s.\n",
-                                            szFunc,
-                                            lLeftovers,
-                                            strPayoutInstrumentDefinitionID
-                                                .Get(),
-                                            strRecipientNymID.Get());
-                                    }
-                                }
                             }  // else
                         }
                         // else{} // TODO log that there was a problem with the
@@ -3942,6 +3762,26 @@ void Notary::NotarizeDeposit(
 
                 bool bSuccess = false;
 
+                // Tokens are recorded in the spent token database as a single
+                // batch after every token in the purse has been verified and
+                // credited. If anything fails, nothing is spent and the
+                // credits listed here are reversed.
+                SpentTokens::Batch spentTokens{};
+                std::vector<std::pair<Account*, Amount>> credited{};
+
+                // The Lucre coins for every token in the purse are verified in
+                // one batch per mint after all the tokens have been checked.
+                struct PendingToken
+                {
+                    std::unique_ptr<Token> token_{nullptr};
+                    std::shared_ptr<Mint> mint_{nullptr};
+                    Account* reserve_{nullptr};
+                    String spendable_{};
+                    OTIdentifier id_{Identifier::Factory()};
+                    bool verified_{false};
+                };
+                std::vector<PendingToken> pending{};
+
                 // Pull the token(s) out of the purse that was received from the
                 // client.
                 while (true) {
@@ -3957,182 +3797,221 @@ void Notary::NotarizeDeposit(
                     if (false == bool(pMint)) {
                         Log::Error("Notary::NotarizeDeposit: Unable to get "
                                    "or load Mint.\n");
+                        bSuccess = false;
                         break;
                     } else if (
                         (pMintCashReserveAcct =
-                             pMint->GetCashReserveAccount()) != nullptr) {
-                        String strSpendableToken;
-                        bool bToken = pToken->GetSpendableString(
-                            server_.m_nymServer, strSpendableToken);
+                             pMint->GetCashReserveAccount()) == nullptr) {
+                        Log::Error("Notary::NotarizeDeposit: Unable to get "
+                                   "cash reserve account for Mint.\n");
+                        bSuccess = false;
+                        break;
+                    }
 
-                        if (!bToken)  // if failure getting the spendable token
-                                      // data from the token object
-                        {
-                            bSuccess = false;
-                            Log::vOutput(
-                                0,
-                                "Notary::NotarizeDeposit: "
-                                "ERROR verifying token: Failure "
-                                "retrieving token data. \n");
-                            break;
-                        } else if (!(pToken->GetInstrumentDefinitionID() ==
-                                     INSTRUMENT_DEFINITION_ID))  // or if
-                                                                 // failure
-                                                                 // verifying
-                        // instrument definition
-                        {
-                            bSuccess = false;
-                            Log::vOutput(
-                                0,
-                                "Notary::NotarizeDeposit: "
-                                "ERROR verifying token: Wrong "
-                                "instrument definition. \n");
-                            break;
-                        } else if (!(pToken->GetNotaryID() ==
-                                     NOTARY_ID))  // or if failure verifying
-                                                  // server ID
-                        {
-                            bSuccess = false;
-                            Log::vOutput(
-                                0,
-                                "Notary::NotarizeDeposit: "
-                                "ERROR verifying token: Wrong "
-                                "server ID. \n");
-                            break;
-                        }
-                        // This call to VerifyToken verifies the token's Series
-                        // and From/To dates against the
-                        // mint's, and also verifies that the CURRENT date is
-                        // inside that valid date range.
-                        //
-                        // It also verifies the Lucre coin data itself against
-                        // the key for that series and
-                        // denomination. (The signed and unblinded Lucre coin is
-                        // finally verified in Lucre
-                        // using the appropriate Mint private key.)
-                        //
-                        else if (!(pMint->VerifyToken(
-                                     server_.m_nymServer,
-                                     strSpendableToken,
-                                     pToken->GetDenomination()))) {
-                            bSuccess = false;
-                            Log::vOutput(
-                                0,
-                                "Notary::NotarizeDeposit: "
-                                "ERROR verifying token: Token "
-                                "verification failed. \n");
-                            break;
+                    String strSpendableToken;
+                    bool bToken = pToken->GetSpendableString(
+                        server_.m_nymServer, strSpendableToken);
+
+                    if (!bToken)  // if failure getting the spendable token data
+                                  // from the token object
+                    {
+                        bSuccess = false;
+                        Log::vOutput(
+                            0,
+                            "Notary::NotarizeDeposit: "
+                            "ERROR verifying token: Failure "
+                            "retrieving token data. \n");
+                        break;
+                    } else if (!(pToken->GetInstrumentDefinitionID() ==
+                                 INSTRUMENT_DEFINITION_ID))  // or if failure
+                                                             // verifying
+                                                             // instrument
+                                                             // definition
+                    {
+                        bSuccess = false;
+                        Log::vOutput(
+                            0,
+                            "Notary::NotarizeDeposit: "
+                            "ERROR verifying token: Wrong "
+                            "instrument definition. \n");
+                        break;
+                    } else if (!(pToken->GetNotaryID() ==
+                                 NOTARY_ID))  // or if failure verifying
+                                              // server ID
+                    {
+                        bSuccess = false;
+                        Log::vOutput(
+                            0,
+                            "Notary::NotarizeDeposit: "
+                            "ERROR verifying token: Wrong "
+                            "server ID. \n");
+                        break;
+                    }
+
+                    PendingToken item{};
+                    item.id_ = SpentTokens::TokenID(strSpendableToken);
+                    item.token_ = std::move(pToken);
+                    item.mint_ = pMint;
+                    item.reserve_ = pMintCashReserveAcct;
+                    item.spendable_ = strSpendableToken;
+                    pending.emplace_back(std::move(item));
+                    bSuccess = true;
+                }  // while success popping token from purse
+
+                // This call to VerifyTokens verifies the token's Series and
+                // From/To dates against the mint's, and also verifies that the
+                // CURRENT date is inside that valid date range.
+                //
+                // It also verifies the Lucre coin data itself against the key
+                // for that series and denomination. (The signed and unblinded
+                // Lucre coin is finally verified in Lucre using the
+                // appropriate Mint private key.)
+                if (bSuccess) {
+                    std::map<Mint*, std::vector<PendingToken*>> batches{};
+
+                    for (auto& item : pending) {
+                        batches[item.mint_.get()].push_back(&item);
+                    }
+
+                    for (auto& [mint, items] : batches) {
+                        std::vector<String> coins{};
+                        std::vector<std::int64_t> denominations{};
+
+                        for (const auto* item : items) {
+                            coins.push_back(item->spendable_);
+                            denominations.push_back(
+                                item->token_->GetDenomination());
                         }
-                        // Lookup the token in the SPENT TOKEN DATABASE, and
-                        // make sure
-                        // that it hasn't already been spent...
-                        else if (pToken->IsTokenAlreadySpent(
-                                     strSpendableToken)) {
-                            // TODO!!!! Need to store the spent token database
-                            // in multiple places, on multiple media!
-                            //          Furthermore need to CHECK those multiple
-                            // places inside IsTokenAlreadySpent.
-                            //          In fact, that should all be configurable
-                            // in the server config file!
-                            //          Related: make sure IsTokenAlreadySpent
-                            // differentiates between ACTUALLY not finding
-                            //          a token as spent (successfully), versus
-                            // some error state with the storage.
-                            bSuccess = false;
-                            Log::vOutput(
-                                0,
-                                "Notary::NotarizeDeposit: "
-                                "ERROR verifying token: Token "
-                                "was already spent. \n");
-                            break;
-                        } else {
-                            Log::Output(
-                                3,
-                                "Notary::NotarizeDeposit: "
-                                "SUCCESS verifying token...    "
-                                "\n");
-
-                            // need to be able to "roll back" if anything inside
-                            // this block fails.
-                            // so unless bSuccess is true, I don't save the
-                            // account below.
-                            //
 
-                            // two defense mechanisms here:  mint cash reserve
-                            // acct, and spent token database
-                            //
-                            if (false == pMintCashReserveAcct->Debit(
-                                             pToken->GetDenomination())) {
-                                Log::Error("Notary::NotarizeDeposit: Error "
-                                           "debiting the mint cash reserve "
-                                           "account. "
-                                           "SHOULD NEVER HAPPEN...\n");
-                                bSuccess = false;
-                                break;
-                            }
-                            // CREDIT the amount to the account...
-                            else if (
-                                false ==
-                                theAccount.Credit(pToken->GetDenomination())) {
-                                Log::Error("Notary::NotarizeDeposit: Error "
-                                           "crediting the user's asset "
-                                           "account...\n");
-
-                                if (false == pMintCashReserveAcct->Credit(
-                                                 pToken->GetDenomination()))
-                                    Log::Error("Notary::NotarizeDeposit: "
-                                               "Failure crediting-back "
-                                               "mint's cash reserve account "
-                                               "while depositing cash.\n");
-                                bSuccess = false;
-                                break;
-                            }
-                            // Spent token database. This is where the call is
-                            // made to add
-                            // the token to the spent token database.
-                            else if (
-                                false ==
-                                pToken->RecordTokenAsSpent(strSpendableToken)) {
-                                Log::Error("Notary::NotarizeDeposit: "
-                                           "Failed recording token as "
-                                           "spent...\n");
-
-                                if (false == pMintCashReserveAcct->Credit(
-                                                 pToken->GetDenomination()))
-                                    Log::Error("Notary::NotarizeDeposit: "
-                                               "Failure crediting-back "
-                                               "mint's cash reserve account "
-                                               "while depositing cash.\n");
-
-                                if (false ==
-                                    theAccount.Debit(pToken->GetDenomination()))
-                                    Log::Error("Notary::NotarizeDeposit: "
-                                               "Failure debiting-back user's "
-                                               "asset account while "
-                                               "depositing cash.\n");
+                        const auto results = mint->VerifyTokens(
+                            server_.m_nymServer, coins, denominations);
 
-                                bSuccess = false;
-                                break;
-                            } else  // SUCCESS!!! (this iteration)
-                            {
-                                Log::vOutput(
-                                    2,
-                                    "Notary::NotarizeDeposit: "
-                                    "SUCCESS crediting account "
-                                    "with cash token...\n");
-                                bSuccess = true;
-
-                                // No break here -- we allow the loop to carry
-                                // on through.
-                            }
+                        for (std::size_t i = 0; i < items.size(); ++i) {
+                            items[i]->verified_ = results[i];
                         }
-                    } else {
-                        Log::Error("Notary::NotarizeDeposit: Unable to get "
-                                   "cash reserve account for Mint.\n");
+                    }
+                }
+
+                for (auto& item : pending) {
+                    if (false == bSuccess) {
+                        break;
+                    }
+
+                    auto& pToken = item.token_;
+                    pMintCashReserveAcct = item.reserve_;
+
+                    if (false == item.verified_) {
                         bSuccess = false;
+                        Log::vOutput(
+                            0,
+                            "Notary::NotarizeDeposit: "
+                            "ERROR verifying token: Token "
+                            "verification failed. \n");
                         break;
                     }
-                }  // while success popping token from purse
+                    // Lookup the token in the SPENT TOKEN DATABASE, and make
+                    // sure that it hasn't already been spent...
+                    else if (spent_tokens_.IsSpent(
+                                 INSTRUMENT_DEFINITION_ID,
+                                 pToken->GetSeries(),
+                                 item.id_)) {
+                        // TODO!!!! Need to store the spent token database in
+                        // multiple places, on multiple media!
+                        //          In fact, that should all be configurable in
+                        // the server config file!
+                        bSuccess = false;
+                        Log::vOutput(
+                            0,
+                            "Notary::NotarizeDeposit: "
+                            "ERROR verifying token: Token "
+                            "was already spent. \n");
+                        break;
+                    }
+
+                    Log::Output(
+                        3,
+                        "Notary::NotarizeDeposit: "
+                        "SUCCESS verifying token...    "
+                        "\n");
+
+                    // need to be able to "roll back" if anything inside this
+                    // block fails. so unless bSuccess is true, I don't save
+                    // the account below.
+                    //
+
+                    // two defense mechanisms here:  mint cash reserve acct, and
+                    // spent token database
+                    //
+                    if (false == pMintCashReserveAcct->Debit(
+                                     pToken->GetDenomination())) {
+                        Log::Error("Notary::NotarizeDeposit: Error "
+                                   "debiting the mint cash reserve "
+                                   "account. "
+                                   "SHOULD NEVER HAPPEN...\n");
+                        bSuccess = false;
+                        break;
+                    }
+                    // CREDIT the amount to the account...
+                    else if (
+                        false == theAccount.Credit(pToken->GetDenomination())) {
+                        Log::Error("Notary::NotarizeDeposit: Error "
+                                   "crediting the user's asset "
+                                   "account...\n");
+
+                        if (false ==
+                            pMintCashReserveAcct->Credit(
+                                pToken->GetDenomination()))
+                            Log::Error("Notary::NotarizeDeposit: "
+                                       "Failure crediting-back "
+                                       "mint's cash reserve account "
+                                       "while depositing cash.\n");
+                        bSuccess = false;
+                        break;
+                    }
+                    // Spent token database. The token is added to the batch
+                    // which is recorded below.
+                    else  // SUCCESS!!! (this iteration)
+                    {
+                        credited.emplace_back(
+                            pMintCashReserveAcct, pToken->GetDenomination());
+                        spentTokens[pToken->GetSeries()].emplace_back(item.id_);
+                        Log::vOutput(
+                            2,
+                            "Notary::NotarizeDeposit: "
+                            "SUCCESS crediting account "
+                            "with cash token...\n");
+
+                        // No break here -- we allow the loop to carry on
+                        // through.
+                    }
+                }
+
+                // Spent token database. This is where the call is made to add
+                // the tokens to the spent token database.
+                if (bSuccess && (false == spent_tokens_.Spend(
+                                              INSTRUMENT_DEFINITION_ID,
+                                              spentTokens))) {
+                    Log::Error("Notary::NotarizeDeposit: "
+                               "Failed recording tokens as "
+                               "spent...\n");
+                    bSuccess = false;
+                }
+
+                if (false == bSuccess) {
+                    for (const auto& [reserve, amount] : credited) {
+                        if (false == reserve->Credit(amount))
+                            Log::Error("Notary::NotarizeDeposit: "
+                                       "Failure crediting-back "
+                                       "mint's cash reserve account "
+                                       "while depositing cash.\n");
+
+                        if (false == theAccount.Debit(amount))
+                            Log::Error("Notary::NotarizeDeposit: "
+                                       "Failure debiting-back user's "
+                                       "asset account while "
+                                       "depositing cash.\n");
+                    }
+                }
 
                 if (bSuccess) {
                     // Release any signatures that were there before (They won't
@@ -7272,7 +7151,7 @@ void Notary::NotarizeTransaction(
             strIDAcct.Get());
     }
     // Make sure I, the server, have signed this file.
-    else if (!theFromAccount.VerifySignature(server_.m_nymServer)) {
+    else if (!verify_account_signature(theFromAccount)) {
         const Identifier idAcct(theFromAccount);
         const String strIDAcct(idAcct);
         Log::vError(
@@ -8319,6 +8198,7 @@ void Notary::NotarizeProcessInbox(
     std::int64_t lTotalBeingAccepted{0};
     std::list<TransactionNumber> theListOfInboxReceiptsBeingRemoved{};
     bool bVerifiedBalanceStatement{false};
+    OriginalItems originalItems{};
     const bool allowed =
         NYM_IS_ALLOWED(strNymID, ServerSettings::__transact_process_inbox);
 
@@ -8382,6 +8262,11 @@ void Notary::NotarizeProcessInbox(
     // can't process the same inbox item twice simultaneously! Or even at
     // all.)
 
+    // Parsing the items (and cheques) that the accepted receipts refer to
+    // doesn't depend on the context or the account, so it is done for all
+    // receipts up front instead of inside the loops below.
+    originalItems = parse_original_items(*pInbox, processInbox);
+
     for (auto& it_bigloop : processInbox.GetItemList()) {
         pItem = it_bigloop;
         OT_ASSERT_MSG(
@@ -8607,13 +8492,9 @@ void Notary::NotarizeProcessInbox(
                 // recipient's acceptPending. THAT item is in reference to
                 // my original transfer (or contains a cheque with my
                 // original number.) (THAT's the # I need.)
-                String strOriginalItem;
-                pServerTransaction->GetReferenceString(strOriginalItem);
-
-                std::unique_ptr<Item> pOriginalItem(Item::CreateItemFromString(
-                    strOriginalItem,
-                    NOTARY_ID,
-                    pServerTransaction->GetReferenceToNum()));
+                auto& original =
+                    originalItems[pServerTransaction->GetTransactionNum()];
+                auto& pOriginalItem = original.item_;
 
                 if (nullptr != pOriginalItem) {
                     // If pOriginalItem is acceptPending, that means the
@@ -8647,13 +8528,9 @@ void Notary::NotarizeProcessInbox(
                     if (Item::depositCheque == pOriginalItem->GetType()) {
                         // Get the cheque from the Item and load it up into
                         // a Cheque object.
-                        String strCheque;
-                        pOriginalItem->GetAttachment(strCheque);
-                        Cheque theCheque;  // allocated on the stack :-)
-
-                        if (false ==
-                            ((strCheque.GetLength() > 2) &&
-                             theCheque.LoadContractFromString(strCheque))) {
+                        if (false == bool(original.cheque_)) {
+                            String strCheque;
+                            pOriginalItem->GetAttachment(strCheque);
                             Log::vError(
                                 "%s: ERROR loading cheque from "
                                 "string:\n%s\n",
@@ -8665,7 +8542,8 @@ void Notary::NotarizeProcessInbox(
                         // accepting the cheque receipt, he can be cleared
                         // for that transaction number...
                         else {
-                            const auto number = theCheque.GetTransactionNum();
+                            const auto number =
+                                original.cheque_->GetTransactionNum();
                             // IF it's actually there on theNym, then
                             // schedule it for removal. (Otherwise we'd end
                             // up improperly re-adding it.)
@@ -8735,6 +8613,8 @@ void Notary::NotarizeProcessInbox(
                         bSuccessFindingAllTransactions = false;
                     }
                 } else {
+                    String strOriginalItem;
+                    pServerTransaction->GetReferenceString(strOriginalItem);
                     Log::vError(
                         "%s: Unable to load original item from "
                         "string while accepting item "
@@ -9124,13 +9004,8 @@ void Notary::NotarizeProcessInbox(
             // the original item (from the sender) as the
             // "referenced to" object. So let's extract
             // it.
-            String strOriginalItem;
-            pServerTransaction->GetReferenceString(strOriginalItem);
-
-            std::unique_ptr<Item> pOriginalItem(Item::CreateItemFromString(
-                strOriginalItem,
-                NOTARY_ID,
-                pServerTransaction->GetReferenceToNum()));
+            auto& pOriginalItem =
+                originalItems[pServerTransaction->GetTransactionNum()].item_;
 
             if (nullptr != pOriginalItem) {
 
@@ -9597,4 +9472,99 @@ send_message:
     // request that triggered it.)
     processInboxResponse.SaveContract(szFoldername, strPath.Get());
 }
+
+// Parses the original item, and any cheque attached to it, of each receipt
+// which processInbox accepts. Large inboxes are parsed on several threads.
+Notary::OriginalItems Notary::parse_original_items(
+    Ledger& inbox,
+    OTTransaction& processInbox) const
+{
+    const Identifier notaryID(server_.m_strNotaryID);
+    std::vector<OTTransaction*> receipts{};
+
+    for (auto& pItem : processInbox.GetItemList()) {
+        OT_ASSERT(nullptr != pItem);
+
+        switch (pItem->GetType()) {
+            case Item::acceptPending:
+            case Item::acceptItemReceipt: {
+                auto pReceipt =
+                    inbox.GetTransaction(pItem->GetReferenceToNum());
+
+                if (nullptr != pReceipt) {
+                    receipts.push_back(pReceipt);
+                }
+            } break;
+            default: {
+            }
+        }
+    }
+
+    std::vector<OriginalItem> parsed(receipts.size());
+    ParallelFor(
+        receipts.size(),
+        OT_PROCESS_INBOX_PARALLEL_ITEMS,
+        OT_PARALLEL_MAX_THREADS,
+        [&](const std::size_t i) {
+            const auto& receipt = *receipts.at(i);
+            auto& output = parsed.at(i);
+            String serialized;
+            receipt.GetReferenceString(serialized);
+            output.item_.reset(Item::CreateItemFromString(
+                serialized, notaryID, receipt.GetReferenceToNum()));
+
+            if (false == bool(output.item_)) {
+
+                return;
+            }
+
+            if (Item::depositCheque != output.item_->GetType()) {
+
+                return;
+            }
+
+            String cheque;
+            output.item_->GetAttachment(cheque);
+            output.cheque_.reset(new Cheque);
+
+            OT_ASSERT(output.cheque_);
+
+            if (false == ((cheque.GetLength() > 2) &&
+                          output.cheque_->LoadContractFromString(cheque))) {
+                output.cheque_.reset();
+            }
+        });
+
+    OriginalItems output{};
+
+    for (std::size_t i = 0; i < receipts.size(); ++i) {
+        output.emplace(
+            receipts.at(i)->GetTransactionNum(), std::move(parsed.at(i)));
+    }
+
+    return output;
+}
+
+// Each transaction in a notarizeTransaction request loads its account afresh.
+// Only the first of them needs to check the signature, unless the account has
+// changed in between.
+bool Notary::verify_account_signature(const Account& account) const
+{
+    const auto& cache = server_.cache_;
+    const String id(account.GetRealAccountID());
+
+    if (cache.Verified(OTFolders::Account().Get(), id.Get())) {
+
+        return true;
+    }
+
+    if (false == account.VerifySignature(server_.m_nymServer)) {
+
+        return false;
+    }
+
+    cache.SetVerified(OTFolders::Account().Get(), id.Get());
+
+    return true;
+}
 }  // namespace opentxs::server
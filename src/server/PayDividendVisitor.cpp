@@ -101,6 +101,94 @@ PayDividendVisitor::~PayDividendVisitor()
     m_lAmountReturned = 0;
 }
 
+bool PayDividendVisitor::Refund(const int64_t lAmount)
+{
+    if (0 >= lAmount) {
+
+        return true;
+    }
+
+    OT_ASSERT(nullptr != GetNotaryID());
+    const Identifier& theNotaryID = *(GetNotaryID());
+    OT_ASSERT(nullptr != GetPayoutInstrumentDefinitionID());
+    const Identifier& thePayoutInstrumentDefinitionID =
+        *(GetPayoutInstrumentDefinitionID());
+    OT_ASSERT(nullptr != GetVoucherAcctID());
+    const Identifier& theVoucherAcctID = *(GetVoucherAcctID());
+    OT_ASSERT(nullptr != GetServer());
+    server::Server& theServer = *(GetServer());
+    Nym& theServerNym = const_cast<Nym&>(theServer.GetServerNym());
+    const Identifier theServerNymID(theServerNym);
+    OT_ASSERT(nullptr != GetNymID());
+    const Identifier& theSenderNymID = *(GetNymID());
+    OT_ASSERT(nullptr != GetMemo());
+    const String& strMemo = *(GetMemo());
+    const String strPayoutInstrumentDefinitionID(
+        thePayoutInstrumentDefinitionID),
+        strSenderNymID(theSenderNymID);
+    const time64_t VALID_FROM = OTTimeGetCurrentTime();
+    const time64_t VALID_TO = OTTimeAddTimeInterval(
+        VALID_FROM, OTTimeGetSecondsFromTime(OT_TIME_SIX_MONTHS_IN_SECONDS));
+    TransactionNumber lNewTransactionNumber = 0;
+    auto context = OT::App().Wallet().mutable_ClientContext(
+        theServerNym.ID(), theServerNym.ID());
+
+    if (false == theServer.transactor_.issueNextTransactionNumberToNym(
+                     context.It(), lNewTransactionNumber)) {
+        Log::vError(
+            "PayDividendVisitor::Refund: ERROR!! Failed issuing next "
+            "transaction number while trying to send a voucher (while "
+            "returning leftover funds, after paying dividends.) WAS TRYING "
+            "TO PAY %" PRId64 " of instrument definition %s to Nym %s.\n",
+            lAmount,
+            strPayoutInstrumentDefinitionID.Get(),
+            strSenderNymID.Get());
+
+        return false;
+    }
+
+    Cheque theVoucher(theNotaryID, thePayoutInstrumentDefinitionID);
+    const bool bIssueVoucher = theVoucher.IssueCheque(
+        lAmount,
+        lNewTransactionNumber,
+        VALID_FROM,
+        VALID_TO,
+        theVoucherAcctID,
+        theServerNymID,
+        strMemo,
+        &theSenderNymID);
+    bool bSent = false;
+
+    if (bIssueVoucher) {
+        theVoucher.SetAsVoucher(theServerNymID, theVoucherAcctID);
+        theVoucher.SignContract(theServerNym);
+        theVoucher.SaveContract();
+        const String strVoucher(theVoucher);
+        OTPayment thePayment(strVoucher);
+        bSent = theServer.SendInstrumentToNym(
+            theNotaryID,
+            theServerNymID,
+            theSenderNymID,
+            &thePayment,
+            "payDividend");  // todo: hardcoding.
+    }
+
+    if (bSent) {
+        m_lAmountReturned += lAmount;
+    } else {
+        Log::vError(
+            "PayDividendVisitor::Refund: ERROR failed issuing voucher (to "
+            "return leftovers back to the dividend payout initiator.) WAS "
+            "TRYING TO PAY %" PRId64 " of instrument definition %s to Nym "
+            "%s.\n",
+            lAmount,
+            strPayoutInstrumentDefinitionID.Get(),
+            strSenderNymID.Get());
+    }
+
+    return bSent;
+}
+
 // For each "user" account of a specific instrument definition, this function
 // is called in order to pay a dividend to the Nym who owns that account.
 
@@ -0,0 +1,396 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/server/PayoutEngine.hpp"
+
+#include "opentxs/api/client/Wallet.hpp"
+#include "opentxs/core/contract/UnitDefinition.hpp"
+#include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/util/ParallelFor.hpp"
+#include "opentxs/core/Account.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/OTStorage.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/server/PayDividendVisitor.hpp"
+#include "opentxs/server/Server.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#define PAYOUT_BATCH_SIZE 256
+#define PAYOUT_CHECKPOINT_FILE "dividends.pending"
+#define PAYOUT_PARALLEL_ACCOUNTS 2
+
+#define OT_METHOD "opentxs::server::PayoutEngine::"
+
+namespace opentxs::server
+{
+PayoutEngine::PayoutEngine(Server& server)
+    : server_(server)
+    , batch_size_(PAYOUT_BATCH_SIZE)
+{
+}
+
+PayoutEngine::Payout PayoutEngine::deserialize(
+    const std::string& id,
+    const std::string& input)
+{
+    Payout output{};
+    output.id_ = id;
+    std::unique_ptr<OTDB::Storable> pStorable(
+        OTDB::DecodeObject(OTDB::STORED_OBJ_STRING_MAP, input));
+    auto pMap = dynamic_cast<OTDB::StringMap*>(pStorable.get());
+
+    if (nullptr == pMap) {
+
+        return output;
+    }
+
+    auto& map = pMap->the_map;
+    output.nym_ = map["nym"];
+    output.shares_ = map["shares"];
+    output.payout_unit_ = map["payout"];
+    output.voucher_account_ = map["voucher"];
+    output.memo_ = map["memo"];
+
+    try {
+        output.per_share_ = std::stoll(map["per_share"]);
+        output.total_ = std::stoll(map["total"]);
+        output.next_shard_ = std::stoull(map["next_shard"]);
+        output.paid_ = std::stoll(map["paid"]);
+        output.returned_ = std::stoll(map["returned"]);
+    } catch (...) {
+        output.shares_.clear();
+    }
+
+    return output;
+}
+
+bool PayoutEngine::erase_checkpoint(const std::string& id) const
+{
+    auto pStorable = load_checkpoints();
+    auto pMap = dynamic_cast<OTDB::StringMap*>(pStorable.get());
+
+    if (nullptr == pMap) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to load payout checkpoints." << std::endl;
+
+        return false;
+    }
+
+    pMap->the_map.erase(id);
+
+    return store_checkpoints(*pMap);
+}
+
+std::vector<std::unique_ptr<Account>> PayoutEngine::load(
+    const Identifier& notaryID,
+    const std::vector<std::string>& ids,
+    const mapOfAccounts* loaded) const
+{
+    std::vector<std::unique_ptr<Account>> output(ids.size());
+    ParallelFor(
+        ids.size(),
+        PAYOUT_PARALLEL_ACCOUNTS,
+        OT_PARALLEL_MAX_THREADS,
+        [&](const std::size_t i) {
+            const auto& id = ids.at(i);
+
+            if ((nullptr != loaded) && (0 < loaded->count(id))) {
+
+                return;
+            }
+
+            output.at(i).reset(
+                Account::LoadExistingAccount(Identifier(id), notaryID));
+        });
+
+    return output;
+}
+
+std::unique_ptr<OTDB::Storable> PayoutEngine::load_checkpoints() const
+{
+    const auto serialized =
+        server_.cache_.Query(OTFolders::Cron().Get(), PAYOUT_CHECKPOINT_FILE);
+
+    if (serialized.empty()) {
+
+        return std::unique_ptr<OTDB::Storable>(
+            OTDB::CreateObject(OTDB::STORED_OBJ_STRING_MAP));
+    }
+
+    return std::unique_ptr<OTDB::Storable>(
+        OTDB::DecodeObject(OTDB::STORED_OBJ_STRING_MAP, serialized));
+}
+
+bool PayoutEngine::Pay(Payout& payout, mapOfAccounts* loaded)
+{
+    // The funds were moved to the voucher reserve before this call. The
+    // checkpoint is committed together with that move, so a payout is
+    // resumed if and only if its funds are in the reserve.
+    const bool saved = save_checkpoint(payout);
+
+    if (false == server_.cache_.Commit()) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to commit the start of dividend payout "
+              << payout.id_ << std::endl;
+    }
+
+    if (false == saved) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to save checkpoint for dividend payout "
+              << payout.id_ << ". It will not be resumed if interrupted."
+              << std::endl;
+    }
+
+    return pay(payout, loaded);
+}
+
+bool PayoutEngine::pay(Payout& payout, mapOfAccounts* loaded) const
+{
+    const auto shares =
+        server_.wallet_.UnitDefinition(Identifier(payout.shares_));
+
+    if (false == bool(shares)) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Unable to load shares contract " << payout.shares_
+              << " for dividend payout " << payout.id_ << std::endl;
+
+        return false;
+    }
+
+    const Identifier& notaryID = server_.GetServerID();
+    PayDividendVisitor visitor(
+        notaryID,
+        Identifier(payout.nym_),
+        Identifier(payout.payout_unit_),
+        Identifier(payout.voucher_account_),
+        String(payout.memo_),
+        server_,
+        payout.per_share_,
+        loaded);
+    const auto paid = payout.paid_;
+    const auto returned = payout.returned_;
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t accounts{0};
+    bool output{true};
+
+    for (auto shard = payout.next_shard_;
+         shard < UnitDefinition::AccountRecordShards;
+         ++shard) {
+        const auto records = shares->AccountRecords(shard);
+        const std::vector<std::string> ids(records.begin(), records.end());
+
+        for (std::size_t first = 0; first < ids.size(); first += batch_size_) {
+            const std::vector<std::string> batch(
+                ids.begin() + first,
+                ids.begin() + std::min(ids.size(), first + batch_size_));
+            auto accountList = load(notaryID, batch, loaded);
+
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                Account* account = accountList.at(i).get();
+
+                if ((nullptr == account) && (nullptr != loaded)) {
+                    auto it = loaded->find(batch.at(i));
+
+                    if (loaded->end() != it) {
+                        account = it->second;
+                    }
+                }
+
+                ++accounts;
+
+                if (nullptr == account) {
+                    otErr << OT_METHOD << __FUNCTION__
+                          << ": Failed loading account " << batch.at(i)
+                          << std::endl;
+                    output = false;
+
+                    continue;
+                }
+
+                if (false == visitor.Trigger(*account)) {
+                    otErr << OT_METHOD << __FUNCTION__
+                          << ": Failed paying dividend to account "
+                          << batch.at(i) << std::endl;
+                    output = false;
+                }
+            }
+        }
+
+        // The vouchers for this shard and the checkpoint which skips it are
+        // committed as one unit, so a resumed payout never pays them twice
+        payout.next_shard_ = shard + 1;
+        payout.paid_ = paid + visitor.GetAmountPaidOut();
+        payout.returned_ = returned + visitor.GetAmountReturned();
+        save_checkpoint(payout);
+        server_.cache_.Commit();
+        const auto elapsed =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+        otInfo << OT_METHOD << __FUNCTION__ << ": Dividend payout "
+               << payout.id_ << ": " << payout.next_shard_ << " of "
+               << UnitDefinition::AccountRecordShards << " shards, "
+               << accounts << " accounts in " << elapsed.count() << " ms"
+               << std::endl;
+    }
+
+    const auto leftovers = payout.total_ - (payout.paid_ + payout.returned_);
+
+    if (0 < leftovers) {
+        otWarn << OT_METHOD << __FUNCTION__ << ": After dividend payout "
+               << payout.id_ << ", with " << payout.total_
+               << " units removed initially, there were " << leftovers
+               << " units remaining. (Returning them to sender...)"
+               << std::endl;
+        visitor.Refund(leftovers);
+    }
+
+    // Likewise the refund and the removal of the checkpoint
+    erase_checkpoint(payout.id_);
+    server_.cache_.Commit();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    const auto rate =
+        (0 < elapsed.count()) ? (accounts * 1000 / elapsed.count()) : accounts;
+    otWarn << OT_METHOD << __FUNCTION__ << ": Dividend payout " << payout.id_
+           << " finished. Paid " << accounts << " accounts in "
+           << elapsed.count() << " ms (" << rate << " accounts/s)"
+           << std::endl;
+
+    return output;
+}
+
+void PayoutEngine::Resume()
+{
+    // The box cache writes new files through immediately. The checkpoint
+    // file must already exist for its updates to be held by the cache and
+    // committed together with the payments they describe.
+    if (false ==
+        OTDB::Exists(OTFolders::Cron().Get(), PAYOUT_CHECKPOINT_FILE)) {
+        std::unique_ptr<OTDB::Storable> pEmpty(
+            OTDB::CreateObject(OTDB::STORED_OBJ_STRING_MAP));
+        auto pMap = dynamic_cast<OTDB::StringMap*>(pEmpty.get());
+
+        OT_ASSERT(nullptr != pMap);
+
+        store_checkpoints(*pMap);
+
+        return;
+    }
+
+    auto pStorable = load_checkpoints();
+    auto pMap = dynamic_cast<OTDB::StringMap*>(pStorable.get());
+
+    if (nullptr == pMap) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to load payout checkpoints." << std::endl;
+
+        return;
+    }
+
+    for (const auto& it : pMap->the_map) {
+        auto payout = deserialize(it.first, it.second);
+
+        if (payout.shares_.empty()) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Invalid checkpoint for dividend payout " << it.first
+                  << std::endl;
+
+            continue;
+        }
+
+        otWarn << OT_METHOD << __FUNCTION__ << ": Resuming dividend payout "
+               << payout.id_ << " at shard " << payout.next_shard_ << " of "
+               << UnitDefinition::AccountRecordShards << std::endl;
+        pay(payout, nullptr);
+    }
+}
+
+bool PayoutEngine::save_checkpoint(const Payout& payout) const
+{
+    auto pStorable = load_checkpoints();
+    auto pMap = dynamic_cast<OTDB::StringMap*>(pStorable.get());
+
+    if (nullptr == pMap) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to load payout checkpoints." << std::endl;
+
+        return false;
+    }
+
+    pMap->the_map[payout.id_] = serialize(payout);
+
+    return store_checkpoints(*pMap);
+}
+
+bool PayoutEngine::store_checkpoints(OTDB::StringMap& checkpoints) const
+{
+    return server_.cache_.Store(
+        OTDB::EncodeObject(checkpoints),
+        OTFolders::Cron().Get(),
+        PAYOUT_CHECKPOINT_FILE);
+}
+
+std::string PayoutEngine::serialize(const Payout& payout)
+{
+    std::unique_ptr<OTDB::Storable> pStorable(
+        OTDB::CreateObject(OTDB::STORED_OBJ_STRING_MAP));
+    auto pMap = dynamic_cast<OTDB::StringMap*>(pStorable.get());
+
+    OT_ASSERT(nullptr != pMap);
+
+    auto& map = pMap->the_map;
+    map["nym"] = payout.nym_;
+    map["shares"] = payout.shares_;
+    map["payout"] = payout.payout_unit_;
+    map["voucher"] = payout.voucher_account_;
+    map["memo"] = payout.memo_;
+    map["per_share"] = std::to_string(payout.per_share_);
+    map["total"] = std::to_string(payout.total_);
+    map["next_shard"] = std::to_string(payout.next_shard_);
+    map["paid"] = std::to_string(payout.paid_);
+    map["returned"] = std::to_string(payout.returned_);
+
+    return OTDB::EncodeObject(*pMap);
+}
+}  // namespace opentxs::server
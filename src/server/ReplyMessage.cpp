@@ -45,6 +45,7 @@
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Message.hpp"
 #include "opentxs/core/String.hpp"
+#include "opentxs/server/Metrics.hpp"
 #include "opentxs/server/Server.hpp"
 #include "opentxs/server/ReplyMessage.hpp"
 #include "opentxs/server/UserCommandProcessor.hpp"
@@ -98,6 +99,7 @@ void ReplyMessage::attach_request()
     const auto type = Message::Type(command);
 
     switch (type) {
+        case MessageType::getMarketData:
         case MessageType::getMarketOffers:
         case MessageType::getMarketRecentTrades:
         case MessageType::getNymMarketOffers:
@@ -152,6 +154,7 @@ void ReplyMessage::clear_request()
                    << command << " message." << std::endl;
             message_.m_ascInReferenceTo.Release();
         } break;
+        case MessageType::getMarketData:
         case MessageType::getMarketOffers:
         case MessageType::getMarketRecentTrades:
         case MessageType::getNymMarketOffers:
@@ -339,6 +342,12 @@ void ReplyMessage::SetRequestNumber(const RequestNumber number)
     message_.m_lNewRequestNum = number;
 }
 
+void ReplyMessage::SetStarting()
+{
+    message_.m_bStarting = true;
+    message_.m_bSuccess = false;
+}
+
 void ReplyMessage::SetSuccess(const bool success)
 {
     message_.m_bSuccess = success;
@@ -362,8 +371,11 @@ void ReplyMessage::SetTargetNym(const String& nymID)
 
 ReplyMessage::~ReplyMessage()
 {
-    message_.SignContract(signer_);
-    message_.SaveContract();
+    {
+        Metrics::Timer timer(Metrics::Phase::Sign);
+        message_.SignContract(signer_);
+        message_.SaveContract();
+    }
 
     if (drop_ && context_) {
         UserCommandProcessor::drop_reply_notice_to_nymbox(
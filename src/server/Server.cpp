@@ -43,6 +43,7 @@
 #include "opentxs/api/client/Wallet.hpp"
 #include "opentxs/api/crypto/Crypto.hpp"
 #include "opentxs/api/crypto/Encode.hpp"
+#include "opentxs/api/crypto/Hash.hpp"
 #include "opentxs/api/storage/Storage.hpp"
 #include "opentxs/api/Identity.hpp"
 #include "opentxs/api/Native.hpp"
@@ -53,9 +54,11 @@
 #include "opentxs/core/crypto/OTASCIIArmor.hpp"
 #include "opentxs/core/crypto/OTCachedKey.hpp"
 #include "opentxs/core/crypto/OTEnvelope.hpp"
+#include "opentxs/core/crypto/OTPassword.hpp"
 #include "opentxs/core/util/Assert.hpp"
 #include "opentxs/core/util/OTDataFolder.hpp"
 #include "opentxs/core/util/OTPaths.hpp"
+#include "opentxs/core/Data.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Ledger.hpp"
 #include "opentxs/core/Log.hpp"
@@ -76,6 +79,7 @@
 #include <sys/types.h>
 
 #include <fstream>
+#include <sstream>
 #include <string>
 #include <regex>
 
@@ -86,6 +90,7 @@
 #define SERVER_CONFIG_BIND_KEY "bindip"
 #define SERVER_CONFIG_COMMAND_KEY "command"
 #define SERVER_CONFIG_NOTIFY_KEY "notification"
+#define SERVER_CONFIG_NOTIFY_SECRET_KEY "notification_key"
 
 #define OT_METHOD "opentxs::Server::"
 
@@ -117,10 +122,12 @@ Server::Server(
     , mint_(mint)
     , storage_(storage)
     , wallet_(wallet)
+    , cache_()
     , mainFile_(*this, crypto_, wallet_)
     , notary_(*this, mint_, wallet_)
     , transactor_(this)
     , userCommandProcessor_(*this, config_, mint_, wallet_)
+    , payout_(*this)
     , m_strWalletFilename()
     , m_bReadOnly(false)
     , m_bShutdownFlag(false)
@@ -128,15 +135,79 @@ Server::Server(
     , m_strServerNymID()
     , m_nymServer()
     , m_Cron()
+    , cron_ready_(false)
+    , cron_thread_(nullptr)
+    , startup_lock_()
+    , startup_(std::chrono::steady_clock::now())
+    , phases_()
 {
 }
 
 void Server::ActivateCron()
 {
+    if (cron_thread_) {
+
+        return;
+    }
+
+    cron_thread_.reset(new std::thread(&Server::load_cron, this));
+}
+
+// Runs on cron_thread_ while the message processor is already serving
+// requests. Nothing else touches m_Cron until cron_ready_ is set.
+// Read once at startup, since every pingNotary reply reports the port
+void Server::load_notify_info()
+{
+    bool notUsed = false;
+    int64_t port = 0;
+
+    have_notify_port_ = config_.CheckSet_long(
+        SERVER_CONFIG_LISTEN_SECTION,
+        SERVER_CONFIG_NOTIFY_KEY,
+        DEFAULT_NOTIFY_PORT,
+        port,
+        notUsed);
+
+    port = (MAX_TCP_PORT < port) ? DEFAULT_NOTIFY_PORT : port;
+    port = (MIN_TCP_PORT > port) ? DEFAULT_NOTIFY_PORT : port;
+
+    notify_port_ = port;
+    String key{};
+    bool isNew{false};
+    config_.CheckSet_str(
+        SERVER_CONFIG_LISTEN_SECTION,
+        SERVER_CONFIG_NOTIFY_SECRET_KEY,
+        crypto_.Encode().Nonce(32),
+        key,
+        isNew);
+    notify_key_ = key.Get();
+
+    config_.Save();
+}
+
+void Server::load_cron()
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    if (false == m_Cron.LoadCron()) {
+        Log::vError(
+            "%s: Failed loading Cron file. (Did you just create "
+            "this server?)\n",
+            __FUNCTION__);
+    }
+
+    startup_phase("cron", start);
+    Log::vOutput(
+        0,
+        "%s: %zu markets will be loaded on first use.\n",
+        __FUNCTION__,
+        m_Cron.GetUnloadedMarketCount());
     Log::vOutput(
         1,
         "Server::ActivateCron: %s \n",
         m_Cron.ActivateCron() ? "(STARTED)" : "FAILED");
+    cron_ready_.store(true);
+    startup_phase("ready", startup_);
 }
 
 /// Currently the test server calls this 10 times per second.
@@ -146,6 +217,11 @@ void Server::ActivateCron()
 ///
 void Server::ProcessCron()
 {
+    if (false == cron_ready_.load()) {
+
+        return;
+    }
+
     if (!m_Cron.IsActivated()) return;
 
     bool bAddedNumbers = false;
@@ -182,6 +258,38 @@ const Nym& Server::GetServerNym() const { return m_nymServer; }
 
 bool Server::IsFlaggedForShutdown() const { return m_bShutdownFlag; }
 
+std::string Server::StartupReport() const
+{
+    Lock lock(startup_lock_);
+    std::stringstream output{};
+    output << "startup";
+
+    for (const auto& [name, elapsed] : phases_) {
+        output << " " << name << "_us=" << elapsed.count();
+    }
+
+    output << " cron_ready=" << (cron_ready_.load() ? "true" : "false")
+           << "\n";
+
+    return output.str();
+}
+
+void Server::startup_phase(
+    const std::string& name,
+    const std::chrono::steady_clock::time_point& start)
+{
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    Log::vOutput(
+        0,
+        "Server::%s: %s took %lld ms\n",
+        __FUNCTION__,
+        name.c_str(),
+        static_cast<long long>(elapsed.count() / 1000));
+    Lock lock(startup_lock_);
+    phases_.emplace_back(name, elapsed);
+}
+
 std::pair<std::string, std::string> Server::parse_seed_backup(
     const std::string& input) const
 {
@@ -490,6 +598,7 @@ void Server::CreateMainFile(bool& mainFileExists)
 void Server::Init(bool readOnly)
 {
     m_bReadOnly = readOnly;
+    startup_ = std::chrono::steady_clock::now();
 
     if (!OTDataFolder::IsInitialized()) {
         Log::vError("Unable to Init data folders!");
@@ -500,6 +609,8 @@ void Server::Init(bool readOnly)
         OT_FAIL;
     }
 
+    startup_phase("config", startup_);
+
     String dataPath;
     bool bGetDataFolderSuccess = OTDataFolder::Get(dataPath);
 
@@ -581,6 +692,15 @@ void Server::Init(bool readOnly)
     }
     OTDB::InitDefaultStorage(OTDB_DEFAULT_STORAGE, OTDB_DEFAULT_PACKER);
 
+    // Finish any box cache commit which was interrupted, before anything is
+    // read from storage
+    if ((false == readOnly) && (false == cache_.Recover())) {
+        Log::vError("Failed to apply the box cache journal.\n");
+        OT_FAIL;
+    }
+
+    const auto mainFileStart = std::chrono::steady_clock::now();
+
     // Load up the transaction number and other Server data members.
     bool mainFileExists = m_strWalletFilename.Exists()
                               ? OTDB::Exists(".", m_strWalletFilename.Get())
@@ -612,6 +732,9 @@ void Server::Init(bool readOnly)
         }
     }
 
+    startup_phase("main_file", mainFileStart);
+    load_notify_info();
+
     auto password = crypto_.Encode().Nonce(16);
     String notUsed;
     bool ignored;
@@ -619,9 +742,13 @@ void Server::Init(bool readOnly)
         "permissions", "admin_password", password, notUsed, ignored);
     config_.Save();
 
+    if (false == readOnly) {
+        payout_.Resume();
+    }
+
     // With the Server's private key loaded, and the latest transaction number
     // loaded, and all the various other data (contracts, etc) the server is now
-    // ready for operation!
+    // ready for operation! Except for cron, which is loaded by ActivateCron.
 }
 
 // msg, the request msg from payer, which is attached WHOLE to the Nymbox
@@ -996,6 +1123,32 @@ bool Server::GetConnectInfo(std::string& strHostname, uint32_t& nPort) const
     return (haveIP && havePort);
 }
 
+bool Server::GetNotifyInfo(uint32_t& nPort) const
+{
+    nPort = notify_port_;
+
+    return have_notify_port_;
+}
+
+std::string Server::NotificationTopic(const Identifier& nymID) const
+{
+    OTPassword key{};
+    key.setMemory(notify_key_.data(), notify_key_.size());
+    const std::string input = m_strNotaryID->str() + nymID.str();
+    const auto data = Data::Factory(input.data(), input.size());
+    OTPassword digest{};
+
+    if (false ==
+        crypto_.Hash().HMAC(proto::HASHTYPE_SHA256, key, data, digest)) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Failed to calculate notification topic." << std::endl;
+
+        return {};
+    }
+
+    return Data::Factory(digest.getMemory(), digest.getMemorySize())->asHex();
+}
+
 std::unique_ptr<OTPassword> Server::TransportKey(Data& pubkey) const
 {
     auto contract = wallet_.Server(m_strNotaryID);
@@ -1007,6 +1160,11 @@ std::unique_ptr<OTPassword> Server::TransportKey(Data& pubkey) const
 
 Server::~Server()
 {
+    if (cron_thread_) {
+        cron_thread_->join();
+        cron_thread_.reset();
+    }
+
     // PID -- Set it to 0 in the lock file so the next time we run OT, it knows
     // there isn't
     // another copy already running (otherwise we might wind up with two copies
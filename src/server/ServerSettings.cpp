@@ -54,6 +54,10 @@ int64_t ServerSettings::__min_market_scale = 1;
 int32_t ServerSettings::__heartbeat_no_requests = 10;
 // number of ms between each heartbeat.
 int32_t ServerSettings::__heartbeat_ms_between_beats = 100;
+// Endpoint of the request metrics socket. Disabled by default.
+std::string ServerSettings::__metrics_endpoint;
+// Only local metrics endpoints are bound unless this is set.
+bool ServerSettings::__metrics_allow_remote = false;
 // The Nym who's allowed to do certain
 // commands even if they are turned off.
 std::string ServerSettings::__override_nym_id;
@@ -0,0 +1,826 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include "opentxs/stdafx.hpp"
+
+#include "opentxs/server/SpentTokens.hpp"
+
+#if OT_CASH
+#include "opentxs/core/util/Assert.hpp"
+#include "opentxs/core/util/OTDataFolder.hpp"
+#include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/util/OTPaths.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/OTStorage.hpp"
+#include "opentxs/core/String.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+
+extern "C" {
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+}
+
+// Size of a token ID calculated with the default Identifier hash type
+#define SPENT_TOKEN_HASH_SIZE 20
+#define SPENT_TOKEN_LOG_MAGIC "OTSPLOG1"
+#define SPENT_TOKEN_INDEX_MAGIC "OTSPIDX1"
+#define SPENT_TOKEN_MAGIC_SIZE 8
+#define SPENT_TOKEN_INDEX_HEADER_SIZE 24
+#define SPENT_TOKEN_MIN_BUCKETS 4096
+#define SPENT_TOKEN_BLOOM_BITS_PER_TOKEN 16
+#define SPENT_TOKEN_BLOOM_HASHES 8
+#define SPENT_TOKEN_READ_CHUNK 4096
+
+#define OT_METHOD "opentxs::server::SpentTokens::"
+
+namespace opentxs::server
+{
+class SpentTokens::Store
+{
+public:
+    using Hash = std::string;
+
+    static Hash hash(const Identifier& tokenID);
+
+    /** Returns true if the token is spent or if an error occurs */
+    bool Contains(const Identifier& tokenID, const Hash& hash) const;
+    /** Durably appends the hashes to the log without indexing them
+     *
+     *  rollback is set to the log position which Revert() should restore.
+     */
+    bool Write(const std::vector<Hash>& hashes, off_t& rollback);
+    /** Makes records written by Write() visible to lookups */
+    bool Commit(const std::vector<Hash>& hashes);
+    /** Discards records written by Write() */
+    void Revert(const off_t rollback);
+
+    Store(const std::string& folder, const std::string& name);
+
+    ~Store();
+
+private:
+    const std::string name_;
+    const std::string log_path_;
+    const std::string index_path_;
+    const bool legacy_{false};
+    int log_{-1};
+    int index_{-1};
+    std::uint64_t records_{0};
+    std::uint64_t buckets_{0};
+    std::vector<std::uint64_t> bloom_{};
+
+    static std::uint64_t word(const Hash& hash, const std::size_t offset);
+
+    std::uint64_t capacity() const { return buckets_ / 2; }
+    bool bloom_check(const Hash& hash) const;
+    bool index_contains(const Hash& hash, bool& error) const;
+    bool legacy_contains(const Identifier& tokenID) const;
+    std::uint64_t log_offset(const std::uint64_t record) const;
+    bool read_exact(int fd, void* out, std::size_t size, off_t position) const;
+    bool write_exact(
+        int fd,
+        const void* in,
+        std::size_t size,
+        off_t position) const;
+
+    void bloom_insert(const Hash& hash);
+    bool index_insert(const Hash& hash);
+    bool index_write_header(const std::uint64_t covered);
+    bool open_index();
+    bool open_log();
+    bool rebuild();
+    template <typename F>
+    bool scan_log(const std::uint64_t start, F visitor) const;
+
+    Store() = delete;
+    Store(const Store&) = delete;
+    Store(Store&&) = delete;
+    Store& operator=(const Store&) = delete;
+    Store& operator=(Store&&) = delete;
+};
+
+SpentTokens::Store::Store(const std::string& folder, const std::string& name)
+    : name_(name)
+    , log_path_(folder + name + ".log")
+    , index_path_(folder + name + ".idx")
+    , legacy_(OTDB::Exists(OTFolders::Spent().Get(), name))
+{
+    if (false == open_log()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to open " << log_path_
+              << std::endl;
+
+        return;
+    }
+
+    if (false == open_index()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to open "
+              << index_path_ << std::endl;
+    }
+}
+
+bool SpentTokens::Store::bloom_check(const Hash& hash) const
+{
+    const std::uint64_t bits = bloom_.size() * 64;
+
+    if (0 == bits) {
+
+        return true;
+    }
+
+    const auto h1 = word(hash, 0);
+    const auto h2 = word(hash, 8) | 1;
+
+    for (std::uint64_t i = 0; i < SPENT_TOKEN_BLOOM_HASHES; ++i) {
+        const auto bit = (h1 + i * h2) % bits;
+
+        if (0 == (bloom_[bit / 64] & (std::uint64_t(1) << (bit % 64)))) {
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void SpentTokens::Store::bloom_insert(const Hash& hash)
+{
+    const std::uint64_t bits = bloom_.size() * 64;
+
+    if (0 == bits) {
+
+        return;
+    }
+
+    const auto h1 = word(hash, 0);
+    const auto h2 = word(hash, 8) | 1;
+
+    for (std::uint64_t i = 0; i < SPENT_TOKEN_BLOOM_HASHES; ++i) {
+        const auto bit = (h1 + i * h2) % bits;
+        bloom_[bit / 64] |= (std::uint64_t(1) << (bit % 64));
+    }
+}
+
+bool SpentTokens::Store::Commit(const std::vector<Hash>& hashes)
+{
+    if ((-1 == index_) || (records_ > capacity())) {
+
+        return rebuild();
+    }
+
+    for (const auto& hash : hashes) {
+        if (false == index_insert(hash)) {
+
+            return rebuild();
+        }
+
+        bloom_insert(hash);
+    }
+
+    return index_write_header(records_);
+}
+
+bool SpentTokens::Store::Contains(const Identifier& tokenID, const Hash& hash)
+    const
+{
+    if ((-1 == log_) || (-1 == index_)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Store " << name_
+              << " is not available." << std::endl;
+
+        return true;
+    }
+
+    if (SPENT_TOKEN_HASH_SIZE != hash.size()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Invalid token hash."
+              << std::endl;
+
+        return true;
+    }
+
+    if (bloom_check(hash)) {
+        bool error{false};
+        const auto found = index_contains(hash, error);
+
+        if (found || error) {
+
+            return true;
+        }
+    }
+
+    return legacy_contains(tokenID);
+}
+
+SpentTokens::Store::Hash SpentTokens::Store::hash(const Identifier& tokenID)
+{
+    return Hash(
+        static_cast<const char*>(tokenID.GetPointer()), tokenID.GetSize());
+}
+
+bool SpentTokens::Store::index_contains(const Hash& hash, bool& error) const
+{
+    error = false;
+    std::string slot(SPENT_TOKEN_HASH_SIZE, '\0');
+    const std::string empty(SPENT_TOKEN_HASH_SIZE, '\0');
+    auto bucket = word(hash, 0) % buckets_;
+
+    for (std::uint64_t i = 0; i < buckets_; ++i) {
+        const off_t position =
+            SPENT_TOKEN_INDEX_HEADER_SIZE + bucket * SPENT_TOKEN_HASH_SIZE;
+
+        if (false ==
+            read_exact(index_, &slot[0], SPENT_TOKEN_HASH_SIZE, position)) {
+            error = true;
+
+            return false;
+        }
+
+        if (slot == hash) {
+
+            return true;
+        }
+
+        if (slot == empty) {
+
+            return false;
+        }
+
+        bucket = (bucket + 1) % buckets_;
+    }
+
+    return false;
+}
+
+bool SpentTokens::Store::index_insert(const Hash& hash)
+{
+    std::string slot(SPENT_TOKEN_HASH_SIZE, '\0');
+    const std::string empty(SPENT_TOKEN_HASH_SIZE, '\0');
+    auto bucket = word(hash, 0) % buckets_;
+
+    for (std::uint64_t i = 0; i < buckets_; ++i) {
+        const off_t position =
+            SPENT_TOKEN_INDEX_HEADER_SIZE + bucket * SPENT_TOKEN_HASH_SIZE;
+
+        if (false ==
+            read_exact(index_, &slot[0], SPENT_TOKEN_HASH_SIZE, position)) {
+
+            return false;
+        }
+
+        if (slot == hash) {
+
+            return true;
+        }
+
+        if (slot == empty) {
+            return write_exact(
+                index_, hash.data(), SPENT_TOKEN_HASH_SIZE, position);
+        }
+
+        bucket = (bucket + 1) % buckets_;
+    }
+
+    return false;
+}
+
+bool SpentTokens::Store::index_write_header(const std::uint64_t covered)
+{
+    char header[SPENT_TOKEN_INDEX_HEADER_SIZE]{};
+    std::memcpy(header, SPENT_TOKEN_INDEX_MAGIC, SPENT_TOKEN_MAGIC_SIZE);
+    std::memcpy(header + 8, &buckets_, sizeof(buckets_));
+    std::memcpy(header + 16, &covered, sizeof(covered));
+
+    return write_exact(index_, header, sizeof(header), 0);
+}
+
+bool SpentTokens::Store::legacy_contains(const Identifier& tokenID) const
+{
+    if (false == legacy_) {
+
+        return false;
+    }
+
+    const String hash(tokenID);
+
+    if (OTDB::Exists(OTFolders::Spent().Get(), name_, hash.Get())) {
+        otOut << OT_METHOD << __FUNCTION__ << ": Token was already spent: "
+              << OTFolders::Spent() << Log::PathSeparator() << name_
+              << Log::PathSeparator() << hash << std::endl;
+
+        return true;
+    }
+
+    return false;
+}
+
+std::uint64_t SpentTokens::Store::log_offset(const std::uint64_t record) const
+{
+    return SPENT_TOKEN_MAGIC_SIZE + record * SPENT_TOKEN_HASH_SIZE;
+}
+
+bool SpentTokens::Store::open_index()
+{
+    index_ = ::open(index_path_.c_str(), O_RDWR | O_CREAT, 0600);
+
+    if (-1 == index_) {
+
+        return false;
+    }
+
+    char header[SPENT_TOKEN_INDEX_HEADER_SIZE]{};
+    std::uint64_t covered{0};
+
+    if (read_exact(index_, header, sizeof(header), 0) &&
+        (0 == std::memcmp(
+                  header, SPENT_TOKEN_INDEX_MAGIC, SPENT_TOKEN_MAGIC_SIZE))) {
+        std::memcpy(&buckets_, header + 8, sizeof(buckets_));
+        std::memcpy(&covered, header + 16, sizeof(covered));
+    } else {
+        buckets_ = 0;
+    }
+
+    struct stat info {
+    };
+    const auto expected =
+        SPENT_TOKEN_INDEX_HEADER_SIZE + buckets_ * SPENT_TOKEN_HASH_SIZE;
+    const bool valid = (0 != buckets_) && (0 == ::fstat(index_, &info)) &&
+                       (static_cast<std::uint64_t>(info.st_size) == expected) &&
+                       (covered <= records_) && (records_ <= capacity());
+
+    if (false == valid) {
+        otWarn << OT_METHOD << __FUNCTION__ << ": Rebuilding index for "
+               << name_ << std::endl;
+
+        return rebuild();
+    }
+
+    const std::uint64_t bits = std::max<std::uint64_t>(
+        capacity() * SPENT_TOKEN_BLOOM_BITS_PER_TOKEN, 64);
+    bloom_.assign((bits + 63) / 64, 0);
+
+    // Records which were logged but not indexed before a crash are indexed
+    // here. Everything is added to the Bloom filter.
+    const bool scanned = scan_log(0, [&](const Hash& hash, std::uint64_t n) {
+        bloom_insert(hash);
+
+        if (n >= covered) {
+
+            return index_insert(hash);
+        }
+
+        return true;
+    });
+
+    if (false == scanned) {
+
+        return rebuild();
+    }
+
+    return index_write_header(records_);
+}
+
+bool SpentTokens::Store::open_log()
+{
+    log_ = ::open(log_path_.c_str(), O_RDWR | O_CREAT, 0600);
+
+    if (-1 == log_) {
+
+        return false;
+    }
+
+    struct stat info {
+    };
+
+    if (0 != ::fstat(log_, &info)) {
+
+        return false;
+    }
+
+    if (0 == info.st_size) {
+        if (false == write_exact(
+                         log_,
+                         SPENT_TOKEN_LOG_MAGIC,
+                         SPENT_TOKEN_MAGIC_SIZE,
+                         0)) {
+
+            return false;
+        }
+
+        records_ = 0;
+
+        return 0 == ::fsync(log_);
+    }
+
+    char magic[SPENT_TOKEN_MAGIC_SIZE]{};
+
+    if ((false == read_exact(log_, magic, sizeof(magic), 0)) ||
+        (0 != std::memcmp(magic, SPENT_TOKEN_LOG_MAGIC, sizeof(magic)))) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Corrupt log file "
+              << log_path_ << std::endl;
+        ::close(log_);
+        log_ = -1;
+
+        return false;
+    }
+
+    const std::uint64_t body = info.st_size - SPENT_TOKEN_MAGIC_SIZE;
+    records_ = body / SPENT_TOKEN_HASH_SIZE;
+
+    // A partial record can only be the result of an interrupted append which
+    // was never reported as successful.
+    if (0 != body % SPENT_TOKEN_HASH_SIZE) {
+        otErr << OT_METHOD << __FUNCTION__
+              << ": Discarding incomplete record in " << log_path_
+              << std::endl;
+
+        if (0 != ::ftruncate(log_, log_offset(records_))) {
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool SpentTokens::Store::read_exact(
+    int fd,
+    void* out,
+    std::size_t size,
+    off_t position) const
+{
+    auto* output = static_cast<char*>(out);
+
+    while (0 < size) {
+        const auto read = ::pread(fd, output, size, position);
+
+        if (0 >= read) {
+
+            return false;
+        }
+
+        output += read;
+        size -= read;
+        position += read;
+    }
+
+    return true;
+}
+
+bool SpentTokens::Store::rebuild()
+{
+    std::uint64_t buckets{SPENT_TOKEN_MIN_BUCKETS};
+
+    // Leave room for the store to double before the next rebuild
+    while ((buckets / 2) < (records_ * 2)) {
+        buckets *= 2;
+    }
+
+    const auto temp = index_path_ + ".tmp";
+    const int fd = ::open(temp.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+
+    if (-1 == fd) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to create " << temp
+              << std::endl;
+
+        return false;
+    }
+
+    if (0 != ::ftruncate(
+                 fd,
+                 SPENT_TOKEN_INDEX_HEADER_SIZE +
+                     buckets * SPENT_TOKEN_HASH_SIZE)) {
+        ::close(fd);
+
+        return false;
+    }
+
+    if (-1 != index_) {
+        ::close(index_);
+    }
+
+    index_ = fd;
+    buckets_ = buckets;
+    const std::uint64_t bits = capacity() * SPENT_TOKEN_BLOOM_BITS_PER_TOKEN;
+    bloom_.assign((bits + 63) / 64, 0);
+    const bool scanned = scan_log(0, [&](const Hash& hash, std::uint64_t) {
+        bloom_insert(hash);
+
+        return index_insert(hash);
+    });
+
+    if ((false == scanned) || (false == index_write_header(records_)) ||
+        (0 != ::fsync(index_)) ||
+        (0 != ::rename(temp.c_str(), index_path_.c_str()))) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to rebuild index for "
+              << name_ << std::endl;
+        ::close(index_);
+        index_ = -1;
+        bloom_.clear();
+
+        return false;
+    }
+
+    return true;
+}
+
+void SpentTokens::Store::Revert(const off_t rollback)
+{
+    if (0 != ::ftruncate(log_, rollback)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to revert " << log_path_
+              << std::endl;
+    }
+
+    ::fsync(log_);
+    records_ = (rollback - SPENT_TOKEN_MAGIC_SIZE) / SPENT_TOKEN_HASH_SIZE;
+}
+
+template <typename F>
+bool SpentTokens::Store::scan_log(const std::uint64_t start, F visitor) const
+{
+    struct stat info {
+    };
+
+    if (0 != ::fstat(log_, &info)) {
+
+        return false;
+    }
+
+    const std::uint64_t end =
+        (info.st_size - SPENT_TOKEN_MAGIC_SIZE) / SPENT_TOKEN_HASH_SIZE;
+    std::vector<char> buffer(SPENT_TOKEN_READ_CHUNK * SPENT_TOKEN_HASH_SIZE);
+
+    for (auto n = start; n < end;) {
+        const auto count =
+            std::min<std::uint64_t>(end - n, SPENT_TOKEN_READ_CHUNK);
+
+        if (false == read_exact(
+                         log_,
+                         buffer.data(),
+                         count * SPENT_TOKEN_HASH_SIZE,
+                         log_offset(n))) {
+
+            return false;
+        }
+
+        for (std::uint64_t i = 0; i < count; ++i, ++n) {
+            const Hash hash(
+                buffer.data() + (i * SPENT_TOKEN_HASH_SIZE),
+                SPENT_TOKEN_HASH_SIZE);
+
+            if (false == visitor(hash, n)) {
+
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+std::uint64_t SpentTokens::Store::word(
+    const Hash& hash,
+    const std::size_t offset)
+{
+    std::uint64_t output{0};
+    std::memcpy(&output, hash.data() + offset, sizeof(output));
+
+    return output;
+}
+
+bool SpentTokens::Store::Write(const std::vector<Hash>& hashes, off_t& rollback)
+{
+    if (-1 == log_) {
+
+        return false;
+    }
+
+    std::string buffer{};
+    buffer.reserve(hashes.size() * SPENT_TOKEN_HASH_SIZE);
+
+    for (const auto& hash : hashes) {
+        buffer.append(hash);
+    }
+
+    rollback = log_offset(records_);
+
+    if (false ==
+        write_exact(log_, buffer.data(), buffer.size(), rollback)) {
+        Revert(rollback);
+
+        return false;
+    }
+
+    if (0 != ::fsync(log_)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to sync " << log_path_
+              << std::endl;
+        Revert(rollback);
+
+        return false;
+    }
+
+    records_ += hashes.size();
+
+    return true;
+}
+
+bool SpentTokens::Store::write_exact(
+    int fd,
+    const void* in,
+    std::size_t size,
+    off_t position) const
+{
+    const auto* input = static_cast<const char*>(in);
+
+    while (0 < size) {
+        const auto written = ::pwrite(fd, input, size, position);
+
+        if (0 >= written) {
+
+            return false;
+        }
+
+        input += written;
+        size -= written;
+        position += written;
+    }
+
+    return true;
+}
+
+SpentTokens::Store::~Store()
+{
+    if (-1 != index_) {
+        ::close(index_);
+    }
+
+    if (-1 != log_) {
+        ::close(log_);
+    }
+}
+
+SpentTokens::SpentTokens()
+    : lock_()
+    , stores_()
+{
+}
+
+SpentTokens::Store& SpentTokens::get_store(
+    const Lock& lock,
+    const Identifier& unitID,
+    const std::uint32_t series) const
+{
+    OT_ASSERT(lock.owns_lock())
+
+    const auto name = store_name(unitID, series);
+    auto& store = stores_[name];
+
+    if (false == bool(store)) {
+        bool created{false};
+        String folder{""};
+        const auto haveFolder = OTPaths::AppendFolder(
+            folder, OTDataFolder::Get(), OTFolders::Spent());
+
+        OT_ASSERT(haveFolder)
+
+        OTPaths::BuildFolderPath(folder, created);
+        store.reset(new Store(folder.Get(), name));
+
+        OT_ASSERT(store)
+    }
+
+    return *store;
+}
+
+bool SpentTokens::IsSpent(
+    const Identifier& unitID,
+    const std::uint32_t series,
+    const Identifier& tokenID) const
+{
+    Lock lock(lock_);
+
+    return get_store(lock, unitID, series)
+        .Contains(tokenID, Store::hash(tokenID));
+}
+
+bool SpentTokens::Spend(const Identifier& unitID, const Batch& tokens) const
+{
+    Lock lock(lock_);
+    std::map<Store*, std::vector<Store::Hash>> pending{};
+    std::set<Store::Hash> unique{};
+
+    for (const auto& [series, ids] : tokens) {
+        auto& store = get_store(lock, unitID, series);
+        auto& hashes = pending[&store];
+
+        for (const auto& id : ids) {
+            auto hash = Store::hash(id);
+
+            if (false == unique.emplace(hash).second) {
+                otOut << OT_METHOD << __FUNCTION__
+                      << ": Token appears more than once in batch."
+                      << std::endl;
+
+                return false;
+            }
+
+            if (store.Contains(id, hash)) {
+                otOut << OT_METHOD << __FUNCTION__
+                      << ": Token was already spent." << std::endl;
+
+                return false;
+            }
+
+            hashes.emplace_back(std::move(hash));
+        }
+    }
+
+    std::map<Store*, off_t> written{};
+
+    for (const auto& [store, hashes] : pending) {
+        off_t rollback{0};
+
+        if (false == store->Write(hashes, rollback)) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed to record spent tokens." << std::endl;
+
+            for (const auto& [done, position] : written) {
+                done->Revert(position);
+            }
+
+            return false;
+        }
+
+        written.emplace(store, rollback);
+    }
+
+    // Every record is durable at this point. A failure to update an index is
+    // repaired when the store is next opened.
+    for (const auto& [store, hashes] : pending) {
+        if (false == store->Commit(hashes)) {
+            otErr << OT_METHOD << __FUNCTION__
+                  << ": Failed to update spent token index." << std::endl;
+        }
+    }
+
+    return true;
+}
+
+std::string SpentTokens::store_name(
+    const Identifier& unitID,
+    const std::uint32_t series)
+{
+    String output{};
+    output.Format("%s.%d", String(unitID).Get(), series);
+
+    return output.Get();
+}
+
+OTIdentifier SpentTokens::TokenID(const String& spendableToken)
+{
+    auto output = Identifier::Factory();
+    output->CalculateDigest(spendableToken);
+
+    return output;
+}
+
+SpentTokens::~SpentTokens() = default;
+}  // namespace opentxs::server
+#endif  // OT_CASH
@@ -71,8 +71,10 @@
 #include "opentxs/core/OTStorage.hpp"
 #include "opentxs/core/OTTransaction.hpp"
 #include "opentxs/core/String.hpp"
+#include "opentxs/server/BoxCache.hpp"
 #include "opentxs/server/Macros.hpp"
 #include "opentxs/server/MainFile.hpp"
+#include "opentxs/server/Metrics.hpp"
 #include "opentxs/server/Notary.hpp"
 #include "opentxs/server/Server.hpp"
 #include "opentxs/server/ReplyMessage.hpp"
@@ -360,6 +362,28 @@ void UserCommandProcessor::check_acknowledgements(ReplyMessage& reply) const
     reply.SetAcknowledgments(context);
 }
 
+std::string UserCommandProcessor::box_folder(const Ledger& box)
+{
+    switch (box.GetType()) {
+        case Ledger::nymbox: {
+
+            return OTFolders::Nymbox().Get();
+        }
+        case Ledger::inbox: {
+
+            return OTFolders::Inbox().Get();
+        }
+        case Ledger::outbox: {
+
+            return OTFolders::Outbox().Get();
+        }
+        default: {
+
+            return {};
+        }
+    }
+}
+
 bool UserCommandProcessor::check_client_isnt_server(
     const Identifier& nymID,
     const Nym& serverNym)
@@ -431,6 +455,22 @@ bool UserCommandProcessor::check_client_nym(ReplyMessage& reply) const
     return true;
 }
 
+// Requests which use cron or the markets are refused with a retryable status
+// until the cron file has finished loading in the background.
+bool UserCommandProcessor::check_cron_ready(ReplyMessage& reply) const
+{
+    if (server_.CronReady()) {
+
+        return true;
+    }
+
+    otErr << OT_METHOD << __FUNCTION__
+          << ": Cron is still loading. Rejecting request." << std::endl;
+    reply.SetStarting();
+
+    return false;
+}
+
 bool UserCommandProcessor::check_message_notary(
     const Identifier& notaryID,
     const Identifier& realNotaryID)
@@ -1014,6 +1054,11 @@ bool UserCommandProcessor::cmd_get_market_list(ReplyMessage& reply) const
 
     OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_get_market_list);
 
+    if (false == check_cron_ready(reply)) {
+
+        return true;
+    }
+
     OTASCIIArmor output{};
     std::int32_t count{0};
     reply.SetSuccess(server_.m_Cron.GetMarketList(output, count));
@@ -1038,6 +1083,11 @@ bool UserCommandProcessor::cmd_get_market_offers(ReplyMessage& reply) const
 
     OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_get_market_offers);
 
+    if (false == check_cron_ready(reply)) {
+
+        return true;
+    }
+
     auto depth = msgIn.m_lDepth;
 
     if (depth < 0) {
@@ -1076,6 +1126,11 @@ bool UserCommandProcessor::cmd_get_market_recent_trades(
 
     OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_get_market_recent_trades);
 
+    if (false == check_cron_ready(reply)) {
+
+        return true;
+    }
+
     auto market = server_.m_Cron.GetMarket(Identifier(msgIn.m_strNymID2));
 
     if (nullptr == market) {
@@ -1099,6 +1154,40 @@ bool UserCommandProcessor::cmd_get_market_recent_trades(
     return true;
 }
 
+// Get trades or OHLCV bars for a time range on a specific market.
+bool UserCommandProcessor::cmd_get_market_data(ReplyMessage& reply) const
+{
+    const auto& msgIn = reply.Original();
+    reply.SetTargetNym(msgIn.m_strNymID2);
+
+    OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_get_market_recent_trades);
+
+    if (false == check_cron_ready(reply)) {
+
+        return true;
+    }
+
+    auto market = server_.m_Cron.GetMarket(Identifier(msgIn.m_strNymID2));
+
+    if (nullptr == market) {
+
+        return false;
+    }
+
+    String output;
+    std::int32_t count = 0;
+    reply.SetSuccess(market->GetMarketData(
+        msgIn.m_lDepth, msgIn.m_lRangeStart, msgIn.m_lRangeEnd, output, count));
+
+    if (reply.Success()) {
+        reply.SetDepth(count);
+        reply.ClearRequest();
+        reply.SetPayload(output);
+    }
+
+    return true;
+}
+
 #if OT_CASH
 bool UserCommandProcessor::cmd_get_mint(ReplyMessage& reply) const
 {
@@ -1108,11 +1197,11 @@ bool UserCommandProcessor::cmd_get_mint(ReplyMessage& reply) const
     OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_get_mint);
 
     const auto& unitID = msgIn.m_strInstrumentDefinitionID;
-    auto mint = mint_.GetPublicMint(Identifier(unitID));
+    auto mint = mint_.GetPublicMintPayload(Identifier(unitID));
 
     if (mint) {
         reply.SetSuccess(true);
-        reply.SetPayload(String(*mint));
+        reply.SetPayload(*mint);
     }
 
     return true;
@@ -1126,6 +1215,11 @@ bool UserCommandProcessor::cmd_get_nym_market_offers(ReplyMessage& reply) const
 
     OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_get_nym_market_offers);
 
+    if (false == check_cron_ready(reply)) {
+
+        return true;
+    }
+
     const auto& nymID = reply.Context().RemoteNym().ID();
 
     OTASCIIArmor output{};
@@ -1521,6 +1615,18 @@ bool UserCommandProcessor::cmd_notarize_transaction(ReplyMessage& reply) const
         return false;
     }
 
+    if (uses_cron(*input) && (false == check_cron_ready(reply))) {
+
+        return true;
+    }
+
+    // Transactions are applied in order. The accounts, boxes and box receipts
+    // they share are read and written through the notary cache, so each file
+    // is loaded and has its signature checked once per request, and is
+    // written to storage once, before the reply is sent. The boxes they
+    // change are signed once, with their final contents, when the batch
+    // goes out of scope.
+    BoxCache::Batch batch(server_.cache_);
     // Returning before this point will result in the reply message
     // m_bSuccess = false, and no reply ledger
     FinalizeResponse response(serverNym, reply, *responseLedger);
@@ -1586,7 +1692,37 @@ bool UserCommandProcessor::cmd_notarize_transaction(ReplyMessage& reply) const
 
 bool UserCommandProcessor::cmd_ping_notary(ReplyMessage& reply) const
 {
-    reply.SetSuccess(check_ping_notary(reply.Original()));
+    const auto& msgIn = reply.Original();
+    const bool verified = check_ping_notary(msgIn);
+    reply.SetSuccess(verified);
+    std::uint32_t port{0};
+
+    // The notification port is configured independently of the command port,
+    // so clients learn it here instead of deriving it from the contract
+    if (server_.GetNotifyInfo(port)) {
+        reply.SetDepth(port);
+    }
+
+    if (false == verified) {
+
+        return true;
+    }
+
+    // The notification topic is only revealed to a registered nym which
+    // signed the ping with its own authentication key
+    const auto nym = wallet_.Nym(Identifier(msgIn.m_strNymID));
+
+    if (false == bool(nym)) {
+
+        return true;
+    }
+
+    String authKey{};
+    nym->GetPublicAuthKey().GetPublicKey(authKey);
+
+    if (authKey == msgIn.m_strNymPublicKey) {
+        reply.SetPayload(String(server_.NotificationTopic(nym->ID())));
+    }
 
     return true;
 }
@@ -1769,6 +1905,11 @@ bool UserCommandProcessor::cmd_process_nymbox(ReplyMessage& reply) const
         return false;
     }
 
+    if (uses_cron(*input) && (false == check_cron_ready(reply))) {
+
+        return true;
+    }
+
     // Returning before this point will result in the reply message
     // m_bSuccess = false, and no reply ledger
     FinalizeResponse response(serverNym, reply, *responseLedger);
@@ -2417,6 +2558,11 @@ bool UserCommandProcessor::cmd_trigger_clause(ReplyMessage& reply) const
 
     OT_ENFORCE_PERMISSION_MSG(ServerSettings::__cmd_trigger_clause);
 
+    if (false == check_cron_ready(reply)) {
+
+        return true;
+    }
+
     const auto& number = msgIn.m_lTransactionNum;
     const auto& context = reply.Context();
     const auto& nym = context.RemoteNym();
@@ -2836,6 +2982,15 @@ std::unique_ptr<Account> UserCommandProcessor::load_account(
         return {};
     }
 
+    // Unchanged accounts are not verified again
+    const auto& cache = server_.cache_;
+    const String id(accountID);
+
+    if (cache.Verified(OTFolders::Account().Get(), id.Get())) {
+
+        return account;
+    }
+
     if (false == account->VerifySignature(server_.m_nymServer)) {
         otErr << OT_METHOD << __FUNCTION__ << ": Invalid signature on account "
               << String(accountID) << " for " << String(nymID) << std::endl;
@@ -2843,6 +2998,8 @@ std::unique_ptr<Account> UserCommandProcessor::load_account(
         return {};
     }
 
+    cache.SetVerified(OTFolders::Account().Get(), id.Get());
+
     return account;
 }
 
@@ -3007,23 +3164,35 @@ bool UserCommandProcessor::ProcessUserCommand(
 
     switch (type) {
         case MessageType::pingNotary: {
+            Metrics::Timer timer(Metrics::Phase::Handler);
+
             return cmd_ping_notary(reply);
         }
         case MessageType::registerNym: {
+            Metrics::Timer timer(Metrics::Phase::Handler);
+
             return cmd_register_nym(reply);
         }
         default: {
         }
     }
 
-    if (false == check_client_nym(reply)) {
+    {
+        Metrics::Timer timer(Metrics::Phase::CheckNym);
 
-        return false;
+        if (false == check_client_nym(reply)) {
+
+            return false;
+        }
     }
 
-    if (false == reply.LoadContext()) {
+    {
+        Metrics::Timer timer(Metrics::Phase::LoadContext);
 
-        return false;
+        if (false == reply.LoadContext()) {
+
+            return false;
+        }
     }
 
     OT_ASSERT(reply.HaveContext());
@@ -3069,6 +3238,8 @@ bool UserCommandProcessor::ProcessUserCommand(
     // verifying the Nym, or about dealing with the Request Number. It's all
     // handled in here.
     check_acknowledgements(reply);
+    // Destroyed before reply, so signing the reply is not counted here
+    Metrics::Timer handler(Metrics::Phase::Handler);
 
     switch (type) {
         case MessageType::getRequestNumber: {
@@ -3141,6 +3312,9 @@ bool UserCommandProcessor::ProcessUserCommand(
         case MessageType::getMarketRecentTrades: {
             return cmd_get_market_recent_trades(reply);
         }
+        case MessageType::getMarketData: {
+            return cmd_get_market_data(reply);
+        }
         case MessageType::getNymMarketOffers: {
             return cmd_get_nym_market_offers(reply);
         }
@@ -3275,6 +3449,29 @@ bool UserCommandProcessor::save_outbox(
     return true;
 }
 
+bool UserCommandProcessor::uses_cron(const Ledger& input)
+{
+    for (const auto& it : input.GetTransactionMap()) {
+        const auto& transaction = it.second;
+
+        OT_ASSERT(nullptr != transaction);
+
+        switch (transaction->GetType()) {
+            case OTTransaction::marketOffer:
+            case OTTransaction::paymentPlan:
+            case OTTransaction::smartContract:
+            case OTTransaction::cancelCronItem: {
+
+                return true;
+            }
+            default: {
+            }
+        }
+    }
+
+    return false;
+}
+
 bool UserCommandProcessor::verify_box(
     const Identifier& ownerID,
     Ledger& box,
@@ -3296,6 +3493,17 @@ bool UserCommandProcessor::verify_box(
             return false;
         }
     } else {
+        // Unchanged boxes are not verified again
+        const auto& cache = server_.cache_;
+        const auto folder = box_folder(box);
+        const String notaryID(box.GetRealNotaryID());
+        const String boxID(box.GetRealAccountID());
+
+        if (cache.Verified(folder, notaryID.Get(), boxID.Get())) {
+
+            return true;
+        }
+
         if (false == box.VerifySignature(nym)) {
             otErr << OT_METHOD << __FUNCTION__
                   << ": Unable to verify signature for " << String(ownerID)
@@ -3303,6 +3511,8 @@ bool UserCommandProcessor::verify_box(
 
             return false;
         }
+
+        cache.SetVerified(folder, notaryID.Get(), boxID.Get());
     }
 
     return true;
@@ -62,6 +62,13 @@ Plugin::Plugin(
 {
 }
 
+bool Plugin::Archived(const std::string&) const
+{
+    // Bucketed plugins garbage collect the inactive bucket, so the presence
+    // of an object says nothing about whether it will survive
+    return false;
+}
+
 bool Plugin::Load(
     const std::string& key,
     const bool checking,
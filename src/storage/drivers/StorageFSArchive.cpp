@@ -40,6 +40,7 @@
 #include "opentxs/storage/drivers/StorageFSArchive.hpp"
 
 #if OT_STORAGE_FS
+#include "opentxs/core/crypto/OTASCIIArmor.hpp"
 #include "opentxs/core/crypto/OTPassword.hpp"
 #include "opentxs/core/crypto/OTPasswordData.hpp"
 #include "opentxs/core/crypto/SymmetricKey.hpp"
@@ -53,11 +54,15 @@
 #include <boost/iostreams/device/file_descriptor.hpp>
 #include <boost/iostreams/stream.hpp>
 
+#include <zlib.h>
+#include <algorithm>
 #include <cstdio>
 #include <cstdint>
 #include <fstream>
 #include <ios>
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
 #include <thread>
 #include <vector>
 
@@ -72,6 +77,9 @@ extern "C" {
 }
 
 #define ROOT_FILE_EXTENSION ".hash"
+#define ARCHIVE_MANIFEST_FILE "manifest"
+#define ARCHIVE_SEGMENT_DIRECTORY "segments"
+#define ARCHIVE_SEGMENT_SIZE (32 * 1024 * 1024)
 
 #define OT_METHOD "opentxs::StorageFSArchive::"
 
@@ -89,10 +97,30 @@ StorageFSArchive::StorageFSArchive(
     : ot_super(storage, config, hash, random, folder, bucket)
     , encryption_key_(key.release())
     , encrypted_(bool(encryption_key_))
+    , segmented_(encrypted_)
+    , segment_lock_()
+    , manifest_()
+    , pending_()
+    , pending_bytes_(0)
+    , next_segment_(0)
+    , cached_segment_id_(0)
+    , cached_segment_()
 {
     Init_StorageFSArchive();
 }
 
+bool StorageFSArchive::Archived(const std::string& key) const
+{
+    if (false == segmented_) {
+
+        return false;
+    }
+
+    Lock lock(segment_lock_);
+
+    return (0 < manifest_.count(key)) || (0 < pending_.count(key));
+}
+
 std::string StorageFSArchive::calculate_path(
     const std::string& key,
     const bool,
@@ -139,20 +167,217 @@ void StorageFSArchive::Cleanup()
 
 void StorageFSArchive::Cleanup_StorageFSArchive()
 {
-    // future cleanup actions go here
+    if (segmented_ && ready_.get()) {
+        Lock lock(segment_lock_);
+        flush_segment(lock);
+    }
 }
 
 bool StorageFSArchive::EmptyBucket(const bool) const { return true; }
 
+StorageFSArchive* StorageFSArchive::Factory(
+    const api::storage::Storage& storage,
+    const StorageConfig& config,
+    const Digest& hash,
+    const Random& random,
+    const Flag& bucket,
+    const std::string& folder,
+    std::unique_ptr<SymmetricKey>& key)
+{
+    return new StorageFSArchive(
+        storage, config, hash, random, bucket, folder, key);
+}
+
+// Packs every pending object into the next segment, then appends their
+// locations to the manifest. A segment only becomes visible once its
+// manifest entries are synced, so a crash leaves at worst an orphaned file.
+bool StorageFSArchive::flush_segment(const Lock& lock) const
+{
+    OT_ASSERT(lock.owns_lock());
+
+    if (pending_.empty()) {
+
+        return true;
+    }
+
+    const auto segment = next_segment_;
+    std::map<std::string, Location> index{};
+    std::string payload{};
+    payload.reserve(pending_bytes_);
+
+    for (const auto& it : pending_) {
+        const auto& key = it.first;
+        const auto& value = it.second;
+        index.emplace(key, Location{segment, payload.size(), value.size()});
+        payload.append(value);
+    }
+
+    std::string compressed{};
+
+    try {
+        // Compression favours speed since every backup run pays for it
+        compressed = OTASCIIArmor::compress_string(payload, Z_BEST_SPEED);
+    } catch (const std::runtime_error& e) {
+        otErr << OT_METHOD << __FUNCTION__ << ": " << e.what() << std::endl;
+
+        return false;
+    }
+
+    const auto filename = segment_filename(segment);
+
+    if (false == write_file(segment_directory(), filename, compressed)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to write segment "
+              << segment << std::endl;
+
+        return false;
+    }
+
+    std::ostringstream entries{};
+
+    for (const auto& it : index) {
+        const auto& location = it.second;
+        entries << it.first << " " << std::get<0>(location) << " "
+                << std::get<1>(location) << " " << std::get<2>(location)
+                << "\n";
+    }
+
+    const auto text = entries.str();
+    boost::filesystem::path manifestPath(manifest_filename());
+    File manifest(manifestPath, std::ios_base::out | std::ios_base::app);
+
+    if (false == manifest.good()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to open manifest."
+              << std::endl;
+
+        return false;
+    }
+
+    manifest.write(text.c_str(), text.size());
+
+    if (false == sync(manifest)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Failed to sync manifest."
+              << std::endl;
+    }
+
+    manifest.close();
+
+    if (false == sync(folder_)) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Unable to sync directory "
+              << folder_ << std::endl;
+    }
+
+    manifest_.insert(index.begin(), index.end());
+    pending_.clear();
+    pending_bytes_ = 0;
+    ++next_segment_;
+
+    return true;
+}
+
 void StorageFSArchive::Init_StorageFSArchive()
 {
     OT_ASSERT(false == folder_.empty());
 
     boost::system::error_code ec{};
+    boost::filesystem::create_directory(folder_, ec);
+
+    // An existing archive is reopened so it can be updated incrementally
+    if (false == boost::filesystem::is_directory(folder_, ec)) {
+
+        return;
+    }
+
+    if (segmented_) {
+        boost::filesystem::create_directory(segment_directory(), ec);
+        read_manifest();
+    }
+
+    ready_->On();
+}
+
+bool StorageFSArchive::load_segment(
+    const Lock& lock,
+    const std::uint64_t segment) const
+{
+    OT_ASSERT(lock.owns_lock());
+
+    if ((segment == cached_segment_id_) && (false == cached_segment_.empty())) {
+
+        return true;
+    }
+
+    cached_segment_.clear();
+    const auto compressed = read_file(segment_filename(segment));
+
+    if (compressed.empty()) {
+        otErr << OT_METHOD << __FUNCTION__ << ": Unable to read segment "
+              << segment << std::endl;
+
+        return false;
+    }
 
-    if (boost::filesystem::create_directory(folder_, ec)) {
-        ready_->On();
+    try {
+        cached_segment_ = OTASCIIArmor::decompress_string(compressed);
+    } catch (const std::runtime_error& e) {
+        otErr << OT_METHOD << __FUNCTION__ << ": " << e.what() << std::endl;
+
+        return false;
+    }
+
+    cached_segment_id_ = segment;
+
+    return true;
+}
+
+bool StorageFSArchive::LoadFromBucket(
+    const std::string& key,
+    std::string& value,
+    const bool bucket) const
+{
+    value.clear();
+
+    if (segmented_) {
+        Lock lock(segment_lock_);
+        const auto pending = pending_.find(key);
+
+        if (pending_.end() != pending) {
+            value = pending->second;
+
+            return true;
+        }
+
+        const auto it = manifest_.find(key);
+
+        if (manifest_.end() != it) {
+            const auto& segment = std::get<0>(it->second);
+            const auto& offset = std::get<1>(it->second);
+            const auto& size = std::get<2>(it->second);
+
+            if (false == load_segment(lock, segment)) {
+
+                return false;
+            }
+
+            if (cached_segment_.size() < (offset + size)) {
+                otErr << OT_METHOD << __FUNCTION__ << ": Segment " << segment
+                      << " is truncated." << std::endl;
+
+                return false;
+            }
+
+            value = cached_segment_.substr(offset, size);
+
+            return false == value.empty();
+        }
     }
+
+    // Objects written before segmentation was introduced
+    return ot_super::LoadFromBucket(key, value, bucket);
+}
+
+std::string StorageFSArchive::manifest_filename() const
+{
+    return folder_ + path_seperator_ + ARCHIVE_MANIFEST_FILE;
 }
 
 std::string StorageFSArchive::prepare_read(const std::string& input) const
@@ -200,12 +425,109 @@ std::string StorageFSArchive::prepare_write(const std::string& plaintext) const
     return proto::ProtoAsString(ciphertext);
 }
 
+void StorageFSArchive::read_manifest()
+{
+    std::ifstream file(manifest_filename());
+    std::string line{};
+
+    while (std::getline(file, line)) {
+        // A line without a terminator was interrupted mid-write
+        if (file.eof()) {
+            break;
+        }
+
+        std::istringstream entry(line);
+        std::string key{};
+        std::uint64_t segment{0};
+        std::uint64_t offset{0};
+        std::uint64_t size{0};
+
+        if (entry >> key >> segment >> offset >> size) {
+            manifest_[key] = Location{segment, offset, size};
+            next_segment_ = std::max(next_segment_, segment + 1);
+        }
+    }
+
+    otInfo << OT_METHOD << __FUNCTION__ << ": Loaded " << manifest_.size()
+           << " archived objects in " << next_segment_ << " segments."
+           << std::endl;
+}
+
 std::string StorageFSArchive::root_filename() const
 {
     return folder_ + path_seperator_ + config_.fs_root_file_ +
            ROOT_FILE_EXTENSION;
 }
 
+std::string StorageFSArchive::segment_directory() const
+{
+    return folder_ + path_seperator_ + ARCHIVE_SEGMENT_DIRECTORY;
+}
+
+std::string StorageFSArchive::segment_filename(
+    const std::uint64_t segment) const
+{
+    return segment_directory() + path_seperator_ + std::to_string(segment);
+}
+
+void StorageFSArchive::store(
+    const bool isTransaction,
+    const std::string& key,
+    const std::string& value,
+    const bool bucket,
+    std::promise<bool>* promise) const
+{
+    if (false == segmented_) {
+        ot_super::store(isTransaction, key, value, bucket, promise);
+
+        return;
+    }
+
+    OT_ASSERT(nullptr != promise);
+
+    if (false == ready_.get()) {
+        promise->set_value(false);
+
+        return;
+    }
+
+    Lock lock(segment_lock_);
+
+    // Keys are content hashes, so a known key never needs to be rewritten
+    if ((0 < manifest_.count(key)) || (0 < pending_.count(key))) {
+        promise->set_value(true);
+
+        return;
+    }
+
+    pending_.emplace(key, value);
+    pending_bytes_ += value.size();
+
+    if (ARCHIVE_SEGMENT_SIZE > pending_bytes_) {
+        promise->set_value(true);
+
+        return;
+    }
+
+    promise->set_value(flush_segment(lock));
+}
+
+bool StorageFSArchive::StoreRoot(const bool commit, const std::string& hash)
+    const
+{
+    if (segmented_) {
+        Lock lock(segment_lock_);
+
+        // The root must never refer to objects which are not yet on disk
+        if (false == flush_segment(lock)) {
+
+            return false;
+        }
+    }
+
+    return ot_super::StoreRoot(commit, hash);
+}
+
 StorageFSArchive::~StorageFSArchive() { Cleanup_StorageFSArchive(); }
 }  // namespace opentxs
 #endif
@@ -83,6 +83,12 @@ StorageMultiplex::StorageMultiplex(
     Init_StorageMultiplex(primary, migrate, previous);
 }
 
+bool StorageMultiplex::Archived(const std::string&) const
+{
+    // The multiplexer is only ever the source of a migration
+    return false;
+}
+
 std::string StorageMultiplex::best_root(bool& primaryOutOfSync)
 {
     OT_ASSERT(primary_plugin_);
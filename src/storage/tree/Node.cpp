@@ -151,6 +151,11 @@ bool Node::migrate(
         return true;
     }
 
+    if (to.Archived(hash)) {
+
+        return true;
+    }
+
     return driver_.Migrate(hash, to);
 }
 
@@ -168,14 +173,23 @@ bool Node::Migrate(const opentxs::api::storage::Driver& to) const
         return true;
     }
 
+    if (to.Archived(root_)) {
+
+        return true;
+    }
+
     bool output{true};
-    output &= migrate(root_, to);
 
+    // Items first, so an index present in the target implies its items are
     for (const auto& item : item_map_) {
         const auto& hash = std::get<0>(item.second);
         output &= migrate(hash, to);
     }
 
+    // An archived root makes later runs skip the whole subtree, so it is
+    // only written once everything it references has been
+    output = output && migrate(root_, to);
+
     return output;
 }
 
@@ -451,6 +451,11 @@ const Mailbox& Nym::MailOutbox() const { return *mail_outbox(); }
 
 bool Nym::Migrate(const opentxs::api::storage::Driver& to) const
 {
+    if (to.Archived(root_)) {
+
+        return true;
+    }
+
     bool output{true};
     output &= migrate(credentials_, to);
     output &= sent_request_box()->Migrate(to);
@@ -466,7 +471,7 @@ bool Nym::Migrate(const opentxs::api::storage::Driver& to) const
     output &= threads()->Migrate(to);
     output &= contexts()->Migrate(to);
     output &= issuers()->Migrate(to);
-    output &= migrate(root_, to);
+    output = output && migrate(root_, to);
 
     return output;
 }
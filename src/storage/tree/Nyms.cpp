@@ -138,6 +138,11 @@ void Nyms::Map(NymLambda lambda) const
 
 bool Nyms::Migrate(const opentxs::api::storage::Driver& to) const
 {
+    if (to.Archived(root_)) {
+
+        return true;
+    }
+
     bool output{true};
 
     for (const auto index : item_map_) {
@@ -146,7 +151,7 @@ bool Nyms::Migrate(const opentxs::api::storage::Driver& to) const
         output &= node.Migrate(to);
     }
 
-    output &= migrate(root_, to);
+    output = output && migrate(root_, to);
 
     return output;
 }
@@ -197,6 +197,11 @@ ObjectList Threads::List(const bool unreadOnly) const
 
 bool Threads::Migrate(const opentxs::api::storage::Driver& to) const
 {
+    if (to.Archived(root_)) {
+
+        return true;
+    }
+
     bool output{true};
 
     for (const auto index : item_map_) {
@@ -205,7 +210,7 @@ bool Threads::Migrate(const opentxs::api::storage::Driver& to) const
         output &= node.Migrate(to);
     }
 
-    output &= migrate(root_, to);
+    output = output && migrate(root_, to);
 
     return output;
 }
@@ -230,6 +230,11 @@ void Tree::init(const std::string& hash)
 
 bool Tree::Migrate(const opentxs::api::storage::Driver& to) const
 {
+    if (to.Archived(root_)) {
+
+        return true;
+    }
+
     bool output{true};
     output &= blockchain()->Migrate(to);
     output &= contacts()->Migrate(to);
@@ -238,7 +243,9 @@ bool Tree::Migrate(const opentxs::api::storage::Driver& to) const
     output &= seeds()->Migrate(to);
     output &= servers()->Migrate(to);
     output &= units()->Migrate(to);
-    output &= migrate(root_, to);
+    // An archived root makes later runs skip the whole subtree, so it is
+    // only written once everything it references has been
+    output = output && migrate(root_, to);
 
     return output;
 }
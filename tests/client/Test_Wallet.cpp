@@ -0,0 +1,163 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/api/client/Wallet.hpp"
+#include "opentxs/api/Api.hpp"
+#include "opentxs/api/Native.hpp"
+#include "opentxs/client/OTAPI_Exec.hpp"
+#include "opentxs/consensus/ServerContext.hpp"
+#include "opentxs/core/contract/ServerContract.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Proto.hpp"
+
+#include <limits>
+#include <list>
+#include <string>
+
+using namespace opentxs;
+
+namespace
+{
+class Test_Wallet : public ::testing::Test
+{
+public:
+    const api::client::Wallet& wallet_;
+    const OTAPI_Exec& exec_;
+
+    Test_Wallet()
+        : wallet_(OT::App().Wallet())
+        , exec_(OT::App().API().Exec())
+    {
+        // Start every test from a cache which only holds referenced objects
+        wallet_.Trim(0);
+    }
+
+    Identifier nym(const std::string& name) const
+    {
+        return Identifier(
+            exec_.CreateNymHD(proto::CITEMTYPE_INDIVIDUAL, name));
+    }
+
+    ConstServerContract server(const Identifier& nymID) const
+    {
+        const std::list<ServerContract::Endpoint> endpoints{
+            {proto::ADDRESSTYPE_IPV4,
+             proto::PROTOCOLVERSION_LEGACY,
+             "127.0.0.1",
+             7085,
+             1}};
+
+        return wallet_.Server(nymID.str(), "Notary", "Terms", endpoints);
+    }
+};
+}  // namespace
+
+TEST_F(Test_Wallet, referenced_nyms_are_not_evicted)
+{
+    const auto before = wallet_.CacheStats();
+    const auto id = nym("Alice");
+    auto alice = wallet_.Nym(id);
+
+    ASSERT_TRUE(alice);
+
+    wallet_.Trim(0);
+    const auto held = wallet_.CacheStats();
+
+    ASSERT_EQ(held.nyms_, before.nyms_ + 1);
+    ASSERT_LT(before.bytes_, held.bytes_);
+
+    alice.reset();
+    wallet_.Trim(0);
+    const auto after = wallet_.CacheStats();
+
+    ASSERT_EQ(after.nyms_, before.nyms_);
+    ASSERT_EQ(after.bytes_, before.bytes_);
+    ASSERT_LT(held.evictions_, after.evictions_);
+    ASSERT_TRUE(wallet_.Nym(id));
+}
+
+TEST_F(Test_Wallet, bytes_are_released_when_a_contract_is_removed)
+{
+    const auto notary = nym("Notary");
+    auto contract = server(notary);
+
+    ASSERT_TRUE(contract);
+
+    const auto id = contract->ID();
+    const auto before = wallet_.CacheStats();
+    contract.reset();
+
+    ASSERT_TRUE(wallet_.RemoveServer(id));
+
+    const auto after = wallet_.CacheStats();
+
+    ASSERT_EQ(after.servers_ + 1, before.servers_);
+    ASSERT_LT(after.bytes_, before.bytes_);
+    ASSERT_EQ(after.evictions_, before.evictions_);
+}
+
+TEST_F(Test_Wallet, nymfile_locks_are_kept_while_a_context_is_cached)
+{
+    const auto local = nym("Bob");
+    const auto notary = nym("Notary");
+    const auto contract = server(notary);
+
+    ASSERT_TRUE(contract);
+
+    const auto before = wallet_.CacheStats();
+
+    {
+        auto context = wallet_.mutable_ServerContext(local, contract->ID());
+    }
+
+    // No one but the cached context uses the nymfile mutex of the local nym
+    wallet_.Trim(std::numeric_limits<std::size_t>::max());
+    const auto cached = wallet_.CacheStats();
+
+    ASSERT_EQ(cached.contexts_, before.contexts_ + 1);
+    ASSERT_EQ(cached.locks_, before.locks_ + 1);
+
+    wallet_.Trim(0);
+    const auto evicted = wallet_.CacheStats();
+
+    ASSERT_EQ(evicted.contexts_, before.contexts_);
+    ASSERT_EQ(evicted.locks_, before.locks_);
+}
@@ -908,6 +908,48 @@ TEST_F(Test_ContactData, HaveClaim_2)
         "dummyContactItemValue"));
 }
 
+TEST_F(Test_ContactData, HaveClaim_after_update)
+{
+    const auto& data1 = contactData_.AddItem(activeContactItem_);
+    // Build the index of data1 before deriving new versions from it.
+    ASSERT_TRUE(data1.HaveClaim(activeContactItem_->ID()));
+
+    const auto& contactItem2 =
+        std::shared_ptr<opentxs::ContactItem>(new opentxs::ContactItem(
+            std::string("contactItem2"),
+            CONTACT_CONTACT_DATA_VERSION,
+            CONTACT_CONTACT_DATA_VERSION,
+            opentxs::proto::CONTACTSECTION_IDENTIFIER,
+            opentxs::proto::CITEMTYPE_INDIVIDUAL,
+            std::string("contactItemValue2"),
+            {opentxs::proto::ContactItemAttribute::CITEMATTR_ACTIVE},
+            NULL_START,
+            NULL_END));
+    const auto& data2 = data1.AddItem(contactItem2);
+    ASSERT_TRUE(data2.HaveClaim(contactItem2->ID()));
+    ASSERT_TRUE(data2.HaveClaim(
+        opentxs::proto::CONTACTSECTION_IDENTIFIER,
+        opentxs::proto::CITEMTYPE_INDIVIDUAL,
+        "contactItemValue2"));
+    ASSERT_FALSE(data1.HaveClaim(contactItem2->ID()));
+    ASSERT_FALSE(data1.HaveClaim(
+        opentxs::proto::CONTACTSECTION_IDENTIFIER,
+        opentxs::proto::CITEMTYPE_INDIVIDUAL,
+        "contactItemValue2"));
+
+    const auto& data3 = data2.Delete(activeContactItem_->ID());
+    ASSERT_FALSE(data3.HaveClaim(activeContactItem_->ID()));
+    ASSERT_FALSE(data3.HaveClaim(
+        opentxs::proto::CONTACTSECTION_IDENTIFIER,
+        opentxs::proto::CITEMTYPE_INDIVIDUAL,
+        "activeContactItemValue"));
+    ASSERT_TRUE(data2.HaveClaim(activeContactItem_->ID()));
+
+    const opentxs::ContactData copy(data3);
+    ASSERT_TRUE(copy.HaveClaim(contactItem2->ID()));
+    ASSERT_EQ(copy.Claim(contactItem2->ID())->Value(), "contactItemValue2");
+}
+
 TEST_F(Test_ContactData, Name)
 {
     // Verify that Name returns an empty string if there is no scope group.
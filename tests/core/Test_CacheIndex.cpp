@@ -0,0 +1,112 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/core/CacheIndex.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace opentxs;
+
+namespace
+{
+std::function<std::size_t()> size(const std::size_t bytes)
+{
+    return [bytes]() -> std::size_t { return bytes; };
+}
+}  // namespace
+
+TEST(CacheIndex, referenced_entries_are_not_evicted)
+{
+    CacheIndex<std::string> index;
+    index.Touch("a", size(10));
+    index.Touch("b", size(20));
+    index.Touch("c", size(30));
+
+    const auto evicted = index.Evict(
+        60, [](const std::string& key) -> bool { return "b" != key; });
+
+    ASSERT_EQ(evicted, 2u);
+    ASSERT_EQ(index.Size(), 1u);
+    ASSERT_EQ(index.Bytes(), 20u);
+}
+
+TEST(CacheIndex, eviction_is_least_recently_used_first)
+{
+    CacheIndex<std::string> index;
+    index.Touch("a", size(10));
+    index.Touch("b", size(10));
+    index.Touch("c", size(10));
+    index.Touch("a", size(10));
+    std::vector<std::string> visited{};
+
+    const auto evicted =
+        index.Evict(15, [&visited](const std::string& key) -> bool {
+            visited.push_back(key);
+
+            return true;
+        });
+
+    ASSERT_EQ(evicted, 2u);
+    ASSERT_EQ(visited, std::vector<std::string>({"b", "c"}));
+    ASSERT_EQ(index.Size(), 1u);
+    ASSERT_EQ(index.Bytes(), 10u);
+}
+
+TEST(CacheIndex, bytes_follow_erase_and_evict)
+{
+    CacheIndex<std::string> index;
+    index.Touch("a", size(10));
+    index.Touch("b", size(20));
+    // The estimate is only recorded the first time an entry is touched
+    index.Touch("a", size(99));
+
+    ASSERT_EQ(index.Bytes(), 30u);
+
+    index.Erase("a");
+    index.Erase("missing");
+
+    ASSERT_EQ(index.Size(), 1u);
+    ASSERT_EQ(index.Bytes(), 20u);
+    ASSERT_EQ(index.Evict(1, [](const std::string&) { return true; }), 1u);
+    ASSERT_EQ(index.Size(), 0u);
+    ASSERT_EQ(index.Bytes(), 0u);
+}
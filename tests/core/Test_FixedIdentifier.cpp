@@ -0,0 +1,129 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "opentxs/core/FixedIdentifier.hpp"
+#include "opentxs/core/Identifier.hpp"
+
+using namespace opentxs;
+
+namespace
+{
+OTIdentifier make_id(const std::uint8_t seed, const std::size_t size = 32)
+{
+    std::string bytes(size, '\0');
+
+    for (std::size_t i = 0; i < size; ++i) {
+        bytes[i] = static_cast<char>(seed + i);
+    }
+
+    auto output = Identifier::Factory();
+    output->Assign(bytes.data(), bytes.size());
+
+    return output;
+}
+}  // namespace
+
+TEST(FixedIdentifier, default_is_empty)
+{
+    const FixedIdentifier id{};
+
+    ASSERT_TRUE(id.empty());
+    ASSERT_EQ(id.size(), 0);
+    ASSERT_TRUE(id == FixedIdentifier(Identifier::Factory()));
+}
+
+TEST(FixedIdentifier, round_trip)
+{
+    const auto original = make_id(1);
+    const FixedIdentifier id(original);
+
+    ASSERT_FALSE(id.empty());
+    ASSERT_EQ(id.size(), original->GetSize());
+    ASSERT_EQ(id.Type(), original->Type());
+    ASSERT_TRUE(id.Get() == original);
+}
+
+TEST(FixedIdentifier, compare)
+{
+    const FixedIdentifier one(make_id(1));
+    const FixedIdentifier same(make_id(1));
+    const FixedIdentifier other(make_id(2));
+
+    ASSERT_TRUE(one == same);
+    ASSERT_EQ(one.Hash(), same.Hash());
+    ASSERT_TRUE(one != other);
+    ASSERT_TRUE((one < other) != (other < one));
+    ASSERT_FALSE(one < same);
+}
+
+TEST(FixedIdentifier, short_values)
+{
+    const FixedIdentifier one(make_id(1, 4));
+    const FixedIdentifier other(make_id(1, 5));
+
+    ASSERT_EQ(one.size(), 4);
+    ASSERT_TRUE(one != other);
+    ASSERT_TRUE(one < other);
+}
+
+TEST(FixedIdentifier, oversize_is_empty)
+{
+    const FixedIdentifier id(make_id(1, FixedIdentifier::MaxSize + 1));
+
+    ASSERT_TRUE(id.empty());
+}
+
+TEST(FixedIdentifier, unordered_key)
+{
+    std::unordered_map<FixedIdentifier, int> map{};
+
+    for (std::uint8_t i = 0; i < 100; ++i) {
+        map[FixedIdentifier(make_id(i))] = i;
+    }
+
+    ASSERT_EQ(map.size(), 100);
+
+    for (std::uint8_t i = 0; i < 100; ++i) {
+        ASSERT_EQ(map.at(FixedIdentifier(make_id(i))), i);
+    }
+}
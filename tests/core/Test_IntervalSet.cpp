@@ -0,0 +1,178 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "opentxs/core/IntervalSet.hpp"
+#include "opentxs/core/NumList.hpp"
+#include "opentxs/core/String.hpp"
+
+using namespace opentxs;
+
+TEST(IntervalSet, default_is_empty)
+{
+    IntervalSet set;
+    ASSERT_TRUE(set.empty());
+    ASSERT_EQ(set.size(), 0);
+    ASSERT_TRUE(set.begin() == set.end());
+    ASSERT_EQ(set.Serialize(), "");
+}
+
+TEST(IntervalSet, consecutive_numbers_merge)
+{
+    IntervalSet set;
+    ASSERT_TRUE(set.insert(3).second);
+    ASSERT_TRUE(set.insert(1).second);
+    ASSERT_TRUE(set.insert(2).second);
+    ASSERT_FALSE(set.insert(2).second);
+    ASSERT_EQ(set.size(), 3);
+    ASSERT_EQ(set.Intervals().size(), 1);
+    ASSERT_EQ(set.Serialize(), "1-3");
+}
+
+TEST(IntervalSet, erase_splits_range)
+{
+    IntervalSet set;
+    ASSERT_EQ(set.InsertRange(1, 10), 10);
+    ASSERT_EQ(set.erase(5), 1);
+    ASSERT_EQ(set.erase(5), 0);
+    ASSERT_EQ(set.erase(1), 1);
+    ASSERT_EQ(set.erase(10), 1);
+    ASSERT_EQ(set.size(), 7);
+    ASSERT_EQ(set.count(4), 1);
+    ASSERT_EQ(set.count(5), 0);
+    ASSERT_EQ(set.Serialize(), "2-4,6-9");
+}
+
+TEST(IntervalSet, iterates_in_order)
+{
+    const std::set<std::int64_t> numbers{1, 2, 3, 7, 9, 10};
+    IntervalSet set(numbers);
+    ASSERT_EQ(set.size(), numbers.size());
+    ASSERT_EQ(std::set<std::int64_t>(set.begin(), set.end()), numbers);
+    ASSERT_EQ(set.Set(), numbers);
+}
+
+TEST(IntervalSet, insert_range_counts_new_values)
+{
+    IntervalSet set;
+    set.InsertRange(5, 9);
+    set.InsertRange(20, 25);
+    ASSERT_EQ(set.InsertRange(1, 30), 19);
+    ASSERT_EQ(set.size(), 30);
+    ASSERT_EQ(set.Serialize(), "1-30");
+}
+
+TEST(IntervalSet, subset_and_intersection)
+{
+    IntervalSet set;
+    set.InsertRange(1, 100);
+    set.InsertRange(200, 300);
+
+    IntervalSet subset;
+    subset.InsertRange(10, 20);
+    subset.insert(250);
+
+    IntervalSet other;
+    other.InsertRange(150, 199);
+
+    ASSERT_TRUE(set.Contains(subset));
+    ASSERT_FALSE(subset.Contains(set));
+    ASSERT_TRUE(set.Intersects(subset));
+    ASSERT_FALSE(set.Intersects(other));
+
+    other.insert(300);
+
+    ASSERT_TRUE(set.Intersects(other));
+    ASSERT_FALSE(set.Contains(other));
+}
+
+TEST(IntervalSet, parse_accepts_lists_and_ranges)
+{
+    IntervalSet set;
+    ASSERT_TRUE(IntervalSet::Parse("1,2, 3 5-9,12", set));
+    ASSERT_EQ(set.size(), 9);
+    ASSERT_EQ(set.Serialize(), "1-3,5-9,12");
+
+    IntervalSet copy;
+    ASSERT_TRUE(IntervalSet::Parse(set.Serialize(), copy));
+    ASSERT_TRUE(copy == set);
+}
+
+TEST(IntervalSet, parse_rejects_garbage)
+{
+    IntervalSet set;
+    ASSERT_FALSE(IntervalSet::Parse("1,x", set));
+    ASSERT_FALSE(IntervalSet::Parse("9-5", set));
+    ASSERT_FALSE(IntervalSet::Parse("-5", set));
+}
+
+TEST(IntervalSet, parse_without_ranges_rejects_ranges)
+{
+    IntervalSet set;
+    ASSERT_TRUE(IntervalSet::Parse("1,2,3", set, false));
+    ASSERT_EQ(set.size(), 3);
+    ASSERT_FALSE(IntervalSet::Parse("1-9000000000000000000", set, false));
+}
+
+TEST(IntervalSet, serialize_without_ranges)
+{
+    IntervalSet set;
+    set.InsertRange(1, 3);
+    set.insert(5);
+    ASSERT_EQ(set.Serialize(false), "1,2,3,5");
+}
+
+TEST(IntervalSet, numlist_rejects_ranges)
+{
+    NumList list(String("1-9000000000000000000"));
+    ASSERT_EQ(list.Count(), 0);
+
+    NumList plain(String("1,2,3,5"));
+    ASSERT_EQ(plain.Count(), 4);
+    ASSERT_TRUE(plain.Verify(2));
+    ASSERT_FALSE(plain.Verify(4));
+
+    String output;
+    ASSERT_TRUE(plain.Output(output));
+    ASSERT_STREQ(output.Get(), "1,2,3,5");
+}
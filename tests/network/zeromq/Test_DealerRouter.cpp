@@ -0,0 +1,184 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+
+#include "opentxs/Forward.hpp"
+#include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/DealerSocket.hpp"
+#include "opentxs/network/zeromq/ReplyCallback.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
+#include "opentxs/network/zeromq/ReplySocket.hpp"
+#include "opentxs/network/zeromq/RequestSocket.hpp"
+#include "opentxs/network/zeromq/RouterSocket.hpp"
+
+using namespace opentxs;
+
+namespace
+{
+
+class Test_DealerRouter : public ::testing::Test
+{
+public:
+    static OTZMQContext context_;
+
+    const std::string testMessage_{"zeromq test message"};
+    const std::string endpoint_{"inproc://opentxs/test/dealer_router_test"};
+};
+
+OTZMQContext Test_DealerRouter::context_{network::zeromq::Context::Factory()};
+
+}  // namespace
+
+TEST_F(Test_DealerRouter, Dealer_Router)
+{
+    auto replyCallback = network::zeromq::ReplyCallback::Factory(
+        [](const network::zeromq::Message& input) -> OTZMQMessage {
+            return network::zeromq::Message::Factory(input);
+        });
+
+    ASSERT_NE(&replyCallback.get(), nullptr);
+
+    auto routerSocket = network::zeromq::RouterSocket::Factory(
+        Test_DealerRouter::context_, replyCallback);
+
+    ASSERT_NE(&routerSocket.get(), nullptr);
+    ASSERT_EQ(routerSocket->Type(), SocketType::Router);
+
+    routerSocket->SetTimeouts(0, 10000, -1);
+    routerSocket->Start(endpoint_ + "/1");
+
+    auto dealerSocket =
+        network::zeromq::DealerSocket::Factory(Test_DealerRouter::context_);
+
+    ASSERT_NE(&dealerSocket.get(), nullptr);
+    ASSERT_EQ(dealerSocket->Type(), SocketType::Dealer);
+
+    dealerSocket->SetTimeouts(0, -1, 10000);
+    dealerSocket->Start(endpoint_ + "/1");
+
+    auto[result, message] = dealerSocket->SendRequest(testMessage_).get();
+
+    ASSERT_EQ(result, SendResult::VALID_REPLY);
+    const std::string& messageString = message.get();
+    ASSERT_EQ(messageString, testMessage_);
+}
+
+TEST_F(Test_DealerRouter, Dealer_Router_Multiple_In_Flight)
+{
+    auto replyCallback = network::zeromq::ReplyCallback::Factory(
+        [](const network::zeromq::Message& input) -> OTZMQMessage {
+            return network::zeromq::Message::Factory(input);
+        });
+    auto routerSocket = network::zeromq::RouterSocket::Factory(
+        Test_DealerRouter::context_, replyCallback);
+    routerSocket->SetTimeouts(0, 10000, -1);
+    routerSocket->Start(endpoint_ + "/2");
+    auto dealerSocket =
+        network::zeromq::DealerSocket::Factory(Test_DealerRouter::context_);
+    dealerSocket->SetTimeouts(0, -1, 10000);
+    dealerSocket->Start(endpoint_ + "/2");
+    std::vector<std::future<network::zeromq::Socket::MessageSendResult>>
+        replies{};
+
+    for (int i = 0; i < 10; ++i) {
+        replies.emplace_back(
+            dealerSocket->SendRequest(testMessage_ + std::to_string(i)));
+    }
+
+    // Replies must be matched to the request which produced them even when
+    // they are collected in a different order than they were sent
+    for (int i = 9; i >= 0; --i) {
+        auto[result, message] = replies.at(i).get();
+
+        ASSERT_EQ(result, SendResult::VALID_REPLY);
+        const std::string& messageString = message.get();
+        ASSERT_EQ(messageString, testMessage_ + std::to_string(i));
+    }
+}
+
+TEST_F(Test_DealerRouter, Request_Router)
+{
+    auto replyCallback = network::zeromq::ReplyCallback::Factory(
+        [](const network::zeromq::Message& input) -> OTZMQMessage {
+            return network::zeromq::Message::Factory(input);
+        });
+    auto routerSocket = network::zeromq::RouterSocket::Factory(
+        Test_DealerRouter::context_, replyCallback);
+    routerSocket->SetTimeouts(0, 10000, -1);
+    routerSocket->Start(endpoint_ + "/3");
+    auto requestSocket =
+        network::zeromq::RequestSocket::Factory(Test_DealerRouter::context_);
+    requestSocket->SetTimeouts(0, -1, 10000);
+    requestSocket->Start(endpoint_ + "/3");
+
+    auto[result, message] = requestSocket->SendRequest(testMessage_);
+
+    ASSERT_EQ(result, SendResult::VALID_REPLY);
+    const std::string& messageString = message.get();
+    ASSERT_EQ(messageString, testMessage_);
+}
+
+// Notaries which still bind a REP socket must be reachable from a DealerSocket
+TEST_F(Test_DealerRouter, Dealer_Reply)
+{
+    auto replyCallback = network::zeromq::ReplyCallback::Factory(
+        [](const network::zeromq::Message& input) -> OTZMQMessage {
+            return network::zeromq::Message::Factory(input);
+        });
+    auto replySocket = network::zeromq::ReplySocket::Factory(
+        Test_DealerRouter::context_, replyCallback);
+    replySocket->SetTimeouts(0, 10000, -1);
+    replySocket->Start(endpoint_ + "/4");
+    auto dealerSocket =
+        network::zeromq::DealerSocket::Factory(Test_DealerRouter::context_);
+    dealerSocket->SetTimeouts(0, -1, 10000);
+    dealerSocket->Start(endpoint_ + "/4");
+
+    auto[result, message] = dealerSocket->SendRequest(testMessage_).get();
+
+    ASSERT_EQ(result, SendResult::VALID_REPLY);
+    const std::string& messageString = message.get();
+    ASSERT_EQ(messageString, testMessage_);
+}
@@ -0,0 +1,214 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/core/OTStorage.hpp"
+#include "opentxs/server/BoxCache.hpp"
+
+#include <memory>
+#include <string>
+
+using namespace opentxs;
+
+namespace
+{
+const std::string folder_{"boxcache_test"};
+
+class Test_BoxCache : public ::testing::Test
+{
+public:
+    const std::string name_;
+
+    Test_BoxCache()
+        : name_(::testing::UnitTest::GetInstance()
+                    ->current_test_info()
+                    ->name())
+    {
+        OTDB::EraseValueByKey(folder_, name_, "a");
+        OTDB::EraseValueByKey(folder_, name_, "b");
+    }
+};
+}  // namespace
+
+TEST_F(Test_BoxCache, new_files_are_written_through)
+{
+    server::BoxCache cache;
+
+    ASSERT_TRUE(cache.Store("one", folder_, name_, "a"));
+    ASSERT_EQ(OTDB::QueryPlainString(folder_, name_, "a"), "one");
+    ASSERT_EQ(cache.Query(folder_, name_, "a"), "one");
+}
+
+TEST_F(Test_BoxCache, existing_files_are_written_on_flush)
+{
+    ASSERT_TRUE(OTDB::StorePlainString("one", folder_, name_, "a"));
+
+    server::BoxCache cache;
+
+    ASSERT_TRUE(cache.Store("two", folder_, name_, "a"));
+    ASSERT_TRUE(cache.Store("three", folder_, name_, "a"));
+    ASSERT_EQ(cache.Query(folder_, name_, "a"), "three");
+    ASSERT_EQ(OTDB::QueryPlainString(folder_, name_, "a"), "one");
+    ASSERT_EQ(cache.Stats().coalesced_writes_, 1u);
+
+    ASSERT_TRUE(cache.Flush());
+    ASSERT_EQ(OTDB::QueryPlainString(folder_, name_, "a"), "three");
+    ASSERT_EQ(cache.Stats().flushes_, 1u);
+
+    // Nothing is dirty, so a second flush writes nothing
+    ASSERT_TRUE(cache.Flush());
+    ASSERT_EQ(cache.Stats().flushes_, 1u);
+}
+
+TEST_F(Test_BoxCache, stored_contents_are_verified)
+{
+    ASSERT_TRUE(OTDB::StorePlainString("one", folder_, name_, "a"));
+
+    server::BoxCache cache;
+
+    ASSERT_FALSE(cache.Verified(folder_, name_, "a"));
+
+    cache.SetVerified(folder_, name_, "a");
+
+    ASSERT_TRUE(cache.Verified(folder_, name_, "a"));
+
+    ASSERT_TRUE(OTDB::StorePlainString("two", folder_, name_, "b"));
+    ASSERT_TRUE(cache.Store("three", folder_, name_, "b"));
+    ASSERT_TRUE(cache.Verified(folder_, name_, "b"));
+}
+
+TEST_F(Test_BoxCache, eviction_keeps_dirty_entries)
+{
+    ASSERT_TRUE(OTDB::StorePlainString("one", folder_, name_, "a"));
+    ASSERT_TRUE(OTDB::StorePlainString("one", folder_, name_, "b"));
+
+    server::BoxCache cache(1);
+
+    ASSERT_TRUE(cache.Store("two", folder_, name_, "a"));
+    cache.SetVerified(folder_, name_, "b");
+
+    ASSERT_EQ(cache.Query(folder_, name_, "a"), "two");
+
+    // Flushing evicts down to capacity, which forgets verification state
+    ASSERT_TRUE(cache.Flush());
+    ASSERT_EQ(OTDB::QueryPlainString(folder_, name_, "a"), "two");
+    ASSERT_FALSE(cache.Verified(folder_, name_, "b"));
+}
+
+TEST_F(Test_BoxCache, commit_writes_everything)
+{
+    ASSERT_TRUE(OTDB::StorePlainString("one", folder_, name_, "a"));
+    ASSERT_TRUE(OTDB::StorePlainString("one", folder_, name_, "b"));
+
+    server::BoxCache cache;
+
+    ASSERT_TRUE(cache.Store("two", folder_, name_, "a"));
+    ASSERT_TRUE(cache.Store("two", folder_, name_, "b"));
+    ASSERT_TRUE(cache.Commit());
+    ASSERT_EQ(OTDB::QueryPlainString(folder_, name_, "a"), "two");
+    ASSERT_EQ(OTDB::QueryPlainString(folder_, name_, "b"), "two");
+
+    // Nothing is left for recovery to apply
+    ASSERT_TRUE(OTDB::StorePlainString("three", folder_, name_, "a"));
+    ASSERT_TRUE(server::BoxCache().Recover());
+    ASSERT_EQ(OTDB::QueryPlainString(folder_, name_, "a"), "three");
+}
+
+// A dividend payout commits each shard's vouchers together with the
+// checkpoint which moves past that shard. Here "a" stands in for a
+// shareholder's nymbox and "b" for the payout checkpoint.
+TEST_F(Test_BoxCache, resume_after_crash_mid_shard)
+{
+    ASSERT_TRUE(OTDB::StorePlainString("no voucher", folder_, name_, "a"));
+    ASSERT_TRUE(OTDB::StorePlainString("shard 0", folder_, name_, "b"));
+
+    // Never destroyed, as if the process had stopped
+    auto crashed = std::make_unique<server::BoxCache>();
+
+    ASSERT_TRUE(crashed->Store("voucher", folder_, name_, "a"));
+    ASSERT_TRUE(crashed->Store("shard 1", folder_, name_, "b"));
+    ASSERT_TRUE(crashed->Prepare());
+    crashed.release();
+
+    // The nymbox reached storage but the checkpoint did not
+    ASSERT_TRUE(OTDB::StorePlainString("voucher", folder_, name_, "a"));
+    ASSERT_EQ(OTDB::QueryPlainString(folder_, name_, "b"), "shard 0");
+
+    server::BoxCache restarted;
+
+    ASSERT_TRUE(restarted.Recover());
+    ASSERT_EQ(restarted.Query(folder_, name_, "a"), "voucher");
+    ASSERT_EQ(restarted.Query(folder_, name_, "b"), "shard 1");
+}
+
+TEST_F(Test_BoxCache, batch_signs_each_box_once)
+{
+    ASSERT_TRUE(OTDB::StorePlainString("signed one", folder_, name_, "a"));
+
+    server::BoxCache cache;
+    int signatures{0};
+    const auto sign = [&]() -> bool {
+        ++signatures;
+
+        return cache.Store("signed three", folder_, name_, "a");
+    };
+
+    ASSERT_FALSE(cache.Batching());
+
+    {
+        server::BoxCache::Batch batch(cache);
+
+        ASSERT_TRUE(cache.Batching());
+
+        ASSERT_TRUE(cache.Store("two", folder_, name_, "a"));
+        cache.Defer(folder_, name_, "a", sign);
+        ASSERT_TRUE(cache.Store("three", folder_, name_, "a"));
+        cache.Defer(folder_, name_, "a", sign);
+
+        // Unsigned contents are never written
+        ASSERT_TRUE(cache.Flush());
+        ASSERT_EQ(OTDB::QueryPlainString(folder_, name_, "a"), "signed one");
+        ASSERT_EQ(signatures, 0);
+    }
+
+    ASSERT_FALSE(cache.Batching());
+    ASSERT_EQ(signatures, 1);
+    ASSERT_TRUE(cache.Flush());
+    ASSERT_EQ(OTDB::QueryPlainString(folder_, name_, "a"), "signed three");
+}
@@ -0,0 +1,133 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/server/SpentTokens.hpp"
+
+#if OT_CASH
+#include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/OTStorage.hpp"
+#include "opentxs/core/String.hpp"
+
+#include <memory>
+#include <string>
+
+using namespace opentxs;
+
+namespace
+{
+class Test_SpentTokens : public ::testing::Test
+{
+public:
+    const std::string name_;
+    const OTIdentifier unit_;
+    const OTIdentifier one_;
+    const OTIdentifier two_;
+
+    Test_SpentTokens()
+        : name_(::testing::UnitTest::GetInstance()
+                    ->current_test_info()
+                    ->name())
+        , unit_(server::SpentTokens::TokenID(String(name_.c_str())))
+        , one_(server::SpentTokens::TokenID(String("one")))
+        , two_(server::SpentTokens::TokenID(String("two")))
+    {
+        erase(0);
+        erase(1);
+    }
+
+private:
+    void erase(const std::uint32_t series) const
+    {
+        String store{};
+        store.Format("%s.%d", String(unit_).Get(), series);
+        const std::string name{store.Get()};
+        OTDB::EraseValueByKey(OTFolders::Spent().Get(), name + ".log");
+        OTDB::EraseValueByKey(OTFolders::Spent().Get(), name + ".idx");
+    }
+};
+}  // namespace
+
+TEST_F(Test_SpentTokens, round_trip)
+{
+    server::SpentTokens spent;
+
+    ASSERT_FALSE(spent.IsSpent(unit_, 0, one_));
+    ASSERT_TRUE(spent.Spend(unit_, {{0, {one_}}}));
+    ASSERT_TRUE(spent.IsSpent(unit_, 0, one_));
+    ASSERT_FALSE(spent.IsSpent(unit_, 0, two_));
+
+    // Series are tracked separately
+    ASSERT_FALSE(spent.IsSpent(unit_, 1, one_));
+}
+
+TEST_F(Test_SpentTokens, duplicate_spend)
+{
+    server::SpentTokens spent;
+
+    ASSERT_TRUE(spent.Spend(unit_, {{0, {one_}}}));
+    ASSERT_FALSE(spent.Spend(unit_, {{0, {one_}}}));
+
+    // A batch which fails records none of its tokens
+    ASSERT_FALSE(spent.Spend(unit_, {{0, {two_, one_}}}));
+    ASSERT_FALSE(spent.IsSpent(unit_, 0, two_));
+
+    // A token may not appear twice in the same batch
+    ASSERT_FALSE(spent.Spend(unit_, {{1, {two_, two_}}}));
+    ASSERT_FALSE(spent.IsSpent(unit_, 1, two_));
+    ASSERT_TRUE(spent.Spend(unit_, {{0, {two_}}, {1, {two_}}}));
+    ASSERT_TRUE(spent.IsSpent(unit_, 0, two_));
+    ASSERT_TRUE(spent.IsSpent(unit_, 1, two_));
+}
+
+TEST_F(Test_SpentTokens, reopen_after_restart)
+{
+    std::unique_ptr<server::SpentTokens> spent{new server::SpentTokens};
+
+    ASSERT_TRUE(spent->Spend(unit_, {{0, {one_}}, {1, {two_}}}));
+
+    spent.reset(new server::SpentTokens);
+
+    ASSERT_TRUE(spent->IsSpent(unit_, 0, one_));
+    ASSERT_TRUE(spent->IsSpent(unit_, 1, two_));
+    ASSERT_FALSE(spent->IsSpent(unit_, 0, two_));
+    ASSERT_FALSE(spent->Spend(unit_, {{0, {one_}}}));
+}
+#endif  // OT_CASH
@@ -0,0 +1,248 @@
+/************************************************************
+ *
+ *                 OPEN TRANSACTIONS
+ *
+ *       Financial Cryptography and Digital Cash
+ *       Library, Protocol, API, Server, CLI, GUI
+ *
+ *       -- Anonymous Numbered Accounts.
+ *       -- Untraceable Digital Cash.
+ *       -- Triple-Signed Receipts.
+ *       -- Cheques, Vouchers, Transfers, Inboxes.
+ *       -- Basket Currencies, Markets, Payment Plans.
+ *       -- Signed, XML, Ricardian-style Contracts.
+ *       -- Scripted smart contracts.
+ *
+ *  EMAIL:
+ *  fellowtraveler@opentransactions.org
+ *
+ *  WEBSITE:
+ *  http://www.opentransactions.org/
+ *
+ *  -----------------------------------------------------
+ *
+ *   LICENSE:
+ *   This Source Code Form is subject to the terms of the
+ *   Mozilla Public License, v. 2.0. If a copy of the MPL
+ *   was not distributed with this file, You can obtain one
+ *   at http://mozilla.org/MPL/2.0/.
+ *
+ *   DISCLAIMER:
+ *   This program is distributed in the hope that it will
+ *   be useful, but WITHOUT ANY WARRANTY; without even the
+ *   implied warranty of MERCHANTABILITY or FITNESS FOR A
+ *   PARTICULAR PURPOSE.  See the Mozilla Public License
+ *   for more details.
+ *
+ ************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "opentxs/core/trade/TradeLog.hpp"
+#include "opentxs/core/util/OTFolders.hpp"
+#include "opentxs/core/OTStorage.hpp"
+
+#include <string>
+
+using namespace opentxs;
+
+namespace
+{
+const std::string folder_{"trades"};
+
+class Test_TradeLog : public ::testing::Test
+{
+public:
+    const std::string market_;
+
+    Test_TradeLog()
+        : market_(
+              std::string("tradelog_") + ::testing::UnitTest::GetInstance()
+                                             ->current_test_info()
+                                             ->name())
+    {
+        erase("days");
+        erase("index");
+
+        for (const auto& day : {-86400, 0, 86400}) {
+            erase("index_" + std::to_string(day));
+        }
+
+        for (const auto& start : {-7200, -3600, 0, 3600, 7200, 86400}) {
+            erase(std::to_string(start));
+        }
+    }
+
+    bool erase(const std::string& name) const
+    {
+        return OTDB::EraseValueByKey(
+            OTFolders::Market().Get(), folder_, market_, name);
+    }
+
+    bool store(const std::string& value, const std::string& name) const
+    {
+        return OTDB::StorePlainString(
+            value, OTFolders::Market().Get(), folder_, market_, name);
+    }
+};
+}  // namespace
+
+TEST_F(Test_TradeLog, negative_times_round_down)
+{
+    TradeLog log(market_);
+    log.Add({-1, 10, 1, 1, 2});
+    log.Add({-3601, 20, 1, 3, 4});
+
+    const auto minutes = log.Bars(60, -7200, 0, 10);
+
+    ASSERT_EQ(minutes.size(), 2u);
+    ASSERT_EQ(minutes[0].start_, -3660);
+    ASSERT_EQ(minutes[1].start_, -60);
+
+    const auto hours = log.Bars(3600, -7200, 0, 10);
+
+    ASSERT_EQ(hours.size(), 2u);
+    ASSERT_EQ(hours[0].start_, -7200);
+    ASSERT_EQ(hours[1].start_, -3600);
+}
+
+TEST_F(Test_TradeLog, days_are_rolled_up_from_the_index)
+{
+    TradeLog log(market_);
+    log.Add({100, 10, 1, 1, 2});
+    log.Add({3700, 30, 2, 3, 4});
+    log.Add({7300, 20, 3, 5, 6});
+
+    ASSERT_TRUE(log.Save());
+
+    TradeLog reopened(market_);
+    const auto days = reopened.Bars(86400, 0, 86400, 10);
+
+    ASSERT_EQ(days.size(), 1u);
+    ASSERT_EQ(days[0].start_, 0);
+    ASSERT_EQ(days[0].open_, 10);
+    ASSERT_EQ(days[0].high_, 30);
+    ASSERT_EQ(days[0].low_, 10);
+    ASSERT_EQ(days[0].close_, 20);
+    ASSERT_EQ(days[0].volume_, 6);
+    ASSERT_EQ(days[0].trades_, 3);
+    ASSERT_EQ(reopened.Bars(3600, 0, 86400, 10).size(), 3u);
+}
+
+TEST_F(Test_TradeLog, saves_only_rewrite_changed_days)
+{
+    TradeLog log(market_);
+    log.Add({100, 10, 1, 1, 2});
+
+    ASSERT_TRUE(log.Save());
+    ASSERT_TRUE(erase("index_0"));
+
+    log.Add({86500, 20, 2, 3, 4});
+
+    ASSERT_TRUE(log.Save());
+    ASSERT_FALSE(OTDB::Exists(
+        OTFolders::Market().Get(), folder_, market_, "index_0"));
+    ASSERT_TRUE(OTDB::Exists(
+        OTFolders::Market().Get(), folder_, market_, "index_86400"));
+
+    TradeLog reopened(market_);
+    const auto days = reopened.Bars(86400, 0, 172800, 10);
+
+    ASSERT_EQ(days.size(), 1u);
+    ASSERT_EQ(days[0].start_, 86400);
+}
+
+TEST_F(Test_TradeLog, single_index_is_split_by_day)
+{
+    ASSERT_TRUE(store("0 10 10 10 10 1 1\n86400 20 20 20 20 2 2\n", "index"));
+
+    TradeLog log(market_);
+
+    ASSERT_TRUE(log.Save());
+    ASSERT_TRUE(erase("index"));
+
+    TradeLog reopened(market_);
+    const auto hours = reopened.Bars(3600, 0, 172800, 10);
+
+    ASSERT_EQ(hours.size(), 2u);
+    ASSERT_EQ(hours[0].volume_, 1);
+    ASSERT_EQ(hours[1].start_, 86400);
+    ASSERT_EQ(hours[1].volume_, 2);
+}
+
+TEST_F(Test_TradeLog, partitions_are_read_back)
+{
+    TradeLog log(market_);
+    log.Add({100, 10, 1, 2, 3});
+    log.Add({200, 20, 4, 5, 6});
+
+    ASSERT_TRUE(log.Save());
+
+    TradeLog reopened(market_);
+    const auto trades = reopened.Trades(0, 3600, 10);
+
+    ASSERT_EQ(trades.size(), 2u);
+    ASSERT_EQ(trades[1].time_, 200);
+    ASSERT_EQ(trades[1].price_, 20);
+    ASSERT_EQ(trades[1].amount_, 4);
+    ASSERT_EQ(trades[1].offer_, 5);
+    ASSERT_EQ(trades[1].other_offer_, 6);
+}
+
+TEST_F(Test_TradeLog, corrupt_partitions_are_ignored)
+{
+    ASSERT_TRUE(store("0 10 10 10 10 1 1\n3600 10 10 10 10 2 2\n", "index"));
+    // Four columns
+    ASSERT_TRUE(store("100\n10\n1\n2\n", "0"));
+    // Columns of different lengths
+    ASSERT_TRUE(store("3700 3800\n10 10\n1 1\n2 2\n3\n", "3600"));
+
+    TradeLog log(market_);
+
+    ASSERT_TRUE(log.Trades(0, 7200, 10).empty());
+}
+
+TEST_F(Test_TradeLog, unindexed_partitions_are_recovered)
+{
+    // The partition was saved but the index was not
+    ASSERT_TRUE(store("100\n10\n1\n2\n3\n", "0"));
+
+    TradeLog log(market_);
+    log.Add({200, 20, 4, 5, 6});
+
+    ASSERT_EQ(log.Trades(0, 3600, 10).size(), 2u);
+    ASSERT_EQ(log.Bars(3600, 0, 3600, 10).at(0).trades_, 2);
+    ASSERT_TRUE(log.Save());
+
+    TradeLog reopened(market_);
+
+    ASSERT_EQ(reopened.Trades(0, 3600, 10).size(), 2u);
+    ASSERT_EQ(reopened.Bars(86400, 0, 86400, 10).at(0).volume_, 5);
+}
+
+TEST_F(Test_TradeLog, limits_keep_the_newest_rows)
+{
+    TradeLog log(market_);
+
+    for (const auto& time : {100, 200, 300, 400, 500, 3700, 3800}) {
+        log.Add({time, 10, 1, 1, 1});
+    }
+
+    const auto trades = log.Trades(0, 7200, 4);
+
+    ASSERT_EQ(trades.size(), 4u);
+    ASSERT_EQ(trades[0].time_, 400);
+    ASSERT_EQ(trades[3].time_, 3800);
+
+    const auto minutes = log.Bars(60, 0, 7200, 3);
+
+    ASSERT_EQ(minutes.size(), 3u);
+    ASSERT_EQ(minutes[0].start_, 480);
+    ASSERT_EQ(minutes[1].start_, 3660);
+    ASSERT_EQ(minutes[2].start_, 3780);
+
+    const auto hours = log.Bars(3600, 0, 7200, 1);
+
+    ASSERT_EQ(hours.size(), 1u);
+    ASSERT_EQ(hours[0].start_, 3600);
+}